@@ -4,7 +4,9 @@
  */
 
 #include "abstractbasemodel_p.h"
+#include "job_p.h"
 #include "logging.h"
+#include "stringpool.h"
 #include <QJsonDocument>
 #include <QObject>
 
@@ -34,31 +36,63 @@ void AbstractBaseModelPrivate::setupJob()
 
 }
 
-bool AbstractBaseModelPrivate::startJob(AbstractBaseModel::LoadMode mode)
+bool AbstractBaseModelPrivate::startJob(AbstractBaseModel::LoadMode mode, bool incremental)
 {
     setIsLoading(true);
     setError(0, QString());
 
     Q_Q(AbstractBaseModel);
 
-    q->clear();
+    // a result still being decoded for a previous load is outdated now
+    if (decoder) {
+        decoder->cancel();
+    }
+
+    if (!incremental) {
+        q->clear();
+    }
 
     job->setConfiguration(q->configuration());
 
+    const BackgroundDecoder::DecodeFunction decode = decodeFunction();
+    // models with a decode function decode the raw reply without building a QJsonDocument
+    job->d_func()->keepRawReply = decode != nullptr;
+    const quint32 columns = columnsForRoles(activeRoles);
+
     if (mode == AbstractBaseModel::LoadAsync) {
-        QObject::connect(job, &Job::result, q, [this](SJob *sjob){
+        QObject::connect(job, &Job::result, q, [this, incremental, decode, columns](SJob *sjob){
             if (sjob->error()) {
                 finishLoading(sjob->error(), sjob->errorString());
             } else {
                 Job *_job = qobject_cast<Job* >(sjob);
-                loadFromJson(_job->replyData());
+                if (decode) {
+                    if (!decoder) {
+                        decoder.reset(new BackgroundDecoder);
+                    }
+                    // only replies served from the response cache come as parsed document
+                    decoder->start(_job->d_func()->rawReply, _job->d_func()->jsonResult, columns, decode, [this, incremental](DecodedRows *rows){
+                        finishDecoding(rows, incremental);
+                    });
+                } else if (incremental) {
+                    updateFromJson(_job->replyData());
+                } else {
+                    loadFromJson(_job->replyData());
+                }
             }
         });
-        job->start();
+        if (jobQueue) {
+            jobQueue->enqueue(job, JobQueue::Interactive);
+        } else {
+            job->start();
+        }
         return true;
     } else {
         if (job->exec()) {
-            return loadFromJson(job->replyData());
+            if (decode) {
+                const std::shared_ptr<DecodedRows> rows = decode(job->d_func()->rawReply, job->d_func()->jsonResult, columns);
+                return finishDecoding(rows.get(), incremental);
+            }
+            return incremental ? updateFromJson(job->replyData()) : loadFromJson(job->replyData());
         } else {
             finishLoading(job->error(), job->errorString());
             return false;
@@ -73,6 +107,65 @@ bool AbstractBaseModelPrivate::loadFromJson(const QJsonDocument &json)
     return true;
 }
 
+bool AbstractBaseModelPrivate::updateFromJson(const QJsonDocument &json)
+{
+    Q_Q(AbstractBaseModel);
+    q->clear();
+    return loadFromJson(json);
+}
+
+QVector<int> AbstractBaseModelPrivate::rolesForColumns(quint32 columns) const
+{
+    Q_UNUSED(columns);
+    return QVector<int>();
+}
+
+quint32 AbstractBaseModelPrivate::columnsForRoles(const QVector<int> &roles) const
+{
+    Q_UNUSED(roles);
+    return AllColumns;
+}
+
+BackgroundDecoder::DecodeFunction AbstractBaseModelPrivate::decodeFunction() const
+{
+    return nullptr;
+}
+
+bool AbstractBaseModelPrivate::applyDecoded(DecodedRows *rows, bool incremental)
+{
+    Q_UNUSED(rows);
+    Q_UNUSED(incremental);
+    finishLoading(0);
+    return true;
+}
+
+void AbstractBaseModelPrivate::removeFromIndexes(int first, int count)
+{
+    Q_UNUSED(first);
+    Q_UNUSED(count);
+}
+
+void AbstractBaseModelPrivate::addToIndexes(int first)
+{
+    Q_UNUSED(first);
+}
+
+void AbstractBaseModelPrivate::rebuildIndexes()
+{
+
+}
+
+bool AbstractBaseModelPrivate::finishDecoding(DecodedRows *rows, bool incremental)
+{
+    if (!rows) {
+        //: Error message
+        //% "Failed to decode the data received from the Docker daemon."
+        finishLoading(JsonParseError, qtTrId("libschauer-error-model-decode"));
+        return false;
+    }
+    return applyDecoded(rows, incremental);
+}
+
 void AbstractBaseModelPrivate::finishLoading(int error, const QString &errorString)
 {
     setError(error, errorString);
@@ -118,6 +211,7 @@ QStringList AbstractBaseModelPrivate::jsonArrayToStringList(const QJsonArray &ar
         for (const QJsonValue &val : array) {
             _list << val.toString();
         }
+        StringPool::intern(_list);
     }
     return _list;
 }
@@ -135,6 +229,7 @@ QMap<QString,QString> AbstractBaseModelPrivate::jsonObjectToStringMap(const QJso
         for (const QString &key : keys) {
             _map.insert(key, object.value(key).toString());
         }
+        StringPool::intern(_map);
     }
     return _map;
 }
@@ -144,6 +239,83 @@ QMap<QString,QString> AbstractBaseModelPrivate::jsonObjectToStringMap(const QJso
     return AbstractBaseModelPrivate::jsonObjectToStringMap(value.toObject());
 }
 
+LabelSetTable::LabelSetTable()
+    : m_sets(1)
+{
+
+}
+
+int LabelSetTable::insert(const QMap<QString,QString> &labels)
+{
+    if (labels.isEmpty()) {
+        return 0;
+    }
+
+    // length prefixes keep the key unambiguous whatever the labels contain
+    QString key;
+    auto i = labels.constBegin();
+    while (i != labels.constEnd()) {
+        key += QString::number(i.key().size()) + QLatin1Char(':') + i.key() + QString::number(i.value().size()) + QLatin1Char(':') + i.value();
+        ++i;
+    }
+
+    auto it = m_index.constFind(key);
+    if (it != m_index.constEnd()) {
+        return it.value();
+    }
+
+    const int index = size();
+    m_sets.push_back(labels);
+    m_index.insert(key, index);
+    return index;
+}
+
+void LabelSetTable::compact(std::vector<int> &labels)
+{
+    std::vector<int> remap(m_sets.size(), -1);
+    remap[0] = 0;
+    int used = 1;
+    for (int label : labels) {
+        if (remap[static_cast<std::size_t>(label)] < 0) {
+            remap[static_cast<std::size_t>(label)] = used++;
+        }
+    }
+
+    // only compact if most sets are unused, so that the table is not rebuilt on every refresh
+    if (size() - used <= used) {
+        return;
+    }
+
+    std::vector<QMap<QString,QString>> sets(static_cast<std::size_t>(used));
+    for (std::size_t i = 0; i < m_sets.size(); ++i) {
+        if (remap[i] >= 0) {
+            std::swap(sets[static_cast<std::size_t>(remap[i])], m_sets[i]);
+        }
+    }
+    m_sets.swap(sets);
+
+    auto it = m_index.begin();
+    while (it != m_index.end()) {
+        const int index = remap[static_cast<std::size_t>(it.value())];
+        if (index < 0) {
+            it = m_index.erase(it);
+        } else {
+            it.value() = index;
+            ++it;
+        }
+    }
+
+    for (int &label : labels) {
+        label = remap[static_cast<std::size_t>(label)];
+    }
+}
+
+void LabelSetTable::clear()
+{
+    m_sets.resize(1);
+    m_index.clear();
+}
+
 AbstractBaseModel::AbstractBaseModel(QObject *parent)
     : QAbstractItemModel(parent), s_ptr(new AbstractBaseModelPrivate(this))
 {
@@ -174,6 +346,38 @@ void AbstractBaseModel::setConfiguration(AbstractConfiguration *configuration)
     }
 }
 
+JobQueue* AbstractBaseModel::jobQueue() const
+{
+    Q_D(const AbstractBaseModel);
+    return d->jobQueue;
+}
+
+void AbstractBaseModel::setJobQueue(JobQueue *jobQueue)
+{
+    Q_D(AbstractBaseModel);
+    if (jobQueue != d->jobQueue) {
+        qCDebug(schCore) << "Changing jobQueue from" << d->jobQueue.data() << "to" << jobQueue;
+        d->jobQueue = jobQueue;
+        Q_EMIT jobQueueChanged(d->jobQueue);
+    }
+}
+
+QVector<int> AbstractBaseModel::activeRoles() const
+{
+    Q_D(const AbstractBaseModel);
+    return d->activeRoles;
+}
+
+void AbstractBaseModel::setActiveRoles(const QVector<int> &activeRoles)
+{
+    Q_D(AbstractBaseModel);
+    if (activeRoles != d->activeRoles) {
+        qCDebug(schCore) << "Changing activeRoles from" << d->activeRoles << "to" << activeRoles;
+        d->activeRoles = activeRoles;
+        Q_EMIT activeRolesChanged(d->activeRoles);
+    }
+}
+
 bool AbstractBaseModel::isLoading() const
 {
     Q_D(const AbstractBaseModel);
@@ -199,6 +403,13 @@ bool AbstractBaseModel::load(Schauer::AbstractBaseModel::LoadMode mode)
     return d->startJob(mode);
 }
 
+bool AbstractBaseModel::refresh(Schauer::AbstractBaseModel::LoadMode mode)
+{
+    Q_D(AbstractBaseModel);
+    d->setupJob();
+    return d->startJob(mode, true);
+}
+
 void AbstractBaseModel::clear()
 {
 
@@ -8,7 +8,9 @@
 
 #include "schauer_exports.h"
 #include "abstractconfiguration.h"
+#include "jobqueue.h"
 #include <QAbstractItemModel>
+#include <QVector>
 #include <memory>
 
 namespace Schauer {
@@ -45,6 +47,41 @@ class SCHAUER_LIBRARY AbstractBaseModel : public QAbstractItemModel
      * \li void configurationChanged(AbstractConfiguration *configuration)
      */
     Q_PROPERTY(Schauer::AbstractConfiguration *configuration READ configuration WRITE setConfiguration NOTIFY configurationChanged)
+    /*!
+     * \brief Pointer to a queue used to start the jobs loading the model data.
+     *
+     * If a JobQueue is set, asynchronous loads are added to the queue with
+     * JobQueue::Interactive priority, so they are started before queued bulk operations.
+     * If no queue is set, the jobs are started directly. Synchronous loads are never queued.
+     * By default this property holds a \c nullptr.
+     *
+     * \par Access functions
+     * \li JobQueue *jobQueue() const
+     * \li void setJobQueue(JobQueue *jobQueue)
+     *
+     * \par Notifier signal
+     * \li void jobQueueChanged(JobQueue *jobQueue)
+     */
+    Q_PROPERTY(Schauer::JobQueue *jobQueue READ jobQueue WRITE setJobQueue NOTIFY jobQueueChanged)
+    /*!
+     * \brief Roles that are actually used to display the model data.
+     *
+     * If this list is not empty, only the data of these roles is decoded when the model
+     * gets loaded, data() returns empty values for all other roles. That saves time and
+     * memory if a view only shows some of the roles. Data needed by the lookup functions
+     * of a model, like the container names, is always decoded. Changes take effect on the
+     * next load() or refresh(). Models that do not support it always decode all roles.
+     *
+     * By default this property holds an empty list, so all roles are decoded.
+     *
+     * \par Access functions
+     * \li QVector<int> activeRoles() const
+     * \li void setActiveRoles(const QVector<int> &activeRoles)
+     *
+     * \par Notifier signal
+     * \li void activeRolesChanged(const QVector<int> &activeRoles)
+     */
+    Q_PROPERTY(QVector<int> activeRoles READ activeRoles WRITE setActiveRoles NOTIFY activeRolesChanged)
     /*!
      * \brief Indicates loading state.
      *
@@ -117,6 +154,30 @@ public:
      */
     void setConfiguration(AbstractConfiguration *configuration);
 
+    /*!
+     * \brief Getter function for the \link AbstractBaseModel::jobQueue jobQueue\endlink property.
+     * \sa setJobQueue(), jobQueueChanged()
+     */
+    JobQueue* jobQueue() const;
+
+    /*!
+     * \brief Setter function for the \link AbstractBaseModel::jobQueue jobQueue\endlink property.
+     * \sa jobQueue(), jobQueueChanged()
+     */
+    void setJobQueue(JobQueue *jobQueue);
+
+    /*!
+     * \brief Getter function for the \link AbstractBaseModel::activeRoles activeRoles\endlink property.
+     * \sa setActiveRoles(), activeRolesChanged()
+     */
+    QVector<int> activeRoles() const;
+
+    /*!
+     * \brief Setter function for the \link AbstractBaseModel::activeRoles activeRoles\endlink property.
+     * \sa activeRoles(), activeRolesChanged()
+     */
+    void setActiveRoles(const QVector<int> &activeRoles);
+
     /*!
      * \brief Returns \c true while the model is loading, otherwise returns \c false.
      */
@@ -155,6 +216,21 @@ public Q_SLOTS:
      */
     bool load(Schauer::AbstractBaseModel::LoadMode mode = LoadAsync);
 
+    /*!
+     * \brief Loads the model data again and only applies the changes.
+     *
+     * Other than load(), this does not clear the model first. The new data is compared
+     * with the current rows by ID: rows that do not exist anymore are removed, new rows
+     * are appended to the end and changed rows emit dataChanged() for the changed roles
+     * only. Rows that did not change are not touched, so views keep their selection and
+     * scroll position. Use this to periodically update a model.
+     *
+     * Models that do not support incremental updates are cleared and loaded again.
+     *
+     * See load() for the meaning of \a mode and the return value.
+     */
+    bool refresh(Schauer::AbstractBaseModel::LoadMode mode = LoadAsync);
+
 Q_SIGNALS:
     /*!
      * \brief Emitted to indicate model data loading has been finished.
@@ -172,6 +248,16 @@ Q_SIGNALS:
      * \sa configuration(), setConfiguration()
      */
     void configurationChanged(Schauer::AbstractConfiguration *configuration);
+    /*!
+     * \brief Notifier signal for the \link AbstractBaseModel::jobQueue jobQueue\endlink property.
+     * \sa jobQueue(), setJobQueue()
+     */
+    void jobQueueChanged(Schauer::JobQueue *jobQueue);
+    /*!
+     * \brief Notifier signal for the \link AbstractBaseModel::activeRoles activeRoles\endlink property.
+     * \sa activeRoles(), setActiveRoles()
+     */
+    void activeRolesChanged(const QVector<int> &activeRoles);
     /*!
      * \brief Notifier signal for the \link AbstractBaseModel::error error\endlink property.
      * \sa error()
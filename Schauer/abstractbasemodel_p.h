@@ -8,24 +8,77 @@
 
 #include "abstractbasemodel.h"
 #include "job.h"
+#include "backgrounddecoder.h"
+#include <QHash>
+#include <QMap>
+#include <QPointer>
+#include <QVector>
+#include <utility>
+#include <vector>
 
 class QJsonDocument;
 
 namespace Schauer {
 
+/*!
+ * \internal
+ * \brief Stores every distinct set of labels only once.
+ *
+ * Rows of a model only store the index of their label set. Many containers and
+ * images share the same labels, for example all containers of a compose project.
+ * Index \c 0 is always the empty set. compact() drops the sets that are not used
+ * by any row anymore.
+ */
+class SCHAUER_AUTOTEST_EXPORT LabelSetTable
+{
+public:
+    LabelSetTable();
+
+    int insert(const QMap<QString,QString> &labels);
+
+    const QMap<QString,QString> &at(int index) const { return m_sets.at(index); }
+
+    int size() const { return static_cast<int>(m_sets.size()); }
+
+    void compact(std::vector<int> &labels);
+
+    void clear();
+
+private:
+    std::vector<QMap<QString,QString>> m_sets;
+    QHash<QString,int> m_index;
+};
+
 class AbstractBaseModelPrivate
 {
 public:
+    static constexpr quint32 AllColumns = 0xFFFFFFFF;
+
     AbstractBaseModelPrivate(AbstractBaseModel *q);
 
     virtual ~AbstractBaseModelPrivate();
 
     AbstractConfiguration *configuration = nullptr;
     Job *job = nullptr;
+    QPointer<JobQueue> jobQueue;
+    QVector<int> activeRoles;
+    std::unique_ptr<BackgroundDecoder> decoder;
 
     virtual void setupJob();
-    bool startJob(AbstractBaseModel::LoadMode mode);
+    bool startJob(AbstractBaseModel::LoadMode mode, bool incremental = false);
     virtual bool loadFromJson(const QJsonDocument &json);
+    virtual bool updateFromJson(const QJsonDocument &json);
+    virtual QVector<int> rolesForColumns(quint32 columns) const;
+    virtual quint32 columnsForRoles(const QVector<int> &roles) const;
+    virtual BackgroundDecoder::DecodeFunction decodeFunction() const;
+    virtual bool applyDecoded(DecodedRows *rows, bool incremental);
+    virtual void removeFromIndexes(int first, int count);
+    virtual void addToIndexes(int first);
+    virtual void rebuildIndexes();
+    bool finishDecoding(DecodedRows *rows, bool incremental);
+
+    template<typename Columns>
+    bool mergeColumns(Columns &current, const Columns &fresh);
     void finishLoading(int error, const QString &errorString = QString());
 
     void setIsLoading(bool isLoading);
@@ -53,6 +106,108 @@ private:
     Q_DECLARE_PUBLIC(AbstractBaseModel)
 };
 
+/*!
+ * \internal
+ * \brief Applies the differences between the \a current and the \a fresh rows to the model.
+ *
+ * Rows are matched by their ID. Rows that are not part of \a fresh anymore are removed,
+ * changed rows emit dataChanged() for the changed roles only and new rows are appended.
+ * Returns \c true if anything has been changed.
+ *
+ * The lookup indexes are updated before a change is signalled, so that slots connected to
+ * the model already see matching indexes. Removed and appended rows are updated in the
+ * indexes by removeFromIndexes() and addToIndexes(), rebuildIndexes() is only called if
+ * an update changed one of the \a LookupColumns. Label sets that are not used anymore
+ * are finally dropped from the label set table.
+ *
+ * \a Columns has to provide the \a ids, \a labels and \a labelSets columns, the
+ * \a LookupColumns mask, rowCount(), reserve(), remove(), append() and update(),
+ * where update() returns a bit mask of the changed columns.
+ */
+template<typename Columns>
+bool AbstractBaseModelPrivate::mergeColumns(Columns &current, const Columns &fresh)
+{
+    Q_Q(AbstractBaseModel);
+
+    QHash<QString,int> freshRows;
+    freshRows.reserve(fresh.rowCount());
+    for (int i = 0; i < fresh.rowCount(); ++i) {
+        freshRows.insert(fresh.ids[i], i);
+    }
+
+    bool changed = false;
+
+    // remove from the end, so that the numbers of the rows in front stay valid
+    int last = current.rowCount() - 1;
+    while (last >= 0) {
+        if (freshRows.contains(current.ids[last])) {
+            --last;
+            continue;
+        }
+        int first = last;
+        while (first > 0 && !freshRows.contains(current.ids[first - 1])) {
+            --first;
+        }
+        q->beginRemoveRows(QModelIndex(), first, last);
+        removeFromIndexes(first, last - first + 1);
+        current.remove(first, last - first + 1);
+        q->endRemoveRows();
+        changed = true;
+        last = first - 1;
+    }
+
+    QHash<QString,int> currentRows;
+    currentRows.reserve(current.rowCount());
+    for (int i = 0; i < current.rowCount(); ++i) {
+        currentRows.insert(current.ids[i], i);
+    }
+
+    std::vector<int> added;
+    std::vector<std::pair<int,quint32>> updated;
+    quint32 updatedColumns = 0;
+    for (int i = 0; i < fresh.rowCount(); ++i) {
+        auto it = currentRows.constFind(fresh.ids[i]);
+        if (it == currentRows.constEnd()) {
+            added.push_back(i);
+            continue;
+        }
+        const quint32 columns = current.update(it.value(), fresh, i);
+        if (columns != 0) {
+            updated.emplace_back(it.value(), columns);
+            updatedColumns |= columns;
+        }
+    }
+
+    if (!updated.empty()) {
+        if (updatedColumns & Columns::LookupColumns) {
+            rebuildIndexes();
+        }
+        for (const auto &u : updated) {
+            const QModelIndex idx = q->index(u.first, 0);
+            Q_EMIT q->dataChanged(idx, idx, rolesForColumns(u.second));
+        }
+        changed = true;
+    }
+
+    if (!added.empty()) {
+        const int first = current.rowCount();
+        q->beginInsertRows(QModelIndex(), first, first + static_cast<int>(added.size()) - 1);
+        current.reserve(static_cast<std::size_t>(first) + added.size());
+        for (int i : added) {
+            current.append(fresh, i);
+        }
+        addToIndexes(first);
+        q->endInsertRows();
+        changed = true;
+    }
+
+    if (changed) {
+        current.labelSets.compact(current.labels);
+    }
+
+    return changed;
+}
+
 }
 
 #endif // SCHAUER_ABSTRACTBASEMODEL_P_H
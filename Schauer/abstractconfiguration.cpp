@@ -4,6 +4,7 @@
  */
 
 #include "abstractconfiguration.h"
+#include "responsecache.h"
 
 using namespace Schauer;
 
@@ -12,7 +13,10 @@ AbstractConfiguration::AbstractConfiguration(QObject *parent) : QObject(parent)
 
 }
 
-AbstractConfiguration::~AbstractConfiguration() = default;
+AbstractConfiguration::~AbstractConfiguration()
+{
+    ResponseCache::remove(this);
+}
 
 QString AbstractConfiguration::username() const
 {
@@ -44,4 +48,30 @@ bool AbstractConfiguration::ignoreSslErrors() const
     return false;
 }
 
+QString AbstractConfiguration::socketPath() const
+{
+    return QString();
+}
+
+int AbstractConfiguration::maxConnectionsPerHost() const
+{
+    return 6;
+}
+
+int AbstractConfiguration::connectionIdleTimeout() const
+{
+    return 30;
+}
+
+int AbstractConfiguration::responseCacheTimeToLive(const QString &endpoint) const
+{
+    Q_UNUSED(endpoint)
+    return 0;
+}
+
+void AbstractConfiguration::invalidateResponseCache(const QString &endpoint)
+{
+    ResponseCache::invalidate(this, endpoint);
+}
+
 #include "moc_abstractconfiguration.cpp"
@@ -73,6 +73,60 @@ public:
      */
     virtual bool ignoreSslErrors() const;
 
+    /*!
+     * \brief Returns the path to the unix domain socket the Docker daemon is listening on.
+     *
+     * If this returns a non-empty path, all requests will be send over the local socket
+     * at that path, like \c /var/run/docker.sock, and host(), port(), useSsl() and
+     * ignoreSslErrors() will not be used. The default implementation returns an empty
+     * string, so requests are send via TCP.
+     */
+    virtual QString socketPath() const;
+
+    /*!
+     * \brief Returns the maximum number of concurrent connections to the Docker daemon.
+     *
+     * All jobs and models using configurations with the same host, port, SSL setting and
+     * socket path share a pool of keep-alive connections. This limits the number of requests
+     * that are in flight at the same time, further requests are queued until a connection
+     * is available. The default implementation returns \c 6.
+     */
+    virtual int maxConnectionsPerHost() const;
+
+    /*!
+     * \brief Returns the time in seconds after that unused pooled connections will be closed.
+     *
+     * The default implementation returns \c 30.
+     */
+    virtual int connectionIdleTimeout() const;
+
+    /*!
+     * \brief Returns the time in milliseconds replies of the read-only \a endpoint will be cached.
+     *
+     * Replies of jobs that only read data, like GetVersionJob, ListImagesJob and
+     * ListContainersJob, can be cached per configuration. A job requesting the same
+     * endpoint with the same query finishes with the cached result then, without sending
+     * a request and without parsing the reply again. \a endpoint is the API route without
+     * the version prefix, like \c /version, \c /images/json or \c /containers/json.
+     *
+     * Jobs that change containers, like CreateContainerJob or RemoveContainerJob, invalidate
+     * the cached container lists of their configuration when they succeed. Use
+     * invalidateResponseCache() to invalidate cached replies yourself.
+     *
+     * A value of \c 0 or lower disables the cache for the \a endpoint. The default
+     * implementation returns \c 0 for all endpoints.
+     */
+    virtual int responseCacheTimeToLive(const QString &endpoint) const;
+
+    /*!
+     * \brief Removes cached replies of the \a endpoint for this configuration.
+     *
+     * If \a endpoint is empty, all cached replies of this configuration will be removed.
+     *
+     * \sa responseCacheTimeToLive()
+     */
+    void invalidateResponseCache(const QString &endpoint = QString());
+
 private:
     Q_DISABLE_COPY(AbstractConfiguration)
 };
@@ -5,14 +5,34 @@
 
 #include "abstractcontainermodel_p.h"
 #include "listcontainersjob.h"
+#include "listdecoder.h"
 #include "logging.h"
+#include "stringpool.h"
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QJsonValue>
+#include <QMutex>
+#include <QMutexLocker>
+#include <algorithm>
 
 using namespace Schauer;
 
+namespace {
+
+constexpr int firstOtherState = static_cast<int>(ContainerState::Dead) + 1;
+constexpr int maxOtherStates = 255 - static_cast<int>(ContainerState::Dead);
+
+// states reported by newer daemons, shared by all models
+struct OtherStates {
+    QMutex mutex;
+    std::vector<QString> names;
+};
+
+Q_GLOBAL_STATIC(OtherStates, otherStates)
+
+}
+
 AbstractContainerModelPrivate::AbstractContainerModelPrivate(AbstractContainerModel *q)
     : AbstractBaseModelPrivate(q)
 {
@@ -27,37 +47,59 @@ void AbstractContainerModelPrivate::setupJob()
     auto _job = new ListContainersJob(q);
     _job->setShowAll(showAll);
     _job->setShowSize(showSize);
+    _job->setFilters(filters);
     job = _job;
 }
 
-bool AbstractContainerModelPrivate::loadFromJson(const QJsonDocument &json)
+BackgroundDecoder::DecodeFunction AbstractContainerModelPrivate::decodeFunction() const
 {
-    Q_Q(AbstractContainerModel);
-
-    const QJsonArray conts = json.array();
+    return &AbstractContainerModelPrivate::decodeRows;
+}
 
-    q->beginInsertRows(QModelIndex(), containers.size(), containers.size() + conts.size() - 1);
+std::shared_ptr<DecodedRows> AbstractContainerModelPrivate::decodeRows(const QByteArray &data, const QJsonDocument &json, quint32 columns)
+{
+    columns |= ContainerColumns::LookupColumns;
+    auto rows = std::make_shared<ContainerRows>();
+    if (!data.isEmpty()) {
+        ListDecoder decoder(data.constData(), data.size());
+        if (!decoder.decode(rows->columns, columns)) {
+            qCCritical(schCore) << "Failed to decode the list of containers";
+            return nullptr;
+        }
+    } else {
+        // replies taken from the response cache are already parsed
+        const QJsonArray conts = json.array();
+        rows->columns.reserve(static_cast<std::size_t>(conts.size()));
+        for (const QJsonValue &cont : conts) {
+            rows->columns.appendFromJson(cont.toObject(), columns);
+        }
+    }
+    rows->indexes.rebuild(rows->columns);
+    return rows;
+}
 
-    for (const QJsonValue &cont : conts) {
-        const QJsonObject o = cont.toObject();
+bool AbstractContainerModelPrivate::applyDecoded(DecodedRows *rows, bool incremental)
+{
+    Q_Q(AbstractContainerModel);
 
-        const QString id = o.value(QStringLiteral("Id")).toString();
-        const QStringList names = AbstractBaseModelPrivate::jsonArrayToStringList(o.value(QStringLiteral("Names")));
-        const QString image = o.value(QStringLiteral("Image")).toString();
-        const QString imageId = o.value(QStringLiteral("ImageID")).toString();
-        const QString command = o.value(QStringLiteral("Command")).toString();
-        const QDateTime created = QDateTime::fromSecsSinceEpoch(static_cast<qint64>(o.value(QStringLiteral("Created")).toDouble()), Qt::UTC);
-        const QString state = o.value(QStringLiteral("State")).toString();
-        const QString status = o.value(QStringLiteral("Status")).toString();
-        const QMap<QString,QString> labels = AbstractBaseModelPrivate::jsonObjectToStringMap(o.value(QStringLiteral("Labels")));
-        const quint64 sizeRw = static_cast<quint64>(o.value(QStringLiteral("SizeRw")).toDouble());
-        const quint64 sizeRootFs = static_cast<quint64>(o.value(QStringLiteral("SizeRootFs")).toDouble());
+    auto decoded = static_cast<ContainerRows*>(rows);
 
-        containers.emplace_back(id, names, image, imageId, command, created, state, status, labels, sizeRw, sizeRootFs);
+    if (incremental) {
+        merging = decoded;
+        mergeColumns(containers, decoded->columns);
+        merging = nullptr;
+    } else {
+        if (!containers.empty()) {
+            q->clear();
+        }
+        if (!decoded->columns.empty()) {
+            q->beginInsertRows(QModelIndex(), 0, decoded->columns.rowCount() - 1);
+            std::swap(containers, decoded->columns);
+            std::swap(indexes, decoded->indexes);
+            q->endInsertRows();
+        }
     }
 
-    q->endInsertRows();
-
     Q_EMIT q->loaded();
 
     setIsLoading(false);
@@ -65,59 +107,322 @@ bool AbstractContainerModelPrivate::loadFromJson(const QJsonDocument &json)
     return true;
 }
 
-bool AbstractContainerModelPrivate::contains(QLatin1String idOrName) const
+void AbstractContainerModelPrivate::removeFromIndexes(int first, int count)
 {
-    if (containers.empty() || idOrName.isEmpty()) {
-        return false;
+    indexes.remove(containers, first, count);
+}
+
+void AbstractContainerModelPrivate::addToIndexes(int first)
+{
+    for (int row = first; row < containers.rowCount(); ++row) {
+        indexes.add(containers, row);
     }
+}
 
-    if (idOrName.startsWith(QLatin1Char('/'))) {
-        for (const ContainerModelItem &item : static_cast<const std::vector<ContainerModelItem>&>(containers)) {
-            for (const QString &name : static_cast<const QStringList &>(item.names)) {
-                if (name == idOrName) {
-                    return true;
-                }
-            }
-        }
+void AbstractContainerModelPrivate::rebuildIndexes()
+{
+    // the indexes of the decoded rows are still valid if the row order did not change
+    if (merging && merging->columns.ids == containers.ids) {
+        std::swap(indexes, merging->indexes);
     } else {
-        for (const ContainerModelItem &item : static_cast<const std::vector<ContainerModelItem>&>(containers)) {
-            if (item.id == idOrName) {
-                return true;
-            }
-        }
+        indexes.rebuild(containers);
+    }
+}
+
+void ContainerColumns::reserve(std::size_t n)
+{
+    ids.reserve(n);
+    names.reserve(n);
+    images.reserve(n);
+    imageIds.reserve(n);
+    commands.reserve(n);
+    created.reserve(n);
+    states.reserve(n);
+    statuses.reserve(n);
+    labels.reserve(n);
+    sizeRw.reserve(n);
+    sizeRootFs.reserve(n);
+}
+
+void ContainerColumns::clear()
+{
+    ids.clear();
+    names.clear();
+    images.clear();
+    imageIds.clear();
+    commands.clear();
+    created.clear();
+    states.clear();
+    statuses.clear();
+    labels.clear();
+    sizeRw.clear();
+    sizeRootFs.clear();
+    labelSets.clear();
+}
+
+ContainerState ContainerColumns::stateFromString(const QString &state)
+{
+    if (state == QLatin1String("running")) {
+        return ContainerState::Running;
+    } else if (state == QLatin1String("exited")) {
+        return ContainerState::Exited;
+    } else if (state == QLatin1String("created")) {
+        return ContainerState::Created;
+    } else if (state == QLatin1String("paused")) {
+        return ContainerState::Paused;
+    } else if (state == QLatin1String("restarting")) {
+        return ContainerState::Restarting;
+    } else if (state == QLatin1String("removing")) {
+        return ContainerState::Removing;
+    } else if (state == QLatin1String("dead")) {
+        return ContainerState::Dead;
+    } else if (state.isEmpty()) {
+        return ContainerState::Unknown;
     }
 
-    return false;
+    OtherStates *other = otherStates();
+    QMutexLocker locker(&other->mutex);
+    const auto it = std::find(other->names.cbegin(), other->names.cend(), state);
+    if (it != other->names.cend()) {
+        return static_cast<ContainerState>(firstOtherState + static_cast<int>(it - other->names.cbegin()));
+    }
+    if (static_cast<int>(other->names.size()) >= maxOtherStates) {
+        return ContainerState::Unknown;
+    }
+    qCWarning(schCore) << "Unknown container state" << state;
+    other->names.push_back(StringPool::intern(state));
+    return static_cast<ContainerState>(firstOtherState + static_cast<int>(other->names.size()) - 1);
 }
 
-bool AbstractContainerModelPrivate::containsImage(QLatin1String image) const
+QString ContainerColumns::stateToString(ContainerState state)
 {
-    if (containers.empty() || image.isEmpty()) {
-        return false;
+    switch (state) {
+    case ContainerState::Created:
+        return QStringLiteral("created");
+    case ContainerState::Restarting:
+        return QStringLiteral("restarting");
+    case ContainerState::Running:
+        return QStringLiteral("running");
+    case ContainerState::Removing:
+        return QStringLiteral("removing");
+    case ContainerState::Paused:
+        return QStringLiteral("paused");
+    case ContainerState::Exited:
+        return QStringLiteral("exited");
+    case ContainerState::Dead:
+        return QStringLiteral("dead");
+    case ContainerState::Unknown:
+        return QString();
+    }
+
+    OtherStates *other = otherStates();
+    QMutexLocker locker(&other->mutex);
+    return other->names.at(static_cast<std::size_t>(static_cast<int>(state) - firstOtherState));
+}
+
+void ContainerColumns::appendFromJson(const QJsonObject &o, quint32 columns)
+{
+    // skipped columns get default values, so that all columns keep the same size
+    ids.push_back(o.value(QStringLiteral("Id")).toString());
+    names.push_back((columns & NamesColumn) ? AbstractBaseModelPrivate::jsonArrayToStringList(o.value(QStringLiteral("Names"))) : QStringList());
+    images.push_back((columns & ImageColumn) ? StringPool::intern(o.value(QStringLiteral("Image")).toString()) : QString());
+    imageIds.push_back((columns & ImageIdColumn) ? StringPool::intern(o.value(QStringLiteral("ImageID")).toString()) : QString());
+    commands.push_back((columns & CommandColumn) ? StringPool::intern(o.value(QStringLiteral("Command")).toString()) : QString());
+    created.push_back((columns & CreatedColumn) ? static_cast<qint64>(o.value(QStringLiteral("Created")).toDouble()) : 0);
+    states.push_back((columns & StateColumn) ? stateFromString(o.value(QStringLiteral("State")).toString()) : ContainerState::Unknown);
+    statuses.push_back((columns & StatusColumn) ? StringPool::intern(o.value(QStringLiteral("Status")).toString()) : QString());
+    labels.push_back((columns & LabelsColumn) ? labelSets.insert(AbstractBaseModelPrivate::jsonObjectToStringMap(o.value(QStringLiteral("Labels")))) : 0);
+    sizeRw.push_back((columns & SizeRwColumn) ? static_cast<quint64>(o.value(QStringLiteral("SizeRw")).toDouble()) : 0);
+    sizeRootFs.push_back((columns & SizeRootFsColumn) ? static_cast<quint64>(o.value(QStringLiteral("SizeRootFs")).toDouble()) : 0);
+}
+
+void ContainerColumns::append(const ContainerColumns &other, int otherRow)
+{
+    const auto r = static_cast<std::size_t>(otherRow);
+    ids.push_back(other.ids[r]);
+    names.push_back(other.names[r]);
+    images.push_back(other.images[r]);
+    imageIds.push_back(other.imageIds[r]);
+    commands.push_back(other.commands[r]);
+    created.push_back(other.created[r]);
+    states.push_back(other.states[r]);
+    statuses.push_back(other.statuses[r]);
+    labels.push_back(labelSets.insert(other.labelSets.at(other.labels[r])));
+    sizeRw.push_back(other.sizeRw[r]);
+    sizeRootFs.push_back(other.sizeRootFs[r]);
+}
+
+void ContainerColumns::remove(int first, int count)
+{
+    const auto f = static_cast<std::ptrdiff_t>(first);
+    const auto l = static_cast<std::ptrdiff_t>(first + count);
+    ids.erase(ids.begin() + f, ids.begin() + l);
+    names.erase(names.begin() + f, names.begin() + l);
+    images.erase(images.begin() + f, images.begin() + l);
+    imageIds.erase(imageIds.begin() + f, imageIds.begin() + l);
+    commands.erase(commands.begin() + f, commands.begin() + l);
+    created.erase(created.begin() + f, created.begin() + l);
+    states.erase(states.begin() + f, states.begin() + l);
+    statuses.erase(statuses.begin() + f, statuses.begin() + l);
+    labels.erase(labels.begin() + f, labels.begin() + l);
+    sizeRw.erase(sizeRw.begin() + f, sizeRw.begin() + l);
+    sizeRootFs.erase(sizeRootFs.begin() + f, sizeRootFs.begin() + l);
+}
+
+quint32 ContainerColumns::update(int row, const ContainerColumns &other, int otherRow)
+{
+    const auto r = static_cast<std::size_t>(row);
+    const auto o = static_cast<std::size_t>(otherRow);
+    quint32 changed = 0;
+
+    if (names[r] != other.names[o]) {
+        names[r] = other.names[o];
+        changed |= NamesColumn;
+    }
+    if (images[r] != other.images[o]) {
+        images[r] = other.images[o];
+        changed |= ImageColumn;
+    }
+    if (imageIds[r] != other.imageIds[o]) {
+        imageIds[r] = other.imageIds[o];
+        changed |= ImageIdColumn;
+    }
+    if (commands[r] != other.commands[o]) {
+        commands[r] = other.commands[o];
+        changed |= CommandColumn;
+    }
+    if (created[r] != other.created[o]) {
+        created[r] = other.created[o];
+        changed |= CreatedColumn;
+    }
+    if (states[r] != other.states[o]) {
+        states[r] = other.states[o];
+        changed |= StateColumn;
+    }
+    if (statuses[r] != other.statuses[o]) {
+        statuses[r] = other.statuses[o];
+        changed |= StatusColumn;
+    }
+    const QMap<QString,QString> &otherLabels = other.labelSets.at(other.labels[o]);
+    if (labelSets.at(labels[r]) != otherLabels) {
+        labels[r] = labelSets.insert(otherLabels);
+        changed |= LabelsColumn;
+    }
+    if (sizeRw[r] != other.sizeRw[o]) {
+        sizeRw[r] = other.sizeRw[o];
+        changed |= SizeRwColumn;
+    }
+    if (sizeRootFs[r] != other.sizeRootFs[o]) {
+        sizeRootFs[r] = other.sizeRootFs[o];
+        changed |= SizeRootFsColumn;
+    }
+
+    return changed;
+}
+
+void ContainerIndexes::add(const ContainerColumns &columns, int row)
+{
+    idIndex.insert(columns.ids.at(row), row);
+    for (const QString &name : columns.names.at(row)) {
+        nameIndex.insert(name, row);
+    }
+    const QString &image = columns.images.at(row);
+    if (!image.isEmpty()) {
+        ++imageRefs[image];
+    }
+    const QString &imageId = columns.imageIds.at(row);
+    if (!imageId.isEmpty()) {
+        ++imageIdRefs[imageId];
+    }
+}
+
+void ContainerIndexes::remove(const ContainerColumns &columns, int first, int count)
+{
+    const int end = first + count;
+    for (int row = first; row < end; ++row) {
+        idIndex.remove(columns.ids.at(row));
+        for (const QString &name : columns.names.at(row)) {
+            nameIndex.remove(name);
+        }
+        auto image = imageRefs.find(columns.images.at(row));
+        if (image != imageRefs.end() && --image.value() == 0) {
+            imageRefs.erase(image);
+        }
+        auto imageId = imageIdRefs.find(columns.imageIds.at(row));
+        if (imageId != imageIdRefs.end() && --imageId.value() == 0) {
+            imageIdRefs.erase(imageId);
+        }
     }
 
-    for (const ContainerModelItem &item : static_cast<const std::vector<ContainerModelItem>&>(containers)) {
-        if (item.image == image) {
-            return true;
+    // the rows behind the removed ones move to the front
+    const int rows = columns.rowCount();
+    for (int row = end; row < rows; ++row) {
+        idIndex[columns.ids.at(row)] = row - count;
+        for (const QString &name : columns.names.at(row)) {
+            nameIndex[name] = row - count;
         }
     }
+}
+
+void ContainerIndexes::rebuild(const ContainerColumns &columns)
+{
+    clear();
+    const int rows = columns.rowCount();
+    idIndex.reserve(rows);
+    nameIndex.reserve(rows);
+    for (int row = 0; row < rows; ++row) {
+        add(columns, row);
+    }
+}
 
-    return false;
+void ContainerIndexes::clear()
+{
+    idIndex.clear();
+    nameIndex.clear();
+    imageRefs.clear();
+    imageIdRefs.clear();
 }
 
-bool AbstractContainerModelPrivate::containsImageId(QLatin1String imageId) const
+bool AbstractContainerModelPrivate::contains(const QString &idOrName) const
 {
-    if (containers.empty() || imageId.isEmpty()) {
+    if (idOrName.isEmpty()) {
         return false;
     }
 
-    for (const ContainerModelItem &item : static_cast<const std::vector<ContainerModelItem>&>(containers)) {
-        if (item.imageId == imageId) {
-            return true;
-        }
+    if (idOrName.startsWith(QLatin1Char('/'))) {
+        return indexes.nameIndex.contains(idOrName);
+    } else {
+        return indexes.idIndex.contains(idOrName);
+    }
+}
+
+bool AbstractContainerModelPrivate::containsImage(const QString &image) const
+{
+    return !image.isEmpty() && indexes.imageRefs.contains(image);
+}
+
+bool AbstractContainerModelPrivate::containsImageId(const QString &imageId) const
+{
+    return !imageId.isEmpty() && indexes.imageIdRefs.contains(imageId);
+}
+
+int AbstractContainerModelPrivate::rowForId(const QString &id) const
+{
+    return id.isEmpty() ? -1 : indexes.idIndex.value(id, -1);
+}
+
+int AbstractContainerModelPrivate::rowForName(const QString &name) const
+{
+    if (name.isEmpty()) {
+        return -1;
     }
 
-    return false;
+    // the daemon reports container names with a leading slash
+    if (name.startsWith(QLatin1Char('/'))) {
+        return indexes.nameIndex.value(name, -1);
+    } else {
+        return indexes.nameIndex.value(QLatin1Char('/') + name, -1);
+    }
 }
 
 AbstractContainerModel::AbstractContainerModel(QObject *parent)
@@ -137,7 +442,7 @@ AbstractContainerModel::~AbstractContainerModel() = default;
 int AbstractContainerModel::rowCount([[maybe_unused]] const QModelIndex &parent) const
 {
     Q_D(const AbstractContainerModel);
-    return d->containers.size();
+    return d->containers.rowCount();
 }
 
 bool AbstractContainerModel::showAll() const
@@ -172,49 +477,78 @@ void AbstractContainerModel::setShowSize(bool showSize)
     }
 }
 
+Filters AbstractContainerModel::filters() const
+{
+    Q_D(const AbstractContainerModel);
+    return d->filters;
+}
+
+void AbstractContainerModel::setFilters(const Filters &filters)
+{
+    Q_D(AbstractContainerModel);
+    if (d->filters != filters) {
+        qCDebug(schCore) << "Changing \"filters\" from" << d->filters.toJson() << "to" << filters.toJson();
+        d->filters = filters;
+        Q_EMIT filtersChanged(this->filters());
+    }
+}
+
 bool AbstractContainerModel::contains(const QString &idOrName) const
 {
     Q_D(const AbstractContainerModel);
-    return d->contains(QLatin1String(idOrName.toLatin1()));
+    return d->contains(idOrName);
 }
 
 bool AbstractContainerModel::contains(QLatin1String idOrName) const
 {
     Q_D(const AbstractContainerModel);
-    return d->contains(idOrName);
+    return d->contains(QString(idOrName));
 }
 
 bool AbstractContainerModel::containsImage(const QString &image) const
 {
     Q_D(const AbstractContainerModel);
-    return d->containsImage(QLatin1String(image.toLatin1()));
+    return d->containsImage(image);
 }
 
 bool AbstractContainerModel::containsImage(QLatin1String &image) const
 {
     Q_D(const AbstractContainerModel);
-    return d->containsImage(image);
+    return d->containsImage(QString(image));
 }
 
 bool AbstractContainerModel::containsImageId(const QString &imageId) const
 {
     Q_D(const AbstractContainerModel);
-    return d->containsImageId(QLatin1String(imageId.toLatin1()));
+    return d->containsImageId(imageId);
 }
 
 bool AbstractContainerModel::containsImageId(QLatin1String &imageId) const
 {
     Q_D(const AbstractContainerModel);
-    return d->containsImageId(imageId);
+    return d->containsImageId(QString(imageId));
+}
+
+int AbstractContainerModel::rowForId(const QString &id) const
+{
+    Q_D(const AbstractContainerModel);
+    return d->rowForId(id);
+}
+
+int AbstractContainerModel::rowForName(const QString &name) const
+{
+    Q_D(const AbstractContainerModel);
+    return d->rowForName(name);
 }
 
 void AbstractContainerModel::clear()
 {
     Q_D(AbstractContainerModel);
     if (!d->containers.empty()) {
-        beginRemoveRows(QModelIndex(), 0, d->containers.size() - 1);
+        beginRemoveRows(QModelIndex(), 0, d->containers.rowCount() - 1);
 
         d->containers.clear();
+        d->indexes.clear();
 
         endRemoveRows();
     }
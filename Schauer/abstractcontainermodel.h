@@ -8,6 +8,7 @@
 
 #include "schauer_exports.h"
 #include "abstractbasemodel.h"
+#include "filters.h"
 
 namespace Schauer {
 
@@ -53,6 +54,20 @@ class SCHAUER_LIBRARY AbstractContainerModel : public AbstractBaseModel
      * \li void showSizeChanged(bool showSize)
      */
     Q_PROPERTY(bool showSize READ showSize WRITE setShowSize NOTIFY showSizeChanged)
+    /*!
+     * \brief Filters applied to the list of containers on the daemon side.
+     *
+     * By default no filters are set. Changes take effect on the next call of load().
+     * See ListContainersJob::filters.
+     *
+     * \par Access functions
+     * \li Filters filters() const
+     * \li void setFilters(const Filters &filters)
+     *
+     * \par Notifier signal
+     * \li void filtersChanged(const Filters &filters)
+     */
+    Q_PROPERTY(Schauer::Filters filters READ filters WRITE setFilters NOTIFY filtersChanged)
 public:
     /*!
      * \brief Constructs a new %AbstractContainerModel object with the given \a parent.
@@ -90,6 +105,18 @@ public:
      */
     void setShowSize(bool showSize);
 
+    /*!
+     * \brief Getter function for the \link AbstractContainerModel::filters filters\endlink property.
+     * \sa setFilters(), filtersChanged()
+     */
+    Filters filters() const;
+
+    /*!
+     * \brief Setter function for the \link AbstractContainerModel::filters filters\endlink property.
+     * \sa filters(), filtersChanged()
+     */
+    void setFilters(const Filters &filters);
+
     /*!
      * \brief Returns \c true if the model contains a container identified by \a idOrName.
      *
@@ -122,6 +149,26 @@ public:
      */
     bool containsImageId(QLatin1String &imageId) const;
 
+    /*!
+     * \brief Returns the row of the container with the given \a id.
+     *
+     * \a id has to be the full container ID. Returns \c -1 if the model does
+     * not contain such a container.
+     *
+     * \sa rowForName()
+     */
+    int rowForId(const QString &id) const;
+
+    /*!
+     * \brief Returns the row of the container with the given \a name.
+     *
+     * The leading slash reported by the daemon for container names is optional.
+     * Returns \c -1 if the model does not contain such a container.
+     *
+     * \sa rowForId()
+     */
+    int rowForName(const QString &name) const;
+
 Q_SIGNALS:
     /*!
      * \brief Notifier signal for the \link AbstractContainerModel::showAll showAll\endlink property.
@@ -135,6 +182,12 @@ Q_SIGNALS:
      */
     void showSizeChanged(bool showSize);
 
+    /*!
+     * \brief Notifier signal for the \link AbstractContainerModel::filters filters\endlink property.
+     * \sa filters(), setFilters()
+     */
+    void filtersChanged(const Schauer::Filters &filters);
+
 protected:
     AbstractContainerModel(AbstractContainerModelPrivate &dd, QObject *parent = nullptr);
 
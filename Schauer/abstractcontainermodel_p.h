@@ -9,69 +9,114 @@
 #include "abstractcontainermodel.h"
 #include "abstractbasemodel_p.h"
 #include <QDateTime>
+#include <QHash>
+
+class QJsonObject;
 
 namespace Schauer {
 
-struct ContainerModelItem {
-    QString id;
-    QStringList names;
-    QString image;
-    QString imageId;
-    QString command;
-    QDateTime created;
-    QString state;
-    QString status;
-    QMap<QString,QString> labels;
-    quint64 sizeRw = 0;
-    quint64 sizeRootFs = 0;
-
-    ContainerModelItem(const QString &_id, const QStringList &_names, const QString &_image, const QString &_imageId, const QString &_command, const QDateTime &_created, const QString &_state, const QString &_status, const QMap<QString,QString> &_labels, quint64 _sizeRw, quint64 _sizeRootFs) :
-        id{_id},
-        names{_names},
-        image{_image},
-        imageId{_imageId},
-        command{_command},
-        created{_created},
-        state{_state},
-        status{_status},
-        labels{_labels},
-        sizeRw{_sizeRw},
-        sizeRootFs{_sizeRootFs}
-    {}
-
-    ~ContainerModelItem() = default;
-
-    ContainerModelItem(const ContainerModelItem &other) :
-        id{other.id},
-        names{other.names},
-        image{other.image},
-        imageId{other.imageId},
-        command{other.command},
-        created{other.created},
-        state{other.state},
-        status{other.status},
-        labels{other.labels},
-        sizeRw{other.sizeRw},
-        sizeRootFs{other.sizeRootFs}
-    {}
-
-    ContainerModelItem(ContainerModelItem &&other) :
-        id(std::move(other.id)),
-        names(std::move(other.names)),
-        image(std::move(other.image)),
-        imageId(std::move(other.imageId)),
-        command(std::move(other.command)),
-        created(std::move(other.created)),
-        state(std::move(other.state)),
-        status(std::move(other.status)),
-        labels(std::move(other.labels)),
-        sizeRw(std::move(other.sizeRw)),
-        sizeRootFs(std::move(other.sizeRootFs))
-    {}
-
-    ContainerModelItem& operator=(const ContainerModelItem &other) = default;
-
-    ContainerModelItem& operator=(ContainerModelItem &&other) = default;
+/*!
+ * \internal
+ * \brief Container states as reported by the Docker daemon.
+ *
+ * Values behind \c Dead refer to states that are not known to this library,
+ * ContainerColumns::stateToString() returns the name reported by the daemon for them.
+ */
+enum class ContainerState : quint8 {
+    Unknown = 0,
+    Created,
+    Restarting,
+    Running,
+    Removing,
+    Paused,
+    Exited,
+    Dead
+};
+
+/*!
+ * \internal
+ * \brief Column-wise storage of the container model data.
+ *
+ * Every role has its own array, all arrays have the same size. Reading a single
+ * role of a row only touches the array of that role.
+ */
+struct SCHAUER_AUTOTEST_EXPORT ContainerColumns {
+    enum Column : quint32 {
+        IdColumn            = 0x001,
+        NamesColumn         = 0x002,
+        ImageColumn         = 0x004,
+        ImageIdColumn       = 0x008,
+        CommandColumn       = 0x010,
+        CreatedColumn       = 0x020,
+        StateColumn         = 0x040,
+        StatusColumn        = 0x080,
+        LabelsColumn        = 0x100,
+        SizeRwColumn        = 0x200,
+        SizeRootFsColumn    = 0x400,
+        // always decoded, ContainerIndexes needs them
+        LookupColumns       = IdColumn | NamesColumn | ImageColumn | ImageIdColumn
+    };
+
+    std::vector<QString> ids;
+    std::vector<QStringList> names;
+    std::vector<QString> images;
+    std::vector<QString> imageIds;
+    std::vector<QString> commands;
+    std::vector<qint64> created; // seconds since epoch
+    std::vector<ContainerState> states;
+    std::vector<QString> statuses;
+    std::vector<int> labels; // index into labelSets
+    std::vector<quint64> sizeRw;
+    std::vector<quint64> sizeRootFs;
+    LabelSetTable labelSets;
+
+    int rowCount() const { return static_cast<int>(ids.size()); }
+
+    bool empty() const { return ids.empty(); }
+
+    void reserve(std::size_t n);
+
+    void clear();
+
+    void appendFromJson(const QJsonObject &o, quint32 columns);
+
+    void append(const ContainerColumns &other, int otherRow);
+
+    void remove(int first, int count);
+
+    quint32 update(int row, const ContainerColumns &other, int otherRow);
+
+    static ContainerState stateFromString(const QString &state);
+
+    static QString stateToString(ContainerState state);
+};
+
+/*!
+ * \internal
+ * \brief Lookup indexes for the rows of ContainerColumns.
+ */
+struct ContainerIndexes {
+    QHash<QString,int> idIndex;
+    QHash<QString,int> nameIndex;
+    QHash<QString,int> imageRefs;
+    QHash<QString,int> imageIdRefs;
+
+    void add(const ContainerColumns &columns, int row);
+
+    void remove(const ContainerColumns &columns, int first, int count);
+
+    void rebuild(const ContainerColumns &columns);
+
+    void clear();
+};
+
+/*!
+ * \internal
+ * \brief Container rows and indexes decoded on a worker thread.
+ */
+struct ContainerRows : public DecodedRows {
+    ContainerColumns columns;
+    ContainerIndexes indexes;
 };
 
 class AbstractContainerModelPrivate : public AbstractBaseModelPrivate
@@ -83,17 +128,36 @@ public:
 
     void setupJob() override;
 
-    bool loadFromJson(const QJsonDocument &json) override;
+    BackgroundDecoder::DecodeFunction decodeFunction() const override;
+
+    bool applyDecoded(DecodedRows *rows, bool incremental) override;
+
+    void removeFromIndexes(int first, int count) override;
+
+    void addToIndexes(int first) override;
+
+    void rebuildIndexes() override;
+
+    static std::shared_ptr<DecodedRows> decodeRows(const QByteArray &data, const QJsonDocument &json, quint32 columns);
+
+    bool contains(const QString &idOrName) const;
+
+    bool containsImage(const QString &image) const;
 
-    bool contains(QLatin1String idOrName) const;
+    bool containsImageId(const QString &imageId) const;
 
-    bool containsImage(QLatin1String image) const;
+    int rowForId(const QString &id) const;
 
-    bool containsImageId(QLatin1String imageId) const;
+    int rowForName(const QString &name) const;
 
-    std::vector<ContainerModelItem> containers;
+    ContainerColumns containers;
+    // kept in sync with containers
+    ContainerIndexes indexes;
+    // rows that are currently merged into containers
+    ContainerRows *merging = nullptr;
     bool showAll = false;
     bool showSize = false;
+    Filters filters;
 
 private:
     Q_DISABLE_COPY(AbstractContainerModelPrivate)
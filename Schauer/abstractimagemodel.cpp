@@ -5,7 +5,9 @@
 
 #include "abstractimagemodel_p.h"
 #include "listimagesjob.h"
+#include "listdecoder.h"
 #include "logging.h"
+#include "stringpool.h"
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
@@ -27,35 +29,55 @@ void AbstractImageModelPrivate::setupJob()
     auto _job = new ListImagesJob(q);
     _job->setShowAll(showAll);
     _job->setShowDigests(showDigests);
+    _job->setFilters(filters);
     job = _job;
 }
 
-bool AbstractImageModelPrivate::loadFromJson(const QJsonDocument &json)
+BackgroundDecoder::DecodeFunction AbstractImageModelPrivate::decodeFunction() const
 {
-    Q_Q(AbstractImageModel);
+    return &AbstractImageModelPrivate::decodeRows;
+}
 
-    const QJsonArray imgs = json.array();
+std::shared_ptr<DecodedRows> AbstractImageModelPrivate::decodeRows(const QByteArray &data, const QJsonDocument &json, quint32 columns)
+{
+    columns |= ImageColumns::LookupColumns;
+    auto rows = std::make_shared<ImageRows>();
+    if (!data.isEmpty()) {
+        ListDecoder decoder(data.constData(), data.size());
+        if (!decoder.decode(rows->columns, columns)) {
+            qCCritical(schCore) << "Failed to decode the list of images";
+            return nullptr;
+        }
+    } else {
+        // replies taken from the response cache are already parsed
+        const QJsonArray imgs = json.array();
+        rows->columns.reserve(static_cast<std::size_t>(imgs.size()));
+        for (const QJsonValue &img : imgs) {
+            rows->columns.appendFromJson(img.toObject(), columns);
+        }
+    }
+    return rows;
+}
 
-    q->beginInsertRows(QModelIndex(), images.size(), images.size() + imgs.size() - 1);
+bool AbstractImageModelPrivate::applyDecoded(DecodedRows *rows, bool incremental)
+{
+    Q_Q(AbstractImageModel);
 
-    for (const QJsonValue &img : imgs) {
-        const QJsonObject o = img.toObject();
-        const QString id = o.value(QStringLiteral("Id")).toString();
-        const QString parentId = o.value(QStringLiteral("ParentId")).toString();
-        const QStringList repoTags = AbstractBaseModelPrivate::jsonArrayToStringList(o.value(QStringLiteral("RepoTags")));
-        const QStringList repoDigests = AbstractBaseModelPrivate::jsonArrayToStringList(o.value(QStringLiteral("RepoDigests")));
-        const QDateTime created = QDateTime::fromSecsSinceEpoch(static_cast<qint64>(o.value(QStringLiteral("Created")).toDouble()), Qt::UTC);
-        const qint64 size = static_cast<qint64>(o.value(QStringLiteral("Size")).toDouble());
-        const qint64 virtualSize = static_cast<qint64>(o.value(QStringLiteral("VirtualSize")).toDouble());
-        const qint64 sharedSize = static_cast<qint64>(o.value(QStringLiteral("SharedSize")).toDouble());
-        const QMap<QString,QString> labels = AbstractBaseModelPrivate::jsonObjectToStringMap(o.value(QStringLiteral("Labels")));
-        const int containers = o.value(QStringLiteral("Containers")).toInt();
+    auto decoded = static_cast<ImageRows*>(rows);
 
-        images.emplace_back(id, parentId, repoTags, repoDigests, created, size, virtualSize, sharedSize, labels, containers);
+    if (incremental) {
+        mergeColumns(images, decoded->columns);
+    } else {
+        if (!images.empty()) {
+            q->clear();
+        }
+        if (!decoded->columns.empty()) {
+            q->beginInsertRows(QModelIndex(), 0, decoded->columns.rowCount() - 1);
+            std::swap(images, decoded->columns);
+            q->endInsertRows();
+        }
     }
 
-    q->endInsertRows();
-
     Q_EMIT q->loaded();
 
     setIsLoading(false);
@@ -63,6 +85,128 @@ bool AbstractImageModelPrivate::loadFromJson(const QJsonDocument &json)
     return true;
 }
 
+void ImageColumns::reserve(std::size_t n)
+{
+    ids.reserve(n);
+    parentIds.reserve(n);
+    repoTags.reserve(n);
+    repoDigests.reserve(n);
+    created.reserve(n);
+    size.reserve(n);
+    virtualSize.reserve(n);
+    sharedSize.reserve(n);
+    labels.reserve(n);
+    containers.reserve(n);
+}
+
+void ImageColumns::clear()
+{
+    ids.clear();
+    parentIds.clear();
+    repoTags.clear();
+    repoDigests.clear();
+    created.clear();
+    size.clear();
+    virtualSize.clear();
+    sharedSize.clear();
+    labels.clear();
+    containers.clear();
+    labelSets.clear();
+}
+
+void ImageColumns::appendFromJson(const QJsonObject &o, quint32 columns)
+{
+    // skipped columns get default values, so that all columns keep the same size
+    ids.push_back(o.value(QStringLiteral("Id")).toString());
+    parentIds.push_back((columns & ParentIdColumn) ? StringPool::intern(o.value(QStringLiteral("ParentId")).toString()) : QString());
+    repoTags.push_back((columns & RepoTagsColumn) ? AbstractBaseModelPrivate::jsonArrayToStringList(o.value(QStringLiteral("RepoTags"))) : QStringList());
+    repoDigests.push_back((columns & RepoDigestsColumn) ? AbstractBaseModelPrivate::jsonArrayToStringList(o.value(QStringLiteral("RepoDigests"))) : QStringList());
+    created.push_back((columns & CreatedColumn) ? static_cast<qint64>(o.value(QStringLiteral("Created")).toDouble()) : 0);
+    size.push_back((columns & SizeColumn) ? static_cast<qint64>(o.value(QStringLiteral("Size")).toDouble()) : 0);
+    virtualSize.push_back((columns & VirtualSizeColumn) ? static_cast<qint64>(o.value(QStringLiteral("VirtualSize")).toDouble()) : 0);
+    sharedSize.push_back((columns & SharedSizeColumn) ? static_cast<qint64>(o.value(QStringLiteral("SharedSize")).toDouble()) : 0);
+    labels.push_back((columns & LabelsColumn) ? labelSets.insert(AbstractBaseModelPrivate::jsonObjectToStringMap(o.value(QStringLiteral("Labels")))) : 0);
+    containers.push_back((columns & ContainersColumn) ? o.value(QStringLiteral("Containers")).toInt() : 0);
+}
+
+void ImageColumns::append(const ImageColumns &other, int otherRow)
+{
+    const auto r = static_cast<std::size_t>(otherRow);
+    ids.push_back(other.ids[r]);
+    parentIds.push_back(other.parentIds[r]);
+    repoTags.push_back(other.repoTags[r]);
+    repoDigests.push_back(other.repoDigests[r]);
+    created.push_back(other.created[r]);
+    size.push_back(other.size[r]);
+    virtualSize.push_back(other.virtualSize[r]);
+    sharedSize.push_back(other.sharedSize[r]);
+    labels.push_back(labelSets.insert(other.labelSets.at(other.labels[r])));
+    containers.push_back(other.containers[r]);
+}
+
+void ImageColumns::remove(int first, int count)
+{
+    const auto f = static_cast<std::ptrdiff_t>(first);
+    const auto l = static_cast<std::ptrdiff_t>(first + count);
+    ids.erase(ids.begin() + f, ids.begin() + l);
+    parentIds.erase(parentIds.begin() + f, parentIds.begin() + l);
+    repoTags.erase(repoTags.begin() + f, repoTags.begin() + l);
+    repoDigests.erase(repoDigests.begin() + f, repoDigests.begin() + l);
+    created.erase(created.begin() + f, created.begin() + l);
+    size.erase(size.begin() + f, size.begin() + l);
+    virtualSize.erase(virtualSize.begin() + f, virtualSize.begin() + l);
+    sharedSize.erase(sharedSize.begin() + f, sharedSize.begin() + l);
+    labels.erase(labels.begin() + f, labels.begin() + l);
+    containers.erase(containers.begin() + f, containers.begin() + l);
+}
+
+quint32 ImageColumns::update(int row, const ImageColumns &other, int otherRow)
+{
+    const auto r = static_cast<std::size_t>(row);
+    const auto o = static_cast<std::size_t>(otherRow);
+    quint32 changed = 0;
+
+    if (parentIds[r] != other.parentIds[o]) {
+        parentIds[r] = other.parentIds[o];
+        changed |= ParentIdColumn;
+    }
+    if (repoTags[r] != other.repoTags[o]) {
+        repoTags[r] = other.repoTags[o];
+        changed |= RepoTagsColumn;
+    }
+    if (repoDigests[r] != other.repoDigests[o]) {
+        repoDigests[r] = other.repoDigests[o];
+        changed |= RepoDigestsColumn;
+    }
+    if (created[r] != other.created[o]) {
+        created[r] = other.created[o];
+        changed |= CreatedColumn;
+    }
+    if (size[r] != other.size[o]) {
+        size[r] = other.size[o];
+        changed |= SizeColumn;
+    }
+    if (virtualSize[r] != other.virtualSize[o]) {
+        virtualSize[r] = other.virtualSize[o];
+        changed |= VirtualSizeColumn;
+    }
+    if (sharedSize[r] != other.sharedSize[o]) {
+        sharedSize[r] = other.sharedSize[o];
+        changed |= SharedSizeColumn;
+    }
+    const QMap<QString,QString> &otherLabels = other.labelSets.at(other.labels[o]);
+    if (labelSets.at(labels[r]) != otherLabels) {
+        labels[r] = labelSets.insert(otherLabels);
+        changed |= LabelsColumn;
+    }
+    if (containers[r] != other.containers[o]) {
+        containers[r] = other.containers[o];
+        changed |= ContainersColumn;
+    }
+
+    return changed;
+}
+
 AbstractImageModel::AbstractImageModel(QObject *parent)
     : AbstractBaseModel(* new AbstractImageModelPrivate(this), parent)
 {
@@ -81,7 +225,7 @@ int AbstractImageModel::rowCount(const QModelIndex &parent) const
 {
     Q_UNUSED(parent);
     Q_D(const AbstractImageModel);
-    return d->images.size();
+    return d->images.rowCount();
 }
 
 bool AbstractImageModel::showAll() const
@@ -116,6 +260,22 @@ void AbstractImageModel::setShowDigests(bool showDigests)
     }
 }
 
+Filters AbstractImageModel::filters() const
+{
+    Q_D(const AbstractImageModel);
+    return d->filters;
+}
+
+void AbstractImageModel::setFilters(const Filters &filters)
+{
+    Q_D(AbstractImageModel);
+    if (d->filters != filters) {
+        qCDebug(schCore) << "Changing \"filters\" from" << d->filters.toJson() << "to" << filters.toJson();
+        d->filters = filters;
+        Q_EMIT filtersChanged(this->filters());
+    }
+}
+
 bool AbstractImageModel::containsRepoTag(const QString &repo, const QString &tag) const
 {
     return containsRepoTag(QLatin1String(repo.toLatin1()), QLatin1String(tag.toLatin1()));
@@ -128,8 +288,8 @@ bool AbstractImageModel::containsRepoTag(QLatin1String repo, QLatin1String tag)
         return false;
     }
     if (tag.isEmpty()) {
-        for (const ImageModelItem &item : static_cast<const std::vector<ImageModelItem>&>(d->images)) {
-            for (const QString &repoTag : static_cast<const QStringList &>(item.repoTags)) {
+        for (const QStringList &repoTags : d->images.repoTags) {
+            for (const QString &repoTag : repoTags) {
                 const int colonIdx = repoTag.indexOf(QLatin1Char(':'));
                 if (Q_LIKELY(colonIdx > -1)) {
                     if (repoTag.leftRef(colonIdx).compare(repo) == 0) {
@@ -139,8 +299,8 @@ bool AbstractImageModel::containsRepoTag(QLatin1String repo, QLatin1String tag)
             }
         }
     } else {
-        for (const ImageModelItem &item : static_cast<const std::vector<ImageModelItem>&>(d->images)) {
-            for (const QString &repoTag : static_cast<const QStringList &>(item.repoTags)) {
+        for (const QStringList &repoTags : d->images.repoTags) {
+            for (const QString &repoTag : repoTags) {
                 const int colonIdx = repoTag.indexOf(QLatin1Char(':'));
                 if (Q_LIKELY(colonIdx > -1)) {
                     if (repoTag.leftRef(colonIdx).compare(repo) == 0 && repoTag.midRef(colonIdx + 1).compare(tag) == 0) {
@@ -159,7 +319,7 @@ void AbstractImageModel::clear()
     Q_D(AbstractImageModel);
     if (!d->images.empty()) {
 
-        beginRemoveRows(QModelIndex(), 0, d->images.size() - 1);
+        beginRemoveRows(QModelIndex(), 0, d->images.rowCount() - 1);
 
         d->images.clear();
 
@@ -8,6 +8,7 @@
 
 #include "schauer_exports.h"
 #include "abstractbasemodel.h"
+#include "filters.h"
 
 namespace Schauer {
 
@@ -50,6 +51,20 @@ class SCHAUER_LIBRARY AbstractImageModel : public AbstractBaseModel
      * \li void showDigestsChanged(bool showDigests)
      */
     Q_PROPERTY(bool showDigests READ showDigests WRITE setShowDigests NOTIFY showDigestsChanged)
+    /*!
+     * \brief Filters applied to the list of images on the daemon side.
+     *
+     * By default no filters are set. Changes take effect on the next call of load().
+     * See ListImagesJob::filters.
+     *
+     * \par Access functions
+     * \li Filters filters() const
+     * \li void setFilters(const Filters &filters)
+     *
+     * \par Notifier signal
+     * \li void filtersChanged(const Filters &filters)
+     */
+    Q_PROPERTY(Schauer::Filters filters READ filters WRITE setFilters NOTIFY filtersChanged)
 public:
     /*!
      * \brief Constructs a new %AbstractImageModel with the given \a parent.
@@ -87,6 +102,18 @@ public:
      */
     void setShowDigests(bool showDigests);
 
+    /*!
+     * \brief Getter function for the \link AbstractImageModel::filters filters\endlink property.
+     * \sa setFilters(), filtersChanged()
+     */
+    Filters filters() const;
+
+    /*!
+     * \brief Setter function for the \link AbstractImageModel::filters filters\endlink property.
+     * \sa filters(), filtersChanged()
+     */
+    void setFilters(const Filters &filters);
+
     /*!
      * \brief Returns \c true if the model contains an image identfied by \a repo and/or \a tag.
      */
@@ -110,6 +137,12 @@ Q_SIGNALS:
      */
     void showDigestsChanged(bool schowDigests);
 
+    /*!
+     * \brief Notifier signal for the \link AbstractImageModel::filters filters\endlink property.
+     * \sa filters(), setFilters()
+     */
+    void filtersChanged(const Schauer::Filters &filters);
+
 protected:
     AbstractImageModel(AbstractImageModelPrivate &dd, QObject *parent = nullptr);
 
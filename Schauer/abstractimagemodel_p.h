@@ -12,64 +12,67 @@
 #include <QMap>
 #include <vector>
 
+class QJsonObject;
+
 namespace Schauer {
 
-struct ImageModelItem {
-    QString id;
-    QString parentId;
-    QStringList repoTags;
-    QStringList repoDigests;
-    QDateTime created;
-    qint64 size;
-    qint64 virtualSize;
-    qint64 sharedSize;
-    QMap<QString,QString> labels;
-    int containers = 0;
-
-    ImageModelItem(const QString _id, const QString &_parentId, const QStringList &_repoTags, const QStringList &_repoDigests, const QDateTime &_created, qint64 _size, qint64 _virtualSize, qint64 _sharedSize, const QMap<QString,QString> &_labels, int _containers) :
-        id(_id),
-        parentId(_parentId),
-        repoTags(_repoTags),
-        repoDigests(_repoDigests),
-        created(_created),
-        size(_size),
-        virtualSize(_virtualSize),
-        sharedSize(_sharedSize),
-        labels(_labels),
-        containers(_containers)
-    {}
-
-    ~ImageModelItem() = default;
-
-    ImageModelItem(const ImageModelItem &other) :
-        id(other.id),
-        parentId(other.parentId),
-        repoTags(other.repoTags),
-        repoDigests(other.repoDigests),
-        created(other.created),
-        size(other.size),
-        virtualSize(other.virtualSize),
-        sharedSize(other.sharedSize),
-        labels(other.labels),
-        containers(other.containers)
-    {}
-
-    ImageModelItem(ImageModelItem &&other) :
-        id(std::move(other.id)),
-        parentId(std::move(other.parentId)),
-        repoTags(std::move(other.repoTags)),
-        repoDigests(std::move(other.repoDigests)),
-        created(std::move(other.created)),
-        size(std::move(other.size)),
-        virtualSize(std::move(other.virtualSize)),
-        sharedSize(std::move(other.sharedSize)),
-        labels(std::move(other.labels)),
-        containers(std::move(other.containers))
-    {}
-
-    ImageModelItem& operator=(const ImageModelItem &other) = default;
-
-    ImageModelItem& operator=(ImageModelItem &&other) = default;
+/*!
+ * \internal
+ * \brief Column-wise storage of the image model data.
+ *
+ * Every role has its own array, all arrays have the same size.
+ */
+struct ImageColumns {
+    enum Column : quint32 {
+        IdColumn            = 0x001,
+        ParentIdColumn      = 0x002,
+        RepoTagsColumn      = 0x004,
+        RepoDigestsColumn   = 0x008,
+        CreatedColumn       = 0x010,
+        SizeColumn          = 0x020,
+        VirtualSizeColumn   = 0x040,
+        SharedSizeColumn    = 0x080,
+        LabelsColumn        = 0x100,
+        ContainersColumn    = 0x200,
+        // always decoded, rows are matched by ID
+        LookupColumns       = IdColumn
+    };
+
+    std::vector<QString> ids;
+    std::vector<QString> parentIds;
+    std::vector<QStringList> repoTags;
+    std::vector<QStringList> repoDigests;
+    std::vector<qint64> created; // seconds since epoch
+    std::vector<qint64> size;
+    std::vector<qint64> virtualSize;
+    std::vector<qint64> sharedSize;
+    std::vector<int> labels; // index into labelSets
+    std::vector<int> containers;
+    LabelSetTable labelSets;
+
+    int rowCount() const { return static_cast<int>(ids.size()); }
+
+    bool empty() const { return ids.empty(); }
+
+    void reserve(std::size_t n);
+
+    void clear();
+
+    void appendFromJson(const QJsonObject &o, quint32 columns);
+
+    void append(const ImageColumns &other, int otherRow);
+
+    void remove(int first, int count);
+
+    quint32 update(int row, const ImageColumns &other, int otherRow);
+};
+
+/*!
+ * \internal
+ * \brief Image rows decoded on a worker thread.
+ */
+struct ImageRows : public DecodedRows {
+    ImageColumns columns;
 };
 
 class AbstractImageModelPrivate : public AbstractBaseModelPrivate
@@ -80,11 +83,15 @@ public:
     ~AbstractImageModelPrivate();
 
     void setupJob() override;
-    bool loadFromJson(const QJsonDocument &json) override;
+    BackgroundDecoder::DecodeFunction decodeFunction() const override;
+    bool applyDecoded(DecodedRows *rows, bool incremental) override;
+
+    static std::shared_ptr<DecodedRows> decodeRows(const QByteArray &data, const QJsonDocument &json, quint32 columns);
 
-    std::vector<ImageModelItem> images;
+    ImageColumns images;
     bool showAll = false;
     bool showDigests = false;
+    Filters filters;
 
 private:
     Q_DISABLE_COPY(AbstractImageModelPrivate)
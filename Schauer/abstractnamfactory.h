@@ -23,6 +23,10 @@ namespace Schauer {
  * To im plement a factory, subclass AbstractNamFactory and implement the virtual create() method,
  * then assign it to the Schauer API classes using Schauer::setNetworkAccessManagerFactory().
  *
+ * The API classes share their connections, so the factory is only used to create one network access
+ * manager per thread and remote host. Idle managers are destroyed after
+ * AbstractConfiguration::connectionIdleTimeout() and recreated when needed.
+ *
  * \headerfile "" <Schauer/AbstractNamFactory>
  */
 class SCHAUER_LIBRARY AbstractNamFactory
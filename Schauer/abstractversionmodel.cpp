@@ -4,11 +4,8 @@
  */
 
 #include "abstractversionmodel_p.h"
-#include "getversionjob.h"
+#include "getversionjob_p.h"
 #include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
-#include <QJsonValue>
 
 using namespace Schauer;
 
@@ -30,39 +27,21 @@ bool AbstractVersionModelPrivate::loadFromJson(const QJsonDocument &json)
 {
     Q_Q(AbstractVersionModel);
 
-    const QJsonObject versionObject = json.object();
-    apiVersion = versionObject.value(QStringLiteral("ApiVersion")).toString();
-    arch = versionObject.value(QStringLiteral("Arch")).toString();
-    buildTime = QDateTime::fromString(versionObject.value(QStringLiteral("BuildTime")).toString(), Qt::ISODateWithMs);
-    gitCommit = versionObject.value(QStringLiteral("GitCommit")).toString();
-    goVersion = versionObject.value(QStringLiteral("GoVersion")).toString();
-    kernelVersion = versionObject.value(QStringLiteral("KernelVersion")).toString();
-    minApiVersion = versionObject.value(QStringLiteral("MinAPIVersion")).toString();
-    os = versionObject.value(QStringLiteral("Os")).toString();
-    platformName = versionObject.value(QStringLiteral("Platform")).toObject().value(QStringLiteral("Name")).toString();
-    version = versionObject.value(QStringLiteral("Version")).toString();
-
-    const QJsonArray comps = versionObject.value(QStringLiteral("Components")).toArray();
-
-    q->beginInsertRows(QModelIndex(), components.size(), components.size() + comps.size() - 1);
-
-    for (const QJsonValue &v : comps) {
-        const QJsonObject o = v.toObject();
-        const QString name = o.value(QStringLiteral("Name")).toString();
-        const QString version = o.value(QStringLiteral("Version")).toString();
-        const QJsonObject d = o.value(QStringLiteral("Details")).toObject();
-        const QString apiVersion = d.value(QStringLiteral("ApiVersion")).toString();
-        const QString arch = d.value(QStringLiteral("Arch")).toString();
-        const QDateTime buildTime = d.contains(QStringLiteral("BuildTime")) ? QDateTime::fromString(d.value(QStringLiteral("BuildTime")).toString(), Qt::ISODateWithMs) : QDateTime();
-        const bool experimental = d.value(QStringLiteral("Experimental")).toBool();
-        const QString gitCommit = d.value(QStringLiteral("GitCommit")).toString();
-        const QString goVersion = d.value(QStringLiteral("GoVersion")).toString();
-        const QString kernelVersion = d.value(QStringLiteral("KernelVersion")).toString();
-        const QString minApiVersion = d.value(QStringLiteral("MinAPIVersion")).toString();
-        const QString os = d.value(QStringLiteral("Os")).toString();
-
-        components.emplace_back(name, apiVersion, arch, buildTime, gitCommit, goVersion, kernelVersion, minApiVersion, os, version, experimental);
-    }
+    const VersionInfo info = GetVersionJobPrivate::versionFromJson(json.object());
+    apiVersion = info.apiVersion;
+    arch = info.arch;
+    buildTime = info.buildTime;
+    gitCommit = info.gitCommit;
+    goVersion = info.goVersion;
+    kernelVersion = info.kernelVersion;
+    minApiVersion = info.minApiVersion;
+    os = info.os;
+    platformName = info.platformName;
+    version = info.version;
+
+    q->beginInsertRows(QModelIndex(), components.size(), components.size() + info.components.size() - 1);
+
+    components.insert(components.end(), info.components.cbegin(), info.components.cend());
 
     q->endInsertRows();
 
@@ -0,0 +1,109 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "backgrounddecoder.h"
+#include "logging.h"
+#include <QCoreApplication>
+#include <QEvent>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThreadPool>
+
+namespace Schauer {
+
+struct BackgroundDecoderShared {
+    QMutex mutex;
+    BackgroundDecoder *receiver = nullptr;
+};
+
+}
+
+using namespace Schauer;
+
+namespace {
+
+const QEvent::Type decodedEventType = static_cast<QEvent::Type>(QEvent::registerEventType());
+
+class DecodedEvent : public QEvent
+{
+public:
+    DecodedEvent(quint64 _generation, std::shared_ptr<DecodedRows> _rows)
+        : QEvent(decodedEventType), generation(_generation), rows(std::move(_rows))
+    {}
+
+    quint64 generation;
+    std::shared_ptr<DecodedRows> rows;
+};
+
+class DecodeTask : public QRunnable
+{
+public:
+    DecodeTask(const QSharedPointer<BackgroundDecoderShared> &shared, const QByteArray &data, const QJsonDocument &json, quint32 columns, BackgroundDecoder::DecodeFunction decode, quint64 generation)
+        : m_shared(shared), m_data(data), m_json(json), m_columns(columns), m_decode(decode), m_generation(generation)
+    {}
+
+    void run() override
+    {
+        std::shared_ptr<DecodedRows> rows = m_decode(m_data, m_json, m_columns);
+        // the receiver is reset under the lock when it gets destroyed
+        QMutexLocker locker(&m_shared->mutex);
+        if (m_shared->receiver) {
+            QCoreApplication::postEvent(m_shared->receiver, new DecodedEvent(m_generation, std::move(rows)));
+        }
+    }
+
+private:
+    QSharedPointer<BackgroundDecoderShared> m_shared;
+    QByteArray m_data;
+    QJsonDocument m_json;
+    quint32 m_columns;
+    BackgroundDecoder::DecodeFunction m_decode;
+    quint64 m_generation;
+};
+
+}
+
+BackgroundDecoder::BackgroundDecoder(QObject *parent)
+    : QObject(parent), m_shared(new BackgroundDecoderShared)
+{
+    m_shared->receiver = this;
+}
+
+BackgroundDecoder::~BackgroundDecoder()
+{
+    QMutexLocker locker(&m_shared->mutex);
+    m_shared->receiver = nullptr;
+}
+
+void BackgroundDecoder::start(const QByteArray &data, const QJsonDocument &json, quint32 columns, DecodeFunction decode, const ResultCallback &callback)
+{
+    m_callback = callback;
+    auto task = new DecodeTask(m_shared, data, json, columns, decode, ++m_generation);
+    task->setAutoDelete(true);
+    QThreadPool::globalInstance()->start(task);
+}
+
+void BackgroundDecoder::cancel()
+{
+    ++m_generation;
+}
+
+void BackgroundDecoder::customEvent(QEvent *event)
+{
+    if (event->type() == decodedEventType) {
+        auto ev = static_cast<DecodedEvent*>(event);
+        if (ev->generation != m_generation) {
+            qCDebug(schCore) << "Dropping outdated decoded model data";
+            return;
+        }
+        // a nullptr tells the callback that decoding failed
+        if (m_callback) {
+            m_callback(ev->rows.get());
+        }
+    } else {
+        QObject::customEvent(event);
+    }
+}
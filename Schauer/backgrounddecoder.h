@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_BACKGROUNDDECODER_H
+#define SCHAUER_BACKGROUNDDECODER_H
+
+#include <QByteArray>
+#include <QJsonDocument>
+#include <QObject>
+#include <QSharedPointer>
+#include <functional>
+#include <memory>
+
+namespace Schauer {
+
+/*!
+ * \internal
+ * \brief Base class for model rows decoded on a worker thread.
+ */
+class DecodedRows
+{
+public:
+    virtual ~DecodedRows() = default;
+};
+
+struct BackgroundDecoderShared;
+
+/*!
+ * \internal
+ * \brief Decodes model data on the global thread pool.
+ *
+ * start() runs the decode function on QThreadPool::globalInstance() and calls the
+ * result callback on the thread that owns the decoder. Only the result of the last
+ * started decode is delivered, older results and results arriving after cancel()
+ * or after the decoder has been destroyed are dropped.
+ *
+ * The decode function runs on a worker thread and must not access the model. It gets
+ * either the raw reply \a data or, if that is empty, the already parsed \a json, only
+ * decodes the \a columns used by the model and returns a \c nullptr if the data can not
+ * be decoded.
+ */
+class BackgroundDecoder : public QObject
+{
+public:
+    using DecodeFunction = std::shared_ptr<DecodedRows> (*)(const QByteArray &data, const QJsonDocument &json, quint32 columns);
+    using ResultCallback = std::function<void(DecodedRows *rows)>;
+
+    explicit BackgroundDecoder(QObject *parent = nullptr);
+
+    ~BackgroundDecoder() override;
+
+    void start(const QByteArray &data, const QJsonDocument &json, quint32 columns, DecodeFunction decode, const ResultCallback &callback);
+
+    void cancel();
+
+protected:
+    void customEvent(QEvent *event) override;
+
+private:
+    QSharedPointer<BackgroundDecoderShared> m_shared;
+    ResultCallback m_callback;
+    quint64 m_generation = 0;
+
+    Q_DISABLE_COPY(BackgroundDecoder)
+};
+
+}
+
+#endif // SCHAUER_BACKGROUNDDECODER_H
@@ -0,0 +1,333 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "connectionpool.h"
+#include "abstractconfiguration.h"
+#include "abstractnamfactory.h"
+#include "global.h"
+#include "logging.h"
+#include "unixsocketreply.h"
+#include <QNetworkReply>
+#include <QLocalSocket>
+#include <QThreadStorage>
+#include <QTimer>
+#include <memory>
+
+using namespace Schauer;
+
+ConnectionPool::ConnectionPool(QObject *parent)
+    : QObject(parent)
+{
+
+}
+
+ConnectionPool::~ConnectionPool()
+{
+    qDeleteAll(m_hosts);
+}
+
+ConnectionPool *ConnectionPool::instance()
+{
+    static QThreadStorage<ConnectionPool*> pools;
+    if (!pools.hasLocalData()) {
+        pools.setLocalData(new ConnectionPool);
+    }
+    return pools.localData();
+}
+
+QString ConnectionPool::keyFor(AbstractConfiguration *configuration)
+{
+    const QString socketPath = configuration->socketPath();
+    if (!socketPath.isEmpty()) {
+        return QLatin1String("unix://") + socketPath;
+    }
+
+    const QLatin1String scheme = configuration->useSsl() ? QLatin1String("https://") : QLatin1String("http://");
+    return scheme + configuration->host() + QLatin1Char(':') + QString::number(configuration->port());
+}
+
+ConnectionPool::Host *ConnectionPool::host(AbstractConfiguration *configuration)
+{
+    const QString key = keyFor(configuration);
+    Host *h = m_hosts.value(key);
+    if (!h) {
+        h = new Host;
+        h->key = key;
+        h->socketPath = configuration->socketPath();
+        h->idleTimer = new QTimer(this);
+        h->idleTimer->setSingleShot(true);
+        h->idleTimer->setTimerType(Qt::VeryCoarseTimer);
+        connect(h->idleTimer, &QTimer::timeout, this, [this, key](){
+            hostIdleTimeout(key);
+        });
+        m_hosts.insert(key, h);
+        qCDebug(schCore) << "Created connection pool entry for" << key;
+    }
+    h->maxConnections = qMax(1, configuration->maxConnectionsPerHost());
+    h->idleTimeout = qMax(0, configuration->connectionIdleTimeout());
+    return h;
+}
+
+void ConnectionPool::sendRequest(AbstractConfiguration *configuration, QNetworkAccessManager::Operation operation, const QNetworkRequest &request, const QByteArray &payload, QObject *receiver, const ReplyCallback &callback, bool longLived)
+{
+    Host *h = host(configuration);
+
+    PendingRequest req{receiver, callback, request, payload, operation, longLived};
+
+    if (longLived || (h->active < h->maxConnections && h->pending.empty())) {
+        dispatch(h, req);
+    } else {
+        qCDebug(schCore) << "All" << h->maxConnections << "connections to" << h->key << "are busy, queuing request";
+        h->pending.push_back(std::move(req));
+    }
+}
+
+void ConnectionPool::dispatch(Host *h, PendingRequest &req)
+{
+    const bool longLived = req.longLived;
+    if (longLived) {
+        h->longLived++;
+        qCDebug(schCore) << "Sending long-lived request to" << h->key << "on its own connection";
+    } else {
+        h->active++;
+    }
+
+    const QString key = h->key;
+    QNetworkReply *reply = nullptr;
+
+    if (h->socketPath.isEmpty()) {
+        // the access manager limits the connections per host on its own, so long-lived
+        // requests get an access manager of their own that lives as long as the reply
+        QNetworkAccessManager *nam = longLived ? createNetworkAccessManager(key) : networkAccessManager(h);
+        switch (req.operation) {
+        case QNetworkAccessManager::HeadOperation:
+            reply = nam->head(req.request);
+            break;
+        case QNetworkAccessManager::PostOperation:
+            reply = nam->post(req.request, req.payload);
+            break;
+        case QNetworkAccessManager::PutOperation:
+            reply = nam->put(req.request, req.payload);
+            break;
+        case QNetworkAccessManager::DeleteOperation:
+            reply = nam->deleteResource(req.request);
+            break;
+        default:
+            reply = nam->get(req.request);
+            break;
+        }
+        if (longLived) {
+            connect(reply, &QObject::destroyed, nam, &QObject::deleteLater);
+        }
+    } else {
+        QLocalSocket *socket = longLived ? nullptr : takeIdleSocket(h);
+        auto usr = new UnixSocketReply(h->socketPath, socket, req.operation, req.request, req.payload, req.receiver.data());
+        connect(usr, &UnixSocketReply::socketReusable, this, [this, key](QLocalSocket *socket){
+            returnSocket(key, socket);
+        });
+        reply = usr;
+    }
+
+    // release the slot only once, whatever comes first
+    auto released = std::make_shared<bool>(false);
+    auto release = [this, key, released, longLived](){
+        if (!*released) {
+            *released = true;
+            if (longLived) {
+                releaseLongLived(key);
+            } else {
+                releaseSlot(key);
+            }
+        }
+    };
+    connect(reply, &QNetworkReply::finished, this, release);
+    connect(reply, &QObject::destroyed, this, release);
+
+    req.callback(reply);
+}
+
+void ConnectionPool::releaseSlot(const QString &key)
+{
+    Host *h = m_hosts.value(key);
+    if (!h) {
+        return;
+    }
+
+    h->active = qMax(0, h->active - 1);
+
+    while (!h->pending.empty() && h->active < h->maxConnections) {
+        PendingRequest req = std::move(h->pending.front());
+        h->pending.pop_front();
+        if (req.receiver) {
+            dispatch(h, req);
+        }
+    }
+
+    if (h->active == 0 && h->pending.empty()) {
+        scheduleIdleTimer(h);
+    }
+}
+
+void ConnectionPool::releaseLongLived(const QString &key)
+{
+    Host *h = m_hosts.value(key);
+    if (h) {
+        h->longLived = qMax(0, h->longLived - 1);
+    }
+}
+
+QNetworkAccessManager *ConnectionPool::networkAccessManager(Host *h)
+{
+    if (!h->nam) {
+        h->nam = createNetworkAccessManager(h->key);
+    }
+    return h->nam;
+}
+
+QNetworkAccessManager *ConnectionPool::createNetworkAccessManager(const QString &key)
+{
+    QNetworkAccessManager *nam = nullptr;
+    auto namf = Schauer::networkAccessManagerFactory();
+    if (namf) {
+        nam = namf->create(this);
+        qCDebug(schCore) << "Using" << nam << "created by NetworkAccessManagerFactory" << namf << "for" << key;
+    } else {
+        nam = new QNetworkAccessManager(this);
+        qCDebug(schCore) << "Using default created" << nam << "for" << key;
+    }
+    return nam;
+}
+
+QLocalSocket *ConnectionPool::takeIdleSocket(Host *h)
+{
+    while (!h->idleSockets.empty()) {
+        QLocalSocket *socket = h->idleSockets.back().socket;
+        h->idleSockets.pop_back();
+        socket->disconnect(this);
+        if (socket->state() == QLocalSocket::ConnectedState) {
+            qCDebug(schCore) << "Reusing idle connection to" << h->key;
+            return socket;
+        }
+        socket->deleteLater();
+    }
+    return nullptr;
+}
+
+void ConnectionPool::returnSocket(const QString &key, QLocalSocket *socket)
+{
+    Host *h = m_hosts.value(key);
+    if (!h || h->idleTimeout == 0 || socket->state() != QLocalSocket::ConnectedState) {
+        socket->deleteLater();
+        return;
+    }
+
+    if (static_cast<int>(h->idleSockets.size()) >= h->maxConnections) {
+        QLocalSocket *oldest = h->idleSockets.front().socket;
+        h->idleSockets.erase(h->idleSockets.begin());
+        oldest->disconnect(this);
+        oldest->disconnectFromServer();
+        oldest->deleteLater();
+    }
+
+    socket->setParent(this);
+    connect(socket, &QLocalSocket::disconnected, this, [this, key, socket](){
+        removeIdleSocket(key, socket);
+    });
+    // idle connections should not receive anything, so do not trust it anymore
+    connect(socket, &QLocalSocket::readyRead, this, [this, key, socket](){
+        removeIdleSocket(key, socket);
+    });
+
+    IdleSocket idle;
+    idle.socket = socket;
+    idle.idleSince.start();
+    h->idleSockets.push_back(idle);
+
+    scheduleIdleTimer(h);
+}
+
+void ConnectionPool::removeIdleSocket(const QString &key, QLocalSocket *socket)
+{
+    Host *h = m_hosts.value(key);
+    if (h) {
+        for (auto it = h->idleSockets.begin(); it != h->idleSockets.end(); ++it) {
+            if (it->socket == socket) {
+                h->idleSockets.erase(it);
+                break;
+            }
+        }
+    }
+    socket->disconnect(this);
+    socket->abort();
+    socket->deleteLater();
+}
+
+void ConnectionPool::scheduleIdleTimer(Host *h)
+{
+    const qint64 timeout = static_cast<qint64>(h->idleTimeout) * 1000;
+
+    if (h->socketPath.isEmpty()) {
+        if (h->nam && h->active == 0 && h->pending.empty()) {
+            h->idleTimer->start(static_cast<int>(timeout));
+        }
+    } else if (!h->idleSockets.empty()) {
+        // the first idle socket is the one that is idle for the longest time
+        const qint64 remaining = timeout - h->idleSockets.front().idleSince.elapsed();
+        h->idleTimer->start(static_cast<int>(qMax<qint64>(0, remaining)));
+    }
+}
+
+void ConnectionPool::hostIdleTimeout(const QString &key)
+{
+    Host *h = m_hosts.value(key);
+    if (!h) {
+        return;
+    }
+
+    if (h->socketPath.isEmpty()) {
+        if (h->nam && h->active == 0 && h->pending.empty()) {
+            qCDebug(schCore) << "Closing idle connections to" << key;
+            h->nam->deleteLater();
+            h->nam = nullptr;
+        }
+    } else {
+        const qint64 timeout = static_cast<qint64>(h->idleTimeout) * 1000;
+        while (!h->idleSockets.empty() && h->idleSockets.front().idleSince.elapsed() >= timeout) {
+            QLocalSocket *socket = h->idleSockets.front().socket;
+            h->idleSockets.erase(h->idleSockets.begin());
+            qCDebug(schCore) << "Closing idle connection to" << key;
+            socket->disconnect(this);
+            socket->disconnectFromServer();
+            socket->deleteLater();
+        }
+        scheduleIdleTimer(h);
+    }
+}
+
+int ConnectionPool::activeRequests(const QString &key) const
+{
+    const Host *h = m_hosts.value(key);
+    return h ? h->active : 0;
+}
+
+int ConnectionPool::longLivedRequests(const QString &key) const
+{
+    const Host *h = m_hosts.value(key);
+    return h ? h->longLived : 0;
+}
+
+int ConnectionPool::pendingRequests(const QString &key) const
+{
+    const Host *h = m_hosts.value(key);
+    return h ? static_cast<int>(h->pending.size()) : 0;
+}
+
+int ConnectionPool::idleConnections(const QString &key) const
+{
+    const Host *h = m_hosts.value(key);
+    return h ? static_cast<int>(h->idleSockets.size()) : 0;
+}
+
+#include "moc_connectionpool.cpp"
@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_CONNECTIONPOOL_H
+#define SCHAUER_CONNECTIONPOOL_H
+
+#include <QObject>
+#include <QHash>
+#include <QPointer>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QElapsedTimer>
+#include <deque>
+#include <functional>
+#include <vector>
+
+class QNetworkReply;
+class QLocalSocket;
+class QTimer;
+
+namespace Schauer {
+
+class AbstractConfiguration;
+
+/*!
+ * \internal
+ * \brief Per thread pool of connections to Docker daemons.
+ *
+ * All jobs share the connections of this pool. Connections are grouped by host,
+ * port, SSL setting and socket path. For TCP connections one QNetworkAccessManager
+ * is shared per host that keeps its connections alive, for unix domain sockets the
+ * pool keeps idle sockets around to reuse them. The number of requests in flight per
+ * host is limited by AbstractConfiguration::maxConnectionsPerHost(), further requests
+ * are queued.
+ *
+ * Long-lived requests like event streams or blocking waits would hold their slot
+ * for an unlimited time and starve all other requests. They are not counted against
+ * the limit and get a connection of their own that is not shared with other requests.
+ */
+class ConnectionPool : public QObject
+{
+    Q_OBJECT
+public:
+    using ReplyCallback = std::function<void(QNetworkReply *reply)>;
+
+    explicit ConnectionPool(QObject *parent = nullptr);
+    ~ConnectionPool() override;
+
+    /*!
+     * Returns the pool for the current thread.
+     */
+    static ConnectionPool *instance();
+
+    /*!
+     * Returns the key identifying the connections used by \a configuration.
+     */
+    static QString keyFor(AbstractConfiguration *configuration);
+
+    /*!
+     * Sends the \a request as soon as a connection to the daemon configured by
+     * \a configuration is available and calls \a callback with the reply. If
+     * \a receiver is destroyed before that, the request will not be send.
+     *
+     * If \a longLived is \c true, the request is sent immediately on a connection
+     * of its own and does not occupy one of the slots of the host.
+     */
+    void sendRequest(AbstractConfiguration *configuration, QNetworkAccessManager::Operation operation, const QNetworkRequest &request, const QByteArray &payload, QObject *receiver, const ReplyCallback &callback, bool longLived = false);
+
+    int activeRequests(const QString &key) const;
+
+    int longLivedRequests(const QString &key) const;
+
+    int pendingRequests(const QString &key) const;
+
+    int idleConnections(const QString &key) const;
+
+private:
+    struct PendingRequest {
+        QPointer<QObject> receiver;
+        ReplyCallback callback;
+        QNetworkRequest request;
+        QByteArray payload;
+        QNetworkAccessManager::Operation operation;
+        bool longLived;
+    };
+
+    struct IdleSocket {
+        QLocalSocket *socket;
+        QElapsedTimer idleSince;
+    };
+
+    struct Host {
+        QString key;
+        QString socketPath;
+        QNetworkAccessManager *nam = nullptr;
+        QTimer *idleTimer = nullptr;
+        std::vector<IdleSocket> idleSockets;
+        std::deque<PendingRequest> pending;
+        int active = 0;
+        int longLived = 0;
+        int maxConnections = 6;
+        int idleTimeout = 30;
+    };
+
+    Host *host(AbstractConfiguration *configuration);
+    void dispatch(Host *host, PendingRequest &request);
+    void releaseSlot(const QString &key);
+    void releaseLongLived(const QString &key);
+    QNetworkAccessManager *networkAccessManager(Host *host);
+    QNetworkAccessManager *createNetworkAccessManager(const QString &key);
+    QLocalSocket *takeIdleSocket(Host *host);
+    void returnSocket(const QString &key, QLocalSocket *socket);
+    void removeIdleSocket(const QString &key, QLocalSocket *socket);
+    void hostIdleTimeout(const QString &key);
+    void scheduleIdleTimer(Host *host);
+
+    QHash<QString,Host*> m_hosts;
+
+    Q_DISABLE_COPY(ConnectionPool)
+};
+
+}
+
+#endif // SCHAUER_CONNECTIONPOOL_H
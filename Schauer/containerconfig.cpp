@@ -0,0 +1,182 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "containerconfig.h"
+#include "jsonwriter.h"
+
+using namespace Schauer;
+
+namespace {
+
+void writeHostConfig(JsonWriter &w, const HostConfig &hc)
+{
+    w.beginObject();
+
+    if (!hc.portBindings.empty()) {
+        // the API groups the bindings by container port
+        QStringList written;
+        w.key(QLatin1String("PortBindings")).beginObject();
+        for (const PortBinding &pb : hc.portBindings) {
+            if (written.contains(pb.containerPort)) {
+                continue;
+            }
+            written << pb.containerPort;
+            w.key(pb.containerPort).beginArray();
+            for (const PortBinding &other : hc.portBindings) {
+                if (other.containerPort != pb.containerPort) {
+                    continue;
+                }
+                w.beginObject();
+                w.member(QLatin1String("HostIp"), other.hostIp);
+                w.member(QLatin1String("HostPort"), other.hostPort > 0 ? QString::number(other.hostPort) : QString());
+                w.endObject();
+            }
+            w.endArray();
+        }
+        w.endObject();
+    }
+
+    if (!hc.mounts.empty()) {
+        w.key(QLatin1String("Mounts")).beginArray();
+        for (const Mount &m : hc.mounts) {
+            w.beginObject();
+            switch (m.type) {
+            case Mount::Bind:
+                w.member(QLatin1String("Type"), QLatin1String("bind"));
+                break;
+            case Mount::Volume:
+                w.member(QLatin1String("Type"), QLatin1String("volume"));
+                break;
+            case Mount::Tmpfs:
+                w.member(QLatin1String("Type"), QLatin1String("tmpfs"));
+                break;
+            }
+            if (!m.source.isEmpty()) {
+                w.member(QLatin1String("Source"), m.source);
+            }
+            w.member(QLatin1String("Target"), m.target);
+            if (m.readOnly) {
+                w.member(QLatin1String("ReadOnly"), true);
+            }
+            w.endObject();
+        }
+        w.endArray();
+    }
+
+    if (!hc.binds.empty()) {
+        w.member(QLatin1String("Binds"), hc.binds);
+    }
+
+    if (!hc.networkMode.isEmpty()) {
+        w.member(QLatin1String("NetworkMode"), hc.networkMode);
+    }
+
+    if (!hc.restartPolicy.isEmpty()) {
+        w.key(QLatin1String("RestartPolicy")).beginObject();
+        w.member(QLatin1String("Name"), hc.restartPolicy);
+        w.endObject();
+    }
+
+    if (hc.memory > 0) {
+        w.member(QLatin1String("Memory"), hc.memory);
+    }
+
+    if (hc.nanoCpus > 0) {
+        w.member(QLatin1String("NanoCpus"), hc.nanoCpus);
+    }
+
+    if (hc.autoRemove) {
+        w.member(QLatin1String("AutoRemove"), true);
+    }
+
+    if (hc.privileged) {
+        w.member(QLatin1String("Privileged"), true);
+    }
+
+    if (hc.publishAllPorts) {
+        w.member(QLatin1String("PublishAllPorts"), true);
+    }
+
+    w.endObject();
+}
+
+}
+
+QByteArray ContainerConfig::toJson() const
+{
+    QByteArray json;
+    json.reserve(256);
+    JsonWriter w(json);
+
+    w.beginObject();
+    w.member(QLatin1String("Image"), image);
+
+    if (!cmd.empty()) {
+        w.member(QLatin1String("Cmd"), cmd);
+    }
+
+    if (!entrypoint.empty()) {
+        w.member(QLatin1String("Entrypoint"), entrypoint);
+    }
+
+    if (!env.empty()) {
+        w.member(QLatin1String("Env"), env);
+    }
+
+    if (!labels.empty()) {
+        w.key(QLatin1String("Labels")).beginObject();
+        for (auto it = labels.constBegin(), end = labels.constEnd(); it != end; ++it) {
+            w.key(it.key()).value(it.value());
+        }
+        w.endObject();
+    }
+
+    if (!exposedPorts.empty()) {
+        w.key(QLatin1String("ExposedPorts")).beginObject();
+        for (const QString &port : exposedPorts) {
+            w.key(port).beginObject().endObject();
+        }
+        w.endObject();
+    }
+
+    if (!hostname.isEmpty()) {
+        w.member(QLatin1String("Hostname"), hostname);
+    }
+
+    if (!user.isEmpty()) {
+        w.member(QLatin1String("User"), user);
+    }
+
+    if (!workingDir.isEmpty()) {
+        w.member(QLatin1String("WorkingDir"), workingDir);
+    }
+
+    if (tty) {
+        w.member(QLatin1String("Tty"), true);
+    }
+
+    if (openStdin) {
+        w.member(QLatin1String("OpenStdin"), true);
+    }
+
+    if (attachStdin) {
+        w.member(QLatin1String("AttachStdin"), true);
+    }
+
+    if (attachStdout) {
+        w.member(QLatin1String("AttachStdout"), true);
+    }
+
+    if (attachStderr) {
+        w.member(QLatin1String("AttachStderr"), true);
+    }
+
+    w.key(QLatin1String("HostConfig"));
+    writeHostConfig(w, hostConfig);
+
+    w.endObject();
+
+    return json;
+}
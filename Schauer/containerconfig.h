@@ -0,0 +1,267 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_CONTAINERCONFIG_H
+#define SCHAUER_CONTAINERCONFIG_H
+
+#include "schauer_exports.h"
+#include <QByteArray>
+#include <QMap>
+#include <QMetaType>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace Schauer {
+
+/*!
+ * \ingroup api-jobs-containers
+ * \brief Publishes a container port on the host.
+ *
+ * \sa HostConfig
+ *
+ * \headerfile "" <Schauer/ContainerConfig>
+ */
+struct PortBinding
+{
+    /*!
+     * \brief Port inside the container including the protocol, like \c 80/tcp.
+     */
+    QString containerPort;
+
+    /*!
+     * \brief Host IP address to bind to. If empty, the port is published on all interfaces.
+     */
+    QString hostIp;
+
+    /*!
+     * \brief Port on the host. If \c 0, the daemon chooses a free port.
+     */
+    quint16 hostPort = 0;
+};
+
+/*!
+ * \ingroup api-jobs-containers
+ * \brief Mounts a bind mount, a volume or a tmpfs into a container.
+ *
+ * \sa HostConfig
+ *
+ * \headerfile "" <Schauer/ContainerConfig>
+ */
+struct Mount
+{
+    /*!
+     * \brief Types of mounts.
+     */
+    enum Type : qint8 {
+        Bind = 0,   /**< Mounts a file or directory from the host. */
+        Volume,     /**< Mounts a named volume, it will be created if it does not exist. */
+        Tmpfs       /**< Mounts a tmpfs, source has to be empty. */
+    };
+
+    /*!
+     * \brief Type of the mount.
+     */
+    Type type = Bind;
+
+    /*!
+     * \brief Path on the host for bind mounts or the name of the volume.
+     */
+    QString source;
+
+    /*!
+     * \brief Path inside the container.
+     */
+    QString target;
+
+    /*!
+     * \brief Mounts read-only if \c true.
+     */
+    bool readOnly = false;
+};
+
+/*!
+ * \ingroup api-jobs-containers
+ * \brief Host specific configuration of a container.
+ *
+ * Only values that differ from the defaults are sent to the daemon, so the daemon
+ * defaults apply to everything else.
+ *
+ * \sa ContainerConfig
+ *
+ * \headerfile "" <Schauer/ContainerConfig>
+ */
+struct HostConfig
+{
+    /*!
+     * \brief Container ports published on the host.
+     */
+    QVector<PortBinding> portBindings;
+
+    /*!
+     * \brief Mounts to add to the container.
+     */
+    QVector<Mount> mounts;
+
+    /*!
+     * \brief Volume bindings in the form <tt>host-src:container-dest[:options]</tt>.
+     */
+    QStringList binds;
+
+    /*!
+     * \brief Network mode, like \c bridge, \c host or \c none.
+     */
+    QString networkMode;
+
+    /*!
+     * \brief Restart policy, one of \c no, \c always, \c unless-stopped and \c on-failure.
+     */
+    QString restartPolicy;
+
+    /*!
+     * \brief Memory limit in bytes, \c 0 means no limit.
+     */
+    qint64 memory = 0;
+
+    /*!
+     * \brief CPU quota in units of 10<sup>-9</sup> CPUs, \c 0 means no limit.
+     */
+    qint64 nanoCpus = 0;
+
+    /*!
+     * \brief Automatically removes the container when it exits.
+     */
+    bool autoRemove = false;
+
+    /*!
+     * \brief Gives extended privileges to the container.
+     */
+    bool privileged = false;
+
+    /*!
+     * \brief Publishes all exposed ports to random ports on the host.
+     */
+    bool publishAllPorts = false;
+};
+
+/*!
+ * \ingroup api-jobs-containers
+ * \brief Typed configuration of a container to create.
+ *
+ * This is a typed alternative to the QVariantHash used by
+ * CreateContainerJob::containerConfig. toJson() writes the request payload
+ * directly, without going through QVariant and QJsonDocument. The returned
+ * payload can be given to CreateContainerJob::setSerializedConfig() and
+ * CreateAndStartContainerJob::setSerializedConfig() and reused for as many
+ * jobs as needed.
+ *
+ * Only values that differ from the defaults are written, so the daemon
+ * defaults apply to everything else. At least \a image has to be set.
+ *
+ * \par Example
+ * \code{.cpp}
+ * ContainerConfig config;
+ * config.image = QStringLiteral("nginx");
+ * config.env << QStringLiteral("NGINX_PORT=80");
+ * config.hostConfig.portBindings.append({QStringLiteral("80/tcp"), QString(), 8080});
+ * const QByteArray payload = config.toJson();
+ *
+ * auto job = new CreateContainerJob();
+ * job->setSerializedConfig(payload);
+ * job->start();
+ * \endcode
+ *
+ * \dockerAPI{ContainerCreate}
+ *
+ * \headerfile "" <Schauer/ContainerConfig>
+ */
+struct SCHAUER_LIBRARY ContainerConfig
+{
+    /*!
+     * \brief Name of the image to create the container from.
+     */
+    QString image;
+
+    /*!
+     * \brief Command to run, if empty the command of the image is used.
+     */
+    QStringList cmd;
+
+    /*!
+     * \brief Entrypoint to use, if empty the entrypoint of the image is used.
+     */
+    QStringList entrypoint;
+
+    /*!
+     * \brief Environment variables in the form \c VAR=value.
+     */
+    QStringList env;
+
+    /*!
+     * \brief Labels to set on the container.
+     */
+    QMap<QString,QString> labels;
+
+    /*!
+     * \brief Ports to expose, like \c 80/tcp.
+     */
+    QStringList exposedPorts;
+
+    /*!
+     * \brief Hostname of the container.
+     */
+    QString hostname;
+
+    /*!
+     * \brief User that runs the commands inside the container.
+     */
+    QString user;
+
+    /*!
+     * \brief Working directory for the commands inside the container.
+     */
+    QString workingDir;
+
+    /*!
+     * \brief Host specific configuration.
+     */
+    HostConfig hostConfig;
+
+    /*!
+     * \brief Allocates a pseudo-TTY.
+     */
+    bool tty = false;
+
+    /*!
+     * \brief Opens stdin.
+     */
+    bool openStdin = false;
+
+    /*!
+     * \brief Attaches to stdin.
+     */
+    bool attachStdin = false;
+
+    /*!
+     * \brief Attaches to stdout.
+     */
+    bool attachStdout = false;
+
+    /*!
+     * \brief Attaches to stderr.
+     */
+    bool attachStderr = false;
+
+    /*!
+     * \brief Returns the compact JSON payload to create a container with this configuration.
+     */
+    QByteArray toJson() const;
+};
+
+}
+
+Q_DECLARE_METATYPE(Schauer::ContainerConfig)
+
+#endif // SCHAUER_CONTAINERCONFIG_H
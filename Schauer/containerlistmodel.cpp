@@ -16,6 +16,32 @@ ContainerListModelPrivate::ContainerListModelPrivate(ContainerListModel *q)
 
 ContainerListModelPrivate::~ContainerListModelPrivate() = default;
 
+QVector<int> ContainerListModelPrivate::rolesForColumns(quint32 columns) const
+{
+    // the column bits are in the same order as the roles
+    QVector<int> roles;
+    for (int bit = 0; columns != 0; ++bit, columns >>= 1) {
+        if (columns & 1) {
+            roles.push_back(ContainerListModel::IdRole + bit);
+        }
+    }
+    return roles;
+}
+
+quint32 ContainerListModelPrivate::columnsForRoles(const QVector<int> &roles) const
+{
+    if (roles.empty()) {
+        return AllColumns;
+    }
+    quint32 columns = 0;
+    for (int role : roles) {
+        if (role >= ContainerListModel::IdRole && role <= ContainerListModel::SizeRootFsRole) {
+            columns |= 1u << (role - ContainerListModel::IdRole);
+        }
+    }
+    return columns;
+}
+
 ContainerListModel::ContainerListModel(QObject *parent)
     : AbstractContainerModel(* new ContainerListModelPrivate(this), parent)
 {
@@ -89,31 +115,32 @@ QVariant ContainerListModel::data(const QModelIndex &index, int role) const
 
     Q_D(const ContainerListModel);
 
-    const ContainerModelItem c = d->containers.at(index.row());
+    const auto row = static_cast<std::size_t>(index.row());
+    const ContainerColumns &c = d->containers;
 
     switch (role) {
     case IdRole:
-        return QVariant::fromValue(c.id);
+        return QVariant::fromValue(c.ids[row]);
     case NamesRole:
-        return QVariant::fromValue(c.names);
+        return QVariant::fromValue(c.names[row]);
     case ImageRole:
-        return QVariant::fromValue(c.image);
+        return QVariant::fromValue(c.images[row]);
     case ImageIdRole:
-        return QVariant::fromValue(c.imageId);
+        return QVariant::fromValue(c.imageIds[row]);
     case CommandRole:
-        return QVariant::fromValue(c.command);
+        return QVariant::fromValue(c.commands[row]);
     case CreatedRole:
-        return QVariant::fromValue(c.created);
+        return QVariant::fromValue(QDateTime::fromSecsSinceEpoch(c.created[row], Qt::UTC));
     case StateRole:
-        return QVariant::fromValue(c.state);
+        return QVariant::fromValue(ContainerColumns::stateToString(c.states[row]));
     case StatusRole:
-        return QVariant::fromValue(c.status);
+        return QVariant::fromValue(c.statuses[row]);
     case LabelsRole:
-        return QVariant::fromValue(c.labels);
+        return QVariant::fromValue(c.labelSets.at(c.labels[row]));
     case SizeRwRole:
-        return QVariant::fromValue(c.sizeRw);
+        return QVariant::fromValue(c.sizeRw[row]);
     case SizeRootFsRole:
-        return QVariant::fromValue(c.sizeRootFs);
+        return QVariant::fromValue(c.sizeRootFs[row]);
     default:
         return QVariant();
     }
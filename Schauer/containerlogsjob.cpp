@@ -0,0 +1,384 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "containerlogsjob_p.h"
+#include "logging.h"
+#include <QTimer>
+#include <cstring>
+
+using namespace Schauer;
+
+ContainerLogsJobPrivate::ContainerLogsJobPrivate(ContainerLogsJob *q)
+    : JobPrivate(q)
+{
+    namOperation = NetworkOperation::Get;
+    expectedContentType = ExpectedContentType::Stream;
+    requiresAuth = false;
+    demuxer.setCallback([this](StreamDemuxer::StreamType stream, const QByteArray &data){
+        processOutput(stream == StreamDemuxer::Stderr ? LogLine::Stderr : LogLine::Stdout, data);
+    });
+}
+
+ContainerLogsJobPrivate::~ContainerLogsJobPrivate() = default;
+
+QString ContainerLogsJobPrivate::buildUrlPath() const
+{
+    const QString _id = id.startsWith(QLatin1Char('/')) ? id.mid(1) : id;
+    const QString path = JobPrivate::buildUrlPath() + QLatin1String("/containers/") + _id + QLatin1String("/logs");
+    return path;
+}
+
+QUrlQuery ContainerLogsJobPrivate::buildUrlQuery() const
+{
+    QUrlQuery uq = JobPrivate::buildUrlQuery();
+    uq.addQueryItem(QStringLiteral("follow"), follow ? QStringLiteral("true") : QStringLiteral("false"));
+    uq.addQueryItem(QStringLiteral("stdout"), showStdout ? QStringLiteral("true") : QStringLiteral("false"));
+    uq.addQueryItem(QStringLiteral("stderr"), showStderr ? QStringLiteral("true") : QStringLiteral("false"));
+    if (since.isValid()) {
+        uq.addQueryItem(QStringLiteral("since"), QString::number(since.toMSecsSinceEpoch() / 1000));
+    }
+    if (until.isValid()) {
+        uq.addQueryItem(QStringLiteral("until"), QString::number(until.toMSecsSinceEpoch() / 1000));
+    }
+    if (timestamps) {
+        uq.addQueryItem(QStringLiteral("timestamps"), QStringLiteral("true"));
+    }
+    uq.addQueryItem(QStringLiteral("tail"), tail < 0 ? QStringLiteral("all") : QString::number(tail));
+    return uq;
+}
+
+void ContainerLogsJobPrivate::emitDescription()
+{
+    Q_Q(ContainerLogsJob);
+
+    //: Job description title
+    //% "Getting logs of container with ID %1"
+    const QString _title = qtTrId("libschauer-job-desc-container-logs-title").arg(id);
+
+    Q_EMIT q->description(q, _title);
+}
+
+bool ContainerLogsJobPrivate::checkInput()
+{
+    if (!JobPrivate::checkInput()) {
+        return false;
+    }
+
+    if (id.isEmpty()) {
+        //: Error message if container id is missing when trying to get container logs
+        //% "Can not get logs without a valid container ID."
+        emitError(InvalidInput, qtTrId("libschauer-error-container-logs-missing-id"));
+        qCCritical(schCore) << "Missing container ID when trying to get container logs";
+        return false;
+    }
+
+    if (!showStdout && !showStderr) {
+        //: Error message if neither stdout nor stderr has been selected when trying to get container logs
+        //% "Can not get logs if neither stdout nor stderr has been selected."
+        emitError(InvalidInput, qtTrId("libschauer-error-container-logs-no-stream"));
+        qCCritical(schCore) << "Neither stdout nor stderr selected when trying to get container logs";
+        return false;
+    }
+
+    demuxer.reset();
+    resetBuffers();
+
+    return true;
+}
+
+void ContainerLogsJobPrivate::processStreamData(const QByteArray &data)
+{
+    demuxer.feed(data);
+}
+
+void ContainerLogsJobPrivate::processOutput(LogLine::Stream stream, const QByteArray &data)
+{
+    LineBuffer &buffer = buffers[stream == LogLine::Stderr ? 1 : 0];
+    const char *d = data.constData();
+    const int size = data.size();
+    int start = 0;
+
+    while (start < size) {
+        const char *newLine = static_cast<const char *>(std::memchr(d + start, '\n', static_cast<size_t>(size - start)));
+        if (!newLine) {
+            break;
+        }
+        const int end = static_cast<int>(newLine - d);
+        if (buffer.data.isEmpty()) {
+            // complete line in the received data, no need to copy it
+            processLine(stream, buffer, d + start, end - start, false);
+        } else {
+            buffer.data.append(d + start, end - start);
+            processLine(stream, buffer, buffer.data.constData(), buffer.data.size(), false);
+            buffer.data.truncate(0);
+        }
+        start = end + 1;
+    }
+
+    if (start < size) {
+        buffer.data.append(d + start, size - start);
+        // do not buffer more than maxLineLength for a line that does not end
+        while (buffer.data.size() > maxLineLength) {
+            int split = maxLineLength;
+            // do not split in the middle of an UTF-8 sequence
+            while (split > 0 && (static_cast<uchar>(buffer.data.at(split)) & 0xC0) == 0x80) {
+                --split;
+            }
+            if (split == 0) {
+                split = maxLineLength;
+            }
+            processLine(stream, buffer, buffer.data.constData(), split, true);
+            buffer.data.remove(0, split);
+        }
+    }
+}
+
+void ContainerLogsJobPrivate::processLine(LogLine::Stream stream, LineBuffer &buffer, const char *data, int size, bool partial)
+{
+    if (!partial && size > 0 && data[size - 1] == '\r') {
+        --size;
+    }
+
+    LogLine line;
+    line.stream = stream;
+    line.partial = partial;
+
+    if (timestamps) {
+        // only the first part of a long line starts with the timestamp
+        if (!buffer.continued) {
+            const char *space = static_cast<const char *>(std::memchr(data, ' ', static_cast<size_t>(size)));
+            if (space) {
+                const int tsSize = static_cast<int>(space - data);
+                buffer.timestamp = QDateTime::fromString(QString::fromLatin1(data, tsSize), Qt::ISODateWithMs);
+                data = space + 1;
+                size -= tsSize + 1;
+            } else {
+                buffer.timestamp = QDateTime();
+            }
+        }
+        line.timestamp = buffer.timestamp;
+    }
+
+    line.text = QString::fromUtf8(data, size);
+    buffer.continued = partial;
+    lineCount++;
+
+    Q_Q(ContainerLogsJob);
+    Q_EMIT q->lineReceived(line);
+}
+
+void ContainerLogsJobPrivate::resetBuffers()
+{
+    for (LineBuffer &buffer : buffers) {
+        buffer.data.truncate(0);
+        buffer.timestamp = QDateTime();
+        buffer.continued = false;
+    }
+}
+
+bool ContainerLogsJobPrivate::checkOutput(const QByteArray &data)
+{
+    // the last line might not be terminated by a new line
+    for (int i = 0; i < 2; ++i) {
+        LineBuffer &buffer = buffers[i];
+        if (!buffer.data.isEmpty()) {
+            processLine(i == 1 ? LogLine::Stderr : LogLine::Stdout, buffer, buffer.data.constData(), buffer.data.size(), false);
+            buffer.data.truncate(0);
+        }
+    }
+
+    return JobPrivate::checkOutput(data);
+}
+
+ContainerLogsJob::ContainerLogsJob(QObject *parent)
+    : Job(* new ContainerLogsJobPrivate(this), parent)
+{
+
+}
+
+ContainerLogsJob::~ContainerLogsJob() = default;
+
+void ContainerLogsJob::start()
+{
+    Q_D(ContainerLogsJob);
+    d->lineCount = 0;
+    QTimer::singleShot(0, this, &ContainerLogsJob::sendRequest);
+}
+
+QString ContainerLogsJob::id() const
+{
+    Q_D(const ContainerLogsJob);
+    return d->id;
+}
+
+void ContainerLogsJob::setId(const QString &id)
+{
+    Q_D(ContainerLogsJob);
+    if (d->id != id) {
+        qCDebug(schCore) << "Changing \"id\" from" << d->id << "to" << id;
+        d->id = id;
+        Q_EMIT idChanged(this->id());
+    }
+}
+
+bool ContainerLogsJob::follow() const
+{
+    Q_D(const ContainerLogsJob);
+    return d->follow;
+}
+
+void ContainerLogsJob::setFollow(bool follow)
+{
+    Q_D(ContainerLogsJob);
+    if (d->follow != follow) {
+        qCDebug(schCore) << "Changing \"follow\" from" << d->follow << "to" << follow;
+        d->follow = follow;
+        // a followed log is open for an unlimited time
+        d->requestTimeout = follow ? 0 : 300;
+        Q_EMIT followChanged(this->follow());
+    }
+}
+
+int ContainerLogsJob::tail() const
+{
+    Q_D(const ContainerLogsJob);
+    return d->tail;
+}
+
+void ContainerLogsJob::setTail(int tail)
+{
+    Q_D(ContainerLogsJob);
+    if (d->tail != tail) {
+        qCDebug(schCore) << "Changing \"tail\" from" << d->tail << "to" << tail;
+        d->tail = tail;
+        Q_EMIT tailChanged(this->tail());
+    }
+}
+
+QDateTime ContainerLogsJob::since() const
+{
+    Q_D(const ContainerLogsJob);
+    return d->since;
+}
+
+void ContainerLogsJob::setSince(const QDateTime &since)
+{
+    Q_D(ContainerLogsJob);
+    if (d->since != since) {
+        qCDebug(schCore) << "Changing \"since\" from" << d->since << "to" << since;
+        d->since = since;
+        Q_EMIT sinceChanged(this->since());
+    }
+}
+
+QDateTime ContainerLogsJob::until() const
+{
+    Q_D(const ContainerLogsJob);
+    return d->until;
+}
+
+void ContainerLogsJob::setUntil(const QDateTime &until)
+{
+    Q_D(ContainerLogsJob);
+    if (d->until != until) {
+        qCDebug(schCore) << "Changing \"until\" from" << d->until << "to" << until;
+        d->until = until;
+        Q_EMIT untilChanged(this->until());
+    }
+}
+
+bool ContainerLogsJob::timestamps() const
+{
+    Q_D(const ContainerLogsJob);
+    return d->timestamps;
+}
+
+void ContainerLogsJob::setTimestamps(bool timestamps)
+{
+    Q_D(ContainerLogsJob);
+    if (d->timestamps != timestamps) {
+        qCDebug(schCore) << "Changing \"timestamps\" from" << d->timestamps << "to" << timestamps;
+        d->timestamps = timestamps;
+        Q_EMIT timestampsChanged(this->timestamps());
+    }
+}
+
+bool ContainerLogsJob::showStdout() const
+{
+    Q_D(const ContainerLogsJob);
+    return d->showStdout;
+}
+
+void ContainerLogsJob::setShowStdout(bool showStdout)
+{
+    Q_D(ContainerLogsJob);
+    if (d->showStdout != showStdout) {
+        qCDebug(schCore) << "Changing \"showStdout\" from" << d->showStdout << "to" << showStdout;
+        d->showStdout = showStdout;
+        Q_EMIT showStdoutChanged(this->showStdout());
+    }
+}
+
+bool ContainerLogsJob::showStderr() const
+{
+    Q_D(const ContainerLogsJob);
+    return d->showStderr;
+}
+
+void ContainerLogsJob::setShowStderr(bool showStderr)
+{
+    Q_D(ContainerLogsJob);
+    if (d->showStderr != showStderr) {
+        qCDebug(schCore) << "Changing \"showStderr\" from" << d->showStderr << "to" << showStderr;
+        d->showStderr = showStderr;
+        Q_EMIT showStderrChanged(this->showStderr());
+    }
+}
+
+bool ContainerLogsJob::tty() const
+{
+    Q_D(const ContainerLogsJob);
+    return d->tty;
+}
+
+void ContainerLogsJob::setTty(bool tty)
+{
+    Q_D(ContainerLogsJob);
+    if (d->tty != tty) {
+        qCDebug(schCore) << "Changing \"tty\" from" << d->tty << "to" << tty;
+        d->tty = tty;
+        d->demuxer.setMode(tty ? StreamDemuxer::Raw : StreamDemuxer::Multiplexed);
+        Q_EMIT ttyChanged(this->tty());
+    }
+}
+
+int ContainerLogsJob::maxLineLength() const
+{
+    Q_D(const ContainerLogsJob);
+    return d->maxLineLength;
+}
+
+void ContainerLogsJob::setMaxLineLength(int maxLineLength)
+{
+    if (Q_UNLIKELY(maxLineLength <= 0)) {
+        qCWarning(schCore) << "Invalid maximum line length" << maxLineLength << "- has to be greater than 0";
+        return;
+    }
+
+    Q_D(ContainerLogsJob);
+    if (d->maxLineLength != maxLineLength) {
+        qCDebug(schCore) << "Changing \"maxLineLength\" from" << d->maxLineLength << "to" << maxLineLength;
+        d->maxLineLength = maxLineLength;
+        Q_EMIT maxLineLengthChanged(this->maxLineLength());
+    }
+}
+
+quint64 ContainerLogsJob::lineCount() const
+{
+    Q_D(const ContainerLogsJob);
+    return d->lineCount;
+}
+
+#include "moc_containerlogsjob.cpp"
@@ -0,0 +1,462 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_CONTAINERLOGSJOB_H
+#define SCHAUER_CONTAINERLOGSJOB_H
+
+#include "schauer_exports.h"
+#include "job.h"
+#include <QDateTime>
+
+namespace Schauer {
+
+/*!
+ * \ingroup api-jobs-containers
+ * \brief A single line of container log output reported by ContainerLogsJob.
+ *
+ * \headerfile "" <Schauer/ContainerLogsJob>
+ */
+struct LogLine
+{
+    /*!
+     * \brief Output streams a log line can belong to.
+     */
+    enum Stream : qint8 {
+        Stdout = 1, /**< The line has been written to \a stdout. */
+        Stderr = 2  /**< The line has been written to \a stderr. */
+    };
+
+    /*!
+     * \brief The text of the line without the trailing new line character.
+     */
+    QString text;
+
+    /*!
+     * \brief The time the line has been written.
+     *
+     * Only valid if ContainerLogsJob::timestamps is \c true.
+     */
+    QDateTime timestamp;
+
+    /*!
+     * \brief The stream the line has been written to.
+     */
+    Stream stream = Stdout;
+
+    /*!
+     * \brief \c true if the line has been longer than ContainerLogsJob::maxLineLength.
+     *
+     * Overlong lines are delivered in multiple parts, all parts but the last one have
+     * this set to \c true.
+     */
+    bool partial = false;
+};
+
+class ContainerLogsJobPrivate;
+
+/*!
+ * \ingroup api-jobs-containers
+ * \brief Gets the log output of a container.
+ *
+ * The log output is split into lines that are emitted via lineReceived() as soon as
+ * they arrive. The job does not collect the lines, so memory usage is bounded by
+ * \link ContainerLogsJob::maxLineLength maxLineLength\endlink per stream, regardless
+ * of how much output the container produces. replyData() will not contain the log.
+ *
+ * Use \link ContainerLogsJob::tail tail\endlink, \link ContainerLogsJob::since since\endlink
+ * and \link ContainerLogsJob::until until\endlink to let the daemon select the lines
+ * to send instead of reading the complete log. If \link ContainerLogsJob::follow follow\endlink
+ * is \c true, the job keeps the connection open and reports new lines until it is killed
+ * or the container stops.
+ *
+ * Logs of containers without a TTY are multiplexed and will be split into \a stdout
+ * and \a stderr lines. Set \link ContainerLogsJob::tty tty\endlink to \c true for
+ * containers that have been created with a TTY.
+ *
+ * Have a look at the description of the Job class to learn how to use Job
+ * classes.
+ *
+ * \par Example
+ * \code{.cpp}
+ * auto job = new ContainerLogsJob();
+ * job->setId(QStringLiteral("my-container"));
+ * job->setTail(100);
+ * job->setFollow(true);
+ * connect(job, &ContainerLogsJob::lineReceived, this, [](const Schauer::LogLine &line){
+ *     qDebug() << line.text;
+ * });
+ * job->start();
+ * \endcode
+ *
+ * \par API route
+ * /containers/{\link ContainerLogsJob::id id\endlink}/logs
+ *
+ * \par API method
+ * GET
+ *
+ * \dockerAPI{ContainerLogs}
+ *
+ * \headerfile "" <Schauer/ContainerLogsJob>
+ */
+class SCHAUER_LIBRARY ContainerLogsJob : public Job
+{
+    Q_OBJECT
+    /*!
+     * \brief ID or name of the container to get the logs for.
+     *
+     * By default this property holds an empty string. This property must be set to
+     * a valid container ID or name to execute the job.
+     *
+     * \par Access functions
+     * \li QString() id() const
+     * \li void setId(const QString &id)
+     *
+     * \par Notifier signal
+     * \li void idChanged(const QString &id)
+     */
+    Q_PROPERTY(QString id READ id WRITE setId NOTIFY idChanged)
+    /*!
+     * \brief This property holds whether to keep the connection open and report new lines.
+     *
+     * The default value is \c false.
+     *
+     * \par Access functions
+     * \li bool follow() const
+     * \li void setFollow(bool follow)
+     *
+     * \par Notifier signal
+     * \li void followChanged(bool follow)
+     */
+    Q_PROPERTY(bool follow READ follow WRITE setFollow NOTIFY followChanged)
+    /*!
+     * \brief Only return this number of lines from the end of the log.
+     *
+     * A negative value returns all lines. The default value is \c -1.
+     *
+     * \par Access functions
+     * \li int tail() const
+     * \li void setTail(int tail)
+     *
+     * \par Notifier signal
+     * \li void tailChanged(int tail)
+     */
+    Q_PROPERTY(int tail READ tail WRITE setTail NOTIFY tailChanged)
+    /*!
+     * \brief Only return lines written since this timestamp.
+     *
+     * By default this property holds an invalid QDateTime and the log is returned
+     * from the beginning.
+     *
+     * \par Access functions
+     * \li QDateTime since() const
+     * \li void setSince(const QDateTime &since)
+     *
+     * \par Notifier signal
+     * \li void sinceChanged(const QDateTime &since)
+     */
+    Q_PROPERTY(QDateTime since READ since WRITE setSince NOTIFY sinceChanged)
+    /*!
+     * \brief Only return lines written before this timestamp.
+     *
+     * By default this property holds an invalid QDateTime and the log is returned
+     * up to the end.
+     *
+     * \par Access functions
+     * \li QDateTime until() const
+     * \li void setUntil(const QDateTime &until)
+     *
+     * \par Notifier signal
+     * \li void untilChanged(const QDateTime &until)
+     */
+    Q_PROPERTY(QDateTime until READ until WRITE setUntil NOTIFY untilChanged)
+    /*!
+     * \brief This property holds whether to request the time every line has been written.
+     *
+     * If \c true, LogLine::timestamp will contain the time the line has been written.
+     * The default value is \c false.
+     *
+     * \par Access functions
+     * \li bool timestamps() const
+     * \li void setTimestamps(bool timestamps)
+     *
+     * \par Notifier signal
+     * \li void timestampsChanged(bool timestamps)
+     */
+    Q_PROPERTY(bool timestamps READ timestamps WRITE setTimestamps NOTIFY timestampsChanged)
+    /*!
+     * \brief This property holds whether to return lines written to \a stdout.
+     *
+     * The default value is \c true.
+     *
+     * \par Access functions
+     * \li bool showStdout() const
+     * \li void setShowStdout(bool showStdout)
+     *
+     * \par Notifier signal
+     * \li void showStdoutChanged(bool showStdout)
+     */
+    Q_PROPERTY(bool showStdout READ showStdout WRITE setShowStdout NOTIFY showStdoutChanged)
+    /*!
+     * \brief This property holds whether to return lines written to \a stderr.
+     *
+     * The default value is \c true.
+     *
+     * \par Access functions
+     * \li bool showStderr() const
+     * \li void setShowStderr(bool showStderr)
+     *
+     * \par Notifier signal
+     * \li void showStderrChanged(bool showStderr)
+     */
+    Q_PROPERTY(bool showStderr READ showStderr WRITE setShowStderr NOTIFY showStderrChanged)
+    /*!
+     * \brief This property holds whether the container has been created with a TTY.
+     *
+     * The log of containers with a TTY is not multiplexed, all lines will be reported
+     * as LogLine::Stdout. The default value is \c false.
+     *
+     * \par Access functions
+     * \li bool tty() const
+     * \li void setTty(bool tty)
+     *
+     * \par Notifier signal
+     * \li void ttyChanged(bool tty)
+     */
+    Q_PROPERTY(bool tty READ tty WRITE setTty NOTIFY ttyChanged)
+    /*!
+     * \brief Maximum number of bytes buffered for a single line.
+     *
+     * Lines that are longer will be reported in multiple parts, see LogLine::partial.
+     * The value has to be greater than \c 0. The default value is \c 65536.
+     *
+     * \par Access functions
+     * \li int maxLineLength() const
+     * \li void setMaxLineLength(int maxLineLength)
+     *
+     * \par Notifier signal
+     * \li void maxLineLengthChanged(int maxLineLength)
+     */
+    Q_PROPERTY(int maxLineLength READ maxLineLength WRITE setMaxLineLength NOTIFY maxLineLengthChanged)
+public:
+    /*!
+     * \brief Constructs a new %ContainerLogsJob object with the given \a parent.
+     */
+    explicit ContainerLogsJob(QObject *parent = nullptr);
+
+    /*!
+     * \brief Destroys the %ContainerLogsJob object.
+     */
+    ~ContainerLogsJob() override;
+
+    /*!
+     * \brief Starts requesting the logs asynchronously.
+     *
+     * If \link ContainerLogsJob::follow follow\endlink is \c false, result() is
+     * emitted after all selected lines have been received. Otherwise the job runs
+     * until it is killed, fails or the daemon closes the stream.
+     */
+    void start() override;
+
+    /*!
+     * \brief Getter function for the \link ContainerLogsJob::id id\endlink property.
+     * \sa setId(), idChanged()
+     */
+    QString id() const;
+
+    /*!
+     * \brief Setter function for the \link ContainerLogsJob::id id\endlink property.
+     * \sa id(), idChanged()
+     */
+    void setId(const QString &id);
+
+    /*!
+     * \brief Getter function for the \link ContainerLogsJob::follow follow\endlink property.
+     * \sa setFollow(), followChanged()
+     */
+    bool follow() const;
+
+    /*!
+     * \brief Setter function for the \link ContainerLogsJob::follow follow\endlink property.
+     * \sa follow(), followChanged()
+     */
+    void setFollow(bool follow);
+
+    /*!
+     * \brief Getter function for the \link ContainerLogsJob::tail tail\endlink property.
+     * \sa setTail(), tailChanged()
+     */
+    int tail() const;
+
+    /*!
+     * \brief Setter function for the \link ContainerLogsJob::tail tail\endlink property.
+     * \sa tail(), tailChanged()
+     */
+    void setTail(int tail);
+
+    /*!
+     * \brief Getter function for the \link ContainerLogsJob::since since\endlink property.
+     * \sa setSince(), sinceChanged()
+     */
+    QDateTime since() const;
+
+    /*!
+     * \brief Setter function for the \link ContainerLogsJob::since since\endlink property.
+     * \sa since(), sinceChanged()
+     */
+    void setSince(const QDateTime &since);
+
+    /*!
+     * \brief Getter function for the \link ContainerLogsJob::until until\endlink property.
+     * \sa setUntil(), untilChanged()
+     */
+    QDateTime until() const;
+
+    /*!
+     * \brief Setter function for the \link ContainerLogsJob::until until\endlink property.
+     * \sa until(), untilChanged()
+     */
+    void setUntil(const QDateTime &until);
+
+    /*!
+     * \brief Getter function for the \link ContainerLogsJob::timestamps timestamps\endlink property.
+     * \sa setTimestamps(), timestampsChanged()
+     */
+    bool timestamps() const;
+
+    /*!
+     * \brief Setter function for the \link ContainerLogsJob::timestamps timestamps\endlink property.
+     * \sa timestamps(), timestampsChanged()
+     */
+    void setTimestamps(bool timestamps);
+
+    /*!
+     * \brief Getter function for the \link ContainerLogsJob::showStdout showStdout\endlink property.
+     * \sa setShowStdout(), showStdoutChanged()
+     */
+    bool showStdout() const;
+
+    /*!
+     * \brief Setter function for the \link ContainerLogsJob::showStdout showStdout\endlink property.
+     * \sa showStdout(), showStdoutChanged()
+     */
+    void setShowStdout(bool showStdout);
+
+    /*!
+     * \brief Getter function for the \link ContainerLogsJob::showStderr showStderr\endlink property.
+     * \sa setShowStderr(), showStderrChanged()
+     */
+    bool showStderr() const;
+
+    /*!
+     * \brief Setter function for the \link ContainerLogsJob::showStderr showStderr\endlink property.
+     * \sa showStderr(), showStderrChanged()
+     */
+    void setShowStderr(bool showStderr);
+
+    /*!
+     * \brief Getter function for the \link ContainerLogsJob::tty tty\endlink property.
+     * \sa setTty(), ttyChanged()
+     */
+    bool tty() const;
+
+    /*!
+     * \brief Setter function for the \link ContainerLogsJob::tty tty\endlink property.
+     * \sa tty(), ttyChanged()
+     */
+    void setTty(bool tty);
+
+    /*!
+     * \brief Getter function for the \link ContainerLogsJob::maxLineLength maxLineLength\endlink property.
+     * \sa setMaxLineLength(), maxLineLengthChanged()
+     */
+    int maxLineLength() const;
+
+    /*!
+     * \brief Setter function for the \link ContainerLogsJob::maxLineLength maxLineLength\endlink property.
+     * \sa maxLineLength(), maxLineLengthChanged()
+     */
+    void setMaxLineLength(int maxLineLength);
+
+    /*!
+     * \brief Returns the number of lines received since the job has been started.
+     */
+    quint64 lineCount() const;
+
+Q_SIGNALS:
+    /*!
+     * \brief Notifier signal for the \link ContainerLogsJob::id id\endlink property.
+     * \sa id(), setId()
+     */
+    void idChanged(const QString &id);
+
+    /*!
+     * \brief Notifier signal for the \link ContainerLogsJob::follow follow\endlink property.
+     * \sa follow(), setFollow()
+     */
+    void followChanged(bool follow);
+
+    /*!
+     * \brief Notifier signal for the \link ContainerLogsJob::tail tail\endlink property.
+     * \sa tail(), setTail()
+     */
+    void tailChanged(int tail);
+
+    /*!
+     * \brief Notifier signal for the \link ContainerLogsJob::since since\endlink property.
+     * \sa since(), setSince()
+     */
+    void sinceChanged(const QDateTime &since);
+
+    /*!
+     * \brief Notifier signal for the \link ContainerLogsJob::until until\endlink property.
+     * \sa until(), setUntil()
+     */
+    void untilChanged(const QDateTime &until);
+
+    /*!
+     * \brief Notifier signal for the \link ContainerLogsJob::timestamps timestamps\endlink property.
+     * \sa timestamps(), setTimestamps()
+     */
+    void timestampsChanged(bool timestamps);
+
+    /*!
+     * \brief Notifier signal for the \link ContainerLogsJob::showStdout showStdout\endlink property.
+     * \sa showStdout(), setShowStdout()
+     */
+    void showStdoutChanged(bool showStdout);
+
+    /*!
+     * \brief Notifier signal for the \link ContainerLogsJob::showStderr showStderr\endlink property.
+     * \sa showStderr(), setShowStderr()
+     */
+    void showStderrChanged(bool showStderr);
+
+    /*!
+     * \brief Notifier signal for the \link ContainerLogsJob::tty tty\endlink property.
+     * \sa tty(), setTty()
+     */
+    void ttyChanged(bool tty);
+
+    /*!
+     * \brief Notifier signal for the \link ContainerLogsJob::maxLineLength maxLineLength\endlink property.
+     * \sa maxLineLength(), setMaxLineLength()
+     */
+    void maxLineLengthChanged(int maxLineLength);
+
+    /*!
+     * \brief Emitted for every \a line of log output as soon as it has been received.
+     */
+    void lineReceived(const Schauer::LogLine &line);
+
+private:
+    Q_DECLARE_PRIVATE_D(s_ptr, ContainerLogsJob)
+    Q_DISABLE_COPY(ContainerLogsJob)
+};
+
+}
+
+Q_DECLARE_METATYPE(Schauer::LogLine)
+
+#endif // SCHAUER_CONTAINERLOGSJOB_H
@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_CONTAINERLOGSJOB_P_H
+#define SCHAUER_CONTAINERLOGSJOB_P_H
+
+#include "containerlogsjob.h"
+#include "job_p.h"
+#include "streamdemuxer.h"
+
+namespace Schauer {
+
+class ContainerLogsJobPrivate : public JobPrivate
+{
+public:
+    struct LineBuffer {
+        QByteArray data;
+        QDateTime timestamp;
+        bool continued = false;
+    };
+
+    explicit ContainerLogsJobPrivate(ContainerLogsJob *q);
+
+    ~ContainerLogsJobPrivate() override;
+
+    QString buildUrlPath() const override;
+
+    QUrlQuery buildUrlQuery() const override;
+
+    void emitDescription() override;
+
+    bool checkInput() override;
+
+    bool checkOutput(const QByteArray &data) override;
+
+    void processStreamData(const QByteArray &data) override;
+
+    void processOutput(LogLine::Stream stream, const QByteArray &data);
+
+    void processLine(LogLine::Stream stream, LineBuffer &buffer, const char *data, int size, bool partial);
+
+    void resetBuffers();
+
+    StreamDemuxer demuxer;
+    LineBuffer buffers[2];
+    QString id;
+    QDateTime since;
+    QDateTime until;
+    quint64 lineCount = 0;
+    int tail = -1;
+    int maxLineLength = 65536;
+    bool follow = false;
+    bool timestamps = false;
+    bool showStdout = true;
+    bool showStderr = true;
+    bool tty = false;
+
+private:
+    Q_DISABLE_COPY(ContainerLogsJobPrivate)
+    Q_DECLARE_PUBLIC(ContainerLogsJob)
+};
+
+}
+
+#endif // SCHAUER_CONTAINERLOGSJOB_P_H
@@ -0,0 +1,361 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "containerpool_p.h"
+#include "createandstartcontainerjob.h"
+#include "removecontainerjob.h"
+#include "logging.h"
+#include "jsonwriter.h"
+#include <QEventLoop>
+#include <QTimer>
+
+using namespace Schauer;
+
+ContainerPoolPrivate::ContainerPoolPrivate(ContainerPool *q)
+    : q_ptr(q)
+{
+
+}
+
+ContainerPoolPrivate::~ContainerPoolPrivate() = default;
+
+void ContainerPoolPrivate::refill()
+{
+    if (!active || refillPaused) {
+        return;
+    }
+
+    if (!containerConfig.contains(QStringLiteral("Image"))) {
+        qCWarning(schCore) << "Can not fill the container pool without an image in the container configuration";
+        return;
+    }
+
+    Q_Q(ContainerPool);
+
+    while (ready.size() + starting.size() < size && (maxConcurrentStarts <= 0 || starting.size() < maxConcurrentStarts)) {
+        auto job = new CreateAndStartContainerJob(q);
+        job->setConfiguration(configuration);
+        job->setContainerConfig(containerConfig);
+        job->setSerializedConfig(serializedConfig);
+        job->setWaitUntilRunning(true);
+
+        const quint32 jobGeneration = generation;
+        QObject::connect(job, &SJob::result, q, [this, job, jobGeneration](){
+            Q_Q(ContainerPool);
+            starting.remove(job);
+
+            const QString id = job->containerId();
+
+            if (job->error() != SJob::NoError) {
+                // the job removes the container if it has been created
+                qCWarning(schCore) << "Failed to create and start a container for the pool:" << job->errorString();
+                refillPaused = true;
+                Q_EMIT q->failed(job->error(), job->errorString());
+                return;
+            }
+
+            if (jobGeneration != generation || !active || ready.size() >= size) {
+                qCDebug(schCore) << "Container" << id << "is not needed by the pool anymore";
+                removeContainer(id);
+                refill();
+                return;
+            }
+
+            addReady(id);
+            refill();
+        });
+
+        starting.insert(job);
+        job->start();
+    }
+}
+
+void ContainerPoolPrivate::addReady(const QString &id)
+{
+    Q_Q(ContainerPool);
+
+    if (pendingLeases > 0) {
+        pendingLeases--;
+        leased.insert(id);
+        qCDebug(schCore) << "Leased container" << id << "from the pool to a pending request";
+        Q_EMIT q->leased(id);
+        return;
+    }
+
+    qCDebug(schCore) << "Container" << id << "is ready in the pool";
+    ready.append(id);
+    Q_EMIT q->readyCountChanged(ready.size());
+    Q_EMIT q->containerReady(id);
+}
+
+void ContainerPoolPrivate::removeContainer(const QString &id)
+{
+    removeContainer(configuration, id);
+}
+
+void ContainerPoolPrivate::removeContainer(AbstractConfiguration *configuration, const QString &id)
+{
+    auto job = new RemoveContainerJob();
+    job->setConfiguration(configuration);
+    job->setId(id);
+    job->setForce(true);
+    job->setRemoveAnonVolumes(true);
+    job->start();
+}
+
+void ContainerPoolPrivate::removeReady()
+{
+    if (ready.empty()) {
+        return;
+    }
+
+    const QStringList ids = std::move(ready);
+    ready.clear();
+    for (const QString &id : ids) {
+        removeContainer(id);
+    }
+
+    Q_Q(ContainerPool);
+    Q_EMIT q->readyCountChanged(0);
+}
+
+ContainerPool::ContainerPool(QObject *parent)
+    : QObject(parent), s_ptr(new ContainerPoolPrivate(this))
+{
+
+}
+
+ContainerPool::~ContainerPool()
+{
+    Q_D(ContainerPool);
+    d->active = false;
+    d->pendingLeases = 0;
+    const QStringList ids = std::move(d->ready);
+    d->ready.clear();
+    for (const QString &id : ids) {
+        d->removeContainer(id);
+    }
+
+    // the jobs would be deleted together with the pool, leaving their containers behind,
+    // so they finish on their own and the containers they started are removed
+    const QSet<CreateAndStartContainerJob *> jobs = std::move(d->starting);
+    d->starting.clear();
+    for (CreateAndStartContainerJob *job : jobs) {
+        disconnect(job, nullptr, this, nullptr);
+        job->setParent(nullptr);
+        connect(job, &SJob::result, [job](){
+            // failed jobs remove their containers themselves
+            if (job->error() == SJob::NoError) {
+                qCDebug(schCore) << "Removing container" << job->containerId() << "started for a destroyed pool";
+                ContainerPoolPrivate::removeContainer(job->configuration(), job->containerId());
+            }
+        });
+    }
+}
+
+AbstractConfiguration *ContainerPool::configuration() const
+{
+    Q_D(const ContainerPool);
+    return d->configuration;
+}
+
+void ContainerPool::setConfiguration(AbstractConfiguration *configuration)
+{
+    Q_D(ContainerPool);
+    if (configuration != d->configuration) {
+        qCDebug(schCore) << "Changing configuration from" << d->configuration.data() << "to" << configuration;
+        d->removeReady();
+        d->generation++;
+        d->configuration = configuration;
+        Q_EMIT configurationChanged(d->configuration);
+        d->refill();
+    }
+}
+
+QVariantHash ContainerPool::containerConfig() const
+{
+    Q_D(const ContainerPool);
+    return d->containerConfig;
+}
+
+void ContainerPool::setContainerConfig(const QVariantHash &containerConfig)
+{
+    Q_D(ContainerPool);
+    if (d->containerConfig != containerConfig) {
+        qCDebug(schCore) << "Changing \"containerConfig\" from" << d->containerConfig << "to" << containerConfig;
+        d->removeReady();
+        d->generation++;
+        d->containerConfig = containerConfig;
+        d->serializedConfig.clear();
+        JsonWriter w(d->serializedConfig);
+        w.value(QVariant(d->containerConfig));
+        Q_EMIT containerConfigChanged(d->containerConfig);
+        d->refill();
+    }
+}
+
+int ContainerPool::size() const
+{
+    Q_D(const ContainerPool);
+    return d->size;
+}
+
+void ContainerPool::setSize(int size)
+{
+    Q_D(ContainerPool);
+    if (d->size != size) {
+        qCDebug(schCore) << "Changing \"size\" from" << d->size << "to" << size;
+        d->size = size;
+        Q_EMIT sizeChanged(d->size);
+
+        if (d->ready.size() > d->size) {
+            while (d->ready.size() > qMax(d->size, 0)) {
+                d->removeContainer(d->ready.takeLast());
+            }
+            Q_EMIT readyCountChanged(d->ready.size());
+        } else {
+            d->refill();
+        }
+    }
+}
+
+int ContainerPool::maxConcurrentStarts() const
+{
+    Q_D(const ContainerPool);
+    return d->maxConcurrentStarts;
+}
+
+void ContainerPool::setMaxConcurrentStarts(int maxConcurrentStarts)
+{
+    Q_D(ContainerPool);
+    if (d->maxConcurrentStarts != maxConcurrentStarts) {
+        qCDebug(schCore) << "Changing \"maxConcurrentStarts\" from" << d->maxConcurrentStarts << "to" << maxConcurrentStarts;
+        d->maxConcurrentStarts = maxConcurrentStarts;
+        Q_EMIT maxConcurrentStartsChanged(d->maxConcurrentStarts);
+        d->refill();
+    }
+}
+
+int ContainerPool::readyCount() const
+{
+    Q_D(const ContainerPool);
+    return d->ready.size();
+}
+
+int ContainerPool::leasedCount() const
+{
+    Q_D(const ContainerPool);
+    return d->leased.size();
+}
+
+void ContainerPool::fill()
+{
+    Q_D(ContainerPool);
+    d->active = true;
+    d->refillPaused = false;
+    d->refill();
+}
+
+QString ContainerPool::lease(int timeout)
+{
+    Q_D(ContainerPool);
+
+    d->active = true;
+    d->refillPaused = false;
+
+    if (d->ready.empty() && timeout > 0) {
+        d->refill();
+
+        QPointer<ContainerPool> guard(this);
+        QEventLoop loop;
+        QTimer timer;
+        timer.setSingleShot(true);
+        connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+        connect(this, &ContainerPool::containerReady, &loop, &QEventLoop::quit);
+        connect(this, &ContainerPool::failed, &loop, &QEventLoop::quit);
+        connect(this, &QObject::destroyed, &loop, &QEventLoop::quit);
+        timer.start(timeout);
+        loop.exec(QEventLoop::ExcludeUserInputEvents);
+
+        if (!guard) {
+            qCWarning(schCore) << "The container pool has been destroyed while waiting for a container";
+            return QString();
+        }
+    }
+
+    if (d->ready.empty()) {
+        qCDebug(schCore) << "No container ready in the pool";
+        d->refill();
+        return QString();
+    }
+
+    const QString id = d->ready.takeFirst();
+    d->leased.insert(id);
+    qCDebug(schCore) << "Leased container" << id << "from the pool";
+    Q_EMIT readyCountChanged(d->ready.size());
+    d->refill();
+
+    return id;
+}
+
+void ContainerPool::requestLease()
+{
+    Q_D(ContainerPool);
+
+    d->active = true;
+    d->refillPaused = false;
+
+    if (d->ready.empty()) {
+        d->pendingLeases++;
+        qCDebug(schCore) << "No container ready in the pool, waiting for the next one," << d->pendingLeases << "lease requests pending";
+        d->refill();
+        return;
+    }
+
+    const QString id = d->ready.takeFirst();
+    d->leased.insert(id);
+    qCDebug(schCore) << "Leased container" << id << "from the pool";
+    Q_EMIT readyCountChanged(d->ready.size());
+    Q_EMIT leased(id);
+    d->refill();
+}
+
+int ContainerPool::pendingLeases() const
+{
+    Q_D(const ContainerPool);
+    return d->pendingLeases;
+}
+
+void ContainerPool::release(const QString &id, bool reuse)
+{
+    Q_D(ContainerPool);
+
+    if (!d->leased.remove(id)) {
+        qCWarning(schCore) << "Container" << id << "has not been leased from the pool";
+        return;
+    }
+
+    d->refillPaused = false;
+
+    if (reuse && d->active && (d->pendingLeases > 0 || d->ready.size() < d->size)) {
+        qCDebug(schCore) << "Putting container" << id << "back into the pool";
+        d->addReady(id);
+    } else {
+        qCDebug(schCore) << "Removing released container" << id;
+        d->removeContainer(id);
+        d->refill();
+    }
+}
+
+void ContainerPool::drain()
+{
+    Q_D(ContainerPool);
+    qCDebug(schCore) << "Draining the container pool";
+    d->active = false;
+    d->pendingLeases = 0;
+    d->removeReady();
+}
+
+#include "moc_containerpool.cpp"
@@ -0,0 +1,324 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_CONTAINERPOOL_H
+#define SCHAUER_CONTAINERPOOL_H
+
+#include "schauer_exports.h"
+#include "abstractconfiguration.h"
+#include <QObject>
+#include <QVariantHash>
+#include <memory>
+
+namespace Schauer {
+
+class ContainerPoolPrivate;
+
+/*!
+ * \ingroup api-jobs-containers
+ * \brief Keeps a number of created and started containers ready to be leased.
+ *
+ * Creating and starting a container takes some time. The pool creates and starts
+ * up to \link ContainerPool::size size\endlink containers from the
+ * \link ContainerPool::containerConfig containerConfig\endlink template in the
+ * background, so that requestLease() and lease() can return a running container
+ * immediately. Leased containers are given back via release() and the pool refills itself
+ * asynchronously. At most \link ContainerPool::maxConcurrentStarts maxConcurrentStarts\endlink
+ * containers are created and started at the same time.
+ *
+ * Released containers are removed by default and replaced by fresh ones, as their
+ * state might have been changed while they were leased. Use \a reuse in release()
+ * to put a container back into the pool directly.
+ *
+ * If creating or starting a container fails, failed() is emitted and refilling is
+ * paused until fill(), lease() or release() is called the next time.
+ *
+ * Containers waiting in the pool and containers that are still being started are
+ * removed when the pool is drained or destroyed, as long as the event loop keeps
+ * running.
+ *
+ * \par Example
+ * \code{.cpp}
+ * auto pool = new ContainerPool(this);
+ * pool->setContainerConfig({{QStringLiteral("Image"), QStringLiteral("nginx")}});
+ * pool->setSize(4);
+ * pool->fill();
+ *
+ * // later
+ * connect(pool, &ContainerPool::leased, this, [pool](const QString &id){
+ *     // … use the container …
+ *     pool->release(id);
+ * });
+ * pool->requestLease();
+ * \endcode
+ *
+ * \sa CreateAndStartContainerJob
+ *
+ * \headerfile "" <Schauer/ContainerPool>
+ */
+class SCHAUER_LIBRARY ContainerPool : public QObject
+{
+    Q_OBJECT
+    /*!
+     * \brief Pointer to an object providing configuration data.
+     *
+     * If this is a \c nullptr, the global default configuration will be used.
+     *
+     * \par Access functions
+     * \li AbstractConfiguration *configuration() const
+     * \li void setConfiguration(AbstractCofiguration *configuration)
+     *
+     * \par Notifier signal
+     * \li void configurationChanged(AbstractConfiguration *configuration)
+     */
+    Q_PROPERTY(Schauer::AbstractConfiguration *configuration READ configuration WRITE setConfiguration NOTIFY configurationChanged)
+    /*!
+     * \brief Configuration template for the containers in the pool.
+     *
+     * At least the \a Image key must have a valid value. Changing the template
+     * removes all containers waiting in the pool. The template is serialized once when
+     * it is set and the payload is shared by all create requests of the pool. See
+     * CreateContainerJob::containerConfig.
+     *
+     * \par Access functions
+     * \li QVariantHash containerConfig() const
+     * \li void setContainerConfig(const QVariantHash &containerConfig)
+     *
+     * \par Notifier signal
+     * \li void containerConfigChanged(const QVariantHash &containerConfig)
+     */
+    Q_PROPERTY(QVariantHash containerConfig READ containerConfig WRITE setContainerConfig NOTIFY containerConfigChanged)
+    /*!
+     * \brief Number of containers to keep ready in the pool.
+     *
+     * The default value is \c 2.
+     *
+     * \par Access functions
+     * \li int size() const
+     * \li void setSize(int size)
+     *
+     * \par Notifier signal
+     * \li void sizeChanged(int size)
+     */
+    Q_PROPERTY(int size READ size WRITE setSize NOTIFY sizeChanged)
+    /*!
+     * \brief Maximum number of containers created and started at the same time.
+     *
+     * The default value is \c 2.
+     *
+     * \par Access functions
+     * \li int maxConcurrentStarts() const
+     * \li void setMaxConcurrentStarts(int maxConcurrentStarts)
+     *
+     * \par Notifier signal
+     * \li void maxConcurrentStartsChanged(int maxConcurrentStarts)
+     */
+    Q_PROPERTY(int maxConcurrentStarts READ maxConcurrentStarts WRITE setMaxConcurrentStarts NOTIFY maxConcurrentStartsChanged)
+    /*!
+     * \brief Number of running containers waiting in the pool to be leased.
+     *
+     * \par Access functions
+     * \li int readyCount() const
+     *
+     * \par Notifier signal
+     * \li void readyCountChanged(int readyCount)
+     */
+    Q_PROPERTY(int readyCount READ readyCount NOTIFY readyCountChanged)
+public:
+    /*!
+     * \brief Constructs a new %ContainerPool object with the given \a parent.
+     */
+    explicit ContainerPool(QObject *parent = nullptr);
+
+    /*!
+     * \brief Destroys the %ContainerPool object.
+     *
+     * Containers waiting in the pool will be removed if the event loop keeps running.
+     * Containers that are still being created and started are removed as soon as they
+     * have been started. Leased containers are not touched.
+     */
+    ~ContainerPool() override;
+
+    /*!
+     * \brief Getter function for the \link ContainerPool::configuration configuration\endlink property.
+     * \sa setConfiguration(), configurationChanged()
+     */
+    AbstractConfiguration *configuration() const;
+
+    /*!
+     * \brief Setter function for the \link ContainerPool::configuration configuration\endlink property.
+     * \sa configuration(), configurationChanged()
+     */
+    void setConfiguration(AbstractConfiguration *configuration);
+
+    /*!
+     * \brief Getter function for the \link ContainerPool::containerConfig containerConfig\endlink property.
+     * \sa setContainerConfig(), containerConfigChanged()
+     */
+    QVariantHash containerConfig() const;
+
+    /*!
+     * \brief Setter function for the \link ContainerPool::containerConfig containerConfig\endlink property.
+     * \sa containerConfig(), containerConfigChanged()
+     */
+    void setContainerConfig(const QVariantHash &containerConfig);
+
+    /*!
+     * \brief Getter function for the \link ContainerPool::size size\endlink property.
+     * \sa setSize(), sizeChanged()
+     */
+    int size() const;
+
+    /*!
+     * \brief Setter function for the \link ContainerPool::size size\endlink property.
+     * \sa size(), sizeChanged()
+     */
+    void setSize(int size);
+
+    /*!
+     * \brief Getter function for the \link ContainerPool::maxConcurrentStarts maxConcurrentStarts\endlink property.
+     * \sa setMaxConcurrentStarts(), maxConcurrentStartsChanged()
+     */
+    int maxConcurrentStarts() const;
+
+    /*!
+     * \brief Setter function for the \link ContainerPool::maxConcurrentStarts maxConcurrentStarts\endlink property.
+     * \sa maxConcurrentStarts(), maxConcurrentStartsChanged()
+     */
+    void setMaxConcurrentStarts(int maxConcurrentStarts);
+
+    /*!
+     * \brief Getter function for the \link ContainerPool::readyCount readyCount\endlink property.
+     * \sa readyCountChanged()
+     */
+    int readyCount() const;
+
+    /*!
+     * \brief Returns the number of containers currently leased from the pool.
+     */
+    int leasedCount() const;
+
+    /*!
+     * \brief Starts filling the pool in the background.
+     */
+    void fill();
+
+    /*!
+     * \brief Leases a running container from the pool asynchronously.
+     *
+     * If a container is ready, leased() is emitted directly from within this function.
+     * Otherwise the request waits for the next container that becomes ready and
+     * leased() is emitted then. Every call results in one emission of leased(), unless
+     * drain() is called or the pool is destroyed before. If starting a container fails,
+     * the request stays pending until a container is available again.
+     *
+     * \sa pendingLeases(), lease(), release()
+     */
+    void requestLease();
+
+    /*!
+     * \brief Returns the number of requestLease() calls still waiting for a container.
+     */
+    int pendingLeases() const;
+
+    /*!
+     * \brief Leases a running container from the pool and returns its ID.
+     *
+     * If no container is ready and \a timeout is greater than \c 0, this waits up
+     * to \a timeout milliseconds for a container to become ready, processing events
+     * in the meantime. Returns an empty string if no container is available or if
+     * the pool has been destroyed while waiting.
+     *
+     * \warning Waiting runs a nested event loop. Slots of any object can be invoked
+     * before this function returns, including slots that delete the caller or this
+     * pool. Only use a timeout in code that is prepared for this, like tests, and
+     * prefer requestLease() everywhere else.
+     *
+     * \sa requestLease(), release()
+     */
+    QString lease(int timeout = 0);
+
+    /*!
+     * \brief Gives the leased container with the given \a id back to the pool.
+     *
+     * If \a reuse is \c false, the container is removed and the pool creates a fresh
+     * one. If \a reuse is \c true, the container is put back into the pool as it is,
+     * or handed directly to a pending requestLease().
+     *
+     * \sa lease()
+     */
+    void release(const QString &id, bool reuse = false);
+
+    /*!
+     * \brief Stops refilling and removes all containers waiting in the pool.
+     *
+     * Pending requestLease() calls are dropped. Containers that are still being
+     * started are removed as soon as they have been started. Leased containers
+     * are not touched. Call fill(), requestLease() or lease() to start refilling again.
+     */
+    void drain();
+
+Q_SIGNALS:
+    /*!
+     * \brief Notifier signal for the \link ContainerPool::configuration configuration\endlink property.
+     * \sa configuration(), setConfiguration()
+     */
+    void configurationChanged(Schauer::AbstractConfiguration *configuration);
+
+    /*!
+     * \brief Notifier signal for the \link ContainerPool::containerConfig containerConfig\endlink property.
+     * \sa containerConfig(), setContainerConfig()
+     */
+    void containerConfigChanged(const QVariantHash &containerConfig);
+
+    /*!
+     * \brief Notifier signal for the \link ContainerPool::size size\endlink property.
+     * \sa size(), setSize()
+     */
+    void sizeChanged(int size);
+
+    /*!
+     * \brief Notifier signal for the \link ContainerPool::maxConcurrentStarts maxConcurrentStarts\endlink property.
+     * \sa maxConcurrentStarts(), setMaxConcurrentStarts()
+     */
+    void maxConcurrentStartsChanged(int maxConcurrentStarts);
+
+    /*!
+     * \brief Notifier signal for the \link ContainerPool::readyCount readyCount\endlink property.
+     * \sa readyCount()
+     */
+    void readyCountChanged(int readyCount);
+
+    /*!
+     * \brief Emitted when the container with the given \a id is ready to be leased.
+     */
+    void containerReady(const QString &id);
+
+    /*!
+     * \brief Emitted when the container with the given \a id has been leased by requestLease().
+     *
+     * The container has to be given back via release().
+     */
+    void leased(const QString &id);
+
+    /*!
+     * \brief Emitted when creating or starting a container for the pool failed.
+     *
+     * \a error contains the error code and \a errorString a human-readable
+     * description of the error. Refilling is paused afterwards.
+     */
+    void failed(int error, const QString &errorString);
+
+protected:
+    const std::unique_ptr<ContainerPoolPrivate> s_ptr;
+
+private:
+    Q_DECLARE_PRIVATE_D(s_ptr, ContainerPool)
+    Q_DISABLE_COPY(ContainerPool)
+};
+
+}
+
+#endif // SCHAUER_CONTAINERPOOL_H
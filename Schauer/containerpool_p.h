@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_CONTAINERPOOL_P_H
+#define SCHAUER_CONTAINERPOOL_P_H
+
+#include "containerpool.h"
+#include <QPointer>
+#include <QSet>
+#include <QStringList>
+
+namespace Schauer {
+
+class CreateAndStartContainerJob;
+
+class ContainerPoolPrivate
+{
+public:
+    explicit ContainerPoolPrivate(ContainerPool *q);
+
+    ~ContainerPoolPrivate();
+
+    void refill();
+
+    void removeContainer(const QString &id);
+
+    void removeReady();
+
+    void addReady(const QString &id);
+
+    static void removeContainer(AbstractConfiguration *configuration, const QString &id);
+
+    QPointer<AbstractConfiguration> configuration;
+    QVariantHash containerConfig;
+    // containerConfig serialized once and shared by all create jobs
+    QByteArray serializedConfig;
+    QStringList ready;
+    QSet<QString> leased;
+    // jobs currently creating and starting a container for the pool
+    QSet<CreateAndStartContainerJob *> starting;
+    quint32 generation = 0;
+    int size = 2;
+    int maxConcurrentStarts = 2;
+    int pendingLeases = 0;
+    bool active = false;
+    bool refillPaused = false;
+
+protected:
+    ContainerPool *q_ptr = nullptr;
+
+private:
+    Q_DISABLE_COPY(ContainerPoolPrivate)
+    Q_DECLARE_PUBLIC(ContainerPool)
+};
+
+}
+
+#endif // SCHAUER_CONTAINERPOOL_P_H
@@ -0,0 +1,205 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "containerstatsjob_p.h"
+#include "statsdecoder.h"
+#include "logging.h"
+#include <QTimer>
+#include <cstring>
+
+using namespace Schauer;
+
+namespace {
+// a sample is about 2 to 4 KiB, so the line buffer rarely has to grow
+constexpr int initialLineBufferSize = 8192;
+}
+
+ContainerStatsJobPrivate::ContainerStatsJobPrivate(ContainerStatsJob *q)
+    : JobPrivate(q)
+{
+    namOperation = NetworkOperation::Get;
+    expectedContentType = ExpectedContentType::Stream;
+    requiresAuth = false;
+    // the stats stream is open for an unlimited time
+    requestTimeout = 0;
+    lineBuffer.reserve(initialLineBufferSize);
+}
+
+ContainerStatsJobPrivate::~ContainerStatsJobPrivate() = default;
+
+QString ContainerStatsJobPrivate::buildUrlPath() const
+{
+    const QString _id = id.startsWith(QLatin1Char('/')) ? id.mid(1) : id;
+    const QString path = JobPrivate::buildUrlPath() + QLatin1String("/containers/") + _id + QLatin1String("/stats");
+    return path;
+}
+
+QUrlQuery ContainerStatsJobPrivate::buildUrlQuery() const
+{
+    QUrlQuery uq = JobPrivate::buildUrlQuery();
+    uq.addQueryItem(QStringLiteral("stream"), stream ? QStringLiteral("true") : QStringLiteral("false"));
+    return uq;
+}
+
+void ContainerStatsJobPrivate::emitDescription()
+{
+    Q_Q(ContainerStatsJob);
+
+    //: Job description title
+    //% "Getting resource usage of container with ID %1"
+    const QString _title = qtTrId("libschauer-job-desc-container-stats-title").arg(id);
+
+    Q_EMIT q->description(q, _title);
+}
+
+bool ContainerStatsJobPrivate::checkInput()
+{
+    if (!JobPrivate::checkInput()) {
+        return false;
+    }
+
+    if (id.isEmpty()) {
+        //: Error message if container id is missing when trying to get container stats
+        //% "Can not get resource usage statistics without a valid container ID."
+        emitError(InvalidInput, qtTrId("libschauer-error-container-stats-missing-id"));
+        qCCritical(schCore) << "Missing container ID when trying to get container stats";
+        return false;
+    }
+
+    return true;
+}
+
+void ContainerStatsJobPrivate::processStreamData(const QByteArray &data)
+{
+    const char *d = data.constData();
+    const int size = data.size();
+    int start = 0;
+
+    while (start < size) {
+        const char *newLine = static_cast<const char *>(std::memchr(d + start, '\n', static_cast<size_t>(size - start)));
+        if (!newLine) {
+            break;
+        }
+        const int end = static_cast<int>(newLine - d);
+        if (lineBuffer.isEmpty()) {
+            // complete sample in the received data, decode it in place
+            processSample(d + start, end - start);
+        } else {
+            lineBuffer.append(d + start, end - start);
+            processSample(lineBuffer.constData(), lineBuffer.size());
+            // truncate keeps the reserved capacity for the next sample
+            lineBuffer.truncate(0);
+        }
+        start = end + 1;
+    }
+
+    if (start < size) {
+        lineBuffer.append(d + start, size - start);
+    }
+}
+
+void ContainerStatsJobPrivate::processSample(const char *data, int size)
+{
+    while (size > 0 && (data[size - 1] == '\r' || data[size - 1] == ' ')) {
+        --size;
+    }
+    if (size == 0) {
+        return;
+    }
+
+    ContainerStats sample;
+    StatsDecoder decoder(data, size);
+    if (Q_UNLIKELY(!decoder.decode(sample))) {
+        qCWarning(schCore) << "Skipping invalid stats data:" << QByteArray::fromRawData(data, size);
+        return;
+    }
+
+    stats = sample;
+    sampleReceived = true;
+
+    Q_Q(ContainerStatsJob);
+    Q_EMIT q->statsReceived(stats);
+}
+
+bool ContainerStatsJobPrivate::checkOutput(const QByteArray &data)
+{
+    if (!lineBuffer.isEmpty()) {
+        // the last sample might not be terminated by a new line
+        processSample(lineBuffer.constData(), lineBuffer.size());
+        lineBuffer.truncate(0);
+    }
+
+    if (!JobPrivate::checkOutput(data)) {
+        return false;
+    }
+
+    if (!stream && !sampleReceived) {
+        Q_Q(ContainerStatsJob);
+        q->setError(EmptyReply);
+        qCCritical(schCore) << "Invalid reply: stats sample expected, but reply is empty.";
+        return false;
+    }
+
+    return true;
+}
+
+ContainerStatsJob::ContainerStatsJob(QObject *parent)
+    : Job(* new ContainerStatsJobPrivate(this), parent)
+{
+
+}
+
+ContainerStatsJob::~ContainerStatsJob() = default;
+
+void ContainerStatsJob::start()
+{
+    Q_D(ContainerStatsJob);
+    d->lineBuffer.truncate(0);
+    d->stats = ContainerStats();
+    d->sampleReceived = false;
+    QTimer::singleShot(0, this, &ContainerStatsJob::sendRequest);
+}
+
+QString ContainerStatsJob::id() const
+{
+    Q_D(const ContainerStatsJob);
+    return d->id;
+}
+
+void ContainerStatsJob::setId(const QString &id)
+{
+    Q_D(ContainerStatsJob);
+    if (d->id != id) {
+        qCDebug(schCore) << "Changing \"id\" from" << d->id << "to" << id;
+        d->id = id;
+        Q_EMIT idChanged(this->id());
+    }
+}
+
+bool ContainerStatsJob::stream() const
+{
+    Q_D(const ContainerStatsJob);
+    return d->stream;
+}
+
+void ContainerStatsJob::setStream(bool stream)
+{
+    Q_D(ContainerStatsJob);
+    if (d->stream != stream) {
+        qCDebug(schCore) << "Changing \"stream\" from" << d->stream << "to" << stream;
+        d->stream = stream;
+        // only a single sample can run into the default request timeout
+        d->requestTimeout = stream ? 0 : 300;
+        Q_EMIT streamChanged(this->stream());
+    }
+}
+
+ContainerStats ContainerStatsJob::lastStats() const
+{
+    Q_D(const ContainerStatsJob);
+    return d->stats;
+}
+
+#include "moc_containerstatsjob.cpp"
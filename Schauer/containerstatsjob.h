@@ -0,0 +1,274 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_CONTAINERSTATSJOB_H
+#define SCHAUER_CONTAINERSTATSJOB_H
+
+#include "schauer_exports.h"
+#include "job.h"
+
+namespace Schauer {
+
+/*!
+ * \ingroup api-jobs-containers
+ * \brief Resource usage sample of a container.
+ *
+ * All values are taken from a single stats sample reported by the Docker daemon.
+ * Byte and packet counters are totals since the container has been started, network
+ * counters are summed up over all network interfaces of the container.
+ *
+ * \sa ContainerStatsJob
+ *
+ * \headerfile "" <Schauer/ContainerStatsJob>
+ */
+struct ContainerStats
+{
+    /*!
+     * \brief Total CPU time consumed by the container in nanoseconds.
+     */
+    quint64 cpuTotalUsage = 0;
+
+    /*!
+     * \brief Total CPU time consumed by the container in nanoseconds at the previous sample.
+     */
+    quint64 preCpuTotalUsage = 0;
+
+    /*!
+     * \brief Total CPU time of the host system in nanoseconds.
+     */
+    quint64 systemCpuUsage = 0;
+
+    /*!
+     * \brief Total CPU time of the host system in nanoseconds at the previous sample.
+     */
+    quint64 preSystemCpuUsage = 0;
+
+    /*!
+     * \brief Current memory usage of the container in bytes.
+     */
+    quint64 memoryUsage = 0;
+
+    /*!
+     * \brief Memory limit of the container in bytes.
+     */
+    quint64 memoryLimit = 0;
+
+    /*!
+     * \brief Bytes read from block devices.
+     */
+    quint64 blockRead = 0;
+
+    /*!
+     * \brief Bytes written to block devices.
+     */
+    quint64 blockWrite = 0;
+
+    /*!
+     * \brief Bytes received over the network.
+     */
+    quint64 networkRxBytes = 0;
+
+    /*!
+     * \brief Bytes sent over the network.
+     */
+    quint64 networkTxBytes = 0;
+
+    /*!
+     * \brief Packets received over the network.
+     */
+    quint64 networkRxPackets = 0;
+
+    /*!
+     * \brief Packets sent over the network.
+     */
+    quint64 networkTxPackets = 0;
+
+    /*!
+     * \brief Number of processes and threads in the container.
+     */
+    quint64 pids = 0;
+
+    /*!
+     * \brief Number of CPUs available to the container.
+     */
+    quint32 onlineCpus = 0;
+
+    /*!
+     * \brief Returns the CPU time consumed by the container since the previous sample in nanoseconds.
+     */
+    quint64 cpuDelta() const { return cpuTotalUsage > preCpuTotalUsage ? cpuTotalUsage - preCpuTotalUsage : 0; }
+
+    /*!
+     * \brief Returns the CPU time of the host system since the previous sample in nanoseconds.
+     */
+    quint64 systemCpuDelta() const { return systemCpuUsage > preSystemCpuUsage ? systemCpuUsage - preSystemCpuUsage : 0; }
+
+    /*!
+     * \brief Returns the CPU usage of the container since the previous sample in percent.
+     *
+     * Like <tt>docker stats</tt>, the value is relative to a single CPU, so it can be
+     * up to \link ContainerStats::onlineCpus onlineCpus\endlink × 100.
+     */
+    double cpuPercent() const
+    {
+        const quint64 system = systemCpuDelta();
+        return system > 0 ? static_cast<double>(cpuDelta()) / static_cast<double>(system) * (onlineCpus > 0 ? onlineCpus : 1) * 100.0 : 0.0;
+    }
+
+    /*!
+     * \brief Returns the memory usage relative to the memory limit in percent.
+     */
+    double memoryPercent() const { return memoryLimit > 0 ? static_cast<double>(memoryUsage) / static_cast<double>(memoryLimit) * 100.0 : 0.0; }
+};
+
+class ContainerStatsJobPrivate;
+
+/*!
+ * \ingroup api-jobs-containers
+ * \brief Gets resource usage statistics of a container.
+ *
+ * If \link ContainerStatsJob::stream stream\endlink is \c true (the default), the job
+ * keeps the connection open and the daemon sends a new sample about once per second,
+ * that is emitted via statsReceived(). The job runs until it is killed or the container
+ * stops. If \a stream is \c false, only a single sample is requested and the job
+ * finishes afterwards.
+ *
+ * Samples are decoded directly from the received data into a ContainerStats struct
+ * without building a JSON document, so watching many containers at the same time
+ * is cheap. replyData() will not contain the samples, use statsReceived() or
+ * lastStats() instead.
+ *
+ * Have a look at the description of the Job class to learn how to use Job
+ * classes.
+ *
+ * \par Example
+ * \code{.cpp}
+ * auto job = new ContainerStatsJob();
+ * job->setId(QStringLiteral("my-container"));
+ * connect(job, &ContainerStatsJob::statsReceived, this, [](const Schauer::ContainerStats &stats){
+ *     qDebug() << stats.cpuPercent() << stats.memoryUsage;
+ * });
+ * job->start();
+ * \endcode
+ *
+ * \par API route
+ * /containers/{\link ContainerStatsJob::id id\endlink}/stats
+ *
+ * \par API method
+ * GET
+ *
+ * \dockerAPI{ContainerStats}
+ *
+ * \headerfile "" <Schauer/ContainerStatsJob>
+ */
+class SCHAUER_LIBRARY ContainerStatsJob : public Job
+{
+    Q_OBJECT
+    /*!
+     * \brief ID or name of the container to get the stats for.
+     *
+     * By default this property holds an empty string. This property must be set to
+     * a valid container ID or name to execute the job.
+     *
+     * \par Access functions
+     * \li QString() id() const
+     * \li void setId(const QString &id)
+     *
+     * \par Notifier signal
+     * \li void idChanged(const QString &id)
+     */
+    Q_PROPERTY(QString id READ id WRITE setId NOTIFY idChanged)
+    /*!
+     * \brief This property holds whether to stream samples or to get a single sample only.
+     *
+     * The default value is \c true.
+     *
+     * \par Access functions
+     * \li bool stream() const
+     * \li void setStream(bool stream)
+     *
+     * \par Notifier signal
+     * \li void streamChanged(bool stream)
+     */
+    Q_PROPERTY(bool stream READ stream WRITE setStream NOTIFY streamChanged)
+public:
+    /*!
+     * \brief Constructs a new %ContainerStatsJob object with the given \a parent.
+     */
+    explicit ContainerStatsJob(QObject *parent = nullptr);
+
+    /*!
+     * \brief Destroys the %ContainerStatsJob object.
+     */
+    ~ContainerStatsJob() override;
+
+    /*!
+     * \brief Starts requesting the stats asynchronously.
+     *
+     * If \link ContainerStatsJob::stream stream\endlink is \c false, result() is
+     * emitted after the single sample has been received. Otherwise the job runs
+     * until it is killed, fails or the daemon closes the stream.
+     */
+    void start() override;
+
+    /*!
+     * \brief Getter function for the \link ContainerStatsJob::id id\endlink property.
+     * \sa setId(), idChanged()
+     */
+    QString id() const;
+
+    /*!
+     * \brief Setter function for the \link ContainerStatsJob::id id\endlink property.
+     * \sa id(), idChanged()
+     */
+    void setId(const QString &id);
+
+    /*!
+     * \brief Getter function for the \link ContainerStatsJob::stream stream\endlink property.
+     * \sa setStream(), streamChanged()
+     */
+    bool stream() const;
+
+    /*!
+     * \brief Setter function for the \link ContainerStatsJob::stream stream\endlink property.
+     * \sa stream(), streamChanged()
+     */
+    void setStream(bool stream);
+
+    /*!
+     * \brief Returns the last received sample.
+     * \sa statsReceived()
+     */
+    ContainerStats lastStats() const;
+
+Q_SIGNALS:
+    /*!
+     * \brief Notifier signal for the \link ContainerStatsJob::id id\endlink property.
+     * \sa id(), setId()
+     */
+    void idChanged(const QString &id);
+
+    /*!
+     * \brief Notifier signal for the \link ContainerStatsJob::stream stream\endlink property.
+     * \sa stream(), setStream()
+     */
+    void streamChanged(bool stream);
+
+    /*!
+     * \brief Emitted for every \a stats sample reported by the Docker daemon.
+     * \sa lastStats()
+     */
+    void statsReceived(const Schauer::ContainerStats &stats);
+
+private:
+    Q_DISABLE_COPY(ContainerStatsJob)
+    Q_DECLARE_PRIVATE_D(s_ptr, ContainerStatsJob)
+};
+
+}
+
+Q_DECLARE_METATYPE(Schauer::ContainerStats)
+
+#endif // SCHAUER_CONTAINERSTATSJOB_H
@@ -0,0 +1,48 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_CONTAINERSTATSJOB_P_H
+#define SCHAUER_CONTAINERSTATSJOB_P_H
+
+#include "containerstatsjob.h"
+#include "job_p.h"
+
+namespace Schauer {
+
+class ContainerStatsJobPrivate : public JobPrivate
+{
+public:
+    explicit ContainerStatsJobPrivate(ContainerStatsJob *q);
+
+    ~ContainerStatsJobPrivate() override;
+
+    QString buildUrlPath() const override;
+
+    QUrlQuery buildUrlQuery() const override;
+
+    void emitDescription() override;
+
+    bool checkInput() override;
+
+    bool checkOutput(const QByteArray &data) override;
+
+    void processStreamData(const QByteArray &data) override;
+
+    void processSample(const char *data, int size);
+
+    QString id;
+    QByteArray lineBuffer;
+    ContainerStats stats;
+    bool stream = true;
+    bool sampleReceived = false;
+
+private:
+    Q_DISABLE_COPY(ContainerStatsJobPrivate)
+    Q_DECLARE_PUBLIC(ContainerStatsJob)
+};
+
+}
+
+#endif // SCHAUER_CONTAINERSTATSJOB_P_H
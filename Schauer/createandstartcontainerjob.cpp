@@ -0,0 +1,374 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "createandstartcontainerjob_p.h"
+#include "removecontainerjob.h"
+#include "logging.h"
+#include "jsonwriter.h"
+#include "containerconfig.h"
+#include <QRegularExpression>
+#include <QTimer>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <utility>
+
+using namespace Schauer;
+
+namespace {
+constexpr int maxInspects = 20;
+constexpr int inspectDelay = 50;
+}
+
+CreateAndStartContainerJobPrivate::CreateAndStartContainerJobPrivate(CreateAndStartContainerJob *q)
+    : JobPrivate(q)
+{
+    requiresAuth = false;
+    invalidatesEndpoint = QStringLiteral("/containers/json");
+    setStage(Stage::Create);
+}
+
+CreateAndStartContainerJobPrivate::~CreateAndStartContainerJobPrivate() = default;
+
+void CreateAndStartContainerJobPrivate::setStage(Stage newStage)
+{
+    stage = newStage;
+    switch (stage) {
+    case Stage::Create:
+        namOperation = NetworkOperation::Post;
+        expectedContentType = ExpectedContentType::JsonObject;
+        break;
+    case Stage::Start:
+        namOperation = NetworkOperation::Post;
+        expectedContentType = ExpectedContentType::Empty;
+        break;
+    case Stage::Inspect:
+        namOperation = NetworkOperation::Get;
+        expectedContentType = ExpectedContentType::JsonObject;
+        break;
+    }
+}
+
+QString CreateAndStartContainerJobPrivate::buildUrlPath() const
+{
+    switch (stage) {
+    case Stage::Create:
+        return JobPrivate::buildUrlPath() + QLatin1String("/containers/create");
+    case Stage::Start:
+        return JobPrivate::buildUrlPath() + QLatin1String("/containers/") + containerId + QLatin1String("/start");
+    case Stage::Inspect:
+        return JobPrivate::buildUrlPath() + QLatin1String("/containers/") + containerId + QLatin1String("/json");
+    }
+
+    return JobPrivate::buildUrlPath();
+}
+
+QUrlQuery CreateAndStartContainerJobPrivate::buildUrlQuery() const
+{
+    QUrlQuery uq = JobPrivate::buildUrlQuery();
+    if (stage == Stage::Create && !name.isEmpty()) {
+        uq.addQueryItem(QStringLiteral("name"), name);
+    }
+    return uq;
+}
+
+std::pair<QByteArray, QByteArray> CreateAndStartContainerJobPrivate::buildPayload() const
+{
+    if (stage != Stage::Create) {
+        return JobPrivate::buildPayload();
+    }
+
+    if (!serializedConfig.isEmpty()) {
+        return std::make_pair(serializedConfig, QByteArrayLiteral("application/json"));
+    }
+
+    QByteArray payload;
+    JsonWriter w(payload);
+    w.value(QVariant(containerConfig));
+
+    return std::make_pair(payload, QByteArrayLiteral("application/json"));
+}
+
+void CreateAndStartContainerJobPrivate::emitDescription()
+{
+    Q_Q(CreateAndStartContainerJob);
+
+    QString _title;
+
+    if (name.isEmpty()) {
+        //: Job description title
+        //% "Creating and starting new container"
+        _title = qtTrId("libschauer-job-desc-create-start-container-title");
+    } else {
+        //: Job description title, %1 will be replaced by the container name
+        //% "Creating and starting new container %1"
+        _title = qtTrId("libschauer-job-desc-create-start-container-title-with-name").arg(name);
+    }
+
+    //: Job description field name
+    //% "Image"
+    const QString f1Name = qtTrId("libschauer-job-desc-create-container-field1");
+
+    Q_EMIT q->description(q, _title, qMakePair(f1Name, containerConfig.value(QStringLiteral("Image")).toString()));
+}
+
+bool CreateAndStartContainerJobPrivate::checkInput()
+{
+    if (!JobPrivate::checkInput()) {
+        return false;
+    }
+
+    if (stage != Stage::Create) {
+        return true;
+    }
+
+    if (!name.isEmpty()) {
+        const QString reStr = QStringLiteral("^/?[a-zA-Z0-9][a-zA-Z0-9_.-]+$");
+        static QRegularExpression re(reStr);
+        if (!name.contains(re)) {
+            //: Error message if the container name is not valid, %1 will b replaced by the regular expression
+            //% "The name for the container is not valid. It has to match the following regular expression: %1"
+            emitError(InvalidInput, qtTrId("libschauer-error-invalid-input-container-name").arg(reStr));
+            qCCritical(schCore) << "Invalid container name" << name << "does not match this required regular expression:" << reStr;
+            return false;
+        }
+    }
+
+    if (serializedConfig.isEmpty() && containerConfig.value(QStringLiteral("Image")).toString().isEmpty()) {
+        //: Error message if the image name is missing when trying to create a container
+        //% "The name of the image from which the container is to be created is missing."
+        emitError(InvalidInput, qtTrId("libschauer-error-invalid-input-image-name"));
+        qCCritical(schCore) << "Missing image when trying to create container" << name;
+        return false;
+    }
+
+    return true;
+}
+
+bool CreateAndStartContainerJobPrivate::checkOutput(const QByteArray &data)
+{
+    if (!JobPrivate::checkOutput(data)) {
+        return false;
+    }
+
+    Q_Q(CreateAndStartContainerJob);
+
+    if ((stage == Stage::Create || stage == Stage::Inspect) && !parseReply()) {
+        return false;
+    }
+
+    if (stage == Stage::Create) {
+        const QJsonObject o = json().object();
+        containerId = o.value(QStringLiteral("Id")).toString();
+        if (Q_UNLIKELY(containerId.isEmpty())) {
+            q->setError(WrongOutputType);
+            qCCritical(schCore) << "Invalid reply: the created container has no ID.";
+            return false;
+        }
+        const QJsonArray warningsArray = o.value(QStringLiteral("Warnings")).toArray();
+        for (const QJsonValue &warning : warningsArray) {
+            warnings << warning.toString();
+        }
+    } else if (stage == Stage::Inspect) {
+        const QJsonObject state = json().object().value(QStringLiteral("State")).toObject();
+        if (state.value(QStringLiteral("Running")).toBool()) {
+            return true;
+        }
+
+        const QString status = state.value(QStringLiteral("Status")).toString();
+        if ((status == QLatin1String("created") || status == QLatin1String("restarting")) && inspectAttempts < maxInspects) {
+            // prepareNextRequest() will inspect the container again
+            return true;
+        }
+
+        q->setError(APIError);
+        //: Error message if a started container is not running, %1 will be replaced by the container ID, %2 by the container status
+        //% "The container %1 has been started but is not running. Current status: %2"
+        q->setErrorText(qtTrId("libschauer-error-create-start-container-not-running").arg(containerId, status));
+        qCCritical(schCore) << "Container" << containerId << "has been started but is not running, status:" << status;
+        return false;
+    }
+
+    return true;
+}
+
+bool CreateAndStartContainerJobPrivate::prepareNextRequest()
+{
+    switch (stage) {
+    case Stage::Create:
+        qCDebug(schCore) << "Created container" << containerId << ", starting it";
+        setStage(Stage::Start);
+        return true;
+    case Stage::Start:
+        if (!waitUntilRunning) {
+            return false;
+        }
+        setStage(Stage::Inspect);
+        return true;
+    case Stage::Inspect:
+        if (!json().object().value(QStringLiteral("State")).toObject().value(QStringLiteral("Running")).toBool()) {
+            // the container is still starting up
+            inspectAttempts++;
+            nextRequestDelay = inspectDelay;
+            return true;
+        }
+        qCDebug(schCore) << "Container" << containerId << "is running";
+        return false;
+    }
+
+    return false;
+}
+
+void CreateAndStartContainerJobPrivate::removeCreatedContainer()
+{
+    if (!removeOnFailure || containerId.isEmpty()) {
+        return;
+    }
+
+    qCDebug(schCore) << "Removing container" << containerId << "that has not been started successfully";
+    auto job = new RemoveContainerJob();
+    job->setConfiguration(configuration);
+    job->setId(containerId);
+    job->setForce(true);
+    job->setRemoveAnonVolumes(true);
+    job->start();
+}
+
+CreateAndStartContainerJob::CreateAndStartContainerJob(QObject *parent)
+    : Job(* new CreateAndStartContainerJobPrivate(this), parent)
+{
+    connect(this, &Job::failed, this, [this](){
+        Q_D(CreateAndStartContainerJob);
+        d->removeCreatedContainer();
+    });
+}
+
+CreateAndStartContainerJob::~CreateAndStartContainerJob() = default;
+
+bool CreateAndStartContainerJob::doKill()
+{
+    Q_D(CreateAndStartContainerJob);
+    Job::doKill();
+    d->removeCreatedContainer();
+    return true;
+}
+
+void CreateAndStartContainerJob::start()
+{
+    Q_D(CreateAndStartContainerJob);
+    d->setStage(CreateAndStartContainerJobPrivate::Stage::Create);
+    d->containerId.clear();
+    d->warnings.clear();
+    d->inspectAttempts = 0;
+    QTimer::singleShot(0, this, &CreateAndStartContainerJob::sendRequest);
+}
+
+QString CreateAndStartContainerJob::name() const
+{
+    Q_D(const CreateAndStartContainerJob);
+    return d->name;
+}
+
+void CreateAndStartContainerJob::setName(const QString &name)
+{
+    Q_D(CreateAndStartContainerJob);
+    if (d->name != name) {
+        qCDebug(schCore) << "Changing \"name\" from" << d->name << "to" << name;
+        d->name = name;
+        Q_EMIT nameChanged(this->name());
+    }
+}
+
+QVariantHash CreateAndStartContainerJob::containerConfig() const
+{
+    Q_D(const CreateAndStartContainerJob);
+    return d->containerConfig;
+}
+
+void CreateAndStartContainerJob::setContainerConfig(const QVariantHash &containerConfig)
+{
+    Q_D(CreateAndStartContainerJob);
+    if (d->containerConfig != containerConfig) {
+        qCDebug(schCore) << "Changing \"containerConfig\" from" << d->containerConfig << "to" << containerConfig;
+        d->containerConfig = containerConfig;
+        Q_EMIT containerConfigChanged(this->containerConfig());
+    }
+}
+
+QByteArray CreateAndStartContainerJob::serializedConfig() const
+{
+    Q_D(const CreateAndStartContainerJob);
+    return d->serializedConfig;
+}
+
+void CreateAndStartContainerJob::setSerializedConfig(const QByteArray &serializedConfig)
+{
+    Q_D(CreateAndStartContainerJob);
+    if (d->serializedConfig != serializedConfig) {
+        qCDebug(schCore) << "Changing \"serializedConfig\" from" << d->serializedConfig << "to" << serializedConfig;
+        d->serializedConfig = serializedConfig;
+        Q_EMIT serializedConfigChanged(this->serializedConfig());
+    }
+}
+
+void CreateAndStartContainerJob::setSerializedConfig(const ContainerConfig &config)
+{
+    setSerializedConfig(config.toJson());
+}
+
+bool CreateAndStartContainerJob::waitUntilRunning() const
+{
+    Q_D(const CreateAndStartContainerJob);
+    return d->waitUntilRunning;
+}
+
+void CreateAndStartContainerJob::setWaitUntilRunning(bool waitUntilRunning)
+{
+    Q_D(CreateAndStartContainerJob);
+    if (d->waitUntilRunning != waitUntilRunning) {
+        qCDebug(schCore) << "Changing \"waitUntilRunning\" from" << d->waitUntilRunning << "to" << waitUntilRunning;
+        d->waitUntilRunning = waitUntilRunning;
+        Q_EMIT waitUntilRunningChanged(this->waitUntilRunning());
+    }
+}
+
+bool CreateAndStartContainerJob::removeOnFailure() const
+{
+    Q_D(const CreateAndStartContainerJob);
+    return d->removeOnFailure;
+}
+
+void CreateAndStartContainerJob::setRemoveOnFailure(bool removeOnFailure)
+{
+    Q_D(CreateAndStartContainerJob);
+    if (d->removeOnFailure != removeOnFailure) {
+        qCDebug(schCore) << "Changing \"removeOnFailure\" from" << d->removeOnFailure << "to" << removeOnFailure;
+        d->removeOnFailure = removeOnFailure;
+        Q_EMIT removeOnFailureChanged(this->removeOnFailure());
+    }
+}
+
+QString CreateAndStartContainerJob::containerId() const
+{
+    Q_D(const CreateAndStartContainerJob);
+    return d->containerId;
+}
+
+QStringList CreateAndStartContainerJob::warnings() const
+{
+    Q_D(const CreateAndStartContainerJob);
+    return d->warnings;
+}
+
+CreatedContainer CreateAndStartContainerJob::createdContainer() const
+{
+    Q_D(const CreateAndStartContainerJob);
+    CreatedContainer created;
+    created.id = d->containerId;
+    created.warnings = d->warnings;
+    return created;
+}
+
+#include "moc_createandstartcontainerjob.cpp"
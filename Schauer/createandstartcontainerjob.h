@@ -0,0 +1,302 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_CREATEANDSTARTCONTAINERJOB_H
+#define SCHAUER_CREATEANDSTARTCONTAINERJOB_H
+
+#include "schauer_exports.h"
+#include "job.h"
+#include "createcontainerjob.h"
+
+namespace Schauer {
+
+struct ContainerConfig;
+class CreateAndStartContainerJobPrivate;
+
+/*!
+ * \ingroup api-jobs-containers
+ * \brief Creates a new container from an image and starts it.
+ *
+ * This job combines CreateContainerJob and StartContainerJob into a single job.
+ * The ID of the created container is taken directly from the create reply and the
+ * start request is sent on the same connection if possible, without going back
+ * to the event loop in between.
+ *
+ * If \link CreateAndStartContainerJob::waitUntilRunning waitUntilRunning\endlink is
+ * \c true, the container is inspected after it has been started and the job only
+ * succeeds if the container is running. If the container is still starting up, it
+ * will be inspected again after a short delay. If the container has already exited,
+ * the job fails with Schauer::APIError.
+ *
+ * replyData() will contain the reply of the last request, that is the container
+ * inspection if \a waitUntilRunning is \c true, otherwise the create reply.
+ *
+ * If the container has been created but starting or inspecting it fails, the
+ * container is removed again in the background, unless
+ * \link CreateAndStartContainerJob::removeOnFailure removeOnFailure\endlink is
+ * \c false. containerId() returns the ID of the created container in both cases.
+ * The same applies to jobs that are killed after the container has been created.
+ *
+ * Have a look at the description of the Job class to learn how to use Job
+ * classes.
+ *
+ * \par Example
+ * \code{.cpp}
+ * auto job = new CreateAndStartContainerJob();
+ * job->setName(QStringLiteral("my-nginx"));
+ * job->setContainerConfig({{QStringLiteral("Image"), QStringLiteral("nginx")}});
+ * job->setWaitUntilRunning(true);
+ * if (job->exec()) {
+ *     qDebug() << "Started container" << job->containerId();
+ * }
+ * \endcode
+ *
+ * \par API routes
+ * /containers/create, /containers/{id}/start, /containers/{id}/json
+ *
+ * \par API methods
+ * POST, POST, GET
+ *
+ * \dockerAPI{ContainerCreate}
+ *
+ * \sa CreateContainerJob, StartContainerJob
+ *
+ * \headerfile "" <Schauer/CreateAndStartContainerJob>
+ */
+class SCHAUER_LIBRARY CreateAndStartContainerJob : public Job
+{
+    Q_OBJECT
+    /*!
+     * \brief Sets the name of the container to create.
+     *
+     * Must match <pre>/?[a-zA-Z0-9][a-zA-Z0-9_.-]+</pre>
+     *
+     * \par Access functions
+     * \li QString name() const
+     * \li void setName(const QString &name)
+     *
+     * \par Notifier signal
+     * \li void nameChanged(const QString &name)
+     */
+    Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
+    /*!
+     * \brief Sets the configuration for the new container.
+     *
+     * At least the \a Image key must have a valid value.
+     *
+     * \par Access functions
+     * \li QVariantHash containerConfig() const
+     * \li void setContainerConfig(const QVariantHash &containerConfig)
+     *
+     * \par Notifier signal
+     * \li void containerConfigChanged(const QVariantHash &containerConfig)
+     */
+    Q_PROPERTY(QVariantHash containerConfig READ containerConfig WRITE setContainerConfig NOTIFY containerConfigChanged)
+    /*!
+     * \brief Sets the configuration for the new container as pre-serialized JSON payload.
+     *
+     * If this is not empty, it is sent as it is instead of
+     * \link CreateAndStartContainerJob::containerConfig containerConfig\endlink. Use
+     * ContainerConfig::toJson() to create the payload once and reuse it for
+     * as many jobs as needed. By default this property holds an empty byte array.
+     *
+     * \par Access functions
+     * \li QByteArray serializedConfig() const
+     * \li void setSerializedConfig(const QByteArray &serializedConfig)
+     * \li void setSerializedConfig(const ContainerConfig &config)
+     *
+     * \par Notifier signal
+     * \li void serializedConfigChanged(const QByteArray &serializedConfig)
+     */
+    Q_PROPERTY(QByteArray serializedConfig READ serializedConfig WRITE setSerializedConfig NOTIFY serializedConfigChanged)
+    /*!
+     * \brief This property holds whether to confirm that the container is running before finishing.
+     *
+     * The default value is \c false.
+     *
+     * \par Access functions
+     * \li bool waitUntilRunning() const
+     * \li void setWaitUntilRunning(bool waitUntilRunning)
+     *
+     * \par Notifier signal
+     * \li void waitUntilRunningChanged(bool waitUntilRunning)
+     */
+    Q_PROPERTY(bool waitUntilRunning READ waitUntilRunning WRITE setWaitUntilRunning NOTIFY waitUntilRunningChanged)
+    /*!
+     * \brief This property holds whether to remove the created container if starting it fails.
+     *
+     * If this is \c true and the container has been created, but starting or
+     * inspecting it fails or the job is killed, the container and its anonymous
+     * volumes are forcibly removed. The job does not wait for the removal. Set this to \c false to
+     * inspect or remove the container yourself, using containerId().
+     * The default value is \c true.
+     *
+     * \par Access functions
+     * \li bool removeOnFailure() const
+     * \li void setRemoveOnFailure(bool removeOnFailure)
+     *
+     * \par Notifier signal
+     * \li void removeOnFailureChanged(bool removeOnFailure)
+     */
+    Q_PROPERTY(bool removeOnFailure READ removeOnFailure WRITE setRemoveOnFailure NOTIFY removeOnFailureChanged)
+public:
+    /*!
+     * \brief Constructs a new %CreateAndStartContainerJob object with the given \a parent.
+     */
+    explicit CreateAndStartContainerJob(QObject *parent = nullptr);
+
+    /*!
+     * \brief Destroys the %CreateAndStartContainerJob object.
+     */
+    ~CreateAndStartContainerJob() override;
+
+    /*!
+     * \brief Starts creating and starting a new Docker container asynchronously.
+     *
+     * When the job is finished, result() will be emitted.
+     * To create and start a container in a synchronous way, use exec().
+     */
+    void start() override;
+
+    /*!
+     * \brief Getter function for the \link CreateAndStartContainerJob::name name\endlink property.
+     * \sa setName(), nameChanged()
+     */
+    QString name() const;
+
+    /*!
+     * \brief Setter function for the \link CreateAndStartContainerJob::name name\endlink property.
+     * \sa name(), nameChanged()
+     */
+    void setName(const QString &name);
+
+    /*!
+     * \brief Getter function for the \link CreateAndStartContainerJob::containerConfig containerConfig\endlink property.
+     * \sa setContainerConfig(), containerConfigChanged()
+     */
+    QVariantHash containerConfig() const;
+
+    /*!
+     * \brief Setter function for the \link CreateAndStartContainerJob::containerConfig containerConfig\endlink property.
+     * \sa containerConfig(), containerConfigChanged()
+     */
+    void setContainerConfig(const QVariantHash &containerConfig);
+
+    /*!
+     * \brief Getter function for the \link CreateAndStartContainerJob::serializedConfig serializedConfig\endlink property.
+     * \sa setSerializedConfig(), serializedConfigChanged()
+     */
+    QByteArray serializedConfig() const;
+
+    /*!
+     * \brief Setter function for the \link CreateAndStartContainerJob::serializedConfig serializedConfig\endlink property.
+     * \sa serializedConfig(), serializedConfigChanged()
+     */
+    void setSerializedConfig(const QByteArray &serializedConfig);
+
+    /*!
+     * \brief Sets the \link CreateAndStartContainerJob::serializedConfig serializedConfig\endlink property to the payload of \a config.
+     *
+     * This is the same as calling setSerializedConfig(config.toJson()).
+     * \sa serializedConfig(), serializedConfigChanged()
+     */
+    void setSerializedConfig(const ContainerConfig &config);
+
+    /*!
+     * \brief Getter function for the \link CreateAndStartContainerJob::waitUntilRunning waitUntilRunning\endlink property.
+     * \sa setWaitUntilRunning(), waitUntilRunningChanged()
+     */
+    bool waitUntilRunning() const;
+
+    /*!
+     * \brief Setter function for the \link CreateAndStartContainerJob::waitUntilRunning waitUntilRunning\endlink property.
+     * \sa waitUntilRunning(), waitUntilRunningChanged()
+     */
+    void setWaitUntilRunning(bool waitUntilRunning);
+
+    /*!
+     * \brief Getter function for the \link CreateAndStartContainerJob::removeOnFailure removeOnFailure\endlink property.
+     * \sa setRemoveOnFailure(), removeOnFailureChanged()
+     */
+    bool removeOnFailure() const;
+
+    /*!
+     * \brief Setter function for the \link CreateAndStartContainerJob::removeOnFailure removeOnFailure\endlink property.
+     * \sa removeOnFailure(), removeOnFailureChanged()
+     */
+    void setRemoveOnFailure(bool removeOnFailure);
+
+    /*!
+     * \brief Returns the ID of the created container.
+     *
+     * Returns an empty string until the container has been created. If the container
+     * has been created but starting it failed, this still returns the ID, also if
+     * the container is removed because of
+     * \link CreateAndStartContainerJob::removeOnFailure removeOnFailure\endlink.
+     */
+    QString containerId() const;
+
+    /*!
+     * \brief Returns the warnings reported by the daemon when creating the container.
+     */
+    QStringList warnings() const;
+
+    /*!
+     * \brief Returns the ID and the warnings of the created container.
+     *
+     * This can be passed on directly to other workflows. Like containerId(), the
+     * returned object is also valid if the container has been created but starting
+     * it failed.
+     */
+    CreatedContainer createdContainer() const;
+
+Q_SIGNALS:
+    /*!
+     * \brief Notifier signal for the \link CreateAndStartContainerJob::name name\endlink property.
+     * \sa name(), setName()
+     */
+    void nameChanged(const QString &name);
+
+    /*!
+     * \brief Notifier signal for the \link CreateAndStartContainerJob::containerConfig containerConfig\endlink property.
+     * \sa containerConfig(), setContainerConfig()
+     */
+    void containerConfigChanged(const QVariantHash &containerConfig);
+
+    /*!
+     * \brief Notifier signal for the \link CreateAndStartContainerJob::serializedConfig serializedConfig\endlink property.
+     * \sa serializedConfig(), setSerializedConfig()
+     */
+    void serializedConfigChanged(const QByteArray &serializedConfig);
+
+    /*!
+     * \brief Notifier signal for the \link CreateAndStartContainerJob::waitUntilRunning waitUntilRunning\endlink property.
+     * \sa waitUntilRunning(), setWaitUntilRunning()
+     */
+    void waitUntilRunningChanged(bool waitUntilRunning);
+
+    /*!
+     * \brief Notifier signal for the \link CreateAndStartContainerJob::removeOnFailure removeOnFailure\endlink property.
+     * \sa removeOnFailure(), setRemoveOnFailure()
+     */
+    void removeOnFailureChanged(bool removeOnFailure);
+
+protected:
+    /*!
+     * \brief Aborts a running request and removes an already created container.
+     *
+     * The container is only removed if \link CreateAndStartContainerJob::removeOnFailure removeOnFailure\endlink
+     * is \c true. Returns \c true.
+     */
+    bool doKill() override;
+
+private:
+    Q_DECLARE_PRIVATE_D(s_ptr, CreateAndStartContainerJob)
+    Q_DISABLE_COPY(CreateAndStartContainerJob)
+};
+
+}
+
+#endif // SCHAUER_CREATEANDSTARTCONTAINERJOB_H
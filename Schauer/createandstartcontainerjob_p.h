@@ -0,0 +1,62 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_CREATEANDSTARTCONTAINERJOB_P_H
+#define SCHAUER_CREATEANDSTARTCONTAINERJOB_P_H
+
+#include "createandstartcontainerjob.h"
+#include "job_p.h"
+
+namespace Schauer {
+
+class CreateAndStartContainerJobPrivate : public JobPrivate
+{
+public:
+    enum class Stage : qint8 {
+        Create  = 0,
+        Start   = 1,
+        Inspect = 2
+    };
+
+    explicit CreateAndStartContainerJobPrivate(CreateAndStartContainerJob *q);
+
+    ~CreateAndStartContainerJobPrivate() override;
+
+    QString buildUrlPath() const override;
+
+    QUrlQuery buildUrlQuery() const override;
+
+    std::pair<QByteArray, QByteArray> buildPayload() const override;
+
+    void emitDescription() override;
+
+    bool checkInput() override;
+
+    bool checkOutput(const QByteArray &data) override;
+
+    bool prepareNextRequest() override;
+
+    void setStage(Stage newStage);
+
+    void removeCreatedContainer();
+
+    QString name;
+    QString containerId;
+    QStringList warnings;
+    QVariantHash containerConfig;
+    QByteArray serializedConfig;
+    int inspectAttempts = 0;
+    Stage stage = Stage::Create;
+    bool waitUntilRunning = false;
+    bool removeOnFailure = true;
+
+private:
+    Q_DISABLE_COPY(CreateAndStartContainerJobPrivate)
+    Q_DECLARE_PUBLIC(CreateAndStartContainerJob)
+};
+
+}
+
+#endif // SCHAUER_CREATEANDSTARTCONTAINERJOB_P_H
@@ -5,9 +5,13 @@
 
 #include "createcontainerjob_p.h"
 #include <QRegularExpression>
+#include <QJsonObject>
+#include <QJsonArray>
 #include <QTimer>
 #include <utility>
 #include "logging.h"
+#include "jsonwriter.h"
+#include "containerconfig.h"
 
 using namespace Schauer;
 
@@ -17,6 +21,7 @@ CreateContainerJobPrivate::CreateContainerJobPrivate(CreateContainerJob *q)
     namOperation = NetworkOperation::Post;
     expectedContentType = ExpectedContentType::JsonObject;
     requiresAuth = false;
+    invalidatesEndpoint = QStringLiteral("/containers/json");
 }
 
 CreateContainerJobPrivate::~CreateContainerJobPrivate() = default;
@@ -38,10 +43,15 @@ QUrlQuery CreateContainerJobPrivate::buildUrlQuery() const
 
 std::pair<QByteArray, QByteArray> CreateContainerJobPrivate::buildPayload() const
 {
-    const QJsonObject ccObj = QJsonObject::fromVariantHash(containerConfig);
-    const QJsonDocument ccDoc(ccObj);
+    if (!serializedConfig.isEmpty()) {
+        return std::make_pair(serializedConfig, QByteArrayLiteral("application/json"));
+    }
+
+    QByteArray payload;
+    JsonWriter w(payload);
+    w.value(QVariant(containerConfig));
 
-    return std::make_pair(ccDoc.toJson(QJsonDocument::Compact), QByteArrayLiteral("application/json"));
+    return std::make_pair(payload, QByteArrayLiteral("application/json"));
 }
 
 void CreateContainerJobPrivate::emitDescription()
@@ -85,7 +95,7 @@ bool CreateContainerJobPrivate::checkInput()
         }
     }
 
-    if (containerConfig.value(QStringLiteral("Image")).toString().isEmpty()) {
+    if (serializedConfig.isEmpty() && containerConfig.value(QStringLiteral("Image")).toString().isEmpty()) {
         //: Error message if the image name is missing when trying to create a container
         //% "The name of the image from which the container is to be created is missing."
         emitError(InvalidInput, qtTrId("libschauer-error-invalid-input-image-name"));
@@ -96,6 +106,29 @@ bool CreateContainerJobPrivate::checkInput()
     return true;
 }
 
+bool CreateContainerJobPrivate::checkOutput(const QByteArray &data)
+{
+    if (!JobPrivate::checkOutput(data) || !parseReply()) {
+        return false;
+    }
+
+    Q_Q(CreateContainerJob);
+
+    const QJsonObject o = json().object();
+    created.id = o.value(QStringLiteral("Id")).toString();
+    if (Q_UNLIKELY(created.id.isEmpty())) {
+        q->setError(WrongOutputType);
+        qCCritical(schCore) << "Invalid reply: the created container has no ID.";
+        return false;
+    }
+    const QJsonArray warningsArray = o.value(QStringLiteral("Warnings")).toArray();
+    for (const QJsonValue &warning : warningsArray) {
+        created.warnings << warning.toString();
+    }
+
+    return true;
+}
+
 CreateContainerJob::CreateContainerJob(QObject *parent)
     : Job(* new CreateContainerJobPrivate(this), parent)
 {
@@ -106,6 +139,8 @@ CreateContainerJob::~CreateContainerJob() = default;
 
 void CreateContainerJob::start()
 {
+    Q_D(CreateContainerJob);
+    d->created = CreatedContainer();
     QTimer::singleShot(0, this, &CreateContainerJob::sendRequest);
 }
 
@@ -141,4 +176,31 @@ void CreateContainerJob::setContainerConfig(const QVariantHash &containerConfig)
     }
 }
 
+QByteArray CreateContainerJob::serializedConfig() const
+{
+    Q_D(const CreateContainerJob);
+    return d->serializedConfig;
+}
+
+void CreateContainerJob::setSerializedConfig(const QByteArray &serializedConfig)
+{
+    Q_D(CreateContainerJob);
+    if (d->serializedConfig != serializedConfig) {
+        qCDebug(schCore) << "Changing \"serializedConfig\" from" << d->serializedConfig << "to" << serializedConfig;
+        d->serializedConfig = serializedConfig;
+        Q_EMIT serializedConfigChanged(this->serializedConfig());
+    }
+}
+
+void CreateContainerJob::setSerializedConfig(const ContainerConfig &config)
+{
+    setSerializedConfig(config.toJson());
+}
+
+CreatedContainer CreateContainerJob::createdContainer() const
+{
+    Q_D(const CreateContainerJob);
+    return d->created;
+}
+
 #include "moc_createcontainerjob.cpp"
@@ -8,9 +8,30 @@
 
 #include "schauer_exports.h"
 #include "job.h"
+#include <QStringList>
 
 namespace Schauer {
 
+/*!
+ * \ingroup api-jobs-containers
+ * \brief A container created by CreateContainerJob or CreateAndStartContainerJob.
+ *
+ * \headerfile "" <Schauer/CreateContainerJob>
+ */
+struct CreatedContainer
+{
+    /*!
+     * \brief ID of the created container.
+     */
+    QString id;
+
+    /*!
+     * \brief Warnings reported by the daemon while creating the container.
+     */
+    QStringList warnings;
+};
+
+struct ContainerConfig;
 class CreateContainerJobPrivate;
 
 /*!
@@ -60,6 +81,23 @@ class SCHAUER_LIBRARY CreateContainerJob : public Job
      * \li void containerConfigChanged(const QVariantHash &containerConfig)
      */
     Q_PROPERTY(QVariantHash containerConfig READ containerConfig WRITE setContainerConfig NOTIFY containerConfigChanged)
+    /*!
+     * \brief Sets the configuration for the new container as pre-serialized JSON payload.
+     *
+     * If this is not empty, it is sent as it is instead of
+     * \link CreateContainerJob::containerConfig containerConfig\endlink. Use
+     * ContainerConfig::toJson() to create the payload once and reuse it for
+     * as many jobs as needed. By default this property holds an empty byte array.
+     *
+     * \par Access functions
+     * \li QByteArray serializedConfig() const
+     * \li void setSerializedConfig(const QByteArray &serializedConfig)
+     * \li void setSerializedConfig(const ContainerConfig &config)
+     *
+     * \par Notifier signal
+     * \li void serializedConfigChanged(const QByteArray &serializedConfig)
+     */
+    Q_PROPERTY(QByteArray serializedConfig READ serializedConfig WRITE setSerializedConfig NOTIFY serializedConfigChanged)
 public:
     /*!
      * \brief Contstructs a new %CreateContainerJob object with the given \a parent.
@@ -103,6 +141,33 @@ public:
      */
     void setContainerConfig(const QVariantHash &containerConfig);
 
+    /*!
+     * \brief Getter function for the \link CreateContainerJob::serializedConfig serializedConfig\endlink property.
+     * \sa setSerializedConfig(), serializedConfigChanged()
+     */
+    QByteArray serializedConfig() const;
+
+    /*!
+     * \brief Setter function for the \link CreateContainerJob::serializedConfig serializedConfig\endlink property.
+     * \sa serializedConfig(), serializedConfigChanged()
+     */
+    void setSerializedConfig(const QByteArray &serializedConfig);
+
+    /*!
+     * \brief Sets the \link CreateContainerJob::serializedConfig serializedConfig\endlink property to the payload of \a config.
+     *
+     * This is the same as calling setSerializedConfig(config.toJson()).
+     * \sa serializedConfig(), serializedConfigChanged()
+     */
+    void setSerializedConfig(const ContainerConfig &config);
+
+    /*!
+     * \brief Returns the ID and the warnings of the created container.
+     *
+     * The returned object is only valid after the job has been finished successfully.
+     */
+    CreatedContainer createdContainer() const;
+
 Q_SIGNALS:
     /*!
      * \brief Notifier signal for the \link CreateContainerJob::name name\endlink property.
@@ -116,6 +181,12 @@ Q_SIGNALS:
      */
     void containerConfigChanged(const QVariantHash &containerConfig);
 
+    /*!
+     * \brief Notifier signal for the \link CreateContainerJob::serializedConfig serializedConfig\endlink property.
+     * \sa serializedConfig(), setSerializedConfig()
+     */
+    void serializedConfigChanged(const QByteArray &serializedConfig);
+
 private:
     Q_DECLARE_PRIVATE_D(s_ptr, CreateContainerJob)
     Q_DISABLE_COPY(CreateContainerJob)
@@ -123,4 +194,6 @@ private:
 
 }
 
+Q_DECLARE_METATYPE(Schauer::CreatedContainer)
+
 #endif // SCHAUER_CREATECONTAINERJOB_H
@@ -28,8 +28,12 @@ public:
 
     bool checkInput() override;
 
+    bool checkOutput(const QByteArray &data) override;
+
     QString name;
     QVariantHash containerConfig;
+    QByteArray serializedConfig;
+    CreatedContainer created;
 
 private:
     Q_DISABLE_COPY(CreateContainerJobPrivate)
@@ -5,6 +5,7 @@
 
 #include "createexecinstancejob_p.h"
 #include "logging.h"
+#include "jsonwriter.h"
 #include <QTimer>
 #include <QRegularExpression>
 
@@ -29,21 +30,23 @@ QString CreateExecInstanceJobPrivate::buildUrlPath() const
 
 std::pair<QByteArray,QByteArray> CreateExecInstanceJobPrivate::buildPayload() const
 {
-    const QJsonObject body({
-                               {QStringLiteral("AttachStdin"), attachStdin},
-                               {QStringLiteral("AttachStdout"), attachStdout},
-                               {QStringLiteral("AttachStderr"), attachStderr},
-                               {QStringLiteral("DetachKeys"), detachKeys},
-                               {QStringLiteral("Tty"), tty},
-                               {QStringLiteral("Env"), QJsonArray::fromStringList(env)},
-                               {QStringLiteral("Cmd"), QJsonArray::fromStringList(cmd)},
-                               {QStringLiteral("Privileged"), privileged},
-                               {QStringLiteral("User"), user},
-                               {QStringLiteral("WorkingDir"), workingDir}
-                           });
-    const QJsonDocument bodyDoc(body);
-
-    return std::make_pair(bodyDoc.toJson(QJsonDocument::Compact), QByteArrayLiteral("application/json"));
+    QByteArray payload;
+    payload.reserve(256);
+    JsonWriter w(payload);
+    w.beginObject();
+    w.member(QLatin1String("AttachStdin"), attachStdin);
+    w.member(QLatin1String("AttachStdout"), attachStdout);
+    w.member(QLatin1String("AttachStderr"), attachStderr);
+    w.member(QLatin1String("Cmd"), cmd);
+    w.member(QLatin1String("DetachKeys"), detachKeys);
+    w.member(QLatin1String("Env"), env);
+    w.member(QLatin1String("Privileged"), privileged);
+    w.member(QLatin1String("Tty"), tty);
+    w.member(QLatin1String("User"), user);
+    w.member(QLatin1String("WorkingDir"), workingDir);
+    w.endObject();
+
+    return std::make_pair(payload, QByteArrayLiteral("application/json"));
 }
 
 void CreateExecInstanceJobPrivate::emitDescription()
@@ -93,6 +96,24 @@ bool CreateExecInstanceJobPrivate::checkInput()
     return true;
 }
 
+bool CreateExecInstanceJobPrivate::checkOutput(const QByteArray &data)
+{
+    if (!JobPrivate::checkOutput(data) || !parseReply()) {
+        return false;
+    }
+
+    Q_Q(CreateExecInstanceJob);
+
+    execId = json().object().value(QStringLiteral("Id")).toString();
+    if (Q_UNLIKELY(execId.isEmpty())) {
+        q->setError(WrongOutputType);
+        qCCritical(schCore) << "Invalid reply: the created exec instance has no ID.";
+        return false;
+    }
+
+    return true;
+}
+
 CreateExecInstanceJob::CreateExecInstanceJob(QObject *parent)
     : Job(* new CreateExecInstanceJobPrivate(this), parent)
 {
@@ -103,6 +124,8 @@ CreateExecInstanceJob::~CreateExecInstanceJob() = default;
 
 void CreateExecInstanceJob::start()
 {
+    Q_D(CreateExecInstanceJob);
+    d->execId.clear();
     QTimer::singleShot(0, this, &CreateExecInstanceJob::sendRequest);
 }
 
@@ -304,4 +327,10 @@ void CreateExecInstanceJob::setWorkingDir(const QString &workingDir)
     }
 }
 
+QString CreateExecInstanceJob::execId() const
+{
+    Q_D(const CreateExecInstanceJob);
+    return d->execId;
+}
+
 #include "moc_createexecinstancejob.cpp"
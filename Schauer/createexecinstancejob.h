@@ -26,7 +26,7 @@ class CreateExecInstanceJobPrivate;
  * \ingroup api-jobs-exec
  * \brief Create an execution instance.
  *
- * After creating an execution instance, use the returned \a Id to start the
+ * After creating an execution instance, use the returned execId() to start the
  * execution instance with the StartExecInstanceJob.
  *
  * Have a look at the description of the Job class to learn how to use Job
@@ -40,10 +40,8 @@ class CreateExecInstanceJobPrivate;
  * createExec->setCmd(QStringList({QStringLiteral("mkdir"), QStringLiteral("-p"), QStringLiteral("/my/new/directory")}));
  * createExec->exec();
  *
- * const QString execId = createExec->replyData().object().value(QLatin1String("Id)).toString();
- *
  * auto startExec = new StartExecInstanceJob();
- * startExec->setId(execId);
+ * startExec->setId(createExec->execId());
  * startExec->exec();
  * \endcode
  *
@@ -415,6 +413,13 @@ public:
      */
     void setWorkingDir(const QString &workingDir);
 
+    /*!
+     * \brief Returns the ID of the exec instance created by this job.
+     *
+     * Returns an empty string until the exec instance has been created.
+     */
+    QString execId() const;
+
 Q_SIGNALS:
     /*!
      * \brief Notifier signal for the \link CreateExecInstanceJob::id id\endlink property.
@@ -26,7 +26,10 @@ public:
 
     bool checkInput() override;
 
+    bool checkOutput(const QByteArray &data) override;
+
     QString id;
+    QString execId;
     QString detachKeys;
     QString user;
     QString workingDir;
@@ -0,0 +1,351 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "eventsjob_p.h"
+#include "logging.h"
+#include <QTimer>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+using namespace Schauer;
+
+namespace {
+
+constexpr int minReconnectDelay = 1000;
+constexpr int maxReconnectDelay = 30000;
+
+QString nanoToTimestamp(qint64 nano)
+{
+    return QString::number(nano / 1000000000) + QLatin1Char('.') + QStringLiteral("%1").arg(nano % 1000000000, 9, 10, QLatin1Char('0'));
+}
+
+/*
+ * QJsonValue stores numbers as double that is not precise enough for
+ * nanosecond timestamps, so read the value directly from the raw data.
+ */
+qint64 extractTimeNano(const QByteArray &line)
+{
+    const QByteArray key = QByteArrayLiteral("\"timeNano\":");
+    int idx = line.indexOf(key);
+    if (idx < 0) {
+        return 0;
+    }
+    idx += key.size();
+    while (idx < line.size() && line.at(idx) == ' ') {
+        ++idx;
+    }
+    qint64 value = 0;
+    while (idx < line.size() && line.at(idx) >= '0' && line.at(idx) <= '9') {
+        value = value * 10 + (line.at(idx) - '0');
+        ++idx;
+    }
+    return value;
+}
+
+}
+
+QDateTime Event::dateTime() const
+{
+    return QDateTime::fromMSecsSinceEpoch(timeNano / 1000000);
+}
+
+Event::Type Event::typeFromString(const QString &type)
+{
+    if (type == QLatin1String("container")) {
+        return Container;
+    } else if (type == QLatin1String("image")) {
+        return Image;
+    } else if (type == QLatin1String("volume")) {
+        return Volume;
+    } else if (type == QLatin1String("network")) {
+        return Network;
+    } else if (type == QLatin1String("daemon")) {
+        return Daemon;
+    } else if (type == QLatin1String("plugin")) {
+        return Plugin;
+    } else if (type == QLatin1String("node")) {
+        return Node;
+    } else if (type == QLatin1String("service")) {
+        return Service;
+    } else if (type == QLatin1String("secret")) {
+        return Secret;
+    } else if (type == QLatin1String("config")) {
+        return Config;
+    }
+    return Unknown;
+}
+
+EventsJobPrivate::EventsJobPrivate(EventsJob *q)
+    : JobPrivate(q)
+{
+    namOperation = NetworkOperation::Get;
+    expectedContentType = ExpectedContentType::Stream;
+    requiresAuth = false;
+    // the event stream is open for an unlimited time
+    requestTimeout = 0;
+}
+
+EventsJobPrivate::~EventsJobPrivate() = default;
+
+QString EventsJobPrivate::buildUrlPath() const
+{
+    const QString path = JobPrivate::buildUrlPath() + QLatin1String("/events");
+    return path;
+}
+
+QUrlQuery EventsJobPrivate::buildUrlQuery() const
+{
+    QUrlQuery uq = JobPrivate::buildUrlQuery();
+    if (resumeFrom > 0) {
+        uq.addQueryItem(QStringLiteral("since"), nanoToTimestamp(resumeFrom));
+    } else if (since.isValid()) {
+        uq.addQueryItem(QStringLiteral("since"), QString::number(since.toMSecsSinceEpoch() / 1000));
+    }
+    if (until.isValid()) {
+        uq.addQueryItem(QStringLiteral("until"), QString::number(until.toMSecsSinceEpoch() / 1000));
+    }
+    addFiltersQueryItem(uq, filters);
+    return uq;
+}
+
+void EventsJobPrivate::emitDescription()
+{
+    Q_Q(EventsJob);
+
+    //: Job description title
+    //% "Listening for Docker events"
+    const QString _title = qtTrId("libschauer-job-desc-events-title");
+
+    Q_EMIT q->description(q, _title);
+}
+
+void EventsJobPrivate::processStreamData(const QByteArray &data)
+{
+    lineBuffer.append(data);
+
+    int start = 0;
+    int newLine = lineBuffer.indexOf('\n');
+    while (newLine > -1) {
+        if (newLine > start) {
+            processLine(QByteArray::fromRawData(lineBuffer.constData() + start, newLine - start));
+        }
+        start = newLine + 1;
+        newLine = lineBuffer.indexOf('\n', start);
+    }
+
+    lineBuffer.remove(0, start);
+}
+
+void EventsJobPrivate::processLine(const QByteArray &line)
+{
+    QJsonParseError jsonError;
+    const QJsonDocument doc = QJsonDocument::fromJson(line, &jsonError);
+    if (Q_UNLIKELY(jsonError.error != QJsonParseError::NoError || !doc.isObject())) {
+        qCWarning(schCore) << "Skipping invalid event data:" << line;
+        return;
+    }
+
+    const QJsonObject o = doc.object();
+
+    Event event;
+    event.timeNano = extractTimeNano(line);
+    if (event.timeNano == 0) {
+        event.timeNano = static_cast<qint64>(o.value(QStringLiteral("time")).toDouble()) * 1000000000;
+    }
+
+    event.type = Event::typeFromString(o.value(QStringLiteral("Type")).toString());
+    event.action = o.value(QStringLiteral("Action")).toString();
+    if (event.action.isEmpty()) {
+        event.action = o.value(QStringLiteral("status")).toString();
+    }
+
+    const QJsonObject actor = o.value(QStringLiteral("Actor")).toObject();
+    event.actorId = actor.value(QStringLiteral("ID")).toString();
+    if (event.actorId.isEmpty()) {
+        event.actorId = o.value(QStringLiteral("id")).toString();
+    }
+
+    const EventKey key(event.type, event.action, event.actorId);
+
+    if (replaying && event.timeNano > 0) {
+        // after reconnecting, the daemon sends the events since the last received one again
+        if (event.timeNano < lastEventTime) {
+            return;
+        }
+        if (event.timeNano == lastEventTime) {
+            if (replayKeys.removeOne(key)) {
+                return;
+            }
+        } else {
+            replaying = false;
+            replayKeys.clear();
+        }
+    }
+
+    const QJsonObject attributes = actor.value(QStringLiteral("Attributes")).toObject();
+    for (auto i = attributes.constBegin(); i != attributes.constEnd(); ++i) {
+        event.attributes.insert(i.key(), i.value().toString());
+    }
+
+    event.scope = o.value(QStringLiteral("scope")).toString();
+
+    if (event.timeNano > lastEventTime) {
+        lastEventTime = event.timeNano;
+        lastEventKeys.clear();
+    }
+    if (event.timeNano > 0 && event.timeNano == lastEventTime) {
+        lastEventKeys.append(key);
+    }
+    reconnectDelay = 0;
+
+    Q_Q(EventsJob);
+    Q_EMIT q->eventReceived(event);
+}
+
+bool EventsJobPrivate::reconnect()
+{
+    if (!autoReconnect) {
+        return false;
+    }
+
+    if (until.isValid() && until <= QDateTime::currentDateTimeUtc()) {
+        return false;
+    }
+
+    if (lastEventTime > 0) {
+        resumeFrom = lastEventTime;
+        replaying = true;
+        replayKeys = lastEventKeys;
+    } else if (resumeFrom == 0) {
+        resumeFrom = (since.isValid() ? since.toMSecsSinceEpoch() : QDateTime::currentMSecsSinceEpoch()) * 1000000;
+    }
+
+    reconnectDelay = reconnectDelay == 0 ? minReconnectDelay : qMin(reconnectDelay * 2, maxReconnectDelay);
+    nextRequestDelay = reconnectDelay;
+    lineBuffer.clear();
+
+    qCDebug(schCore) << "Event stream has been closed, reconnecting in" << reconnectDelay << "ms and resuming from" << nanoToTimestamp(resumeFrom);
+
+    return true;
+}
+
+bool EventsJobPrivate::prepareNextRequest()
+{
+    // the daemon closes the stream after the until time has been reached
+    if (until.isValid()) {
+        return false;
+    }
+
+    return reconnect();
+}
+
+bool EventsJobPrivate::prepareRetry()
+{
+    return reconnect();
+}
+
+EventsJob::EventsJob(QObject *parent)
+    : Job(* new EventsJobPrivate(this), parent)
+{
+
+}
+
+EventsJob::~EventsJob() = default;
+
+void EventsJob::start()
+{
+    Q_D(EventsJob);
+    d->lineBuffer.clear();
+    d->lastEventTime = 0;
+    d->lastEventKeys.clear();
+    d->replayKeys.clear();
+    d->replaying = false;
+    d->resumeFrom = 0;
+    d->reconnectDelay = 0;
+    QTimer::singleShot(0, this, &EventsJob::sendRequest);
+}
+
+QDateTime EventsJob::since() const
+{
+    Q_D(const EventsJob);
+    return d->since;
+}
+
+void EventsJob::setSince(const QDateTime &since)
+{
+    Q_D(EventsJob);
+    if (d->since != since) {
+        qCDebug(schCore) << "Changing \"since\" from" << d->since << "to" << since;
+        d->since = since;
+        Q_EMIT sinceChanged(this->since());
+    }
+}
+
+QDateTime EventsJob::until() const
+{
+    Q_D(const EventsJob);
+    return d->until;
+}
+
+void EventsJob::setUntil(const QDateTime &until)
+{
+    Q_D(EventsJob);
+    if (d->until != until) {
+        qCDebug(schCore) << "Changing \"until\" from" << d->until << "to" << until;
+        d->until = until;
+        Q_EMIT untilChanged(this->until());
+    }
+}
+
+bool EventsJob::autoReconnect() const
+{
+    Q_D(const EventsJob);
+    return d->autoReconnect;
+}
+
+void EventsJob::setAutoReconnect(bool autoReconnect)
+{
+    Q_D(EventsJob);
+    if (d->autoReconnect != autoReconnect) {
+        qCDebug(schCore) << "Changing \"autoReconnect\" from" << d->autoReconnect << "to" << autoReconnect;
+        d->autoReconnect = autoReconnect;
+        Q_EMIT autoReconnectChanged(this->autoReconnect());
+    }
+}
+
+Filters EventsJob::filters() const
+{
+    Q_D(const EventsJob);
+    return d->filters;
+}
+
+void EventsJob::setFilters(const Filters &filters)
+{
+    Q_D(EventsJob);
+    if (d->filters != filters) {
+        qCDebug(schCore) << "Changing \"filters\" from" << d->filters.toJson() << "to" << filters.toJson();
+        d->filters = filters;
+        Q_EMIT filtersChanged(this->filters());
+    }
+}
+
+void EventsJob::addFilter(const QString &key, const QString &value)
+{
+    Q_D(EventsJob);
+    if (!d->filters.value(key).contains(value)) {
+        qCDebug(schCore) << "Adding filter" << key << "with value" << value;
+        d->filters.add(key, value);
+        Q_EMIT filtersChanged(this->filters());
+    }
+}
+
+qint64 EventsJob::lastEventTime() const
+{
+    Q_D(const EventsJob);
+    return d->lastEventTime;
+}
+
+#include "moc_eventsjob.cpp"
@@ -0,0 +1,301 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_EVENTSJOB_H
+#define SCHAUER_EVENTSJOB_H
+
+#include "schauer_exports.h"
+#include "job.h"
+#include "filters.h"
+#include <QDateTime>
+
+namespace Schauer {
+
+/*!
+ * \ingroup api-jobs-system
+ * \brief Event reported by the Docker daemon.
+ *
+ * \sa EventsJob
+ *
+ * \headerfile "" <Schauer/EventsJob>
+ */
+struct SCHAUER_LIBRARY Event
+{
+    /*!
+     * \brief The type of the object that emitted the event.
+     */
+    enum Type : qint8 {
+        Unknown = 0,    /**< The object type is not known. */
+        Container,      /**< The event has been emitted by a container. */
+        Image,          /**< The event has been emitted by an image. */
+        Volume,         /**< The event has been emitted by a volume. */
+        Network,        /**< The event has been emitted by a network. */
+        Daemon,         /**< The event has been emitted by the daemon. */
+        Plugin,         /**< The event has been emitted by a plugin. */
+        Node,           /**< The event has been emitted by a swarm node. */
+        Service,        /**< The event has been emitted by a swarm service. */
+        Secret,         /**< The event has been emitted by a swarm secret. */
+        Config          /**< The event has been emitted by a swarm config. */
+    };
+
+    /*!
+     * \brief The type of the object that emitted the event.
+     */
+    Type type = Unknown;
+
+    /*!
+     * \brief The type of event, like \c create, \c start or \c die.
+     */
+    QString action;
+
+    /*!
+     * \brief The ID of the object that emitted the event.
+     */
+    QString actorId;
+
+    /*!
+     * \brief Various key/value attributes of the object, depending on its type.
+     */
+    QMap<QString,QString> attributes;
+
+    /*!
+     * \brief Scope of the event. Engine events are \c local, cluster events are \c swarm.
+     */
+    QString scope;
+
+    /*!
+     * \brief Timestamp of the event in nanoseconds since the epoch.
+     */
+    qint64 timeNano = 0;
+
+    /*!
+     * \brief Returns the timestamp of the event as QDateTime.
+     */
+    QDateTime dateTime() const;
+
+    /*!
+     * \brief Returns the event type for the \a type string used by the Docker API.
+     */
+    static Type typeFromString(const QString &type);
+};
+
+class EventsJobPrivate;
+
+/*!
+ * \ingroup api-jobs-system
+ * \brief Subscribes to the real-time events of the Docker daemon.
+ *
+ * This job holds a long-lived connection to the Docker daemon and emits every reported
+ * event via eventReceived() as soon as it arrives. Without an \link EventsJob::until until\endlink
+ * time, the job runs until it is killed. If the connection is lost, the job reconnects
+ * automatically and resumes from the timestamp of the last received event, so no events
+ * get lost and no event will be emitted twice. Reconnection can be disabled with
+ * setAutoReconnect().
+ *
+ * Use setFilters() or addFilter() to let the daemon only send the events you are
+ * interested in.
+ *
+ * Have a look at the description of the Job class to learn how to use Job
+ * classes.
+ *
+ * \par Example
+ * \code{.cpp}
+ * auto job = new EventsJob();
+ * job->addFilter(QStringLiteral("type"), QStringLiteral("container"));
+ * connect(job, &EventsJob::eventReceived, this, [](const Schauer::Event &event){
+ *     qDebug() << event.action << event.actorId;
+ * });
+ * job->start();
+ * \endcode
+ *
+ * \par API route
+ * /events
+ *
+ * \par API method
+ * GET
+ *
+ * \dockerAPI{SystemEvents}
+ *
+ * \headerfile "" <Schauer/EventsJob>
+ */
+class SCHAUER_LIBRARY EventsJob : public Job
+{
+    Q_OBJECT
+    /*!
+     * \brief Show events created since this timestamp.
+     *
+     * By default this property holds an invalid QDateTime and only new events
+     * will be reported.
+     *
+     * \par Access functions
+     * \li QDateTime since() const
+     * \li void setSince(const QDateTime &since)
+     *
+     * \par Notifier signal
+     * \li void sinceChanged(const QDateTime &since)
+     */
+    Q_PROPERTY(QDateTime since READ since WRITE setSince NOTIFY sinceChanged)
+    /*!
+     * \brief Show events created until this timestamp, then stop streaming.
+     *
+     * By default this property holds an invalid QDateTime and the job will
+     * run until it is killed.
+     *
+     * \par Access functions
+     * \li QDateTime until() const
+     * \li void setUntil(const QDateTime &until)
+     *
+     * \par Notifier signal
+     * \li void untilChanged(const QDateTime &until)
+     */
+    Q_PROPERTY(QDateTime until READ until WRITE setUntil NOTIFY untilChanged)
+    /*!
+     * \brief This property holds whether to reconnect if the connection has been lost.
+     *
+     * The default value is \c true.
+     *
+     * \par Access functions
+     * \li bool autoReconnect() const
+     * \li void setAutoReconnect(bool autoReconnect)
+     *
+     * \par Notifier signal
+     * \li void autoReconnectChanged(bool autoReconnect)
+     */
+    Q_PROPERTY(bool autoReconnect READ autoReconnect WRITE setAutoReconnect NOTIFY autoReconnectChanged)
+    /*!
+     * \brief Filters applied to the events on the daemon side.
+     *
+     * Filter names are for example \c type, \c event, \c container or \c label.
+     * See the Docker API documentation for available filters. By default no filters are set.
+     *
+     * \par Access functions
+     * \li Filters filters() const
+     * \li void setFilters(const Filters &filters)
+     *
+     * \par Notifier signal
+     * \li void filtersChanged(const Filters &filters)
+     */
+    Q_PROPERTY(Schauer::Filters filters READ filters WRITE setFilters NOTIFY filtersChanged)
+public:
+    /*!
+     * \brief Constructs a new %EventsJob object with the given \a parent.
+     */
+    explicit EventsJob(QObject *parent = nullptr);
+
+    /*!
+     * \brief Destroys the %EventsJob object.
+     */
+    ~EventsJob() override;
+
+    /*!
+     * \brief Starts listening for events asynchronously.
+     *
+     * If an \link EventsJob::until until\endlink time is set, result() is emitted
+     * when all events until then have been received. Otherwise the job runs until
+     * it is killed or fails.
+     */
+    void start() override;
+
+    /*!
+     * \brief Getter function for the \link EventsJob::since since\endlink property.
+     * \sa setSince(), sinceChanged()
+     */
+    QDateTime since() const;
+
+    /*!
+     * \brief Setter function for the \link EventsJob::since since\endlink property.
+     * \sa since(), sinceChanged()
+     */
+    void setSince(const QDateTime &since);
+
+    /*!
+     * \brief Getter function for the \link EventsJob::until until\endlink property.
+     * \sa setUntil(), untilChanged()
+     */
+    QDateTime until() const;
+
+    /*!
+     * \brief Setter function for the \link EventsJob::until until\endlink property.
+     * \sa until(), untilChanged()
+     */
+    void setUntil(const QDateTime &until);
+
+    /*!
+     * \brief Getter function for the \link EventsJob::autoReconnect autoReconnect\endlink property.
+     * \sa setAutoReconnect(), autoReconnectChanged()
+     */
+    bool autoReconnect() const;
+
+    /*!
+     * \brief Setter function for the \link EventsJob::autoReconnect autoReconnect\endlink property.
+     * \sa autoReconnect(), autoReconnectChanged()
+     */
+    void setAutoReconnect(bool autoReconnect);
+
+    /*!
+     * \brief Getter function for the \link EventsJob::filters filters\endlink property.
+     * \sa setFilters(), filtersChanged()
+     */
+    Filters filters() const;
+
+    /*!
+     * \brief Setter function for the \link EventsJob::filters filters\endlink property.
+     * \sa filters(), filtersChanged()
+     */
+    void setFilters(const Filters &filters);
+
+    /*!
+     * \brief Adds a filter \a value for filter \a key to the \link EventsJob::filters filters\endlink property.
+     * \sa filters(), setFilters()
+     */
+    void addFilter(const QString &key, const QString &value);
+
+    /*!
+     * \brief Returns the timestamp of the last received event in nanoseconds since the epoch.
+     *
+     * Returns \c 0 if no event has been received yet.
+     */
+    qint64 lastEventTime() const;
+
+Q_SIGNALS:
+    /*!
+     * \brief Notifier signal for the \link EventsJob::since since\endlink property.
+     * \sa since(), setSince()
+     */
+    void sinceChanged(const QDateTime &since);
+
+    /*!
+     * \brief Notifier signal for the \link EventsJob::until until\endlink property.
+     * \sa until(), setUntil()
+     */
+    void untilChanged(const QDateTime &until);
+
+    /*!
+     * \brief Notifier signal for the \link EventsJob::autoReconnect autoReconnect\endlink property.
+     * \sa autoReconnect(), setAutoReconnect()
+     */
+    void autoReconnectChanged(bool autoReconnect);
+
+    /*!
+     * \brief Notifier signal for the \link EventsJob::filters filters\endlink property.
+     * \sa filters(), setFilters()
+     */
+    void filtersChanged(const Schauer::Filters &filters);
+
+    /*!
+     * \brief Emitted for every \a event reported by the Docker daemon.
+     */
+    void eventReceived(const Schauer::Event &event);
+
+private:
+    Q_DISABLE_COPY(EventsJob)
+    Q_DECLARE_PRIVATE_D(s_ptr, EventsJob)
+};
+
+}
+
+Q_DECLARE_METATYPE(Schauer::Event)
+
+#endif // SCHAUER_EVENTSJOB_H
@@ -0,0 +1,62 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_EVENTSJOB_P_H
+#define SCHAUER_EVENTSJOB_P_H
+
+#include "eventsjob.h"
+#include "job_p.h"
+#include <QVector>
+#include <tuple>
+
+namespace Schauer {
+
+class EventsJobPrivate : public JobPrivate
+{
+public:
+    using EventKey = std::tuple<Event::Type, QString, QString>;
+
+    explicit EventsJobPrivate(EventsJob *q);
+
+    ~EventsJobPrivate() override;
+
+    QString buildUrlPath() const override;
+
+    QUrlQuery buildUrlQuery() const override;
+
+    void emitDescription() override;
+
+    void processStreamData(const QByteArray &data) override;
+
+    bool prepareNextRequest() override;
+
+    bool prepareRetry() override;
+
+    void processLine(const QByteArray &line);
+
+    bool reconnect();
+
+    Filters filters;
+    // type, action and actor of the events received at lastEventTime
+    QVector<EventKey> lastEventKeys;
+    // events at lastEventTime the daemon will send again after reconnecting
+    QVector<EventKey> replayKeys;
+    QDateTime since;
+    QDateTime until;
+    QByteArray lineBuffer;
+    qint64 lastEventTime = 0;
+    qint64 resumeFrom = 0;
+    int reconnectDelay = 0;
+    bool autoReconnect = true;
+    bool replaying = false;
+
+private:
+    Q_DISABLE_COPY(EventsJobPrivate)
+    Q_DECLARE_PUBLIC(EventsJob)
+};
+
+}
+
+#endif // SCHAUER_EVENTSJOB_P_H
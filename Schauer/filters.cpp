@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "filters.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+using namespace Schauer;
+
+Filters::Filters() = default;
+
+Filters::Filters(const QMap<QString,QStringList> &filters)
+    : m_filters(filters)
+{
+
+}
+
+Filters &Filters::add(const QString &key, const QString &value)
+{
+    QStringList &values = m_filters[key];
+    if (!values.contains(value)) {
+        values.append(value);
+    }
+    return *this;
+}
+
+Filters &Filters::label(const QString &key, const QString &value)
+{
+    return add(QStringLiteral("label"), value.isEmpty() ? key : key + QLatin1Char('=') + value);
+}
+
+Filters &Filters::name(const QString &name)
+{
+    return add(QStringLiteral("name"), name);
+}
+
+Filters &Filters::id(const QString &id)
+{
+    return add(QStringLiteral("id"), id);
+}
+
+Filters &Filters::status(ContainerStatus status)
+{
+    return add(QStringLiteral("status"), statusToString(status));
+}
+
+Filters &Filters::ancestor(const QString &image)
+{
+    return add(QStringLiteral("ancestor"), image);
+}
+
+Filters &Filters::before(const QString &idOrName)
+{
+    return add(QStringLiteral("before"), idOrName);
+}
+
+Filters &Filters::since(const QString &idOrName)
+{
+    return add(QStringLiteral("since"), idOrName);
+}
+
+Filters &Filters::dangling(bool dangling)
+{
+    // only one value makes sense for this filter
+    m_filters.insert(QStringLiteral("dangling"), QStringList(dangling ? QStringLiteral("true") : QStringLiteral("false")));
+    return *this;
+}
+
+Filters &Filters::reference(const QString &reference)
+{
+    return add(QStringLiteral("reference"), reference);
+}
+
+void Filters::remove(const QString &key)
+{
+    m_filters.remove(key);
+}
+
+void Filters::clear()
+{
+    m_filters.clear();
+}
+
+bool Filters::isEmpty() const
+{
+    return m_filters.isEmpty();
+}
+
+QStringList Filters::value(const QString &key) const
+{
+    return m_filters.value(key);
+}
+
+QStringList Filters::keys() const
+{
+    return m_filters.keys();
+}
+
+QMap<QString,QStringList> Filters::toMap() const
+{
+    return m_filters;
+}
+
+QString Filters::toJson() const
+{
+    if (m_filters.isEmpty()) {
+        return QString();
+    }
+
+    QJsonObject fo;
+    auto i = m_filters.constBegin();
+    while (i != m_filters.constEnd()) {
+        fo.insert(i.key(), QJsonArray::fromStringList(i.value()));
+        ++i;
+    }
+    return QString::fromUtf8(QJsonDocument(fo).toJson(QJsonDocument::Compact));
+}
+
+QString Filters::statusToString(ContainerStatus status)
+{
+    switch (status) {
+    case Created:
+        return QStringLiteral("created");
+    case Restarting:
+        return QStringLiteral("restarting");
+    case Running:
+        return QStringLiteral("running");
+    case Removing:
+        return QStringLiteral("removing");
+    case Paused:
+        return QStringLiteral("paused");
+    case Exited:
+        return QStringLiteral("exited");
+    case Dead:
+        return QStringLiteral("dead");
+    }
+    return QString();
+}
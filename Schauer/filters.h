@@ -0,0 +1,195 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_FILTERS_H
+#define SCHAUER_FILTERS_H
+
+#include "schauer_exports.h"
+#include <QMap>
+#include <QMetaType>
+#include <QString>
+#include <QStringList>
+
+namespace Schauer {
+
+/*!
+ * \ingroup api-jobs
+ * \brief Builds the \c filters parameter used by list and event requests.
+ *
+ * The Docker daemon can filter the returned items itself, so only the items you are
+ * interested in have to be transferred and decoded. Every filter key can have multiple
+ * values. Items match if they match any value of a key and all keys.
+ *
+ * The typed functions cover the commonly used filters, add() can be used to add any
+ * other filter supported by the API route. See the Docker API documentation for the
+ * filters supported by the different routes.
+ *
+ * \par Example
+ * \code{.cpp}
+ * auto job = new ListContainersJob();
+ * job->setShowAll(true);
+ * job->setFilters(Filters().label(QStringLiteral("com.example.owner"), QStringLiteral("tests"))
+ *                          .status(Filters::Running)
+ *                          .status(Filters::Paused));
+ * \endcode
+ *
+ * \sa ListContainersJob::filters, ListImagesJob::filters, EventsJob::filters()
+ *
+ * \headerfile "" <Schauer/Filters>
+ */
+class SCHAUER_LIBRARY Filters
+{
+public:
+    /*!
+     * \brief Container states that can be used with status().
+     */
+    enum ContainerStatus : qint8 {
+        Created = 0,
+        Restarting,
+        Running,
+        Removing,
+        Paused,
+        Exited,
+        Dead
+    };
+
+    /*!
+     * \brief Constructs an empty %Filters object.
+     */
+    Filters();
+
+    /*!
+     * \brief Constructs a new %Filters object from a map of \a filters.
+     *
+     * The keys are the filter names, the values the allowed values for that filter.
+     */
+    Filters(const QMap<QString,QStringList> &filters);
+
+    /*!
+     * \brief Adds the \a value for the filter \a key.
+     *
+     * Adding the same value twice has no effect.
+     */
+    Filters &add(const QString &key, const QString &value);
+
+    /*!
+     * \brief Only matches items having a label with the given \a key.
+     *
+     * If \a value is not empty, the label must also have that value.
+     */
+    Filters &label(const QString &key, const QString &value = QString());
+
+    /*!
+     * \brief Only matches containers whose name contains \a name.
+     */
+    Filters &name(const QString &name);
+
+    /*!
+     * \brief Only matches containers whose ID starts with \a id.
+     */
+    Filters &id(const QString &id);
+
+    /*!
+     * \brief Only matches containers with the given \a status.
+     */
+    Filters &status(ContainerStatus status);
+
+    /*!
+     * \brief Only matches containers created from the \a image or a descendant of it.
+     *
+     * \a image can be an image name, an image ID or an image digest.
+     */
+    Filters &ancestor(const QString &image);
+
+    /*!
+     * \brief Only matches items created before the container or image \a idOrName.
+     */
+    Filters &before(const QString &idOrName);
+
+    /*!
+     * \brief Only matches items created after the container or image \a idOrName.
+     */
+    Filters &since(const QString &idOrName);
+
+    /*!
+     * \brief Only matches images that are \a dangling or not.
+     */
+    Filters &dangling(bool dangling);
+
+    /*!
+     * \brief Only matches images whose name matches the \a reference pattern, like \c nginx:*.
+     */
+    Filters &reference(const QString &reference);
+
+    /*!
+     * \brief Removes all values of the filter \a key.
+     */
+    void remove(const QString &key);
+
+    /*!
+     * \brief Removes all filters.
+     */
+    void clear();
+
+    /*!
+     * \brief Returns \c true if no filter has been added.
+     */
+    bool isEmpty() const;
+
+    /*!
+     * \brief Returns \c true if no filter has been added.
+     *
+     * This function is provided for STL compatibility. It is equivalent to isEmpty().
+     */
+    bool empty() const { return isEmpty(); }
+
+    /*!
+     * \brief Returns the values of the filter \a key.
+     *
+     * Returns an empty list if the filter has not been added.
+     */
+    QStringList value(const QString &key) const;
+
+    /*!
+     * \brief Returns the names of all used filters.
+     */
+    QStringList keys() const;
+
+    /*!
+     * \brief Returns the filters as map of filter names and values.
+     */
+    QMap<QString,QStringList> toMap() const;
+
+    /*!
+     * \brief Returns the compact JSON representation used as query parameter.
+     *
+     * Returns an empty string if no filter has been added.
+     */
+    QString toJson() const;
+
+    /*!
+     * \brief Returns the string used by the Docker API for the container \a status.
+     */
+    static QString statusToString(ContainerStatus status);
+
+    /*!
+     * \brief Returns \c true if \a other contains the same filters.
+     */
+    bool operator==(const Filters &other) const { return m_filters == other.m_filters; }
+
+    /*!
+     * \brief Returns \c true if \a other contains different filters.
+     */
+    bool operator!=(const Filters &other) const { return m_filters != other.m_filters; }
+
+private:
+    QMap<QString,QStringList> m_filters;
+};
+
+}
+
+Q_DECLARE_METATYPE(Schauer::Filters)
+
+#endif // SCHAUER_FILTERS_H
@@ -5,6 +5,8 @@
 
 #include "getversionjob_p.h"
 #include <QTimer>
+#include <QJsonObject>
+#include <QJsonArray>
 
 using namespace Schauer;
 
@@ -14,6 +16,7 @@ GetVersionJobPrivate::GetVersionJobPrivate(GetVersionJob *q)
     namOperation = NetworkOperation::Get;
     expectedContentType = ExpectedContentType::JsonObject;
     requiresAuth = false;
+    coalesceRequests = true;
 }
 
 GetVersionJobPrivate::~GetVersionJobPrivate() = default;
@@ -35,6 +38,45 @@ void GetVersionJobPrivate::emitDescription()
     Q_EMIT q->description(q, _title);
 }
 
+VersionInfo GetVersionJobPrivate::versionFromJson(const QJsonObject &o)
+{
+    VersionInfo info;
+    info.platformName = o.value(QStringLiteral("Platform")).toObject().value(QStringLiteral("Name")).toString();
+    info.version = o.value(QStringLiteral("Version")).toString();
+    info.apiVersion = o.value(QStringLiteral("ApiVersion")).toString();
+    info.minApiVersion = o.value(QStringLiteral("MinAPIVersion")).toString();
+    info.gitCommit = o.value(QStringLiteral("GitCommit")).toString();
+    info.goVersion = o.value(QStringLiteral("GoVersion")).toString();
+    info.os = o.value(QStringLiteral("Os")).toString();
+    info.arch = o.value(QStringLiteral("Arch")).toString();
+    info.kernelVersion = o.value(QStringLiteral("KernelVersion")).toString();
+    info.buildTime = QDateTime::fromString(o.value(QStringLiteral("BuildTime")).toString(), Qt::ISODateWithMs);
+
+    const QJsonArray comps = o.value(QStringLiteral("Components")).toArray();
+    info.components.reserve(comps.size());
+    for (const QJsonValue &v : comps) {
+        const QJsonObject co = v.toObject();
+        const QJsonObject d = co.value(QStringLiteral("Details")).toObject();
+        VersionComponent c;
+        c.name = co.value(QStringLiteral("Name")).toString();
+        c.version = co.value(QStringLiteral("Version")).toString();
+        c.apiVersion = d.value(QStringLiteral("ApiVersion")).toString();
+        c.minApiVersion = d.value(QStringLiteral("MinAPIVersion")).toString();
+        c.gitCommit = d.value(QStringLiteral("GitCommit")).toString();
+        c.goVersion = d.value(QStringLiteral("GoVersion")).toString();
+        c.os = d.value(QStringLiteral("Os")).toString();
+        c.arch = d.value(QStringLiteral("Arch")).toString();
+        c.kernelVersion = d.value(QStringLiteral("KernelVersion")).toString();
+        if (d.contains(QStringLiteral("BuildTime"))) {
+            c.buildTime = QDateTime::fromString(d.value(QStringLiteral("BuildTime")).toString(), Qt::ISODateWithMs);
+        }
+        c.experimental = d.value(QStringLiteral("Experimental")).toBool();
+        info.components.push_back(c);
+    }
+
+    return info;
+}
+
 GetVersionJob::GetVersionJob(QObject *parent)
     : Job(* new GetVersionJobPrivate(this), parent)
 {
@@ -45,7 +87,20 @@ GetVersionJob::~GetVersionJob() = default;
 
 void GetVersionJob::start()
 {
+    Q_D(GetVersionJob);
+    d->versionInfo = VersionInfo();
+    d->versionInfoDecoded = false;
     QTimer::singleShot(0, this, &GetVersionJob::sendRequest);
 }
 
+VersionInfo GetVersionJob::versionInfo() const
+{
+    Q_D(const GetVersionJob);
+    if (!d->versionInfoDecoded && d->json().isObject()) {
+        d->versionInfo = GetVersionJobPrivate::versionFromJson(d->json().object());
+        d->versionInfoDecoded = true;
+    }
+    return d->versionInfo;
+}
+
 #include "moc_getversionjob.cpp"
@@ -8,6 +8,8 @@
 
 #include "schauer_exports.h"
 #include "job.h"
+#include <QDateTime>
+#include <QVector>
 
 namespace Schauer {
 
@@ -17,6 +19,138 @@ namespace Schauer {
  * \brief Job classes to get Docker system information
  */
 
+/*!
+ * \ingroup api-jobs-system
+ * \brief Version information of a component of the Docker daemon, like the engine or containerd.
+ *
+ * \sa VersionInfo
+ *
+ * \headerfile "" <Schauer/GetVersionJob>
+ */
+struct VersionComponent
+{
+    /*!
+     * \brief Name of the component.
+     */
+    QString name;
+
+    /*!
+     * \brief Version of the component.
+     */
+    QString version;
+
+    /*!
+     * \brief API version of the component, if any.
+     */
+    QString apiVersion;
+
+    /*!
+     * \brief Minimum supported API version of the component, if any.
+     */
+    QString minApiVersion;
+
+    /*!
+     * \brief Git commit the component has been built from.
+     */
+    QString gitCommit;
+
+    /*!
+     * \brief Go version used to build the component, if any.
+     */
+    QString goVersion;
+
+    /*!
+     * \brief Operating system the component is running on, if any.
+     */
+    QString os;
+
+    /*!
+     * \brief CPU architecture the component is running on, if any.
+     */
+    QString arch;
+
+    /*!
+     * \brief Kernel version the component is running on, if any.
+     */
+    QString kernelVersion;
+
+    /*!
+     * \brief Build time of the component, invalid if not reported.
+     */
+    QDateTime buildTime;
+
+    /*!
+     * \brief \c true if experimental features are enabled.
+     */
+    bool experimental = false;
+};
+
+/*!
+ * \ingroup api-jobs-system
+ * \brief Version information reported by the Docker daemon.
+ *
+ * \sa GetVersionJob::versionInfo()
+ *
+ * \headerfile "" <Schauer/GetVersionJob>
+ */
+struct VersionInfo
+{
+    /*!
+     * \brief Name of the platform, like <i>Docker Engine - Community</i>.
+     */
+    QString platformName;
+
+    /*!
+     * \brief Version of the daemon.
+     */
+    QString version;
+
+    /*!
+     * \brief Default API version of the daemon.
+     */
+    QString apiVersion;
+
+    /*!
+     * \brief Minimum API version supported by the daemon.
+     */
+    QString minApiVersion;
+
+    /*!
+     * \brief Git commit the daemon has been built from.
+     */
+    QString gitCommit;
+
+    /*!
+     * \brief Go version used to build the daemon.
+     */
+    QString goVersion;
+
+    /*!
+     * \brief Operating system the daemon is running on.
+     */
+    QString os;
+
+    /*!
+     * \brief CPU architecture the daemon is running on.
+     */
+    QString arch;
+
+    /*!
+     * \brief Kernel version the daemon is running on.
+     */
+    QString kernelVersion;
+
+    /*!
+     * \brief Build time of the daemon.
+     */
+    QDateTime buildTime;
+
+    /*!
+     * \brief Versions of the components of the daemon.
+     */
+    QVector<VersionComponent> components;
+};
+
 class GetVersionJobPrivate;
 
 /*!
@@ -61,6 +195,15 @@ public:
      */
     void start() override;
 
+    /*!
+     * \brief Returns the version information reported by the daemon.
+     *
+     * The reply is decoded on the first call after the job has been finished
+     * successfully, later calls return the decoded information directly.
+     * Returns a default constructed object as long as there is no reply.
+     */
+    VersionInfo versionInfo() const;
+
 private:
     Q_DECLARE_PRIVATE_D(s_ptr, GetVersionJob)
     Q_DISABLE_COPY(GetVersionJob)
@@ -68,4 +211,7 @@ private:
 
 }
 
+Q_DECLARE_METATYPE(Schauer::VersionComponent)
+Q_DECLARE_METATYPE(Schauer::VersionInfo)
+
 #endif // SCHAUER_GETVERSIONJOB_H
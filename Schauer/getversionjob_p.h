@@ -21,6 +21,11 @@ public:
 
     void emitDescription() override;
 
+    static VersionInfo versionFromJson(const QJsonObject &o);
+
+    mutable VersionInfo versionInfo;
+    mutable bool versionInfoDecoded = false;
+
 private:
     Q_DISABLE_COPY(GetVersionJobPrivate)
     Q_DECLARE_PUBLIC(GetVersionJob)
@@ -16,6 +16,32 @@ ImageListModelPrivate::ImageListModelPrivate(ImageListModel *q)
 
 ImageListModelPrivate::~ImageListModelPrivate() = default;
 
+QVector<int> ImageListModelPrivate::rolesForColumns(quint32 columns) const
+{
+    // the column bits are in the same order as the roles
+    QVector<int> roles;
+    for (int bit = 0; columns != 0; ++bit, columns >>= 1) {
+        if (columns & 1) {
+            roles.push_back(ImageListModel::IdRole + bit);
+        }
+    }
+    return roles;
+}
+
+quint32 ImageListModelPrivate::columnsForRoles(const QVector<int> &roles) const
+{
+    if (roles.empty()) {
+        return AllColumns;
+    }
+    quint32 columns = 0;
+    for (int role : roles) {
+        if (role >= ImageListModel::IdRole && role <= ImageListModel::ContainersRole) {
+            columns |= 1u << (role - ImageListModel::IdRole);
+        }
+    }
+    return columns;
+}
+
 ImageListModel::ImageListModel(QObject *parent)
     : AbstractImageModel(* new ImageListModelPrivate(this), parent)
 {
@@ -90,29 +116,30 @@ QVariant ImageListModel::data(const QModelIndex &index, int role) const
 
     Q_D(const ImageListModel);
 
-    const ImageModelItem i = d->images.at(index.row());
+    const auto row = static_cast<std::size_t>(index.row());
+    const ImageColumns &i = d->images;
 
     switch (role) {
     case IdRole:
-        return QVariant::fromValue(i.id);
+        return QVariant::fromValue(i.ids[row]);
     case ParentIdRole:
-        return QVariant::fromValue(i.parentId);
+        return QVariant::fromValue(i.parentIds[row]);
     case RepoTagsRole:
-        return QVariant::fromValue(i.repoTags);
+        return QVariant::fromValue(i.repoTags[row]);
     case RepoDigestsRole:
-        return QVariant::fromValue(i.repoDigests);
+        return QVariant::fromValue(i.repoDigests[row]);
     case CreatedRole:
-        return QVariant::fromValue(i.created);
+        return QVariant::fromValue(QDateTime::fromSecsSinceEpoch(i.created[row], Qt::UTC));
     case SizeRole:
-        return QVariant::fromValue(i.size);
+        return QVariant::fromValue(i.size[row]);
     case VirtualSizeRole:
-        return QVariant::fromValue(i.virtualSize);
+        return QVariant::fromValue(i.virtualSize[row]);
     case SharedSizeRole:
-        return QVariant::fromValue(i.sharedSize);
+        return QVariant::fromValue(i.sharedSize[row]);
     case LabelsRole:
-        return QVariant::fromValue(i.labels);
+        return QVariant::fromValue(i.labelSets.at(i.labels[row]));
     case ContainersRole:
-        return QVariant::fromValue(i.containers);
+        return QVariant::fromValue(i.containers[row]);
     default:
         return QVariant();
     }
@@ -18,6 +18,10 @@ public:
 
     ~ImageListModelPrivate() override;
 
+    QVector<int> rolesForColumns(quint32 columns) const override;
+
+    quint32 columnsForRoles(const QVector<int> &roles) const override;
+
 private:
     Q_DISABLE_COPY(ImageListModelPrivate)
     Q_DECLARE_PUBLIC(ImageListModel)
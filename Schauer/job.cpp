@@ -5,27 +5,92 @@
 
 #include "job_p.h"
 #include "logging.h"
-#include "abstractnamfactory.h"
 #include "global.h"
+#include "connectionpool.h"
+#include "responsecache.h"
+#include "filters.h"
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QJsonParseError>
 #include <QJsonObject>
 #include <QJsonValue>
-#if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
+#include <QMetaMethod>
+#include <QHash>
+#include <QThreadStorage>
 #include <QTimer>
-#endif
 
 using namespace Schauer;
 
+namespace {
+// identical GET requests currently in flight in this thread and the jobs sending them
+QThreadStorage<QHash<QString,Job*>> inFlightRequests;
+
+inline bool isJsonWhitespace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+/*!
+ * \internal
+ * Only looks at the first and the last non-whitespace character of \a data to find out
+ * if it is a complete JSON array or object and if it has any content. The content itself
+ * is validated when it is parsed.
+ */
+JsonShape scanJsonShape(const QByteArray &data)
+{
+    const char *begin = data.constData();
+    const char *end = begin + data.size();
+
+    while (begin != end && isJsonWhitespace(*begin)) {
+        ++begin;
+    }
+    while (end != begin && isJsonWhitespace(*(end - 1))) {
+        --end;
+    }
+
+    if (begin == end) {
+        return JsonShape::Blank;
+    }
+
+    if (end - begin >= 2) {
+        const char first = *begin;
+        const char last = *(end - 1);
+        if ((first == '[' && last == ']') || (first == '{' && last == '}')) {
+            const char *inner = begin + 1;
+            while (inner != end - 1 && isJsonWhitespace(*inner)) {
+                ++inner;
+            }
+            if (inner == end - 1) {
+                return JsonShape::Blank;
+            }
+            return first == '[' ? JsonShape::Array : JsonShape::Object;
+        }
+    }
+
+    return JsonShape::Invalid;
+}
+}
+
 JobPrivate::JobPrivate(Job *q)
     : q_ptr(q)
 {
-
+    arraySplitter.setCallback([this](const QByteArray &element){
+        decodeArrayElement(element);
+    });
 }
 
-JobPrivate::~JobPrivate() = default;
+JobPrivate::~JobPrivate()
+{
+    abandonCoalescedRequest();
+
+    if (reply) {
+        // give the connection back to the pool if the job is destroyed while the request is in flight
+        QObject::disconnect(reply, nullptr, q_ptr, nullptr);
+        reply->abort();
+        reply->deleteLater();
+    }
+}
 
 void JobPrivate::handleSsslErrors(QNetworkReply *reply, const QList<QSslError> &errors)
 {
@@ -59,6 +124,8 @@ void JobPrivate::requestTimedOut()
     reply = nullptr;
     delete nr;
 
+    abandonCoalescedRequest();
+
     q->setError(RequestTimedOut);
     q->setErrorText(QString::number(requestTimeout));
     q->emitResult();
@@ -73,11 +140,15 @@ void JobPrivate::requestFinished()
     //% "Checking reply"
     Q_EMIT q->infoMessage(q, qtTrId("libschauer-info-msg-req-checking"));
     qCDebug(schCore) << "Request finished, checking reply.";
-    qCDebug(schCore) << "HTTP status code:" << reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    qCDebug(schCore) << "HTTP status code:" << statusCode;
 
     const QByteArray replyData = reply->readAll();
+    const QNetworkReply::NetworkError networkError = reply->error();
+    const QString networkErrorString = reply->errorString();
 
-    qCDebug(schCore) << "Reply data:" << replyData;
+    reply->deleteLater();
+    reply = nullptr;
 
 #if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
     if (Q_LIKELY(timeoutTimer && timeoutTimer->isActive())) {
@@ -86,28 +157,324 @@ void JobPrivate::requestFinished()
     }
 #endif
 
-    if (Q_LIKELY(reply->error() == QNetworkReply::NoError)) {
+    QVector<QPointer<Job>> waiting;
+    QByteArray sharedData;
+    if (!coalesceKey.isEmpty()) {
+        waiting = takeFollowers();
+        if (!waiting.empty()) {
+            // jobs that joined later need the complete reply, not only the rest that has not been read yet
+            sharedData = coalescedData.isEmpty() ? replyData : coalescedData + replyData;
+        }
+        coalescedData.clear();
+    }
+
+    const int status = statusCode;
+
+    handleReply(networkError, networkErrorString, replyData);
+
+    for (const QPointer<Job> &follower : qAsConst(waiting)) {
+        if (!follower) {
+            continue;
+        }
+        JobPrivate *fd = follower->d_func();
+        if (fd->leader != q) {
+            continue;
+        }
+        qCDebug(schCore) << "Completing job" << follower.data() << "with the reply of the identical request of job" << q;
+        fd->leader.clear();
+        fd->coalesceKey.clear();
+        fd->statusCode = status;
+        fd->resetIncrementalParsing();
+        fd->handleReply(networkError, networkErrorString, sharedData);
+    }
+}
+
+void JobPrivate::handleReply(QNetworkReply::NetworkError networkError, const QString &networkErrorString, const QByteArray &replyData)
+{
+    Q_Q(Job);
+
+    qCDebug(schCore) << "Reply data:" << replyData;
+
+    if (Q_LIKELY(networkError == QNetworkReply::NoError)) {
+        if (!replyData.isEmpty()) {
+            if (expectedContentType == ExpectedContentType::Stream) {
+                processStreamData(replyData);
+            } else if (incrementalActive) {
+                feedIncremental(replyData);
+            }
+        }
         if (Q_LIKELY(checkOutput(replyData))) {
-            Q_EMIT q->succeeded(jsonResult);
+            if (!invalidatesEndpoint.isEmpty()) {
+                ResponseCache::invalidate(configuration, invalidatesEndpoint);
+            }
+            if (prepareNextRequest()) {
+                // jobs performing multiple requests continue on the same connection if possible
+                scheduleNextRequest();
+                return;
+            }
+            // replies that have not been parsed are cached as they are, so that neither
+            // this job nor a model owning it has to build a document for the cache
+            if (cacheTimeToLive > 0) {
+                if (rawReply.isEmpty()) {
+                    ResponseCache::insert(configuration, cacheEndpoint, cacheTarget, json(), QByteArray(), cacheTimeToLive, cacheGeneration);
+                } else {
+                    ResponseCache::insert(configuration, cacheEndpoint, cacheTarget, QJsonDocument(), rawReply, cacheTimeToLive, cacheGeneration);
+                }
+            }
+            emitSucceeded();
         } else {
             qCDebug(schCore) << "Error code:" << q->error();
             Q_EMIT q->failed(q->error(), q->errorString());
         }
     } else {
-        extractError(replyData);
+        if (q->error() == SJob::NoError && statusCode < 300 && prepareRetry()) {
+            // the connection failed, not the API request itself
+            qCWarning(schCore) << "Network error:" << networkErrorString << "- trying again";
+            scheduleNextRequest();
+            return;
+        }
+
+        if (statusCode == 0 && q->error() == SJob::NoError) {
+            // the request did not even get a HTTP reply, like when the socket is not available
+            q->setError(NetworkError);
+            q->setErrorText(networkErrorString);
+            qCCritical(schCore) << "Network error:" << networkErrorString;
+        } else {
+            extractError(replyData);
+        }
         if (Q_UNLIKELY(q->error() == SJob::NoError)) {
-            Q_EMIT q->succeeded(jsonResult);
+            emitSucceeded();
         } else {
             Q_EMIT q->failed(q->error(), q->errorString());
         }
     }
 
-    reply->deleteLater();
-    reply = nullptr;
+    q->emitResult();
+}
+
+void JobPrivate::finishFromCache(const QJsonDocument &cached, const QByteArray &cachedRaw)
+{
+    Q_Q(Job);
+
+    statusCode = 200;
+    if (cachedRaw.isEmpty()) {
+        rawReply.clear();
+        jsonResult = cached;
+        jsonErrorString.clear();
+        jsonParsed = true;
+    } else {
+        setRawReply(cachedRaw);
+    }
+
+    if (parseIncrementally && !keepRawReply && json().isArray()) {
+        const QJsonArray array = json().array();
+        for (const QJsonValue &value : array) {
+            if (value.isObject()) {
+                Q_EMIT q->itemReceived(value.toObject());
+            }
+        }
+    }
 
+    emitSucceeded();
     q->emitResult();
 }
 
+void JobPrivate::emitSucceeded()
+{
+    Q_Q(Job);
+
+    // only parse the reply if somebody is interested in the document
+    if (q->isSignalConnected(QMetaMethod::fromSignal(&Job::succeeded))) {
+        Q_EMIT q->succeeded(json());
+    } else {
+        Q_EMIT q->succeeded(QJsonDocument());
+    }
+}
+
+QString JobPrivate::coalescingKey(const QNetworkRequest &request) const
+{
+    if (!coalesceRequests || namOperation != NetworkOperation::Get || expectedContentType == ExpectedContentType::Stream) {
+        return QString();
+    }
+
+    QString key = ConnectionPool::keyFor(configuration) + QLatin1Char(' ') + request.url().toString(QUrl::FullyEncoded);
+    const auto rhl = request.rawHeaderList();
+    for (const QByteArray &h : rhl) {
+        key += QLatin1Char('\n') + QString::fromLatin1(h) + QLatin1Char(':') + QString::fromLatin1(request.rawHeader(h));
+    }
+    return key;
+}
+
+bool JobPrivate::joinInFlightRequest(const QString &key)
+{
+    Q_Q(Job);
+
+    QHash<QString,Job*> &inFlight = inFlightRequests.localData();
+    Job *current = inFlight.value(key);
+
+    if (current && current != q) {
+        if (current->d_func()->replyConsumed) {
+            // the reply is only buffered for followers that joined before it arrived
+            qCDebug(schCore) << "Identical request of job" << current << "is already receiving its reply, sending own request";
+            return false;
+        }
+        qCDebug(schCore) << "Identical request of job" << current << "is in flight, waiting for its reply";
+        coalesceKey = key;
+        leader = current;
+        current->d_func()->followers.append(q);
+        return true;
+    }
+
+    coalesceKey = key;
+    inFlight.insert(key, q);
+    return false;
+}
+
+QVector<QPointer<Job>> JobPrivate::takeFollowers()
+{
+    Q_Q(Job);
+
+    QHash<QString,Job*> &inFlight = inFlightRequests.localData();
+    auto it = inFlight.find(coalesceKey);
+    if (it != inFlight.end() && it.value() == q) {
+        inFlight.erase(it);
+    }
+    coalesceKey.clear();
+
+    QVector<QPointer<Job>> waiting;
+    waiting.swap(followers);
+    return waiting;
+}
+
+void JobPrivate::abandonCoalescedRequest()
+{
+    if (coalesceKey.isEmpty()) {
+        return;
+    }
+
+    Q_Q(Job);
+
+    if (leader) {
+        // this job only waited for another job, the request itself keeps running
+        leader->d_func()->followers.removeAll(q);
+        leader.clear();
+        coalesceKey.clear();
+        return;
+    }
+
+    coalescedData.clear();
+    const QVector<QPointer<Job>> waiting = takeFollowers();
+    for (const QPointer<Job> &follower : waiting) {
+        if (follower && follower->d_func()->leader == q) {
+            qCDebug(schCore) << "Job" << follower.data() << "sends its request itself as job" << q << "stopped sending the identical request";
+            JobPrivate *fd = follower->d_func();
+            fd->leader.clear();
+            fd->coalesceKey.clear();
+            follower->sendRequest();
+        }
+    }
+}
+
+void JobPrivate::replyReadyRead()
+{
+    // error replies contain a JSON message that will be read when the request has been finished
+    if (reply->error() != QNetworkReply::NoError || reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() >= 300) {
+        return;
+    }
+
+#if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
+    // streams might take longer than the request timeout, so only time out if nothing arrives
+    if (timeoutTimer && timeoutTimer->isActive()) {
+        timeoutTimer->start(static_cast<int>(requestTimeout) * 1000);
+    }
+#endif
+
+    const QByteArray data = reply->readAll();
+    if (!data.isEmpty()) {
+        replyConsumed = true;
+        // jobs waiting for this reply need the complete data, not only the rest that will be read later
+        if (!followers.empty()) {
+            coalescedData.append(data);
+        }
+        if (expectedContentType == ExpectedContentType::Stream) {
+            processStreamData(data);
+        } else {
+            feedIncremental(data);
+        }
+    }
+}
+
+void JobPrivate::resetIncrementalParsing()
+{
+    arraySplitter.reset();
+    incrementalResult = QJsonArray();
+    incrementalFallbackData.clear();
+    incrementalErrorString.clear();
+    incrementalActive = parseIncrementally && !keepRawReply && expectedContentType == ExpectedContentType::JsonArray;
+    incrementalFallback = false;
+    incrementalFailed = false;
+}
+
+void JobPrivate::feedIncremental(const QByteArray &data)
+{
+    if (incrementalFallback) {
+        incrementalFallbackData.append(data);
+        return;
+    }
+
+    const bool started = arraySplitter.state() != JsonArraySplitter::Start;
+    if (!arraySplitter.feed(data)) {
+        if (!started) {
+            // not an array at all, let checkOutput() decide what it is
+            incrementalFallback = true;
+            incrementalFallbackData = data;
+        } else if (!incrementalFailed) {
+            incrementalFailed = true;
+            //: Error message
+            //% "Unexpected data after the end of the JSON array."
+            incrementalErrorString = qtTrId("libschauer-error-json-trailing-data");
+        }
+    }
+}
+
+void JobPrivate::decodeArrayElement(const QByteArray &element)
+{
+    if (incrementalFailed) {
+        return;
+    }
+
+    QJsonParseError jsonError;
+    QJsonValue value;
+
+    int first = 0;
+    while (first < element.size() && (element.at(first) == ' ' || element.at(first) == '\n' || element.at(first) == '\r' || element.at(first) == '\t')) {
+        ++first;
+    }
+
+    if (first < element.size() && element.at(first) == '{') {
+        const QJsonDocument doc = QJsonDocument::fromJson(element, &jsonError);
+        value = doc.object();
+    } else {
+        // scalar values can not be parsed standalone by all Qt versions
+        const QJsonDocument doc = QJsonDocument::fromJson('[' + element + ']', &jsonError);
+        value = doc.array().first();
+    }
+
+    if (Q_UNLIKELY(jsonError.error != QJsonParseError::NoError)) {
+        incrementalFailed = true;
+        incrementalErrorString = jsonError.errorString();
+        qCCritical(schCore) << "Invalid JSON data in array element" << incrementalResult.size() << "at offset" << jsonError.offset << ":" << jsonError.errorString();
+        return;
+    }
+
+    incrementalResult.append(value);
+
+    if (value.isObject()) {
+        Q_Q(Job);
+        Q_EMIT q->itemReceived(value.toObject());
+    }
+}
+
 void JobPrivate::extractError(const QByteArray &data)
 {
     Q_Q(Job);
@@ -116,7 +483,10 @@ void JobPrivate::extractError(const QByteArray &data)
         q->setError(APIError);
 
         QJsonParseError jsonError;
+        rawReply = data;
         jsonResult = QJsonDocument::fromJson(data, &jsonError);
+        jsonErrorString.clear();
+        jsonParsed = true;
 
         if (jsonError.error != QJsonParseError::NoError) {
             //: Error message
@@ -167,6 +537,18 @@ QUrlQuery JobPrivate::buildUrlQuery() const
     return query;
 }
 
+void JobPrivate::addFiltersQueryItem(QUrlQuery &query, const Filters &filters)
+{
+    if (filters.isEmpty()) {
+        return;
+    }
+
+    // QUrlQuery keeps a literal "+", that the daemon would decode as space
+    QString json = filters.toJson();
+    json.replace(QLatin1Char('+'), QLatin1String("%2B"));
+    query.addQueryItem(QStringLiteral("filters"), json);
+}
+
 QMap<QByteArray,QByteArray> JobPrivate::buildRequestHeaders() const
 {
     QMap<QByteArray,QByteArray> headers;
@@ -178,9 +560,47 @@ std::pair<QByteArray,QByteArray> JobPrivate::buildPayload() const
     return std::make_pair(QByteArray(), QByteArray());
 }
 
+void JobPrivate::processStreamData(const QByteArray &data)
+{
+    Q_UNUSED(data)
+}
+
+bool JobPrivate::prepareNextRequest()
+{
+    return false;
+}
+
+bool JobPrivate::prepareRetry()
+{
+    return false;
+}
+
+bool JobPrivate::isLongLived() const
+{
+    // streams and blocking waits disable the timeout as they run until the daemon closes them
+    return requestTimeout == 0;
+}
+
+void JobPrivate::scheduleNextRequest()
+{
+    Q_Q(Job);
+
+    if (nextRequestDelay > 0) {
+        if (!nextRequestTimer) {
+            nextRequestTimer = new QTimer(q);
+            nextRequestTimer->setSingleShot(true);
+            QObject::connect(nextRequestTimer, &QTimer::timeout, q, &Job::sendRequest);
+        }
+        nextRequestTimer->start(nextRequestDelay);
+        nextRequestDelay = 0;
+    } else {
+        q->sendRequest();
+    }
+}
+
 bool JobPrivate::checkInput()
 {
-    if (Q_UNLIKELY(configuration->host().isEmpty())) {
+    if (Q_UNLIKELY(configuration->socketPath().isEmpty() && configuration->host().isEmpty())) {
         emitError(MissingHost);
         qCCritical(schCore) << "Can not send request: missing host.";
         return false;
@@ -193,41 +613,123 @@ bool JobPrivate::checkOutput(const QByteArray &data)
 {
     Q_Q(Job);
 
-    if (expectedContentType != ExpectedContentType::Empty && data.isEmpty()) {
-        q->setError(EmptyReply);
-        qCCritical(schCore) << "Invalid reply: content expected, but reply is empty.";
-        return false;
+    if (expectedContentType == ExpectedContentType::Stream) {
+        return true;
     }
 
-    if (expectedContentType == ExpectedContentType::JsonArray || expectedContentType == ExpectedContentType::JsonObject) {
-        QJsonParseError jsonError;
-        jsonResult = QJsonDocument::fromJson(data, &jsonError);
-        if (jsonError.error != QJsonParseError::NoError) {
+    JsonShape shape = JsonShape::Blank;
+
+    if (incrementalActive && !incrementalFallback) {
+        if (arraySplitter.state() == JsonArraySplitter::Start) {
+            q->setError(EmptyReply);
+            qCCritical(schCore) << "Invalid reply: content expected, but reply is empty.";
+            return false;
+        }
+
+        if (incrementalFailed || arraySplitter.state() != JsonArraySplitter::Finished) {
             q->setError(JsonParseError);
-            q->setErrorText(jsonError.errorString());
-            qCCritical(schCore) << "Invalid JSON data in reply at offset" << jsonError.offset << ":" << jsonError.errorString();
+            if (incrementalErrorString.isEmpty()) {
+                //: Error message
+                //% "The JSON array is incomplete."
+                incrementalErrorString = qtTrId("libschauer-error-json-incomplete-array");
+            }
+            q->setErrorText(incrementalErrorString);
+            qCCritical(schCore) << "Invalid JSON data in reply:" << incrementalErrorString;
             return false;
         }
+
+        // the elements have already been parsed while the reply has been received,
+        // the raw data is not kept in addition to them, see Job::rawReplyData()
+        shape = incrementalResult.isEmpty() ? JsonShape::Blank : JsonShape::Array;
+        rawReply.clear();
+        jsonResult = QJsonDocument(incrementalResult);
+        jsonErrorString.clear();
+        jsonParsed = true;
+        incrementalResult = QJsonArray();
+    } else {
+        const QByteArray &input = incrementalFallback ? incrementalFallbackData : data;
+
+        if (expectedContentType != ExpectedContentType::Empty && input.isEmpty()) {
+            q->setError(EmptyReply);
+            qCCritical(schCore) << "Invalid reply: content expected, but reply is empty.";
+            return false;
+        }
+
+        if (expectedContentType == ExpectedContentType::JsonArray || expectedContentType == ExpectedContentType::JsonObject) {
+            setRawReply(input);
+            shape = scanJsonShape(input);
+        }
+    }
+
+    if (expectedContentType != ExpectedContentType::JsonArray && expectedContentType != ExpectedContentType::JsonObject) {
+        return true;
     }
 
-    if ((expectedContentType == ExpectedContentType::JsonArray || expectedContentType == ExpectedContentType::JsonObject) && (jsonResult.isNull() || jsonResult.isEmpty())) {
+    if (shape == JsonShape::Blank) {
         q->setError(EmptyJson);
         qCCritical(schCore) << "Invalid reply: content expected, but reply is empty.";
         return false;
     }
 
-    if (expectedContentType == ExpectedContentType::JsonArray && !jsonResult.isArray()) {
+    if (shape == JsonShape::Invalid) {
+        q->setError(JsonParseError);
+        //: Error message
+        //% "The reply does not contain a complete JSON array or object."
+        q->setErrorText(qtTrId("libschauer-error-json-incomplete"));
+        qCCritical(schCore) << "Invalid reply: the reply does not contain a complete JSON array or object.";
+        return false;
+    }
+
+    if (expectedContentType == ExpectedContentType::JsonArray && shape != JsonShape::Array) {
         q->setError(WrongOutputType);
         qCCritical(schCore) << "Invalid reply: JSON array expected, but got something different.";
         return false;
     }
 
-    if (expectedContentType == ExpectedContentType::JsonObject && !jsonResult.isObject()) {
+    if (expectedContentType == ExpectedContentType::JsonObject && shape != JsonShape::Object) {
         q->setError(WrongOutputType);
         qCCritical(schCore) << "Invalid reply: JSON object expected, but got something different.";
         return false;
     }
 
+    // parsed on demand by json(), jobs evaluating the content call parseReply() themselves
+    return true;
+}
+
+void JobPrivate::setRawReply(const QByteArray &data)
+{
+    rawReply = data;
+    jsonResult = QJsonDocument();
+    jsonErrorString.clear();
+    jsonParsed = false;
+}
+
+const QJsonDocument &JobPrivate::json() const
+{
+    if (!jsonParsed) {
+        jsonParsed = true;
+        QJsonParseError jsonError;
+        jsonResult = QJsonDocument::fromJson(rawReply, &jsonError);
+        if (Q_UNLIKELY(jsonError.error != QJsonParseError::NoError)) {
+            jsonErrorString = jsonError.errorString();
+            qCWarning(schCore) << "Invalid JSON data in reply at offset" << jsonError.offset << ":" << jsonErrorString;
+        }
+    }
+
+    return jsonResult;
+}
+
+bool JobPrivate::parseReply()
+{
+    json();
+
+    if (Q_UNLIKELY(!jsonErrorString.isEmpty())) {
+        Q_Q(Job);
+        q->setError(JsonParseError);
+        q->setErrorText(jsonErrorString);
+        return false;
+    }
+
     return true;
 }
 
@@ -239,17 +741,48 @@ void JobPrivate::emitDescription()
 Job::Job(QObject *parent)
     : SJob(parent), s_ptr(new JobPrivate(this))
 {
-
+    setCapabilities(SJob::Killable);
 }
 
 Job::Job(JobPrivate &dd, QObject *parent)
     : SJob(parent), s_ptr(&dd)
 {
-
+    setCapabilities(SJob::Killable);
 }
 
 Job::~Job() = default;
 
+bool Job::doKill()
+{
+    Q_D(Job);
+
+    // invalidates requests still queued in the connection pool
+    d->requestSerial++;
+
+    d->abandonCoalescedRequest();
+
+    if (d->nextRequestTimer) {
+        d->nextRequestTimer->stop();
+    }
+
+#if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
+    if (d->timeoutTimer) {
+        d->timeoutTimer->stop();
+    }
+#endif
+
+    if (d->reply) {
+        qCDebug(schCore) << "Aborting running request.";
+        QNetworkReply *nr = d->reply;
+        d->reply = nullptr;
+        disconnect(nr, nullptr, this, nullptr);
+        nr->abort();
+        nr->deleteLater();
+    }
+
+    return true;
+}
+
 void Job::sendRequest()
 {
     Q_D(Job);
@@ -277,15 +810,22 @@ void Job::sendRequest()
         return;
     }
 
+    const QString socketPath = d->configuration->socketPath();
+
     QUrl url;
-    if (d->configuration->useSsl()) {
-        url.setScheme(QStringLiteral("https"));
-    } else {
+    if (!socketPath.isEmpty()) {
         url.setScheme(QStringLiteral("http"));
-    }
+        url.setHost(QStringLiteral("localhost"));
+    } else {
+        if (d->configuration->useSsl()) {
+            url.setScheme(QStringLiteral("https"));
+        } else {
+            url.setScheme(QStringLiteral("http"));
+        }
 
-    url.setHost(d->configuration->host());
-    url.setPort(d->configuration->port());
+        url.setHost(d->configuration->host());
+        url.setPort(d->configuration->port());
+    }
     url.setPath(d->buildUrlPath());
     url.setQuery(d->buildUrlQuery());
 
@@ -294,19 +834,24 @@ void Job::sendRequest()
         return;
     }
 
-    if (!d->nam) {
-        auto namf = Schauer::networkAccessManagerFactory();
-        if (namf) {
-            d->nam = namf->create(this);
-            qCDebug(schCore) << "Using" << d->nam << "created by NetworkAccessManagerFactory" << namf;
-        } else {
-            d->nam = new QNetworkAccessManager(this);
-            qCDebug(schCore) << "Using default created" << d->nam;
+    d->cacheTimeToLive = 0;
+    if (d->coalesceRequests && d->namOperation == NetworkOperation::Get) {
+        const QString endpoint = url.path().mid(d->JobPrivate::buildUrlPath().size());
+        const int timeToLive = d->configuration->responseCacheTimeToLive(endpoint);
+        if (timeToLive > 0) {
+            const QString target = url.path(QUrl::FullyEncoded) + QLatin1Char('?') + url.query(QUrl::FullyEncoded);
+            QJsonDocument cached;
+            QByteArray cachedRaw;
+            if (ResponseCache::lookup(d->configuration, endpoint, target, &cached, &cachedRaw)) {
+                qCDebug(schCore) << "Using cached reply for" << target;
+                d->finishFromCache(cached, cachedRaw);
+                return;
+            }
+            d->cacheEndpoint = endpoint;
+            d->cacheTarget = target;
+            d->cacheTimeToLive = timeToLive;
+            d->cacheGeneration = ResponseCache::generation(d->configuration);
         }
-
-        connect(d->nam, &QNetworkAccessManager::sslErrors, this, [d](QNetworkReply *reply, const QList<QSslError> &errors){
-            d->handleSsslErrors(reply, errors);
-        });
     }
 
     QNetworkRequest nr(url);
@@ -373,7 +918,11 @@ void Job::sendRequest()
             break;
         }
         qCDebug(schCore) << "Start performing" << opName << "network operation.";
-        qCDebug(schCore) << "API URL:" << url;
+        if (socketPath.isEmpty()) {
+            qCDebug(schCore) << "API URL:" << url;
+        } else {
+            qCDebug(schCore) << "API URL:" << url << "via unix domain socket" << socketPath;
+        }
         const auto rhl = nr.rawHeaderList();
         for (const QByteArray &h : rhl) {
             if (h == QByteArrayLiteral("X-Registry-Auth")) {
@@ -387,6 +936,16 @@ void Job::sendRequest()
         }
     }
 
+    d->abandonCoalescedRequest();
+    d->replyConsumed = false;
+    const QString coalescingKey = d->coalescingKey(nr);
+    if (!coalescingKey.isEmpty() && d->joinInFlightRequest(coalescingKey)) {
+        //: Job info message to display state information
+        //% "Waiting for identical request"
+        Q_EMIT infoMessage(this, qtTrId("libschauer-info-msg-req-coalesced"));
+        return;
+    }
+
 #if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
     if (Q_LIKELY(d->requestTimeout > 0)) {
         if (!d->timeoutTimer) {
@@ -407,30 +966,50 @@ void Job::sendRequest()
     Q_EMIT infoMessage(this, qtTrId("libschauer-info-msg-req-send"));
     qCDebug(schCore) << "Sending network request.";
 
+    QNetworkAccessManager::Operation op = QNetworkAccessManager::UnknownOperation;
     switch(d->namOperation) {
     case NetworkOperation::Head:
-        d->reply = d->nam->head(nr);
+        op = QNetworkAccessManager::HeadOperation;
         break;
     case NetworkOperation::Post:
-        d->reply = d->nam->post(nr, payload.first);
+        op = QNetworkAccessManager::PostOperation;
         break;
     case NetworkOperation::Put:
-        d->reply = d->nam->put(nr, payload.first);
+        op = QNetworkAccessManager::PutOperation;
         break;
     case NetworkOperation::Delete:
-        d->reply = d->nam->deleteResource(nr);
+        op = QNetworkAccessManager::DeleteOperation;
         break;
     case NetworkOperation::Get:
-        d->reply = d->nam->get(nr);
+        op = QNetworkAccessManager::GetOperation;
         break;
     default:
         Q_ASSERT_X(false, "sending request", "invalid network operation");
         break;
     }
 
-    connect(d->reply, &QNetworkReply::finished, this, [d](){
-        d->requestFinished();
-    });
+    const quint32 serial = ++d->requestSerial;
+    ConnectionPool::instance()->sendRequest(d->configuration, op, nr, payload.first, this, [this, d, serial](QNetworkReply *reply){
+        if (Q_UNLIKELY(serial != d->requestSerial)) {
+            // the job has been killed while the request was queued
+            reply->abort();
+            reply->deleteLater();
+            return;
+        }
+        d->reply = reply;
+        d->resetIncrementalParsing();
+        connect(reply, &QNetworkReply::sslErrors, this, [d, reply](const QList<QSslError> &errors){
+            d->handleSsslErrors(reply, errors);
+        });
+        if (d->expectedContentType == ExpectedContentType::Stream || d->incrementalActive) {
+            connect(reply, &QIODevice::readyRead, this, [d](){
+                d->replyReadyRead();
+            });
+        }
+        connect(reply, &QNetworkReply::finished, this, [d](){
+            d->requestFinished();
+        });
+    }, d->isLongLived());
 }
 
 AbstractConfiguration* Job::configuration() const
@@ -513,7 +1092,17 @@ QString Job::errorString() const
 QJsonDocument Job::replyData() const
 {
     Q_D(const Job);
-    return d->jsonResult;
+    return d->json();
+}
+
+QByteArray Job::rawReplyData() const
+{
+    Q_D(const Job);
+    if (d->rawReply.isEmpty() && d->jsonParsed && !d->jsonResult.isNull()) {
+        // list replies decoded while they have been received are only available as document
+        return d->jsonResult.toJson(QJsonDocument::Compact);
+    }
+    return d->rawReply;
 }
 
 #include "moc_job.cpp"
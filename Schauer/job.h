@@ -14,6 +14,7 @@
 #endif
 #include "abstractconfiguration.h"
 #include <QJsonDocument>
+#include <QJsonObject>
 #include <memory>
 
 namespace Schauer {
@@ -61,6 +62,11 @@ enum {
  * by itself. It provides basic properties and functions used by all classes that perform
  * API requests.
  *
+ * Jobs that only read data, like ListContainersJob, ListImagesJob and GetVersionJob,
+ * do not send their request if an identical request using the same configuration is
+ * already in flight in the same thread. They wait for the reply of that request and
+ * finish with it instead.
+ *
  * \par Example usages
  *
  * \code{.cpp}
@@ -147,10 +153,30 @@ public:
      * If the API request has been successful and SJob::error() returns \c 0, this
      * function returns the requested JSON data (if any).
      *
-     * \sa succeeded()
+     * The reply is only checked for being a complete JSON array or object when it
+     * is received. It is parsed on the first call of this function, later calls
+     * return the parsed document directly. Jobs that evaluate the content of the
+     * reply themselves, like CreateContainerJob, parse it when it is received and
+     * fail with Schauer::JsonParseError if it is invalid. For all other jobs, invalid
+     * content inside a complete JSON array or object does not fail the job, instead
+     * this function returns an empty document.
+     *
+     * \sa rawReplyData(), succeeded()
      */
     QJsonDocument replyData() const;
 
+    /*!
+     * \brief Returns the raw JSON data of the API reply after successful request.
+     *
+     * The data is returned as received from the daemon. Use this to forward the reply
+     * to a file or another process. List replies that have been decoded while they
+     * have been received are serialized from the parsed document, as their raw data
+     * is not kept. This also applies if they are served from the response cache.
+     *
+     * \sa replyData()
+     */
+    QByteArray rawReplyData() const;
+
 Q_SIGNALS:
     /*!
      * \brief Notifier signal for the \link Job::configuration configuration\endlink property.
@@ -163,7 +189,8 @@ Q_SIGNALS:
      *
      * This signal is triggered together with SJob::finished() and SJob::result()
      * if the API request was successful. \a json will contain the data requested
-     * from the remote server.
+     * from the remote server. The reply is only parsed for this signal if it is
+     * connected, otherwise \a json is empty.
      *
      * \sa replyData()
      */
@@ -180,6 +207,16 @@ Q_SIGNALS:
      */
     void failed(int errorCode, const QString &errorString);
 
+    /*!
+     * \brief Emitted for every \a item of a list as soon as it has been received.
+     *
+     * Jobs requesting lists like ListContainersJob and ListImagesJob decode the
+     * reply while it is downloaded and emit every list item as soon as it is
+     * complete. The complete list is still available via succeeded() and replyData()
+     * after the job has been finished.
+     */
+    void itemReceived(const QJsonObject &item);
+
 protected:
     /*!
      * \brief Constructs a new %Job object with the given \a parent.
@@ -196,11 +233,19 @@ protected:
      */
     void sendRequest();
 
+    /*!
+     * \brief Aborts a running request.
+     *
+     * Returns \c true.
+     */
+    bool doKill() override;
+
     const std::unique_ptr<JobPrivate> s_ptr;
 
 private:
     Q_DECLARE_PRIVATE_D(s_ptr, Job)
     Q_DISABLE_COPY(Job)
+    friend class AbstractBaseModelPrivate;
 };
 
 }
@@ -7,23 +7,36 @@
 #define SCHAUER_JOB_P_H
 
 #include "job.h"
+#include "jsonarraysplitter.h"
+#include <QJsonArray>
 #include <QUrlQuery>
 #include <QSslError>
+#include <QNetworkReply>
+#include <QPointer>
+#include <QVector>
 #include <utility>
 
-class QNetworkReply;
-class QNetworkAccessManager;
-#if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
+class QNetworkRequest;
 class QTimer;
-#endif
 
 namespace Schauer {
 
+class Filters;
+
 enum class ExpectedContentType : qint8 {
     Invalid     = -1,
     Empty       = 0,
     JsonArray   = 1,
-    JsonObject  = 2
+    JsonObject  = 2,
+    Stream      = 3
+};
+
+// result of the structural pre-scan of a JSON reply, blank also covers empty arrays and objects
+enum class JsonShape : qint8 {
+    Blank   = 0,
+    Invalid = 1,
+    Array   = 2,
+    Object  = 3
 };
 
 enum class NetworkOperation : qint8 {
@@ -42,18 +55,45 @@ public:
     JobPrivate(Job *q);
     virtual ~JobPrivate();
 
-    QJsonDocument jsonResult;
-    QNetworkAccessManager *nam = nullptr;
+    // parsed from rawReply on first access, see json()
+    mutable QJsonDocument jsonResult;
+    mutable QString jsonErrorString;
+    JsonArraySplitter arraySplitter;
+    QJsonArray incrementalResult;
+    QByteArray incrementalFallbackData;
+    QString incrementalErrorString;
 #if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
     QTimer *timeoutTimer = nullptr;
 #endif
     QNetworkReply *reply = nullptr;
+    QPointer<Job> leader;
+    QVector<QPointer<Job>> followers;
+    QString coalesceKey;
+    QByteArray coalescedData;
+    QByteArray rawReply;
+    QString cacheEndpoint;
+    QString cacheTarget;
+    // cached replies of this endpoint are dropped if the job succeeds, set by jobs changing daemon state
+    QString invalidatesEndpoint;
+    quint64 cacheGeneration = 0;
+    QTimer *nextRequestTimer = nullptr;
     AbstractConfiguration *configuration = nullptr;
     NetworkOperation namOperation = NetworkOperation::Invalid;
     ExpectedContentType expectedContentType = ExpectedContentType::Invalid;
     int statusCode = 0;
+    int nextRequestDelay = 0;
+    int cacheTimeToLive = 0;
+    quint32 requestSerial = 0;
     quint16 requestTimeout = 300;
     bool requiresAuth = true;
+    bool parseIncrementally = false;
+    bool coalesceRequests = false;
+    bool keepRawReply = false;
+    bool replyConsumed = false;
+    mutable bool jsonParsed = true;
+    bool incrementalActive = false;
+    bool incrementalFallback = false;
+    bool incrementalFailed = false;
 
     void handleSsslErrors(QNetworkReply *reply, const QList<QSslError> &errors);
 
@@ -63,12 +103,42 @@ public:
 
     void requestFinished();
 
+    void handleReply(QNetworkReply::NetworkError networkError, const QString &networkErrorString, const QByteArray &replyData);
+
+    QString coalescingKey(const QNetworkRequest &request) const;
+
+    bool joinInFlightRequest(const QString &key);
+
+    QVector<QPointer<Job>> takeFollowers();
+
+    void abandonCoalescedRequest();
+
+    void finishFromCache(const QJsonDocument &cached, const QByteArray &cachedRaw);
+
+    void emitSucceeded();
+
+    void replyReadyRead();
+
+    void resetIncrementalParsing();
+
+    void feedIncremental(const QByteArray &data);
+
+    void decodeArrayElement(const QByteArray &element);
+
     void emitError(int errorCode, const QString &errorText = QString());
 
+    void setRawReply(const QByteArray &data);
+
+    const QJsonDocument &json() const;
+
+    bool parseReply();
+
     virtual QString buildUrlPath() const;
 
     virtual QUrlQuery buildUrlQuery() const;
 
+    static void addFiltersQueryItem(QUrlQuery &query, const Filters &filters);
+
     virtual QMap<QByteArray, QByteArray> buildRequestHeaders() const;
 
     virtual std::pair<QByteArray, QByteArray> buildPayload() const;
@@ -79,6 +149,17 @@ public:
 
     virtual void extractError(const QByteArray &data);
 
+    virtual void processStreamData(const QByteArray &data);
+
+    virtual bool prepareNextRequest();
+
+    virtual bool prepareRetry();
+
+    // long-lived requests do not occupy a slot of the connection pool
+    virtual bool isLongLived() const;
+
+    void scheduleNextRequest();
+
     virtual void emitDescription();
 
 protected:
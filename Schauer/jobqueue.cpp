@@ -0,0 +1,294 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "jobqueue_p.h"
+#include "global.h"
+#include "logging.h"
+
+using namespace Schauer;
+
+JobQueuePrivate::JobQueuePrivate(JobQueue *q)
+    : q_ptr(q)
+{
+
+}
+
+JobQueuePrivate::~JobQueuePrivate() = default;
+
+AbstractConfiguration *JobQueuePrivate::configurationFor(Job *job) const
+{
+    AbstractConfiguration *config = job->configuration();
+    return config ? config : Schauer::defaultConfiguration();
+}
+
+bool JobQueuePrivate::hasCapacity(AbstractConfiguration *config) const
+{
+    int limit = maxRunningJobsPerConfiguration;
+    if (limit < 0 || !config) {
+        return true;
+    }
+
+    if (limit == 0) {
+        limit = config->maxConnectionsPerHost();
+        if (limit <= 0) {
+            return true;
+        }
+    }
+
+    return runningPerConfig.value(config, 0) < limit;
+}
+
+void JobQueuePrivate::dispatch()
+{
+    if (dispatching) {
+        return;
+    }
+    dispatching = true;
+
+    Q_Q(JobQueue);
+
+    while (queueDepth > 0 && (maxRunningJobs <= 0 || running.size() < maxRunningJobs)) {
+        Entry entry;
+        AbstractConfiguration *config = nullptr;
+
+        // take the oldest job of the highest priority whose configuration has capacity left
+        for (std::deque<Entry> &list : pending) {
+            for (auto it = list.begin(); it != list.end(); ++it) {
+                AbstractConfiguration *c = configurationFor(it->job);
+                if (hasCapacity(c)) {
+                    entry = *it;
+                    config = c;
+                    list.erase(it);
+                    break;
+                }
+            }
+            if (entry.job) {
+                break;
+            }
+        }
+
+        if (!entry.job) {
+            break;
+        }
+
+        queueDepth--;
+        running.insert(entry.job, config);
+        runningPerConfig[config]++;
+
+        const qint64 waitTime = entry.waiting.elapsed();
+        totalWaitTime += waitTime;
+        startedJobs++;
+        if (waitTime > maxWaitTime) {
+            maxWaitTime = waitTime;
+        }
+
+        qCDebug(schCore) << "Starting queued job" << entry.job << "after waiting" << waitTime << "ms";
+        entry.job->start();
+        Q_EMIT q->jobStarted(entry.job, waitTime);
+    }
+
+    dispatching = false;
+}
+
+bool JobQueuePrivate::removePending(SJob *job)
+{
+    for (std::deque<Entry> &list : pending) {
+        for (auto it = list.begin(); it != list.end(); ++it) {
+            if (it->job == job) {
+                list.erase(it);
+                queueDepth--;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void JobQueuePrivate::jobFinished(SJob *job)
+{
+    const int oldQueueDepth = queueDepth;
+    const int oldRunningJobs = running.size();
+
+    auto it = running.find(job);
+    if (it != running.end()) {
+        AbstractConfiguration *config = it.value();
+        running.erase(it);
+        auto cIt = runningPerConfig.find(config);
+        if (cIt != runningPerConfig.end() && --cIt.value() <= 0) {
+            runningPerConfig.erase(cIt);
+        }
+    } else if (removePending(job)) {
+        qCDebug(schCore) << "Removed finished job" << job << "from the queue";
+    } else {
+        return;
+    }
+
+    dispatch();
+    emitChanges(oldQueueDepth, oldRunningJobs);
+}
+
+void JobQueuePrivate::emitChanges(int oldQueueDepth, int oldRunningJobs)
+{
+    Q_Q(JobQueue);
+    if (queueDepth != oldQueueDepth) {
+        Q_EMIT q->queueDepthChanged(queueDepth);
+    }
+    if (running.size() != oldRunningJobs) {
+        Q_EMIT q->runningJobsChanged(running.size());
+    }
+}
+
+JobQueue::JobQueue(QObject *parent)
+    : QObject(parent), s_ptr(new JobQueuePrivate(this))
+{
+
+}
+
+JobQueue::~JobQueue()
+{
+    Q_D(JobQueue);
+
+    const auto running = d->running.keys();
+    for (SJob *job : running) {
+        disconnect(job, nullptr, this, nullptr);
+    }
+
+    const auto pending = std::move(d->pending);
+    d->pending = {};
+    d->queueDepth = 0;
+    for (const std::deque<JobQueuePrivate::Entry> &list : pending) {
+        for (const JobQueuePrivate::Entry &entry : list) {
+            disconnect(entry.job, nullptr, this, nullptr);
+            entry.job->kill(SJob::EmitResult);
+        }
+    }
+}
+
+void JobQueue::enqueue(Job *job, Priority priority)
+{
+    if (!job) {
+        return;
+    }
+
+    Q_D(JobQueue);
+
+    if (d->running.contains(job)) {
+        qCWarning(schCore) << "Job" << job << "is already running in the queue";
+        return;
+    }
+
+    for (const std::deque<JobQueuePrivate::Entry> &list : d->pending) {
+        for (const JobQueuePrivate::Entry &entry : list) {
+            if (entry.job == job) {
+                qCWarning(schCore) << "Job" << job << "is already waiting in the queue";
+                return;
+            }
+        }
+    }
+
+    const int oldQueueDepth = d->queueDepth;
+    const int oldRunningJobs = d->running.size();
+
+    const int prio = qBound(static_cast<int>(Interactive), static_cast<int>(priority), static_cast<int>(Bulk));
+
+    connect(job, &SJob::finished, this, [d](SJob *sjob){
+        d->jobFinished(sjob);
+    });
+
+    JobQueuePrivate::Entry entry;
+    entry.job = job;
+    entry.waiting.start();
+    d->pending[static_cast<size_t>(prio)].push_back(entry);
+    d->queueDepth++;
+
+    qCDebug(schCore) << "Enqueued job" << job << "with priority" << priority;
+
+    d->dispatch();
+    d->emitChanges(oldQueueDepth, oldRunningJobs);
+}
+
+int JobQueue::maxRunningJobs() const
+{
+    Q_D(const JobQueue);
+    return d->maxRunningJobs;
+}
+
+void JobQueue::setMaxRunningJobs(int maxRunningJobs)
+{
+    Q_D(JobQueue);
+    if (d->maxRunningJobs != maxRunningJobs) {
+        qCDebug(schCore) << "Changing \"maxRunningJobs\" from" << d->maxRunningJobs << "to" << maxRunningJobs;
+        d->maxRunningJobs = maxRunningJobs;
+        Q_EMIT maxRunningJobsChanged(this->maxRunningJobs());
+        const int oldQueueDepth = d->queueDepth;
+        const int oldRunningJobs = d->running.size();
+        d->dispatch();
+        d->emitChanges(oldQueueDepth, oldRunningJobs);
+    }
+}
+
+int JobQueue::maxRunningJobsPerConfiguration() const
+{
+    Q_D(const JobQueue);
+    return d->maxRunningJobsPerConfiguration;
+}
+
+void JobQueue::setMaxRunningJobsPerConfiguration(int maxRunningJobsPerConfiguration)
+{
+    Q_D(JobQueue);
+    if (d->maxRunningJobsPerConfiguration != maxRunningJobsPerConfiguration) {
+        qCDebug(schCore) << "Changing \"maxRunningJobsPerConfiguration\" from" << d->maxRunningJobsPerConfiguration << "to" << maxRunningJobsPerConfiguration;
+        d->maxRunningJobsPerConfiguration = maxRunningJobsPerConfiguration;
+        Q_EMIT maxRunningJobsPerConfigurationChanged(this->maxRunningJobsPerConfiguration());
+        const int oldQueueDepth = d->queueDepth;
+        const int oldRunningJobs = d->running.size();
+        d->dispatch();
+        d->emitChanges(oldQueueDepth, oldRunningJobs);
+    }
+}
+
+int JobQueue::queueDepth() const
+{
+    Q_D(const JobQueue);
+    return d->queueDepth;
+}
+
+int JobQueue::queueDepth(Priority priority) const
+{
+    Q_D(const JobQueue);
+    const int prio = static_cast<int>(priority);
+    if (prio < static_cast<int>(Interactive) || prio > static_cast<int>(Bulk)) {
+        return 0;
+    }
+    return static_cast<int>(d->pending[static_cast<size_t>(prio)].size());
+}
+
+int JobQueue::runningJobs() const
+{
+    Q_D(const JobQueue);
+    return d->running.size();
+}
+
+qint64 JobQueue::averageWaitTime() const
+{
+    Q_D(const JobQueue);
+    return d->startedJobs > 0 ? d->totalWaitTime / d->startedJobs : 0;
+}
+
+qint64 JobQueue::maxWaitTime() const
+{
+    Q_D(const JobQueue);
+    return d->maxWaitTime;
+}
+
+void JobQueue::resetStatistics()
+{
+    Q_D(JobQueue);
+    d->totalWaitTime = 0;
+    d->maxWaitTime = 0;
+    d->startedJobs = 0;
+}
+
+#include "moc_jobqueue.cpp"
@@ -0,0 +1,233 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_JOBQUEUE_H
+#define SCHAUER_JOBQUEUE_H
+
+#include "schauer_exports.h"
+#include <QObject>
+#include <memory>
+
+namespace Schauer {
+
+class Job;
+class JobQueuePrivate;
+
+/*!
+ * \ingroup api-jobs
+ * \brief Starts jobs with a bounded number of concurrently running jobs.
+ *
+ * Calling Job::start() sends the request immediately. If a lot of jobs are started
+ * at once, all requests hit the Docker daemon at the same time and might all run into
+ * their request timeout together. Jobs added to the queue via enqueue() are started by
+ * the queue instead, as soon as the number of running jobs is below the
+ * \link JobQueue::maxRunningJobs maxRunningJobs\endlink limit and the number of running
+ * jobs using the same configuration is below the
+ * \link JobQueue::maxRunningJobsPerConfiguration maxRunningJobsPerConfiguration\endlink
+ * limit.
+ *
+ * Waiting jobs are started by Priority: all jobs with a higher priority are started
+ * before jobs with a lower priority, jobs with the same priority are started in the
+ * order they have been added. A job that can not be started because its configuration
+ * has reached its limit does not block jobs using other configurations.
+ *
+ * Jobs in the queue can be killed as usual, they are removed from the queue then. A job
+ * added to a queue must not be started by yourself.
+ *
+ * \par Example
+ * \code{.cpp}
+ * auto queue = new JobQueue(this);
+ * queue->setMaxRunningJobs(4);
+ * for (const QString &name : names) {
+ *     auto job = new RemoveContainerJob();
+ *     job->setId(name);
+ *     queue->enqueue(job, JobQueue::Bulk);
+ * }
+ * \endcode
+ *
+ * \headerfile "" <Schauer/JobQueue>
+ */
+class SCHAUER_LIBRARY JobQueue : public QObject
+{
+    Q_OBJECT
+    /*!
+     * \brief Maximum number of jobs running at the same time.
+     *
+     * A value of \c 0 disables the limit. The default value is \c 8.
+     *
+     * \par Access functions
+     * \li int maxRunningJobs() const
+     * \li void setMaxRunningJobs(int maxRunningJobs)
+     *
+     * \par Notifier signal
+     * \li void maxRunningJobsChanged(int maxRunningJobs)
+     */
+    Q_PROPERTY(int maxRunningJobs READ maxRunningJobs WRITE setMaxRunningJobs NOTIFY maxRunningJobsChanged)
+    /*!
+     * \brief Maximum number of jobs using the same configuration running at the same time.
+     *
+     * A value of \c 0 uses AbstractConfiguration::maxConnectionsPerHost() of the
+     * configuration used by the jobs. A negative value disables the limit. The default
+     * value is \c 0.
+     *
+     * \par Access functions
+     * \li int maxRunningJobsPerConfiguration() const
+     * \li void setMaxRunningJobsPerConfiguration(int maxRunningJobsPerConfiguration)
+     *
+     * \par Notifier signal
+     * \li void maxRunningJobsPerConfigurationChanged(int maxRunningJobsPerConfiguration)
+     */
+    Q_PROPERTY(int maxRunningJobsPerConfiguration READ maxRunningJobsPerConfiguration WRITE setMaxRunningJobsPerConfiguration NOTIFY maxRunningJobsPerConfigurationChanged)
+    /*!
+     * \brief Number of jobs waiting to be started.
+     *
+     * \par Access functions
+     * \li int queueDepth() const
+     *
+     * \par Notifier signal
+     * \li void queueDepthChanged(int queueDepth)
+     */
+    Q_PROPERTY(int queueDepth READ queueDepth NOTIFY queueDepthChanged)
+    /*!
+     * \brief Number of jobs started by the queue that have not been finished yet.
+     *
+     * \par Access functions
+     * \li int runningJobs() const
+     *
+     * \par Notifier signal
+     * \li void runningJobsChanged(int runningJobs)
+     */
+    Q_PROPERTY(int runningJobs READ runningJobs NOTIFY runningJobsChanged)
+public:
+    /*!
+     * \brief Priority classes for queued jobs.
+     */
+    enum Priority : int {
+        Interactive = 0,    /**< Jobs the user is waiting for, like loading a model. */
+        Normal,             /**< Default priority. */
+        Bulk                /**< Background and batch operations, like creating or removing many containers. */
+    };
+    Q_ENUM(Priority)
+
+    /*!
+     * \brief Constructs a new %JobQueue object with the given \a parent.
+     */
+    explicit JobQueue(QObject *parent = nullptr);
+
+    /*!
+     * \brief Destroys the %JobQueue object.
+     *
+     * Jobs still waiting in the queue are killed.
+     */
+    ~JobQueue() override;
+
+    /*!
+     * \brief Adds the \a job with the given \a priority to the queue.
+     *
+     * The job will be started by the queue as soon as the limits allow it.
+     * Do not call Job::start() on the \a job yourself.
+     */
+    void enqueue(Job *job, Priority priority = Normal);
+
+    /*!
+     * \brief Getter function for the \link JobQueue::maxRunningJobs maxRunningJobs\endlink property.
+     * \sa setMaxRunningJobs(), maxRunningJobsChanged()
+     */
+    int maxRunningJobs() const;
+
+    /*!
+     * \brief Setter function for the \link JobQueue::maxRunningJobs maxRunningJobs\endlink property.
+     * \sa maxRunningJobs(), maxRunningJobsChanged()
+     */
+    void setMaxRunningJobs(int maxRunningJobs);
+
+    /*!
+     * \brief Getter function for the \link JobQueue::maxRunningJobsPerConfiguration maxRunningJobsPerConfiguration\endlink property.
+     * \sa setMaxRunningJobsPerConfiguration(), maxRunningJobsPerConfigurationChanged()
+     */
+    int maxRunningJobsPerConfiguration() const;
+
+    /*!
+     * \brief Setter function for the \link JobQueue::maxRunningJobsPerConfiguration maxRunningJobsPerConfiguration\endlink property.
+     * \sa maxRunningJobsPerConfiguration(), maxRunningJobsPerConfigurationChanged()
+     */
+    void setMaxRunningJobsPerConfiguration(int maxRunningJobsPerConfiguration);
+
+    /*!
+     * \brief Getter function for the \link JobQueue::queueDepth queueDepth\endlink property.
+     * \sa queueDepthChanged()
+     */
+    int queueDepth() const;
+
+    /*!
+     * \brief Returns the number of jobs with the given \a priority waiting to be started.
+     */
+    int queueDepth(Priority priority) const;
+
+    /*!
+     * \brief Getter function for the \link JobQueue::runningJobs runningJobs\endlink property.
+     * \sa runningJobsChanged()
+     */
+    int runningJobs() const;
+
+    /*!
+     * \brief Returns the average time in milliseconds jobs have waited in the queue before they were started.
+     * \sa maxWaitTime(), resetStatistics()
+     */
+    qint64 averageWaitTime() const;
+
+    /*!
+     * \brief Returns the longest time in milliseconds a job has waited in the queue before it was started.
+     * \sa averageWaitTime(), resetStatistics()
+     */
+    qint64 maxWaitTime() const;
+
+    /*!
+     * \brief Resets the wait time statistics.
+     * \sa averageWaitTime(), maxWaitTime()
+     */
+    void resetStatistics();
+
+Q_SIGNALS:
+    /*!
+     * \brief Notifier signal for the \link JobQueue::maxRunningJobs maxRunningJobs\endlink property.
+     * \sa maxRunningJobs(), setMaxRunningJobs()
+     */
+    void maxRunningJobsChanged(int maxRunningJobs);
+
+    /*!
+     * \brief Notifier signal for the \link JobQueue::maxRunningJobsPerConfiguration maxRunningJobsPerConfiguration\endlink property.
+     * \sa maxRunningJobsPerConfiguration(), setMaxRunningJobsPerConfiguration()
+     */
+    void maxRunningJobsPerConfigurationChanged(int maxRunningJobsPerConfiguration);
+
+    /*!
+     * \brief Notifier signal for the \link JobQueue::queueDepth queueDepth\endlink property.
+     * \sa queueDepth()
+     */
+    void queueDepthChanged(int queueDepth);
+
+    /*!
+     * \brief Notifier signal for the \link JobQueue::runningJobs runningJobs\endlink property.
+     * \sa runningJobs()
+     */
+    void runningJobsChanged(int runningJobs);
+
+    /*!
+     * \brief Emitted when the queue starts the \a job after it has waited \a waitTime milliseconds.
+     */
+    void jobStarted(Schauer::Job *job, qint64 waitTime);
+
+protected:
+    const std::unique_ptr<JobQueuePrivate> s_ptr;
+
+private:
+    Q_DECLARE_PRIVATE_D(s_ptr, JobQueue)
+    Q_DISABLE_COPY(JobQueue)
+};
+
+}
+
+#endif // SCHAUER_JOBQUEUE_H
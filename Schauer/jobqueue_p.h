@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_JOBQUEUE_P_H
+#define SCHAUER_JOBQUEUE_P_H
+
+#include "jobqueue.h"
+#include "job.h"
+#include <QElapsedTimer>
+#include <QHash>
+#include <array>
+#include <deque>
+
+namespace Schauer {
+
+class JobQueuePrivate
+{
+public:
+    struct Entry {
+        Job *job = nullptr;
+        QElapsedTimer waiting;
+    };
+
+    explicit JobQueuePrivate(JobQueue *q);
+
+    ~JobQueuePrivate();
+
+    void dispatch();
+
+    void jobFinished(SJob *job);
+
+    bool removePending(SJob *job);
+
+    AbstractConfiguration *configurationFor(Job *job) const;
+
+    bool hasCapacity(AbstractConfiguration *config) const;
+
+    void emitChanges(int oldQueueDepth, int oldRunningJobs);
+
+    std::array<std::deque<Entry>, 3> pending;
+    QHash<SJob*,AbstractConfiguration*> running;
+    QHash<AbstractConfiguration*,int> runningPerConfig;
+    qint64 totalWaitTime = 0;
+    qint64 maxWaitTime = 0;
+    qint64 startedJobs = 0;
+    int queueDepth = 0;
+    int maxRunningJobs = 8;
+    int maxRunningJobsPerConfiguration = 0;
+    bool dispatching = false;
+
+protected:
+    JobQueue *q_ptr = nullptr;
+
+private:
+    Q_DISABLE_COPY(JobQueuePrivate)
+    Q_DECLARE_PUBLIC(JobQueue)
+};
+
+}
+
+#endif // SCHAUER_JOBQUEUE_P_H
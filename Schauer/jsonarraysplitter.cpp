@@ -0,0 +1,140 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "jsonarraysplitter.h"
+
+using namespace Schauer;
+
+namespace {
+
+inline bool isJsonWhitespace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+}
+
+void JsonArraySplitter::setCallback(const Callback &callback)
+{
+    m_callback = callback;
+}
+
+JsonArraySplitter::State JsonArraySplitter::state() const
+{
+    return m_state;
+}
+
+void JsonArraySplitter::reset()
+{
+    m_pending.clear();
+    m_depth = 0;
+    m_state = Start;
+    m_inElement = false;
+    m_inString = false;
+    m_escape = false;
+}
+
+void JsonArraySplitter::emitElement(const QByteArray &data, int start, int end)
+{
+    m_inElement = false;
+
+    if (m_pending.isEmpty()) {
+        if (m_callback) {
+            m_callback(data.mid(start, end - start));
+        }
+    } else {
+        m_pending.append(data.constData() + start, end - start);
+        if (m_callback) {
+            m_callback(m_pending);
+        }
+        m_pending.clear();
+    }
+}
+
+bool JsonArraySplitter::feed(const QByteArray &data)
+{
+    const char *d = data.constData();
+    const int size = data.size();
+    int elementStart = 0;
+
+    for (int i = 0; i < size; ++i) {
+        const char c = d[i];
+
+        if (m_state == InArray) {
+            if (!m_inElement) {
+                if (isJsonWhitespace(c) || c == ',') {
+                    continue;
+                }
+                if (c == ']') {
+                    m_state = Finished;
+                    continue;
+                }
+                m_inElement = true;
+                m_depth = 0;
+                elementStart = i;
+            }
+
+            if (m_inString) {
+                if (m_escape) {
+                    m_escape = false;
+                } else if (c == '\\') {
+                    m_escape = true;
+                } else if (c == '"') {
+                    m_inString = false;
+                }
+                continue;
+            }
+
+            switch (c) {
+            case '"':
+                m_inString = true;
+                break;
+            case '{':
+            case '[':
+                m_depth++;
+                break;
+            case '}':
+            case ']':
+                if (m_depth == 0) {
+                    // closing bracket of the array directly after a scalar element
+                    emitElement(data, elementStart, i);
+                    m_state = Finished;
+                } else if (--m_depth == 0) {
+                    emitElement(data, elementStart, i + 1);
+                }
+                break;
+            case ',':
+                if (m_depth == 0) {
+                    emitElement(data, elementStart, i);
+                }
+                break;
+            default:
+                break;
+            }
+        } else if (m_state == Start) {
+            if (isJsonWhitespace(c)) {
+                continue;
+            }
+            if (c != '[') {
+                m_state = Invalid;
+                return false;
+            }
+            m_state = InArray;
+        } else if (m_state == Finished) {
+            if (!isJsonWhitespace(c)) {
+                m_state = Invalid;
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+
+    if (m_inElement) {
+        m_pending.append(d + elementStart, size - elementStart);
+    }
+
+    return true;
+}
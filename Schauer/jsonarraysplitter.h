@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_JSONARRAYSPLITTER_H
+#define SCHAUER_JSONARRAYSPLITTER_H
+
+#include <QByteArray>
+#include <functional>
+
+namespace Schauer {
+
+/*!
+ * \internal
+ * \brief Splits a JSON array that arrives in chunks into its elements.
+ *
+ * The splitter only scans the structure of the data to find the boundaries of the
+ * top level array elements, it does not validate or decode them. Each complete element
+ * is handed to the callback as soon as its last byte has been fed, so only the incomplete
+ * element at the end of a chunk has to be buffered.
+ */
+class JsonArraySplitter
+{
+public:
+    enum State : qint8 {
+        Start,
+        InArray,
+        Finished,
+        Invalid
+    };
+
+    using Callback = std::function<void(const QByteArray &element)>;
+
+    JsonArraySplitter() = default;
+
+    void setCallback(const Callback &callback);
+
+    /*!
+     * Scans \a data and calls the callback for every completed element.
+     * Returns \c false if the data is not a JSON array.
+     */
+    bool feed(const QByteArray &data);
+
+    State state() const;
+
+    void reset();
+
+private:
+    void emitElement(const QByteArray &data, int start, int end);
+
+    Callback m_callback;
+    QByteArray m_pending;
+    int m_depth = 0;
+    State m_state = Start;
+    bool m_inElement = false;
+    bool m_inString = false;
+    bool m_escape = false;
+};
+
+}
+
+#endif // SCHAUER_JSONARRAYSPLITTER_H
@@ -0,0 +1,318 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "jsonwriter.h"
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QLocale>
+#include <QVariantHash>
+#include <QVariantList>
+#include <QVariantMap>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace Schauer;
+
+namespace {
+// largest integer a double can hold without losing precision
+constexpr double maxExactInteger = 9007199254740992.0;
+}
+
+JsonWriter::JsonWriter(QByteArray &out)
+    : m_out(out)
+{
+
+}
+
+void JsonWriter::separate()
+{
+    if (m_needsComma) {
+        m_out.append(',');
+    }
+}
+
+JsonWriter &JsonWriter::beginObject()
+{
+    separate();
+    m_out.append('{');
+    m_needsComma = false;
+    return *this;
+}
+
+JsonWriter &JsonWriter::endObject()
+{
+    m_out.append('}');
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter &JsonWriter::beginArray()
+{
+    separate();
+    m_out.append('[');
+    m_needsComma = false;
+    return *this;
+}
+
+JsonWriter &JsonWriter::endArray()
+{
+    m_out.append(']');
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter &JsonWriter::key(QLatin1String key)
+{
+    separate();
+    m_out.append('"');
+    m_out.append(key.data(), key.size());
+    m_out.append("\":", 2);
+    m_needsComma = false;
+    return *this;
+}
+
+JsonWriter &JsonWriter::key(const QString &key)
+{
+    separate();
+    writeString(key);
+    m_out.append(':');
+    m_needsComma = false;
+    return *this;
+}
+
+JsonWriter &JsonWriter::null()
+{
+    separate();
+    m_out.append("null", 4);
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter &JsonWriter::value(bool value)
+{
+    separate();
+    if (value) {
+        m_out.append("true", 4);
+    } else {
+        m_out.append("false", 5);
+    }
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter &JsonWriter::value(int value)
+{
+    return this->value(static_cast<qint64>(value));
+}
+
+JsonWriter &JsonWriter::value(qint64 value)
+{
+    separate();
+    m_out.append(QByteArray::number(value));
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter &JsonWriter::value(double value)
+{
+    // JSON has no representation for NaN and infinity, QJsonDocument writes null, too
+    if (!std::isfinite(value)) {
+        return null();
+    }
+
+    if (std::abs(value) < maxExactInteger && std::floor(value) == value) {
+        return this->value(static_cast<qint64>(value));
+    }
+
+    separate();
+#if QT_VERSION >= QT_VERSION_CHECK(5, 7, 0)
+    m_out.append(QByteArray::number(value, 'g', QLocale::FloatingPointShortest));
+#else
+    m_out.append(QByteArray::number(value, 'g', std::numeric_limits<double>::max_digits10));
+#endif
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter &JsonWriter::value(QLatin1String value)
+{
+    return this->value(QString(value));
+}
+
+JsonWriter &JsonWriter::value(const QString &value)
+{
+    separate();
+    writeString(value);
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter &JsonWriter::value(const QStringList &value)
+{
+    beginArray();
+    for (const QString &str : value) {
+        this->value(str);
+    }
+    return endArray();
+}
+
+JsonWriter &JsonWriter::value(const QJsonValue &value)
+{
+    switch (value.type()) {
+    case QJsonValue::Bool:
+        return this->value(value.toBool());
+    case QJsonValue::Double:
+        return this->value(value.toDouble());
+    case QJsonValue::String:
+        return this->value(value.toString());
+    case QJsonValue::Array:
+    {
+        const QJsonArray array = value.toArray();
+        beginArray();
+        for (const QJsonValue &v : array) {
+            this->value(v);
+        }
+        return endArray();
+    }
+    case QJsonValue::Object:
+    {
+        // QJsonObject iterates in sorted key order
+        const QJsonObject object = value.toObject();
+        beginObject();
+        for (auto it = object.constBegin(), end = object.constEnd(); it != end; ++it) {
+            key(it.key());
+            this->value(it.value());
+        }
+        return endObject();
+    }
+    default:
+        return null();
+    }
+}
+
+JsonWriter &JsonWriter::value(const QVariant &value)
+{
+    switch (value.userType()) {
+    case QMetaType::UnknownType:
+    case QMetaType::Nullptr:
+        return null();
+    case QMetaType::Bool:
+        return this->value(value.toBool());
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Long:
+        return this->value(value.toLongLong());
+    case QMetaType::ULongLong:
+    case QMetaType::ULong:
+    {
+        const qulonglong v = value.toULongLong();
+        if (v > static_cast<qulonglong>(std::numeric_limits<qint64>::max())) {
+            return this->value(static_cast<double>(v));
+        }
+        return this->value(static_cast<qint64>(v));
+    }
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return this->value(value.toDouble());
+    case QMetaType::QString:
+        return this->value(value.toString());
+    case QMetaType::QStringList:
+        return this->value(value.toStringList());
+    case QMetaType::QVariantList:
+    {
+        const QVariantList list = value.toList();
+        beginArray();
+        for (const QVariant &v : list) {
+            this->value(v);
+        }
+        return endArray();
+    }
+    case QMetaType::QVariantMap:
+    {
+        const QVariantMap map = value.toMap();
+        beginObject();
+        for (auto it = map.constBegin(), end = map.constEnd(); it != end; ++it) {
+            key(it.key());
+            this->value(it.value());
+        }
+        return endObject();
+    }
+    case QMetaType::QVariantHash:
+    {
+        // sort the keys to get the same output as QJsonObject::fromVariantHash()
+        const QVariantHash hash = value.toHash();
+        QStringList keys = hash.keys();
+        std::sort(keys.begin(), keys.end());
+        beginObject();
+        for (const QString &k : qAsConst(keys)) {
+            key(k);
+            this->value(hash.value(k));
+        }
+        return endObject();
+    }
+    default:
+        return this->value(QJsonValue::fromVariant(value));
+    }
+}
+
+void JsonWriter::writeString(const QString &str)
+{
+    const QByteArray utf8 = str.toUtf8();
+    const char *begin = utf8.constData();
+    const char *end = begin + utf8.size();
+
+    m_out.reserve(m_out.size() + utf8.size() + 2);
+    m_out.append('"');
+
+    const char *chunk = begin;
+    for (const char *p = begin; p != end; ++p) {
+        const auto c = static_cast<uchar>(*p);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        m_out.append(chunk, static_cast<int>(p - chunk));
+        chunk = p + 1;
+
+        switch (c) {
+        case '"':
+            m_out.append("\\\"", 2);
+            break;
+        case '\\':
+            m_out.append("\\\\", 2);
+            break;
+        case '\b':
+            m_out.append("\\b", 2);
+            break;
+        case '\f':
+            m_out.append("\\f", 2);
+            break;
+        case '\n':
+            m_out.append("\\n", 2);
+            break;
+        case '\r':
+            m_out.append("\\r", 2);
+            break;
+        case '\t':
+            m_out.append("\\t", 2);
+            break;
+        default:
+        {
+            static const char hex[] = "0123456789abcdef";
+            const char escaped[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf]};
+            m_out.append(escaped, 6);
+            break;
+        }
+        }
+    }
+
+    m_out.append(chunk, static_cast<int>(end - chunk));
+    m_out.append('"');
+}
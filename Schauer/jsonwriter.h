@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_JSONWRITER_H
+#define SCHAUER_JSONWRITER_H
+
+#include <QByteArray>
+#include <QLatin1String>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+class QJsonValue;
+
+namespace Schauer {
+
+/*!
+ * \internal
+ * \brief Writes compact JSON directly into a QByteArray.
+ *
+ * This is used to build request payloads without creating a QJsonObject and a
+ * QJsonDocument first. The writer only takes care of separators and escaping, the
+ * caller is responsible for a balanced sequence of begin and end calls. Keys written
+ * with a QLatin1String are expected to not need any escaping.
+ *
+ * \code{.cpp}
+ * QByteArray payload;
+ * JsonWriter w(payload);
+ * w.beginObject();
+ * w.member(QLatin1String("Detach"), false);
+ * w.member(QLatin1String("Tty"), true);
+ * w.endObject();
+ * \endcode
+ */
+class JsonWriter
+{
+public:
+    /*!
+     * Constructs a new writer that appends to \a out.
+     */
+    explicit JsonWriter(QByteArray &out);
+
+    JsonWriter &beginObject();
+    JsonWriter &endObject();
+    JsonWriter &beginArray();
+    JsonWriter &endArray();
+
+    JsonWriter &key(QLatin1String key);
+    JsonWriter &key(const QString &key);
+
+    JsonWriter &null();
+    JsonWriter &value(bool value);
+    JsonWriter &value(int value);
+    JsonWriter &value(qint64 value);
+    JsonWriter &value(double value);
+    JsonWriter &value(QLatin1String value);
+    JsonWriter &value(const QString &value);
+    JsonWriter &value(const QStringList &value);
+    JsonWriter &value(const QJsonValue &value);
+
+    /*!
+     * Writes \a value recursively. Hashes and maps are written as objects with sorted keys,
+     * lists as arrays. Types without a direct JSON representation are converted like
+     * QJsonValue::fromVariant() does.
+     */
+    JsonWriter &value(const QVariant &value);
+
+    /*!
+     * Writes \a key followed by \a value.
+     */
+    template<typename T>
+    JsonWriter &member(QLatin1String key, const T &value)
+    {
+        this->key(key);
+        return this->value(value);
+    }
+
+private:
+    void separate();
+    void writeString(const QString &str);
+
+    QByteArray &m_out;
+    bool m_needsComma = false;
+};
+
+}
+
+#endif // SCHAUER_JSONWRITER_H
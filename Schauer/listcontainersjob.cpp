@@ -4,8 +4,11 @@
  */
 
 #include "listcontainersjob_p.h"
+#include "listdecoder.h"
 #include "logging.h"
 #include <QTimer>
+#include <QJsonArray>
+#include <QJsonObject>
 
 using namespace Schauer;
 
@@ -15,6 +18,8 @@ ListContainersJobPrivate::ListContainersJobPrivate(ListContainersJob *q)
     namOperation = NetworkOperation::Get;
     expectedContentType = ExpectedContentType::JsonArray;
     requiresAuth = false;
+    parseIncrementally = true;
+    coalesceRequests = true;
 }
 
 ListContainersJobPrivate::~ListContainersJobPrivate() = default;
@@ -37,6 +42,7 @@ QUrlQuery ListContainersJobPrivate::buildUrlQuery() const
     if (showSize) {
         uq.addQueryItem(QStringLiteral("size"), QStringLiteral("true"));
     }
+    addFiltersQueryItem(uq, filters);
     return uq;
 }
 
@@ -51,6 +57,24 @@ void ListContainersJobPrivate::emitDescription()
     Q_EMIT q->description(q, _title);
 }
 
+ContainerSummary ListContainersJobPrivate::containerFromColumns(const ContainerColumns &columns, int row)
+{
+    const auto r = static_cast<std::size_t>(row);
+    ContainerSummary c;
+    c.id = columns.ids[r];
+    c.names = columns.names[r];
+    c.image = columns.images[r];
+    c.imageId = columns.imageIds[r];
+    c.command = columns.commands[r];
+    c.created = QDateTime::fromSecsSinceEpoch(columns.created[r], Qt::UTC);
+    c.state = ContainerColumns::stateToString(columns.states[r]);
+    c.status = columns.statuses[r];
+    c.labels = columns.labelSets.at(columns.labels[r]);
+    c.sizeRw = static_cast<qint64>(columns.sizeRw[r]);
+    c.sizeRootFs = static_cast<qint64>(columns.sizeRootFs[r]);
+    return c;
+}
+
 ListContainersJob::ListContainersJob(QObject *parent)
     : Job(* new ListContainersJobPrivate(this), parent)
 {
@@ -61,6 +85,9 @@ ListContainersJob::~ListContainersJob() = default;
 
 void ListContainersJob::start()
 {
+    Q_D(ListContainersJob);
+    d->containers.clear();
+    d->containersDecoded = false;
     QTimer::singleShot(0, this, &ListContainersJob::sendRequest);
 }
 
@@ -112,4 +139,58 @@ void ListContainersJob::setShowSize(bool showSize)
     }
 }
 
+Filters ListContainersJob::filters() const
+{
+    Q_D(const ListContainersJob);
+    return d->filters;
+}
+
+void ListContainersJob::setFilters(const Filters &filters)
+{
+    Q_D(ListContainersJob);
+    if (d->filters != filters) {
+        qCDebug(schCore) << "Changing \"filters\" from" << d->filters.toJson() << "to" << filters.toJson();
+        d->filters = filters;
+        Q_EMIT filtersChanged(this->filters());
+    }
+}
+
+void ListContainersJob::addFilter(const QString &key, const QString &value)
+{
+    Q_D(ListContainersJob);
+    if (!d->filters.value(key).contains(value)) {
+        qCDebug(schCore) << "Adding filter" << key << "with value" << value;
+        d->filters.add(key, value);
+        Q_EMIT filtersChanged(this->filters());
+    }
+}
+
+QVector<ContainerSummary> ListContainersJob::containers() const
+{
+    Q_D(const ListContainersJob);
+    if (!d->containersDecoded && (!d->rawReply.isEmpty() || d->json().isArray())) {
+        d->containersDecoded = true;
+        // uses the same decoding and interning as the container models
+        ContainerColumns columns;
+        if (!d->rawReply.isEmpty()) {
+            ListDecoder decoder(d->rawReply.constData(), d->rawReply.size());
+            if (!decoder.decode(columns, AbstractBaseModelPrivate::AllColumns)) {
+                return d->containers;
+            }
+        } else {
+            // replies decoded while received or taken from the response cache
+            const QJsonArray array = d->json().array();
+            columns.reserve(static_cast<std::size_t>(array.size()));
+            for (const QJsonValue &v : array) {
+                columns.appendFromJson(v.toObject(), AbstractBaseModelPrivate::AllColumns);
+            }
+        }
+        d->containers.reserve(columns.rowCount());
+        for (int row = 0; row < columns.rowCount(); ++row) {
+            d->containers.push_back(ListContainersJobPrivate::containerFromColumns(columns, row));
+        }
+    }
+    return d->containers;
+}
+
 #include "moc_listcontainersjob.cpp"
@@ -8,6 +8,11 @@
 
 #include "schauer_exports.h"
 #include "job.h"
+#include "filters.h"
+#include <QDateTime>
+#include <QMap>
+#include <QStringList>
+#include <QVector>
 
 namespace Schauer {
 
@@ -17,6 +22,76 @@ namespace Schauer {
  * \brief Job classes to handle and modify Docker containers
  */
 
+/*!
+ * \ingroup api-jobs-containers
+ * \brief Summary of a container returned by ListContainersJob.
+ *
+ * \sa ListContainersJob::containers()
+ *
+ * \headerfile "" <Schauer/ListContainersJob>
+ */
+struct ContainerSummary
+{
+    /*!
+     * \brief ID of the container.
+     */
+    QString id;
+
+    /*!
+     * \brief Names of the container.
+     */
+    QStringList names;
+
+    /*!
+     * \brief Name of the image the container has been created from.
+     */
+    QString image;
+
+    /*!
+     * \brief ID of the image the container has been created from.
+     */
+    QString imageId;
+
+    /*!
+     * \brief Command running in the container.
+     */
+    QString command;
+
+    /*!
+     * \brief Creation time of the container in UTC.
+     */
+    QDateTime created;
+
+    /*!
+     * \brief State of the container, like \c running or \c exited.
+     */
+    QString state;
+
+    /*!
+     * \brief Human-readable status of the container, like <i>Up 3 hours</i>.
+     */
+    QString status;
+
+    /*!
+     * \brief Labels of the container.
+     */
+    QMap<QString,QString> labels;
+
+    /*!
+     * \brief Size of the files created or changed by the container in bytes.
+     *
+     * Only set if \link ListContainersJob::showSize showSize\endlink is \c true.
+     */
+    qint64 sizeRw = 0;
+
+    /*!
+     * \brief Total size of all files in the container in bytes.
+     *
+     * Only set if \link ListContainersJob::showSize showSize\endlink is \c true.
+     */
+    qint64 sizeRootFs = 0;
+};
+
 class ListContainersJobPrivate;
 
 /*!
@@ -26,6 +101,20 @@ class ListContainersJobPrivate;
  * Use this class to get a list of available containers from the Docker daemon.
  * There is also AbstractContainersModel to provide this information.
  *
+ * The reply is decoded while it is downloaded. Every container is emitted via
+ * itemReceived() as soon as it has been received completely.
+ *
+ * Use \link ListContainersJob::filters filters\endlink to let the daemon only return the
+ * containers you are interested in, instead of filtering them on the client side.
+ *
+ * \par Example
+ * \code{.cpp}
+ * auto job = new ListContainersJob();
+ * job->setShowAll(true);
+ * job->setFilters(Filters().label(QStringLiteral("com.example.owner"), QStringLiteral("tests"))
+ *                          .status(Filters::Exited));
+ * \endcode
+ *
  * \par API route
  * /containers/json
  *
@@ -34,8 +123,6 @@ class ListContainersJobPrivate;
  *
  * \dockerAPI{ContainerList}
  *
- * \todo Implement filters
- *
  * \headerfile "" <Schauer/ListConstainersJob>
  */
 class SCHAUER_LIBRARY ListContainersJob : public Job
@@ -81,6 +168,22 @@ class SCHAUER_LIBRARY ListContainersJob : public Job
      * \li void showSizeChanged(bool showSize)
      */
     Q_PROPERTY(bool showSize READ showSize WRITE setShowSize NOTIFY showSizeChanged)
+    /*!
+     * \brief Filters applied to the list of containers on the daemon side.
+     *
+     * Only containers matching all filters are returned. Supported filters are for example
+     * \c label, \c name, \c id, \c status, \c ancestor, \c before and \c since. By default no filters are set.
+     *
+     * \par Access functions
+     * \li Filters filters() const
+     * \li void setFilters(const Filters &filters)
+     *
+     * \par Notifier signal
+     * \li void filtersChanged(const Filters &filters)
+     *
+     * \sa addFilter()
+     */
+    Q_PROPERTY(Schauer::Filters filters READ filters WRITE setFilters NOTIFY filtersChanged)
 public:
     /*!
      * \brief Constructs a new %ListContainersJob with the given \a parent.
@@ -136,6 +239,33 @@ public:
      */
     void setShowSize(bool showSize);
 
+    /*!
+     * \brief Getter function for the \link ListContainersJob::filters filters\endlink property.
+     * \sa setFilters(), filtersChanged()
+     */
+    Filters filters() const;
+
+    /*!
+     * \brief Setter function for the \link ListContainersJob::filters filters\endlink property.
+     * \sa filters(), filtersChanged()
+     */
+    void setFilters(const Filters &filters);
+
+    /*!
+     * \brief Adds a filter \a value for filter \a key to the \link ListContainersJob::filters filters\endlink property.
+     * \sa filters(), setFilters()
+     */
+    void addFilter(const QString &key, const QString &value);
+
+    /*!
+     * \brief Returns the containers reported by the daemon.
+     *
+     * The reply is decoded on the first call after the job has been finished
+     * successfully, later calls return the decoded list directly. Returns an
+     * empty list as long as there is no reply.
+     */
+    QVector<ContainerSummary> containers() const;
+
 Q_SIGNALS:
     /*!
      * \brief Notifier signal for the \link ListContainersJob::limit limit\endlink property.
@@ -155,6 +285,12 @@ Q_SIGNALS:
      */
     void showSizeChanged(bool showSize);
 
+    /*!
+     * \brief Notifier signal for the \link ListContainersJob::filters filters\endlink property.
+     * \sa filters(), setFilters()
+     */
+    void filtersChanged(const Schauer::Filters &filters);
+
 private:
     Q_DECLARE_PRIVATE_D(s_ptr, ListContainersJob)
     Q_DISABLE_COPY(ListContainersJob)
@@ -162,4 +298,6 @@ private:
 
 }
 
+Q_DECLARE_METATYPE(Schauer::ContainerSummary)
+
 #endif // SCHAUER_LISTCONTAINERSJOB_H
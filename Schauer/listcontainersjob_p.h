@@ -8,6 +8,7 @@
 
 #include "listcontainersjob.h"
 #include "job_p.h"
+#include "abstractcontainermodel_p.h"
 
 namespace Schauer {
 
@@ -24,9 +25,14 @@ public:
 
     void emitDescription() override;
 
+    static ContainerSummary containerFromColumns(const ContainerColumns &columns, int row);
+
+    mutable QVector<ContainerSummary> containers;
     int limit = 0;
     bool showAll = false;
     bool showSize = false;
+    Filters filters;
+    mutable bool containersDecoded = false;
 
 private:
     Q_DISABLE_COPY(ListContainersJobPrivate)
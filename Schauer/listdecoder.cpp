@@ -0,0 +1,619 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "listdecoder.h"
+#include "abstractcontainermodel_p.h"
+#include "abstractimagemodel_p.h"
+#include "stringpool.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SCHAUER_LISTDECODER_SSE2
+#if defined(Q_CC_MSVC) && !defined(Q_CC_CLANG)
+#include <intrin.h>
+#endif
+#endif
+
+using namespace Schauer;
+
+namespace {
+
+inline bool isJsonWhitespace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+template<int N>
+inline bool keyIs(const char *key, int keySize, const char (&literal)[N])
+{
+    return keySize == N - 1 && std::memcmp(key, literal, N - 1) == 0;
+}
+
+#ifdef SCHAUER_LISTDECODER_SSE2
+inline int firstSetBit(unsigned int mask)
+{
+#if defined(Q_CC_MSVC) && !defined(Q_CC_CLANG)
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+/*!
+ * Returns a pointer to the first quotation mark or backslash in [pos, end) or end.
+ */
+inline const char *findStringSpecial(const char *pos, const char *end)
+{
+#ifdef SCHAUER_LISTDECODER_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    while (end - pos >= 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        const int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)));
+        if (mask != 0) {
+            return pos + firstSetBit(static_cast<unsigned int>(mask));
+        }
+        pos += 16;
+    }
+#endif
+    while (pos < end && *pos != '"' && *pos != '\\') {
+        ++pos;
+    }
+    return pos;
+}
+
+/*!
+ * Returns a pointer to the first quotation mark, brace or bracket in [pos, end) or end.
+ */
+inline const char *findStructural(const char *pos, const char *end)
+{
+#ifdef SCHAUER_LISTDECODER_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i openBrace = _mm_set1_epi8('{');
+    const __m128i closeBrace = _mm_set1_epi8('}');
+    const __m128i openBracket = _mm_set1_epi8('[');
+    const __m128i closeBracket = _mm_set1_epi8(']');
+    while (end - pos >= 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        const __m128i braces = _mm_or_si128(_mm_cmpeq_epi8(chunk, openBrace), _mm_cmpeq_epi8(chunk, closeBrace));
+        const __m128i brackets = _mm_or_si128(_mm_cmpeq_epi8(chunk, openBracket), _mm_cmpeq_epi8(chunk, closeBracket));
+        const int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_or_si128(braces, brackets)));
+        if (mask != 0) {
+            return pos + firstSetBit(static_cast<unsigned int>(mask));
+        }
+        pos += 16;
+    }
+#endif
+    while (pos < end && *pos != '"' && *pos != '{' && *pos != '}' && *pos != '[' && *pos != ']') {
+        ++pos;
+    }
+    return pos;
+}
+
+inline int hexValue(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+}
+
+ListDecoder::ListDecoder(const char *data, int size)
+    : m_pos(data), m_end(data + size)
+{
+
+}
+
+bool ListDecoder::decode(ContainerColumns &columns, quint32 mask)
+{
+    m_mask = mask;
+    if (!decodeArray(columns)) {
+        columns.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ListDecoder::decode(ImageColumns &columns, quint32 mask)
+{
+    m_mask = mask;
+    if (!decodeArray(columns)) {
+        columns.clear();
+        return false;
+    }
+    return true;
+}
+
+template<typename Columns>
+bool ListDecoder::decodeArray(Columns &columns)
+{
+    skipWhitespace();
+    if (m_pos >= m_end || *m_pos != '[') {
+        return false;
+    }
+    ++m_pos;
+    skipWhitespace();
+    if (m_pos < m_end && *m_pos == ']') {
+        ++m_pos;
+        skipWhitespace();
+        return m_pos == m_end;
+    }
+
+    while (m_pos < m_end) {
+        if (*m_pos != '{' || !decodeRow(columns)) {
+            return false;
+        }
+
+        skipWhitespace();
+        if (m_pos >= m_end) {
+            return false;
+        }
+        if (*m_pos == ']') {
+            ++m_pos;
+            skipWhitespace();
+            return m_pos == m_end;
+        }
+        if (*m_pos != ',') {
+            return false;
+        }
+        ++m_pos;
+        skipWhitespace();
+    }
+
+    return false;
+}
+
+template<typename Func>
+bool ListDecoder::parseObject(Func member)
+{
+    ++m_pos;
+    skipWhitespace();
+    if (m_pos < m_end && *m_pos == '}') {
+        ++m_pos;
+        return true;
+    }
+
+    while (m_pos < m_end) {
+        const char *key = nullptr;
+        int keySize = 0;
+        if (!parseKey(key, keySize) || !member(key, keySize)) {
+            return false;
+        }
+
+        skipWhitespace();
+        if (m_pos >= m_end) {
+            return false;
+        }
+        if (*m_pos == '}') {
+            ++m_pos;
+            return true;
+        }
+        if (*m_pos != ',') {
+            return false;
+        }
+        ++m_pos;
+    }
+
+    return false;
+}
+
+bool ListDecoder::decodeRow(ContainerColumns &columns)
+{
+    QString id;
+    QStringList names;
+    QString image;
+    QString imageId;
+    QString command;
+    QString state;
+    QString status;
+    QMap<QString,QString> labels;
+    qint64 created = 0;
+    qint64 sizeRw = 0;
+    qint64 sizeRootFs = 0;
+
+    const bool ok = parseObject([&](const char *key, int keySize) -> bool {
+        if (keyIs(key, keySize, "Id")) {
+            return parseString(id);
+        } else if (keyIs(key, keySize, "Names")) {
+            return (m_mask & ContainerColumns::NamesColumn) ? parseStringList(names) : skipValue();
+        } else if (keyIs(key, keySize, "Image")) {
+            return (m_mask & ContainerColumns::ImageColumn) ? parseString(image) : skipValue();
+        } else if (keyIs(key, keySize, "ImageID")) {
+            return (m_mask & ContainerColumns::ImageIdColumn) ? parseString(imageId) : skipValue();
+        } else if (keyIs(key, keySize, "Command")) {
+            return (m_mask & ContainerColumns::CommandColumn) ? parseString(command) : skipValue();
+        } else if (keyIs(key, keySize, "Created")) {
+            return (m_mask & ContainerColumns::CreatedColumn) ? parseInteger(created) : skipValue();
+        } else if (keyIs(key, keySize, "State")) {
+            return (m_mask & ContainerColumns::StateColumn) ? parseString(state) : skipValue();
+        } else if (keyIs(key, keySize, "Status")) {
+            return (m_mask & ContainerColumns::StatusColumn) ? parseString(status) : skipValue();
+        } else if (keyIs(key, keySize, "Labels")) {
+            return (m_mask & ContainerColumns::LabelsColumn) ? parseStringMap(labels) : skipValue();
+        } else if (keyIs(key, keySize, "SizeRw")) {
+            return (m_mask & ContainerColumns::SizeRwColumn) ? parseInteger(sizeRw) : skipValue();
+        } else if (keyIs(key, keySize, "SizeRootFs")) {
+            return (m_mask & ContainerColumns::SizeRootFsColumn) ? parseInteger(sizeRootFs) : skipValue();
+        }
+        return skipValue();
+    });
+
+    if (!ok) {
+        return false;
+    }
+
+    columns.ids.push_back(id);
+    columns.names.push_back(names);
+    columns.images.push_back(StringPool::intern(image));
+    columns.imageIds.push_back(StringPool::intern(imageId));
+    columns.commands.push_back(StringPool::intern(command));
+    columns.created.push_back(created);
+    columns.states.push_back(ContainerColumns::stateFromString(state));
+    columns.statuses.push_back(StringPool::intern(status));
+    columns.labels.push_back(columns.labelSets.insert(labels));
+    columns.sizeRw.push_back(static_cast<quint64>(sizeRw));
+    columns.sizeRootFs.push_back(static_cast<quint64>(sizeRootFs));
+
+    return true;
+}
+
+bool ListDecoder::decodeRow(ImageColumns &columns)
+{
+    QString id;
+    QString parentId;
+    QStringList repoTags;
+    QStringList repoDigests;
+    QMap<QString,QString> labels;
+    qint64 created = 0;
+    qint64 size = 0;
+    qint64 virtualSize = 0;
+    qint64 sharedSize = 0;
+    qint64 containers = 0;
+
+    const bool ok = parseObject([&](const char *key, int keySize) -> bool {
+        if (keyIs(key, keySize, "Id")) {
+            return parseString(id);
+        } else if (keyIs(key, keySize, "ParentId")) {
+            return (m_mask & ImageColumns::ParentIdColumn) ? parseString(parentId) : skipValue();
+        } else if (keyIs(key, keySize, "RepoTags")) {
+            return (m_mask & ImageColumns::RepoTagsColumn) ? parseStringList(repoTags) : skipValue();
+        } else if (keyIs(key, keySize, "RepoDigests")) {
+            return (m_mask & ImageColumns::RepoDigestsColumn) ? parseStringList(repoDigests) : skipValue();
+        } else if (keyIs(key, keySize, "Created")) {
+            return (m_mask & ImageColumns::CreatedColumn) ? parseInteger(created) : skipValue();
+        } else if (keyIs(key, keySize, "Size")) {
+            return (m_mask & ImageColumns::SizeColumn) ? parseInteger(size) : skipValue();
+        } else if (keyIs(key, keySize, "VirtualSize")) {
+            return (m_mask & ImageColumns::VirtualSizeColumn) ? parseInteger(virtualSize) : skipValue();
+        } else if (keyIs(key, keySize, "SharedSize")) {
+            return (m_mask & ImageColumns::SharedSizeColumn) ? parseInteger(sharedSize) : skipValue();
+        } else if (keyIs(key, keySize, "Labels")) {
+            return (m_mask & ImageColumns::LabelsColumn) ? parseStringMap(labels) : skipValue();
+        } else if (keyIs(key, keySize, "Containers")) {
+            return (m_mask & ImageColumns::ContainersColumn) ? parseInteger(containers) : skipValue();
+        }
+        return skipValue();
+    });
+
+    if (!ok) {
+        return false;
+    }
+
+    columns.ids.push_back(id);
+    columns.parentIds.push_back(StringPool::intern(parentId));
+    columns.repoTags.push_back(repoTags);
+    columns.repoDigests.push_back(repoDigests);
+    columns.created.push_back(created);
+    columns.size.push_back(size);
+    columns.virtualSize.push_back(virtualSize);
+    columns.sharedSize.push_back(sharedSize);
+    columns.labels.push_back(columns.labelSets.insert(labels));
+    columns.containers.push_back(static_cast<int>(containers));
+
+    return true;
+}
+
+void ListDecoder::skipWhitespace()
+{
+    while (m_pos < m_end && isJsonWhitespace(*m_pos)) {
+        ++m_pos;
+    }
+}
+
+bool ListDecoder::parseKey(const char *&key, int &keySize)
+{
+    skipWhitespace();
+    if (!parseRawString(key, keySize, m_keyEscaped)) {
+        return false;
+    }
+    skipWhitespace();
+    if (m_pos >= m_end || *m_pos != ':') {
+        return false;
+    }
+    ++m_pos;
+    skipWhitespace();
+    return true;
+}
+
+bool ListDecoder::parseRawString(const char *&str, int &size, bool &escaped)
+{
+    if (m_pos >= m_end || *m_pos != '"') {
+        return false;
+    }
+    ++m_pos;
+    str = m_pos;
+    escaped = false;
+    for (;;) {
+        m_pos = findStringSpecial(m_pos, m_end);
+        if (m_pos >= m_end) {
+            return false;
+        }
+        if (*m_pos == '"') {
+            size = static_cast<int>(m_pos - str);
+            ++m_pos;
+            return true;
+        }
+        // a backslash has to be followed by at least the escaped character
+        if (m_end - m_pos < 2) {
+            return false;
+        }
+        escaped = true;
+        m_pos += 2;
+    }
+}
+
+bool ListDecoder::parseString(QString &str)
+{
+    if (m_pos >= m_end) {
+        return false;
+    }
+    if (*m_pos != '"') {
+        // null or anything else that is not a string is an empty string
+        str.clear();
+        return skipValue();
+    }
+    const char *raw = nullptr;
+    int size = 0;
+    bool escaped = false;
+    return parseRawString(raw, size, escaped) && toString(raw, size, escaped, str);
+}
+
+bool ListDecoder::parseStringList(QStringList &list)
+{
+    if (m_pos >= m_end) {
+        return false;
+    }
+    if (*m_pos != '[') {
+        return skipValue();
+    }
+    ++m_pos;
+    skipWhitespace();
+    if (m_pos < m_end && *m_pos == ']') {
+        ++m_pos;
+        return true;
+    }
+
+    while (m_pos < m_end) {
+        QString str;
+        if (!parseString(str)) {
+            return false;
+        }
+        list << str;
+
+        skipWhitespace();
+        if (m_pos >= m_end) {
+            return false;
+        }
+        if (*m_pos == ']') {
+            ++m_pos;
+            StringPool::intern(list);
+            return true;
+        }
+        if (*m_pos != ',') {
+            return false;
+        }
+        ++m_pos;
+        skipWhitespace();
+    }
+
+    return false;
+}
+
+bool ListDecoder::parseStringMap(QMap<QString,QString> &map)
+{
+    if (m_pos >= m_end) {
+        return false;
+    }
+    if (*m_pos != '{') {
+        return skipValue();
+    }
+
+    const bool ok = parseObject([&](const char *key, int keySize) -> bool {
+        QString k;
+        QString v;
+        if (!toString(key, keySize, m_keyEscaped, k) || !parseString(v)) {
+            return false;
+        }
+        map.insert(k, v);
+        return true;
+    });
+
+    if (ok && !map.isEmpty()) {
+        StringPool::intern(map);
+    }
+
+    return ok;
+}
+
+bool ListDecoder::parseInteger(qint64 &value)
+{
+    value = 0;
+    if (m_pos >= m_end) {
+        return false;
+    }
+
+    const char *start = m_pos;
+    const bool negative = *m_pos == '-';
+    if (negative) {
+        ++m_pos;
+    }
+    if (m_pos >= m_end || *m_pos < '0' || *m_pos > '9') {
+        // null or anything else unexpected counts as 0
+        m_pos = start;
+        return skipValue();
+    }
+
+    int digits = 0;
+    while (m_pos < m_end && *m_pos >= '0' && *m_pos <= '9') {
+        value = value * 10 + (*m_pos - '0');
+        ++m_pos;
+        ++digits;
+    }
+
+    if (digits > 18 || (m_pos < m_end && (*m_pos == '.' || *m_pos == 'e' || *m_pos == 'E'))) {
+        // fractions, exponents and huge values are rare, let Qt convert them
+        while (m_pos < m_end && ((*m_pos >= '0' && *m_pos <= '9') || *m_pos == '.' || *m_pos == 'e' || *m_pos == 'E' || *m_pos == '+' || *m_pos == '-')) {
+            ++m_pos;
+        }
+        bool ok = false;
+        const double d = QByteArray(start, static_cast<int>(m_pos - start)).toDouble(&ok);
+        value = ok ? static_cast<qint64>(d) : 0;
+        return ok;
+    }
+
+    if (negative) {
+        value = -value;
+    }
+    return true;
+}
+
+bool ListDecoder::skipValue()
+{
+    if (m_pos >= m_end) {
+        return false;
+    }
+
+    const char first = *m_pos;
+    if (first == '"') {
+        const char *str = nullptr;
+        int size = 0;
+        bool escaped = false;
+        return parseRawString(str, size, escaped);
+    }
+
+    if (first == '{' || first == '[') {
+        int depth = 0;
+        while (m_pos < m_end) {
+            m_pos = findStructural(m_pos, m_end);
+            if (m_pos >= m_end) {
+                return false;
+            }
+            const char c = *m_pos;
+            if (c == '"') {
+                const char *str = nullptr;
+                int size = 0;
+                bool escaped = false;
+                if (!parseRawString(str, size, escaped)) {
+                    return false;
+                }
+                continue;
+            }
+            ++m_pos;
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if (--depth == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // numbers and literals
+    const char *start = m_pos;
+    while (m_pos < m_end && *m_pos != ',' && *m_pos != '}' && *m_pos != ']' && !isJsonWhitespace(*m_pos)) {
+        ++m_pos;
+    }
+    return m_pos > start;
+}
+
+bool ListDecoder::toString(const char *str, int size, bool escaped, QString &out)
+{
+    if (!escaped) {
+        out = QString::fromUtf8(str, size);
+        return true;
+    }
+
+    out.clear();
+    out.reserve(size);
+    const char *end = str + size;
+    const char *pos = str;
+    while (pos < end) {
+        const char *special = findStringSpecial(pos, end);
+        if (special > pos) {
+            out += QString::fromUtf8(pos, static_cast<int>(special - pos));
+        }
+        if (special >= end) {
+            break;
+        }
+        // special is a backslash, parseRawString() made sure that it is followed by a character
+        pos = special + 1;
+        switch (*pos) {
+        case '"':
+        case '\\':
+        case '/':
+            out += QLatin1Char(*pos);
+            break;
+        case 'b':
+            out += QLatin1Char('\b');
+            break;
+        case 'f':
+            out += QLatin1Char('\f');
+            break;
+        case 'n':
+            out += QLatin1Char('\n');
+            break;
+        case 'r':
+            out += QLatin1Char('\r');
+            break;
+        case 't':
+            out += QLatin1Char('\t');
+            break;
+        case 'u':
+        {
+            if (end - pos < 5) {
+                return false;
+            }
+            ushort unit = 0;
+            for (int i = 1; i <= 4; ++i) {
+                const int h = hexValue(pos[i]);
+                if (h < 0) {
+                    return false;
+                }
+                unit = static_cast<ushort>((unit << 4) | h);
+            }
+            // surrogate pairs are encoded as two escapes and end up as two QChars
+            out += QChar(unit);
+            pos += 4;
+            break;
+        }
+        default:
+            return false;
+        }
+        ++pos;
+    }
+    return true;
+}
@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_LISTDECODER_H
+#define SCHAUER_LISTDECODER_H
+
+#include "schauer_exports.h"
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+namespace Schauer {
+
+struct ContainerColumns;
+struct ImageColumns;
+
+/*!
+ * \internal
+ * \brief Decodes container and image list replies directly into model columns.
+ *
+ * The decoder scans the raw JSON reply of <tt>/containers/json</tt> and <tt>/images/json</tt>
+ * in place and appends the values of the known fields to the columns, without building a
+ * QJsonDocument first. Fields of columns that are not requested are skipped and get
+ * default values. Strings, objects and arrays are skipped 16 bytes at a time on CPUs
+ * with SSE2, everything else falls back to a byte-wise scan.
+ */
+class SCHAUER_AUTOTEST_EXPORT ListDecoder
+{
+public:
+    ListDecoder(const char *data, int size);
+
+    /*!
+     * Appends the containers in the data to \a columns, only decoding the columns set in \a mask.
+     * Returns \c false and clears \a columns if the data is not a JSON array of objects.
+     */
+    bool decode(ContainerColumns &columns, quint32 mask);
+
+    /*!
+     * Appends the images in the data to \a columns, only decoding the columns set in \a mask.
+     * Returns \c false and clears \a columns if the data is not a JSON array of objects.
+     */
+    bool decode(ImageColumns &columns, quint32 mask);
+
+private:
+    template<typename Columns>
+    bool decodeArray(Columns &columns);
+    template<typename Func>
+    bool parseObject(Func member);
+    bool decodeRow(ContainerColumns &columns);
+    bool decodeRow(ImageColumns &columns);
+    bool parseKey(const char *&key, int &keySize);
+    bool parseRawString(const char *&str, int &size, bool &escaped);
+    bool parseString(QString &str);
+    bool parseStringList(QStringList &list);
+    bool parseStringMap(QMap<QString,QString> &map);
+    bool parseInteger(qint64 &value);
+    bool skipValue();
+    void skipWhitespace();
+
+    static bool toString(const char *str, int size, bool escaped, QString &out);
+
+    const char *m_pos = nullptr;
+    const char *m_end = nullptr;
+    quint32 m_mask = 0;
+    bool m_keyEscaped = false;
+};
+
+}
+
+#endif // SCHAUER_LISTDECODER_H
@@ -4,8 +4,11 @@
  */
 
 #include "listimagesjob_p.h"
+#include "listdecoder.h"
 #include "logging.h"
 #include <QTimer>
+#include <QJsonArray>
+#include <QJsonObject>
 
 using namespace Schauer;
 
@@ -15,6 +18,8 @@ ListImagesJobPrivate::ListImagesJobPrivate(ListImagesJob *q)
     namOperation = NetworkOperation::Get;
     expectedContentType = ExpectedContentType::JsonArray;
     requiresAuth = false;
+    parseIncrementally = true;
+    coalesceRequests = true;
 }
 
 ListImagesJobPrivate::~ListImagesJobPrivate() = default;
@@ -34,6 +39,7 @@ QUrlQuery ListImagesJobPrivate::buildUrlQuery() const
     if (showDigests) {
         uq.addQueryItem(QStringLiteral("digests"), QStringLiteral("true"));
     }
+    addFiltersQueryItem(uq, filters);
     return uq;
 }
 
@@ -48,6 +54,23 @@ void ListImagesJobPrivate::emitDescription()
     Q_EMIT q->description(q, _title);
 }
 
+ImageSummary ListImagesJobPrivate::imageFromColumns(const ImageColumns &columns, int row)
+{
+    const auto r = static_cast<std::size_t>(row);
+    ImageSummary i;
+    i.id = columns.ids[r];
+    i.parentId = columns.parentIds[r];
+    i.repoTags = columns.repoTags[r];
+    i.repoDigests = columns.repoDigests[r];
+    i.created = QDateTime::fromSecsSinceEpoch(columns.created[r], Qt::UTC);
+    i.size = columns.size[r];
+    i.virtualSize = columns.virtualSize[r];
+    i.sharedSize = columns.sharedSize[r];
+    i.labels = columns.labelSets.at(columns.labels[r]);
+    i.containers = columns.containers[r];
+    return i;
+}
+
 ListImagesJob::ListImagesJob(QObject *parent)
     : Job(* new ListImagesJobPrivate(this), parent)
 {
@@ -58,6 +81,9 @@ ListImagesJob::~ListImagesJob() = default;
 
 void ListImagesJob::start()
 {
+    Q_D(ListImagesJob);
+    d->images.clear();
+    d->imagesDecoded = false;
     QTimer::singleShot(0, this, &ListImagesJob::sendRequest);
 }
 
@@ -93,4 +119,58 @@ void ListImagesJob::setShowDigests(bool showDigests)
     }
 }
 
+Filters ListImagesJob::filters() const
+{
+    Q_D(const ListImagesJob);
+    return d->filters;
+}
+
+void ListImagesJob::setFilters(const Filters &filters)
+{
+    Q_D(ListImagesJob);
+    if (d->filters != filters) {
+        qCDebug(schCore) << "Changing \"filters\" from" << d->filters.toJson() << "to" << filters.toJson();
+        d->filters = filters;
+        Q_EMIT filtersChanged(this->filters());
+    }
+}
+
+void ListImagesJob::addFilter(const QString &key, const QString &value)
+{
+    Q_D(ListImagesJob);
+    if (!d->filters.value(key).contains(value)) {
+        qCDebug(schCore) << "Adding filter" << key << "with value" << value;
+        d->filters.add(key, value);
+        Q_EMIT filtersChanged(this->filters());
+    }
+}
+
+QVector<ImageSummary> ListImagesJob::images() const
+{
+    Q_D(const ListImagesJob);
+    if (!d->imagesDecoded && (!d->rawReply.isEmpty() || d->json().isArray())) {
+        d->imagesDecoded = true;
+        // uses the same decoding and interning as the image models
+        ImageColumns columns;
+        if (!d->rawReply.isEmpty()) {
+            ListDecoder decoder(d->rawReply.constData(), d->rawReply.size());
+            if (!decoder.decode(columns, AbstractBaseModelPrivate::AllColumns)) {
+                return d->images;
+            }
+        } else {
+            // replies decoded while received or taken from the response cache
+            const QJsonArray array = d->json().array();
+            columns.reserve(static_cast<std::size_t>(array.size()));
+            for (const QJsonValue &v : array) {
+                columns.appendFromJson(v.toObject(), AbstractBaseModelPrivate::AllColumns);
+            }
+        }
+        d->images.reserve(columns.rowCount());
+        for (int row = 0; row < columns.rowCount(); ++row) {
+            d->images.push_back(ListImagesJobPrivate::imageFromColumns(columns, row));
+        }
+    }
+    return d->images;
+}
+
 #include "moc_listimagesjob.cpp"
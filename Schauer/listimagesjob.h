@@ -8,6 +8,11 @@
 
 #include "schauer_exports.h"
 #include "job.h"
+#include "filters.h"
+#include <QDateTime>
+#include <QMap>
+#include <QStringList>
+#include <QVector>
 
 namespace Schauer {
 
@@ -17,6 +22,67 @@ namespace Schauer {
  * \brief Job classes to handle and modify Docker images.
  */
 
+/*!
+ * \ingroup api-jobs-images
+ * \brief Summary of an image returned by ListImagesJob.
+ *
+ * \sa ListImagesJob::images()
+ *
+ * \headerfile "" <Schauer/ListImagesJob>
+ */
+struct ImageSummary
+{
+    /*!
+     * \brief ID of the image.
+     */
+    QString id;
+
+    /*!
+     * \brief ID of the parent image, if any.
+     */
+    QString parentId;
+
+    /*!
+     * \brief Tags referring to the image.
+     */
+    QStringList repoTags;
+
+    /*!
+     * \brief Content addressable digests of the image.
+     */
+    QStringList repoDigests;
+
+    /*!
+     * \brief Creation time of the image in UTC.
+     */
+    QDateTime created;
+
+    /*!
+     * \brief Total size of the image including all layers in bytes.
+     */
+    qint64 size = 0;
+
+    /*!
+     * \brief Virtual size of the image in bytes.
+     */
+    qint64 virtualSize = 0;
+
+    /*!
+     * \brief Size of the layers shared with other images in bytes, \c -1 if not calculated.
+     */
+    qint64 sharedSize = -1;
+
+    /*!
+     * \brief Labels of the image.
+     */
+    QMap<QString,QString> labels;
+
+    /*!
+     * \brief Number of containers using the image, \c -1 if not calculated.
+     */
+    int containers = -1;
+};
+
 class ListImagesJobPrivate;
 
 /*!
@@ -26,6 +92,18 @@ class ListImagesJobPrivate;
  * Use this class to get a list of available images from the docker daemon.
  * There is also AbstractImageModel to provide this information.
  *
+ * The reply is decoded while it is downloaded. Every image is emitted via
+ * itemReceived() as soon as it has been received completely.
+ *
+ * Use \link ListImagesJob::filters filters\endlink to let the daemon only return the
+ * images you are interested in, instead of filtering them on the client side.
+ *
+ * \par Example
+ * \code{.cpp}
+ * auto job = new ListImagesJob();
+ * job->setFilters(Filters().dangling(true));
+ * \endcode
+ *
  * \par API route
  * /images/json
  *
@@ -34,8 +112,6 @@ class ListImagesJobPrivate;
  *
  * \dockerAPI{ImageList}
  *
- * \todo Implement filters
- *
  * \headerfile "" <Schauer/ListImagesJob>
  */
 class SCHAUER_LIBRARY ListImagesJob : public Job
@@ -67,6 +143,22 @@ class SCHAUER_LIBRARY ListImagesJob : public Job
      * \li void showDigestsChanged(bool showDigests)
      */
     Q_PROPERTY(bool showDigests READ showDigests WRITE setShowDigests NOTIFY showDigestsChanged)
+    /*!
+     * \brief Filters applied to the list of images on the daemon side.
+     *
+     * Only images matching all filters are returned. Supported filters are for example
+     * \c label, \c before, \c since, \c dangling and \c reference. By default no filters are set.
+     *
+     * \par Access functions
+     * \li Filters filters() const
+     * \li void setFilters(const Filters &filters)
+     *
+     * \par Notifier signal
+     * \li void filtersChanged(const Filters &filters)
+     *
+     * \sa addFilter()
+     */
+    Q_PROPERTY(Schauer::Filters filters READ filters WRITE setFilters NOTIFY filtersChanged)
 public:
     /*!
      * \brief Constructs a new %ListImagesJob object with the given \a parent.
@@ -110,6 +202,33 @@ public:
      */
     void setShowDigests(bool showDigests);
 
+    /*!
+     * \brief Getter function for the \link ListImagesJob::filters filters\endlink property.
+     * \sa setFilters(), filtersChanged()
+     */
+    Filters filters() const;
+
+    /*!
+     * \brief Setter function for the \link ListImagesJob::filters filters\endlink property.
+     * \sa filters(), filtersChanged()
+     */
+    void setFilters(const Filters &filters);
+
+    /*!
+     * \brief Adds a filter \a value for filter \a key to the \link ListImagesJob::filters filters\endlink property.
+     * \sa filters(), setFilters()
+     */
+    void addFilter(const QString &key, const QString &value);
+
+    /*!
+     * \brief Returns the images reported by the daemon.
+     *
+     * The reply is decoded on the first call after the job has been finished
+     * successfully, later calls return the decoded list directly. Returns an
+     * empty list as long as there is no reply.
+     */
+    QVector<ImageSummary> images() const;
+
 Q_SIGNALS:
     /*!
      * \brief Notifier signal for the \link ListImagesJob::showAll showAll\endlink property.
@@ -123,6 +242,12 @@ Q_SIGNALS:
      */
     void showDigestsChanged(bool showDigests);
 
+    /*!
+     * \brief Notifier signal for the \link ListImagesJob::filters filters\endlink property.
+     * \sa filters(), setFilters()
+     */
+    void filtersChanged(const Schauer::Filters &filters);
+
 private:
     Q_DECLARE_PRIVATE_D(s_ptr, ListImagesJob)
     Q_DISABLE_COPY(ListImagesJob)
@@ -130,4 +255,6 @@ private:
 
 }
 
+Q_DECLARE_METATYPE(Schauer::ImageSummary)
+
 #endif // SCHAUER_LISTIMAGESJOB_H
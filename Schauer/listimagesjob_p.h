@@ -8,6 +8,7 @@
 
 #include "listimagesjob.h"
 #include "job_p.h"
+#include "abstractimagemodel_p.h"
 
 namespace Schauer {
 
@@ -24,8 +25,13 @@ public:
 
     void emitDescription() override;
 
+    static ImageSummary imageFromColumns(const ImageColumns &columns, int row);
+
+    mutable QVector<ImageSummary> images;
     bool showAll = false;
     bool showDigests = false;
+    Filters filters;
+    mutable bool imagesDecoded = false;
 
 private:
     Q_DISABLE_COPY(ListImagesJobPrivate)
@@ -15,6 +15,7 @@ RemoveContainerJobPrivate::RemoveContainerJobPrivate(RemoveContainerJob *q)
     namOperation = NetworkOperation::Delete;
     expectedContentType = ExpectedContentType::Empty;
     requiresAuth = false;
+    invalidatesEndpoint = QStringLiteral("/containers/json");
 }
 
 RemoveContainerJobPrivate::~RemoveContainerJobPrivate() = default;
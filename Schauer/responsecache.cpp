@@ -0,0 +1,147 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "responsecache.h"
+#include "logging.h"
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+using namespace Schauer;
+
+namespace {
+
+struct CacheEntry {
+    QJsonDocument result;
+    // set instead of result for replies that have not been parsed
+    QByteArray raw;
+    QElapsedTimer age;
+    int timeToLive = 0;
+};
+
+// configuration -> endpoint -> request target
+using EndpointEntries = QHash<QString,CacheEntry>;
+using ConfigurationEntries = QHash<QString,EndpointEntries>;
+
+struct CacheData {
+    QMutex mutex;
+    QHash<AbstractConfiguration*,ConfigurationEntries> entries;
+    QHash<AbstractConfiguration*,quint64> generations;
+};
+
+Q_GLOBAL_STATIC(CacheData, cacheData)
+
+}
+
+bool ResponseCache::lookup(AbstractConfiguration *configuration, const QString &endpoint, const QString &target, QJsonDocument *result, QByteArray *raw)
+{
+    CacheData *data = cacheData();
+    if (!data) {
+        return false;
+    }
+
+    QMutexLocker locker(&data->mutex);
+
+    auto cIt = data->entries.find(configuration);
+    if (cIt == data->entries.end()) {
+        return false;
+    }
+
+    auto eIt = cIt.value().find(endpoint);
+    if (eIt == cIt.value().end()) {
+        return false;
+    }
+
+    auto tIt = eIt.value().find(target);
+    if (tIt == eIt.value().end()) {
+        return false;
+    }
+
+    if (tIt.value().age.hasExpired(tIt.value().timeToLive)) {
+        qCDebug(schCore) << "Cached reply for" << target << "has expired";
+        eIt.value().erase(tIt);
+        return false;
+    }
+
+    *result = tIt.value().result;
+    *raw = tIt.value().raw;
+    return true;
+}
+
+quint64 ResponseCache::generation(AbstractConfiguration *configuration)
+{
+    CacheData *data = cacheData();
+    if (!data) {
+        return 0;
+    }
+
+    QMutexLocker locker(&data->mutex);
+    return data->generations.value(configuration, 0);
+}
+
+void ResponseCache::insert(AbstractConfiguration *configuration, const QString &endpoint, const QString &target, const QJsonDocument &result, const QByteArray &raw, int timeToLive, quint64 generation)
+{
+    if (timeToLive <= 0) {
+        return;
+    }
+
+    CacheData *data = cacheData();
+    if (!data) {
+        return;
+    }
+
+    QMutexLocker locker(&data->mutex);
+
+    if (data->generations.value(configuration, 0) != generation) {
+        qCDebug(schCore) << "Not caching reply for" << target << "as the cache has been invalidated in the meantime";
+        return;
+    }
+
+    CacheEntry &entry = data->entries[configuration][endpoint][target];
+    if (raw.isEmpty()) {
+        entry.result = result;
+        entry.raw.clear();
+    } else {
+        entry.result = QJsonDocument();
+        entry.raw = raw;
+    }
+    entry.timeToLive = timeToLive;
+    entry.age.start();
+}
+
+void ResponseCache::invalidate(AbstractConfiguration *configuration, const QString &endpoint)
+{
+    CacheData *data = cacheData();
+    if (!data) {
+        return;
+    }
+
+    QMutexLocker locker(&data->mutex);
+
+    data->generations[configuration]++;
+
+    if (endpoint.isEmpty()) {
+        data->entries.remove(configuration);
+        return;
+    }
+
+    auto cIt = data->entries.find(configuration);
+    if (cIt != data->entries.end() && cIt.value().remove(endpoint) > 0) {
+        qCDebug(schCore) << "Invalidated cached replies for" << endpoint;
+    }
+}
+
+void ResponseCache::remove(AbstractConfiguration *configuration)
+{
+    CacheData *data = cacheData();
+    if (!data) {
+        return;
+    }
+
+    QMutexLocker locker(&data->mutex);
+    data->entries.remove(configuration);
+    data->generations.remove(configuration);
+}
@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_RESPONSECACHE_H
+#define SCHAUER_RESPONSECACHE_H
+
+#include <QByteArray>
+#include <QJsonDocument>
+#include <QString>
+
+namespace Schauer {
+
+class AbstractConfiguration;
+
+/*!
+ * \internal
+ * \brief Process wide cache for replies of read-only API requests.
+ *
+ * Entries are stored per configuration and endpoint, like \c /containers/json, and
+ * the full request target including the query. The time to live is taken from
+ * AbstractConfiguration::responseCacheTimeToLive() when the entry is stored. Replies
+ * are stored as received if they have not been parsed, otherwise as parsed document.
+ * All functions are thread-safe.
+ */
+class ResponseCache
+{
+public:
+    /*!
+     * Returns the cached reply for \a target of \a endpoint if there is one that has
+     * not expired yet. Otherwise returns \c false. Either \a raw is set to the reply
+     * data or \a result to the parsed document, depending on what has been stored.
+     */
+    static bool lookup(AbstractConfiguration *configuration, const QString &endpoint, const QString &target, QJsonDocument *result, QByteArray *raw);
+
+    /*!
+     * Returns the number of times the entries of \a configuration have been invalidated.
+     */
+    static quint64 generation(AbstractConfiguration *configuration);
+
+    /*!
+     * Stores \a raw, or \a result if \a raw is empty, for \a target of \a endpoint for
+     * \a timeToLive milliseconds. If the entries of \a configuration have been invalidated
+     * since \a generation has been taken, the result might be outdated and will not be stored.
+     */
+    static void insert(AbstractConfiguration *configuration, const QString &endpoint, const QString &target, const QJsonDocument &result, const QByteArray &raw, int timeToLive, quint64 generation);
+
+    /*!
+     * Removes all entries of \a endpoint for \a configuration. If \a endpoint is empty,
+     * removes all entries of \a configuration.
+     */
+    static void invalidate(AbstractConfiguration *configuration, const QString &endpoint = QString());
+
+    /*!
+     * Removes all data stored for \a configuration, used when it gets destroyed.
+     */
+    static void remove(AbstractConfiguration *configuration);
+};
+
+}
+
+#endif // SCHAUER_RESPONSECACHE_H
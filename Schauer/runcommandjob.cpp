@@ -0,0 +1,379 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "runcommandjob_p.h"
+#include "logging.h"
+#include "jsonwriter.h"
+#include <QTimer>
+#include <QJsonObject>
+#include <utility>
+
+using namespace Schauer;
+
+namespace {
+constexpr int maxInspects = 20;
+constexpr int inspectDelay = 50;
+}
+
+RunCommandJobPrivate::RunCommandJobPrivate(RunCommandJob *q)
+    : JobPrivate(q)
+{
+    requiresAuth = false;
+    setStage(Stage::Create);
+    demuxer.setCallback([this, q](StreamDemuxer::StreamType stream, const QByteArray &data){
+        if (stream == StreamDemuxer::Stderr) {
+            standardError.append(data);
+            Q_EMIT q->stderrReceived(data);
+        } else {
+            standardOutput.append(data);
+            Q_EMIT q->stdoutReceived(data);
+        }
+    });
+}
+
+RunCommandJobPrivate::~RunCommandJobPrivate() = default;
+
+void RunCommandJobPrivate::setStage(Stage newStage)
+{
+    stage = newStage;
+    switch (stage) {
+    case Stage::Create:
+        namOperation = NetworkOperation::Post;
+        expectedContentType = ExpectedContentType::JsonObject;
+        break;
+    case Stage::Start:
+        namOperation = NetworkOperation::Post;
+        expectedContentType = ExpectedContentType::Stream;
+        break;
+    case Stage::Inspect:
+        namOperation = NetworkOperation::Get;
+        expectedContentType = ExpectedContentType::JsonObject;
+        break;
+    }
+}
+
+QString RunCommandJobPrivate::buildUrlPath() const
+{
+    switch (stage) {
+    case Stage::Create:
+    {
+        const QString _id = id.startsWith(QLatin1Char('/')) ? id.mid(1) : id;
+        return JobPrivate::buildUrlPath() + QLatin1String("/containers/") + _id + QLatin1String("/exec");
+    }
+    case Stage::Start:
+        return JobPrivate::buildUrlPath() + QLatin1String("/exec/") + execId + QLatin1String("/start");
+    case Stage::Inspect:
+        return JobPrivate::buildUrlPath() + QLatin1String("/exec/") + execId + QLatin1String("/json");
+    }
+
+    return JobPrivate::buildUrlPath();
+}
+
+std::pair<QByteArray,QByteArray> RunCommandJobPrivate::buildPayload() const
+{
+    QByteArray payload;
+    JsonWriter w(payload);
+
+    if (stage == Stage::Create) {
+        payload.reserve(256);
+        w.beginObject();
+        w.member(QLatin1String("AttachStdin"), false);
+        w.member(QLatin1String("AttachStdout"), true);
+        w.member(QLatin1String("AttachStderr"), true);
+        w.member(QLatin1String("Cmd"), cmd);
+        w.member(QLatin1String("Env"), env);
+        w.member(QLatin1String("Privileged"), privileged);
+        w.member(QLatin1String("Tty"), tty);
+        w.member(QLatin1String("User"), user);
+        w.member(QLatin1String("WorkingDir"), workingDir);
+        w.endObject();
+    } else if (stage == Stage::Start) {
+        w.beginObject();
+        w.member(QLatin1String("Detach"), false);
+        w.member(QLatin1String("Tty"), tty);
+        w.endObject();
+    } else {
+        return JobPrivate::buildPayload();
+    }
+
+    return std::make_pair(payload, QByteArrayLiteral("application/json"));
+}
+
+void RunCommandJobPrivate::emitDescription()
+{
+    Q_Q(RunCommandJob);
+
+    //: Job description title, %1 will be replaced by container id/name
+    //% "Running command in container %1"
+    const QString _title = qtTrId("libschauer-job-desc-run-command").arg(id);
+
+    //: Job description field name
+    //% "Command"
+    const QString _f1Name = qtTrId("libschauer-job-desc-run-command-field1-name");
+
+    Q_EMIT q->description(q, _title, qMakePair(_f1Name, cmd.join(QLatin1Char(' '))));
+}
+
+bool RunCommandJobPrivate::checkInput()
+{
+    if (!JobPrivate::checkInput()) {
+        return false;
+    }
+
+    if (stage != Stage::Create) {
+        return true;
+    }
+
+    if (id.isEmpty()) {
+        //: Error message when trying to run a command
+        //% "Can not run a command without a valid container ID."
+        emitError(InvalidInput, qtTrId("libschauer-run-command-err-empty-id"));
+        qCCritical(schCore) << "Missing container ID when trying to run a command.";
+        return false;
+    }
+
+    if (cmd.empty()) {
+        //: Error message when trying to run a command
+        //% "Can not run an empty command."
+        emitError(InvalidInput, qtTrId("libschauer-run-command-err-empty-cmd"));
+        qCCritical(schCore) << "Missing command to execute when trying to run a command.";
+        return false;
+    }
+
+    return true;
+}
+
+void RunCommandJobPrivate::processStreamData(const QByteArray &data)
+{
+    demuxer.feed(data);
+}
+
+bool RunCommandJobPrivate::checkOutput(const QByteArray &data)
+{
+    if (!JobPrivate::checkOutput(data)) {
+        return false;
+    }
+
+    if ((stage == Stage::Create || stage == Stage::Inspect) && !parseReply()) {
+        return false;
+    }
+
+    if (stage == Stage::Create) {
+        execId = json().object().value(QStringLiteral("Id")).toString();
+        if (Q_UNLIKELY(execId.isEmpty())) {
+            Q_Q(RunCommandJob);
+            q->setError(WrongOutputType);
+            qCCritical(schCore) << "Invalid reply: the created exec instance has no ID.";
+            return false;
+        }
+    } else if (stage == Stage::Inspect) {
+        if (json().object().value(QStringLiteral("Running")).toBool() && inspectAttempts >= maxInspects) {
+            Q_Q(RunCommandJob);
+            q->setError(APIError);
+            //: Error message if a command is still running after its output has been closed, %1 will be replaced by the exec instance ID
+            //% "The command in exec instance %1 is still running although its output has been closed."
+            q->setErrorText(qtTrId("libschauer-run-command-err-still-running").arg(execId));
+            qCCritical(schCore) << "Command in exec instance" << execId << "is still running after" << inspectAttempts << "inspections.";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool RunCommandJobPrivate::prepareNextRequest()
+{
+    switch (stage) {
+    case Stage::Create:
+        qCDebug(schCore) << "Created exec instance" << execId << "in container" << id;
+        demuxer.setMode(tty ? StreamDemuxer::Raw : StreamDemuxer::Multiplexed);
+        setStage(Stage::Start);
+        return true;
+    case Stage::Start:
+        setStage(Stage::Inspect);
+        return true;
+    case Stage::Inspect:
+    {
+        const QJsonObject o = json().object();
+        if (o.value(QStringLiteral("Running")).toBool()) {
+            // the output stream might be closed slightly before the daemon has updated the exec state,
+            // checkOutput() fails the job if it is still running after the last attempt
+            inspectAttempts++;
+            nextRequestDelay = inspectDelay;
+            return true;
+        }
+        exitCode = o.value(QStringLiteral("ExitCode")).toInt(-1);
+        qCDebug(schCore) << "Command in exec instance" << execId << "exited with code" << exitCode;
+        return false;
+    }
+    }
+
+    return false;
+}
+
+bool RunCommandJobPrivate::isLongLived() const
+{
+    // the output is streamed until the command exits
+    return stage == Stage::Start;
+}
+
+RunCommandJob::RunCommandJob(QObject *parent)
+    : Job(* new RunCommandJobPrivate(this), parent)
+{
+
+}
+
+RunCommandJob::~RunCommandJob() = default;
+
+void RunCommandJob::start()
+{
+    Q_D(RunCommandJob);
+    d->setStage(RunCommandJobPrivate::Stage::Create);
+    d->execId.clear();
+    d->standardOutput.clear();
+    d->standardError.clear();
+    d->exitCode = -1;
+    d->inspectAttempts = 0;
+    d->demuxer.reset();
+    QTimer::singleShot(0, this, &RunCommandJob::sendRequest);
+}
+
+QString RunCommandJob::id() const
+{
+    Q_D(const RunCommandJob);
+    return d->id;
+}
+
+void RunCommandJob::setId(const QString &id)
+{
+    Q_D(RunCommandJob);
+    if (d->id != id) {
+        qCDebug(schCore) << "Changing \"id\" from" << d->id << "to" << id;
+        d->id = id;
+        Q_EMIT idChanged(this->id());
+    }
+}
+
+QStringList RunCommandJob::cmd() const
+{
+    Q_D(const RunCommandJob);
+    return d->cmd;
+}
+
+void RunCommandJob::setCmd(const QStringList &cmd)
+{
+    Q_D(RunCommandJob);
+    if (d->cmd != cmd) {
+        qCDebug(schCore) << "Changing \"cmd\" from" << d->cmd << "to" << cmd;
+        d->cmd = cmd;
+        Q_EMIT cmdChanged(this->cmd());
+    }
+}
+
+QStringList RunCommandJob::env() const
+{
+    Q_D(const RunCommandJob);
+    return d->env;
+}
+
+void RunCommandJob::setEnv(const QStringList &env)
+{
+    Q_D(RunCommandJob);
+    if (d->env != env) {
+        qCDebug(schCore) << "Changing \"env\" from" << d->env << "to" << env;
+        d->env = env;
+        Q_EMIT envChanged(this->env());
+    }
+}
+
+QString RunCommandJob::user() const
+{
+    Q_D(const RunCommandJob);
+    return d->user;
+}
+
+void RunCommandJob::setUser(const QString &user)
+{
+    Q_D(RunCommandJob);
+    if (d->user != user) {
+        qCDebug(schCore) << "Changing \"user\" from" << d->user << "to" << user;
+        d->user = user;
+        Q_EMIT userChanged(this->user());
+    }
+}
+
+QString RunCommandJob::workingDir() const
+{
+    Q_D(const RunCommandJob);
+    return d->workingDir;
+}
+
+void RunCommandJob::setWorkingDir(const QString &workingDir)
+{
+    Q_D(RunCommandJob);
+    if (d->workingDir != workingDir) {
+        qCDebug(schCore) << "Changing \"workingDir\" from" << d->workingDir << "to" << workingDir;
+        d->workingDir = workingDir;
+        Q_EMIT workingDirChanged(this->workingDir());
+    }
+}
+
+bool RunCommandJob::privileged() const
+{
+    Q_D(const RunCommandJob);
+    return d->privileged;
+}
+
+void RunCommandJob::setPrivileged(bool privileged)
+{
+    Q_D(RunCommandJob);
+    if (d->privileged != privileged) {
+        qCDebug(schCore) << "Changing \"privileged\" from" << d->privileged << "to" << privileged;
+        d->privileged = privileged;
+        Q_EMIT privilegedChanged(this->privileged());
+    }
+}
+
+bool RunCommandJob::tty() const
+{
+    Q_D(const RunCommandJob);
+    return d->tty;
+}
+
+void RunCommandJob::setTty(bool tty)
+{
+    Q_D(RunCommandJob);
+    if (d->tty != tty) {
+        qCDebug(schCore) << "Changing \"tty\" from" << d->tty << "to" << tty;
+        d->tty = tty;
+        Q_EMIT ttyChanged(this->tty());
+    }
+}
+
+QString RunCommandJob::execId() const
+{
+    Q_D(const RunCommandJob);
+    return d->execId;
+}
+
+int RunCommandJob::exitCode() const
+{
+    Q_D(const RunCommandJob);
+    return d->exitCode;
+}
+
+QByteArray RunCommandJob::standardOutput() const
+{
+    Q_D(const RunCommandJob);
+    return d->standardOutput;
+}
+
+QByteArray RunCommandJob::standardError() const
+{
+    Q_D(const RunCommandJob);
+    return d->standardError;
+}
+
+#include "moc_runcommandjob.cpp"
@@ -0,0 +1,345 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_RUNCOMMANDJOB_H
+#define SCHAUER_RUNCOMMANDJOB_H
+
+#include "schauer_exports.h"
+#include "job.h"
+
+namespace Schauer {
+
+class RunCommandJobPrivate;
+
+/*!
+ * \ingroup api-jobs-exec
+ * \brief Runs a command in a running container and returns its exit code and output.
+ *
+ * This job combines CreateExecInstanceJob, StartExecInstanceJob and the inspection
+ * of the exec instance into a single job. It creates an exec instance with \a stdout
+ * and \a stderr attached, starts it attached and inspects it after the command has
+ * finished to get the exit code. All requests are performed by this job one after
+ * another, reusing the connection to the Docker daemon if possible.
+ *
+ * The job succeeds if all requests were successful, regardless of the exit code of the
+ * command. The output is emitted via stdoutReceived() and stderrReceived() while it
+ * arrives and is also available via standardOutput() and standardError() after the
+ * job has been finished. replyData() will contain the result of the exec inspection.
+ * If the daemon still reports the exec instance as running after its output has been
+ * closed and some more inspections, the job fails with an \link Schauer::APIError APIError\endlink.
+ *
+ * Have a look at the description of the Job class to learn how to use Job
+ * classes.
+ *
+ * \par Example
+ * \code{.cpp}
+ * auto job = new RunCommandJob();
+ * job->setId(QStringLiteral("my-container"));
+ * job->setCmd(QStringList({QStringLiteral("ls"), QStringLiteral("-l"), QStringLiteral("/")}));
+ * if (job->exec()) {
+ *     qDebug() << "Exit code:" << job->exitCode();
+ *     qDebug() << job->standardOutput();
+ * }
+ * \endcode
+ *
+ * \par API routes
+ * /containers/{\link RunCommandJob::id id\endlink}/exec, /exec/{id}/start, /exec/{id}/json
+ *
+ * \par API methods
+ * POST, POST, GET
+ *
+ * \dockerAPI{ContainerExec}
+ *
+ * \headerfile "" <Schauer/RunCommandJob>
+ */
+class SCHAUER_LIBRARY RunCommandJob : public Job
+{
+    Q_OBJECT
+    /*!
+     * \brief ID or name of the container to exectue the \link RunCommandJob::cmd command\endlink in.
+     *
+     * By default this property holds an empty string. This property must be set to
+     * a valid container ID or name to execute the job.
+     *
+     * \par Access functions
+     * \li QString() id() const
+     * \li void setId(const QString &id)
+     *
+     * \par Notifier signal
+     * \li void idChanged(const QString &id)
+     */
+    Q_PROPERTY(QString id READ id WRITE setId NOTIFY idChanged)
+    /*!
+     * \brief Sets the command and its arguments to execute.
+     *
+     * The command is set as list of command and arguments. The default
+     * value is an empty list and the job will not execute with an empty list.
+     *
+     * \par Access functions
+     * \li QStringList cmd() const
+     * \li void setCmd(const QStringList &cmd)
+     *
+     * \par Notifier signal
+     * \li void cmdChanged(const QStringList &cmd)
+     */
+    Q_PROPERTY(QStringList cmd READ cmd WRITE setCmd NOTIFY cmdChanged)
+    /*!
+     * \brief Sets the environment variabels used when executing the \link RunCommandJob::cmd command\endlink.
+     *
+     * The default value is an empty list. Set the list of environment variables in the form
+     * \c QStringList({QStringLiteral("VAR=value"), …}).
+     *
+     * \par Access functions
+     * \li QStringList env() const
+     * \li void setEnv(const QStringList &env)
+     *
+     * \par Notifier signal
+     * \li void envChanged(const QStringList &env)
+     */
+    Q_PROPERTY(QStringList env READ env WRITE setEnv NOTIFY envChanged)
+    /*!
+     * \brief This property holds the user, and optionally, group to run the command
+     * inside the container.
+     *
+     * Format is one of \c user, \c user:group, \c uid or \c uid:gid.
+     *
+     * \par Access functions
+     * \li QString user() const
+     * \li void setUser(const QString &user)
+     *
+     * \par Notifier signal
+     * \li void userChanged(const QString &user)
+     */
+    Q_PROPERTY(QString user READ user WRITE setUser NOTIFY userChanged)
+    /*!
+     * \brief This property holds the working directoy for the command inside the container.
+     *
+     * \par Access functions
+     * \li QString workingDir() const
+     * \li void setWorkingDir(const QString &workingDir)
+     *
+     * \par Notifier signal
+     * \li void workingDirChanged(const QString &workingDir)
+     */
+    Q_PROPERTY(QString workingDir READ workingDir WRITE setWorkingDir NOTIFY workingDirChanged)
+    /*!
+     * \brief Set this to \c true to run the command with exended privileges.
+     *
+     * The default value is \c false.
+     *
+     * \par Access functions
+     * \li bool privileged() const
+     * \li void setPrivileged(bool privileged)
+     *
+     * \par Notifier signal
+     * \li void privilegedChanged(bool privileged)
+     */
+    Q_PROPERTY(bool privileged READ privileged WRITE setPrivileged NOTIFY privilegedChanged)
+    /*!
+     * \brief This property holds whether a pseudo-TTY should be allocated.
+     *
+     * If a TTY is allocated, \a stdout and \a stderr are not separated and all
+     * output will be available as \a stdout. The default value is \c false.
+     *
+     * \par Access functions
+     * \li bool tty() const
+     * \li void setTty(bool tty)
+     *
+     * \par Notifier signal
+     * \li void ttyChanged(bool tty)
+     */
+    Q_PROPERTY(bool tty READ tty WRITE setTty NOTIFY ttyChanged)
+public:
+    /*!
+     * \brief Constructs a new %RunCommandJob with the given \a parent.
+     */
+    explicit RunCommandJob(QObject *parent = nullptr);
+
+    /*!
+     * \brief Destroys the %RunCommandJob object.
+     */
+    ~RunCommandJob() override;
+
+    /*!
+     * \brief Runs the command asynchronously.
+     *
+     * When the job is finished, result() is emitted.
+     * To run the command in a synchronous way, use exec().
+     */
+    void start() override;
+
+    /*!
+     * \brief Getter function for the \link RunCommandJob::id id\endlink property.
+     * \sa setId(), idChanged()
+     */
+    QString id() const;
+
+    /*!
+     * \brief Setter function for the \link RunCommandJob::id id\endlink property.
+     * \sa id(), idChanged()
+     */
+    void setId(const QString &id);
+
+    /*!
+     * \brief Getter function for the \link RunCommandJob::cmd cmd\endlink property.
+     * \sa setCmd(), cmdChanged()
+     */
+    QStringList cmd() const;
+
+    /*!
+     * \brief Setter function for the \link RunCommandJob::cmd cmd\endlink property.
+     * \sa cmd(), cmdChanged()
+     */
+    void setCmd(const QStringList &cmd);
+
+    /*!
+     * \brief Getter function for the \link RunCommandJob::env env\endlink property.
+     * \sa setEnv(), envChanged()
+     */
+    QStringList env() const;
+
+    /*!
+     * \brief Setter function for the \link RunCommandJob::env env\endlink property.
+     * \sa env(), envChanged()
+     */
+    void setEnv(const QStringList &env);
+
+    /*!
+     * \brief Getter function for the \link RunCommandJob::user user\endlink property.
+     * \sa setUser(), userChanged()
+     */
+    QString user() const;
+
+    /*!
+     * \brief Setter function for the \link RunCommandJob::user user\endlink property.
+     * \sa user(), userChanged()
+     */
+    void setUser(const QString &user);
+
+    /*!
+     * \brief Getter function for the \link RunCommandJob::workingDir workingDir\endlink property.
+     * \sa setWorkingDir(), workingDirChanged()
+     */
+    QString workingDir() const;
+
+    /*!
+     * \brief Setter function for the \link RunCommandJob::workingDir workingDir\endlink property.
+     * \sa workingDir(), workingDirChanged()
+     */
+    void setWorkingDir(const QString &workingDir);
+
+    /*!
+     * \brief Getter function for the \link RunCommandJob::privileged privileged\endlink property.
+     * \sa setPrivileged(), privilegedChanged()
+     */
+    bool privileged() const;
+
+    /*!
+     * \brief Setter function for the \link RunCommandJob::privileged privileged\endlink property.
+     * \sa privileged(), privilegedChanged()
+     */
+    void setPrivileged(bool privileged);
+
+    /*!
+     * \brief Getter function for the \link RunCommandJob::tty tty\endlink property.
+     * \sa setTty(), ttyChanged()
+     */
+    bool tty() const;
+
+    /*!
+     * \brief Setter function for the \link RunCommandJob::tty tty\endlink property.
+     * \sa tty(), ttyChanged()
+     */
+    void setTty(bool tty);
+
+    /*!
+     * \brief Returns the ID of the exec instance created by this job.
+     *
+     * Returns an empty string until the exec instance has been created.
+     */
+    QString execId() const;
+
+    /*!
+     * \brief Returns the exit code of the command.
+     *
+     * Returns \c -1 if the job has not been finished successfully.
+     */
+    int exitCode() const;
+
+    /*!
+     * \brief Returns all data the command has written to \a stdout.
+     * \sa stdoutReceived()
+     */
+    QByteArray standardOutput() const;
+
+    /*!
+     * \brief Returns all data the command has written to \a stderr.
+     * \sa stderrReceived()
+     */
+    QByteArray standardError() const;
+
+Q_SIGNALS:
+    /*!
+     * \brief Notifier signal for the \link RunCommandJob::id id\endlink property.
+     * \sa id(), setId()
+     */
+    void idChanged(const QString &id);
+
+    /*!
+     * \brief Notifier signal for the \link RunCommandJob::cmd cmd\endlink property.
+     * \sa cmd(), setCmd()
+     */
+    void cmdChanged(const QStringList &cmd);
+
+    /*!
+     * \brief Notifier signal for the \link RunCommandJob::env env\endlink property.
+     * \sa env(), setEnv()
+     */
+    void envChanged(const QStringList &env);
+
+    /*!
+     * \brief Notifier signal for the \link RunCommandJob::user user\endlink property.
+     * \sa user(), setUser()
+     */
+    void userChanged(const QString &user);
+
+    /*!
+     * \brief Notifier signal for the \link RunCommandJob::workingDir workingDir\endlink property.
+     * \sa workingDir(), setWorkingDir()
+     */
+    void workingDirChanged(const QString &workingDir);
+
+    /*!
+     * \brief Notifier signal for the \link RunCommandJob::privileged privileged\endlink property.
+     * \sa privileged(), setPrivileged()
+     */
+    void privilegedChanged(bool privileged);
+
+    /*!
+     * \brief Notifier signal for the \link RunCommandJob::tty tty\endlink property.
+     * \sa tty(), setTty()
+     */
+    void ttyChanged(bool tty);
+
+    /*!
+     * \brief Emitted when \a data has been written to \a stdout by the command.
+     * \sa standardOutput()
+     */
+    void stdoutReceived(const QByteArray &data);
+
+    /*!
+     * \brief Emitted when \a data has been written to \a stderr by the command.
+     * \sa standardError()
+     */
+    void stderrReceived(const QByteArray &data);
+
+private:
+    Q_DISABLE_COPY(RunCommandJob)
+    Q_DECLARE_PRIVATE_D(s_ptr, RunCommandJob)
+};
+
+}
+
+#endif // SCHAUER_RUNCOMMANDJOB_H
@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_RUNCOMMANDJOB_P_H
+#define SCHAUER_RUNCOMMANDJOB_P_H
+
+#include "runcommandjob.h"
+#include "job_p.h"
+#include "streamdemuxer.h"
+
+namespace Schauer {
+
+class RunCommandJobPrivate : public JobPrivate
+{
+public:
+    enum class Stage : qint8 {
+        Create  = 0,
+        Start   = 1,
+        Inspect = 2
+    };
+
+    explicit RunCommandJobPrivate(RunCommandJob *q);
+
+    ~RunCommandJobPrivate() override;
+
+    QString buildUrlPath() const override;
+
+    std::pair<QByteArray, QByteArray> buildPayload() const override;
+
+    void emitDescription() override;
+
+    bool checkInput() override;
+
+    bool checkOutput(const QByteArray &data) override;
+
+    void processStreamData(const QByteArray &data) override;
+
+    bool prepareNextRequest() override;
+
+    bool isLongLived() const override;
+
+    void setStage(Stage newStage);
+
+    StreamDemuxer demuxer;
+    QString id;
+    QString user;
+    QString workingDir;
+    QString execId;
+    QStringList cmd;
+    QStringList env;
+    QByteArray standardOutput;
+    QByteArray standardError;
+    int exitCode = -1;
+    int inspectAttempts = 0;
+    Stage stage = Stage::Create;
+    bool privileged = false;
+    bool tty = false;
+
+private:
+    Q_DISABLE_COPY(RunCommandJobPrivate)
+    Q_DECLARE_PUBLIC(RunCommandJob)
+};
+
+}
+
+#endif // SCHAUER_RUNCOMMANDJOB_P_H
@@ -14,4 +14,11 @@
 #  define SCHAUER_LIBRARY Q_DECL_IMPORT
 #endif
 
+// internal classes that are only exported for the tests and benchmarks
+#if defined(SCHAUER_WITH_AUTOTEST_EXPORTS)
+#  define SCHAUER_AUTOTEST_EXPORT SCHAUER_LIBRARY
+#else
+#  define SCHAUER_AUTOTEST_EXPORT
+#endif
+
 #endif // SCHAUER_EXPORTS_H
@@ -16,6 +16,7 @@ StartContainerJobPrivate::StartContainerJobPrivate(StartContainerJob *q)
     namOperation = NetworkOperation::Post;
     expectedContentType = ExpectedContentType::Empty;
     requiresAuth = false;
+    invalidatesEndpoint = QStringLiteral("/containers/json");
 }
 
 StartContainerJobPrivate::~StartContainerJobPrivate() = default;
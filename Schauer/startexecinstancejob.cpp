@@ -5,9 +5,8 @@
 
 #include "startexecinstancejob_p.h"
 #include "logging.h"
+#include "jsonwriter.h"
 #include <QTimer>
-#include <QJsonObject>
-#include <QJsonDocument>
 #include <utility>
 
 using namespace Schauer;
@@ -18,6 +17,13 @@ StartExecInstanceJobPrivate::StartExecInstanceJobPrivate(StartExecInstanceJob *q
     namOperation = NetworkOperation::Post;
     expectedContentType = ExpectedContentType::Empty;
     requiresAuth = false;
+    demuxer.setCallback([q](StreamDemuxer::StreamType stream, const QByteArray &data){
+        if (stream == StreamDemuxer::Stderr) {
+            Q_EMIT q->stderrReceived(data);
+        } else {
+            Q_EMIT q->stdoutReceived(data);
+        }
+    });
 }
 
 StartExecInstanceJobPrivate::~StartExecInstanceJobPrivate() = default;
@@ -30,13 +36,14 @@ QString StartExecInstanceJobPrivate::buildUrlPath() const
 
 std::pair<QByteArray,QByteArray> StartExecInstanceJobPrivate::buildPayload() const
 {
-    const QJsonObject body({
-                               {QStringLiteral("Detach"), detach},
-                               {QStringLiteral("Tty"), tty}
-                           });
-    const QJsonDocument bodyDoc(body);
-
-    return std::make_pair(bodyDoc.toJson(QJsonDocument::Compact), QByteArrayLiteral("application/json"));
+    QByteArray payload;
+    JsonWriter w(payload);
+    w.beginObject();
+    w.member(QLatin1String("Detach"), detach);
+    w.member(QLatin1String("Tty"), tty);
+    w.endObject();
+
+    return std::make_pair(payload, QByteArrayLiteral("application/json"));
 }
 
 void StartExecInstanceJobPrivate::emitDescription()
@@ -68,9 +75,22 @@ bool StartExecInstanceJobPrivate::checkInput()
         return false;
     }
 
+    demuxer.reset();
+
     return true;
 }
 
+void StartExecInstanceJobPrivate::processStreamData(const QByteArray &data)
+{
+    demuxer.feed(data);
+}
+
+bool StartExecInstanceJobPrivate::isLongLived() const
+{
+    // attached requests run until the command exits
+    return !detach;
+}
+
 StartExecInstanceJob::StartExecInstanceJob(QObject *parent)
     : Job(* new StartExecInstanceJobPrivate(this), parent)
 {
@@ -112,6 +132,7 @@ void StartExecInstanceJob::setDetach(bool detach)
     if (d->detach != detach) {
         qCDebug(schCore) << "Changing \"detach\" from" << d->detach << "to" << detach;
         d->detach = detach;
+        d->expectedContentType = detach ? ExpectedContentType::Empty : ExpectedContentType::Stream;
         Q_EMIT detachChanged(this->detach());
     }
 }
@@ -128,6 +149,7 @@ void StartExecInstanceJob::setTty(bool tty)
     if (d->tty != tty) {
         qCDebug(schCore) << "Changing \"tty\" from" << d->tty << "to" << tty;
         d->tty = tty;
+        d->demuxer.setMode(tty ? StreamDemuxer::Raw : StreamDemuxer::Multiplexed);
         Q_EMIT ttyChanged(this->tty());
     }
 }
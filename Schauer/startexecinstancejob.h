@@ -38,6 +38,26 @@ class StartExecInstanceJobPrivate;
  * startExec->exec();
  * \endcode
  *
+ * \par Reading the output
+ * If \link StartExecInstanceJob::detach detach\endlink is set to \c false, the job stays
+ * attached to the command and emits the output of the command via stdoutReceived() and
+ * stderrReceived() as soon as it arrives. The output is not buffered by the job. The job
+ * finishes when the command has finished. The exec instance has to be created with
+ * CreateExecInstanceJob::attachStdout and/or CreateExecInstanceJob::attachStderr set to \c true.
+ *
+ * \code{.cpp}
+ * auto startExec = new StartExecInstanceJob();
+ * startExec->setId(execId);
+ * startExec->setDetach(false);
+ * connect(startExec, &StartExecInstanceJob::stdoutReceived, this, [](const QByteArray &data){
+ *     qDebug() << "stdout:" << data;
+ * });
+ * connect(startExec, &StartExecInstanceJob::stderrReceived, this, [](const QByteArray &data){
+ *     qDebug() << "stderr:" << data;
+ * });
+ * startExec->start();
+ * \endcode
+ *
  * \par API route
  * /exec/{\link StartExecInstanceJob::id id\endlink}/start
  *
@@ -67,6 +87,9 @@ class SCHAUER_LIBRARY StartExecInstanceJob : public Job
     /*!
      * \brief This property holds whether to detach from the command.
      *
+     * If this is \c false, the job will stay attached to the command until it has been
+     * finished and will emit its output via stdoutReceived() and stderrReceived().
+     *
      * The default value is \c true.
      *
      * \par Access functions
@@ -80,6 +103,10 @@ class SCHAUER_LIBRARY StartExecInstanceJob : public Job
     /*!
      * \brief This property holds whether to allocate a pseudo-TTY.
      *
+     * This has to match the value used when creating the exec instance. If a TTY is
+     * allocated, the output is not multiplexed and all output will be emitted via
+     * stdoutReceived().
+     *
      * The default value is \c false.
      *
      * \par Access functions
@@ -164,6 +191,23 @@ Q_SIGNALS:
      */
     void ttyChanged(bool tty);
 
+    /*!
+     * \brief Emitted when \a data has been written to \a stdout by the attached command.
+     *
+     * Only emitted if \link StartExecInstanceJob::detach detach\endlink is \c false.
+     * \sa stderrReceived()
+     */
+    void stdoutReceived(const QByteArray &data);
+
+    /*!
+     * \brief Emitted when \a data has been written to \a stderr by the attached command.
+     *
+     * Only emitted if \link StartExecInstanceJob::detach detach\endlink is \c false and
+     * no TTY has been allocated.
+     * \sa stdoutReceived()
+     */
+    void stderrReceived(const QByteArray &data);
+
 private:
     Q_DISABLE_COPY(StartExecInstanceJob)
     Q_DECLARE_PRIVATE_D(s_ptr, StartExecInstanceJob)
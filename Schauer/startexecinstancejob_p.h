@@ -8,6 +8,7 @@
 
 #include "startexecinstancejob.h"
 #include "job_p.h"
+#include "streamdemuxer.h"
 
 namespace Schauer {
 
@@ -26,6 +27,11 @@ public:
 
     bool checkInput() override;
 
+    void processStreamData(const QByteArray &data) override;
+
+    bool isLongLived() const override;
+
+    StreamDemuxer demuxer;
     QString id;
     bool detach = true;
     bool tty = false;
@@ -0,0 +1,385 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "statsdecoder.h"
+#include "containerstatsjob.h"
+#include <cstring>
+
+using namespace Schauer;
+
+namespace {
+
+inline bool isJsonWhitespace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+template<int N>
+inline bool keyIs(const char *key, int keySize, const char (&literal)[N])
+{
+    return keySize == N - 1 && std::memcmp(key, literal, N - 1) == 0;
+}
+
+template<int N>
+inline bool keyIsCaseInsensitive(const char *key, int keySize, const char (&literal)[N])
+{
+    return keySize == N - 1 && qstrnicmp(key, literal, N - 1) == 0;
+}
+
+enum BlkioOp : qint8 {
+    OtherOp = 0,
+    ReadOp,
+    WriteOp
+};
+
+}
+
+StatsDecoder::StatsDecoder(const char *data, int size)
+    : m_pos(data), m_end(data + size)
+{
+
+}
+
+bool StatsDecoder::decode(ContainerStats &stats)
+{
+    stats = ContainerStats();
+    m_stats = &stats;
+    return parseObject(Context::Root);
+}
+
+void StatsDecoder::skipWhitespace()
+{
+    while (m_pos < m_end && isJsonWhitespace(*m_pos)) {
+        ++m_pos;
+    }
+}
+
+bool StatsDecoder::parseString(const char *&str, int &size)
+{
+    if (m_pos >= m_end || *m_pos != '"') {
+        return false;
+    }
+    ++m_pos;
+    str = m_pos;
+    while (m_pos < m_end) {
+        const char c = *m_pos;
+        if (c == '\\') {
+            // a backslash has to be followed by at least the escaped character
+            if (m_end - m_pos < 2) {
+                return false;
+            }
+            m_pos += 2;
+            continue;
+        }
+        if (c == '"') {
+            size = static_cast<int>(m_pos - str);
+            ++m_pos;
+            return true;
+        }
+        ++m_pos;
+    }
+    return false;
+}
+
+bool StatsDecoder::parseKey(const char *&key, int &keySize)
+{
+    skipWhitespace();
+    if (!parseString(key, keySize)) {
+        return false;
+    }
+    skipWhitespace();
+    if (m_pos >= m_end || *m_pos != ':') {
+        return false;
+    }
+    ++m_pos;
+    skipWhitespace();
+    return true;
+}
+
+bool StatsDecoder::parseNumber(quint64 &value)
+{
+    value = 0;
+    if (m_pos >= m_end) {
+        return false;
+    }
+    if (*m_pos < '0' || *m_pos > '9') {
+        // null, negative values or anything else unexpected count as 0
+        return skipValue();
+    }
+    while (m_pos < m_end && *m_pos >= '0' && *m_pos <= '9') {
+        value = value * 10 + static_cast<quint64>(*m_pos - '0');
+        ++m_pos;
+    }
+    // ignore fractions and exponents
+    while (m_pos < m_end && ((*m_pos >= '0' && *m_pos <= '9') || *m_pos == '.' || *m_pos == 'e' || *m_pos == 'E' || *m_pos == '+' || *m_pos == '-')) {
+        ++m_pos;
+    }
+    return true;
+}
+
+bool StatsDecoder::skipValue()
+{
+    if (m_pos >= m_end) {
+        return false;
+    }
+
+    const char first = *m_pos;
+    if (first == '"') {
+        const char *str = nullptr;
+        int size = 0;
+        return parseString(str, size);
+    }
+
+    if (first == '{' || first == '[') {
+        int depth = 0;
+        while (m_pos < m_end) {
+            const char c = *m_pos;
+            if (c == '"') {
+                const char *str = nullptr;
+                int size = 0;
+                if (!parseString(str, size)) {
+                    return false;
+                }
+                continue;
+            }
+            ++m_pos;
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // numbers and literals
+    while (m_pos < m_end && *m_pos != ',' && *m_pos != '}' && *m_pos != ']' && !isJsonWhitespace(*m_pos)) {
+        ++m_pos;
+    }
+    return true;
+}
+
+bool StatsDecoder::parseBlkioArray()
+{
+    if (m_pos >= m_end || *m_pos != '[') {
+        // the daemon sends null if there are no values
+        return skipValue();
+    }
+    ++m_pos;
+    skipWhitespace();
+    if (m_pos < m_end && *m_pos == ']') {
+        ++m_pos;
+        return true;
+    }
+
+    while (m_pos < m_end) {
+        m_entryValue = 0;
+        m_entryOp = OtherOp;
+        if (*m_pos == '{') {
+            if (!parseObject(Context::BlkioEntry)) {
+                return false;
+            }
+            if (m_entryOp == ReadOp) {
+                m_stats->blockRead += m_entryValue;
+            } else if (m_entryOp == WriteOp) {
+                m_stats->blockWrite += m_entryValue;
+            }
+        } else if (!skipValue()) {
+            return false;
+        }
+
+        skipWhitespace();
+        if (m_pos >= m_end) {
+            return false;
+        }
+        if (*m_pos == ']') {
+            ++m_pos;
+            return true;
+        }
+        if (*m_pos != ',') {
+            return false;
+        }
+        ++m_pos;
+        skipWhitespace();
+    }
+
+    return false;
+}
+
+bool StatsDecoder::parseObject(Context context)
+{
+    skipWhitespace();
+    if (m_pos >= m_end || *m_pos != '{') {
+        return false;
+    }
+    ++m_pos;
+    skipWhitespace();
+    if (m_pos < m_end && *m_pos == '}') {
+        ++m_pos;
+        return true;
+    }
+
+    while (m_pos < m_end) {
+        const char *key = nullptr;
+        int keySize = 0;
+        if (!parseKey(key, keySize)) {
+            return false;
+        }
+
+        quint64 *target = nullptr;
+        bool accumulate = false;
+        bool hasChild = false;
+        bool consumed = false;
+        Context child = Context::Root;
+        bool ok = true;
+
+        switch (context) {
+        case Context::Root:
+            hasChild = true;
+            if (keyIs(key, keySize, "cpu_stats")) {
+                child = Context::CpuStats;
+            } else if (keyIs(key, keySize, "precpu_stats")) {
+                child = Context::PreCpuStats;
+            } else if (keyIs(key, keySize, "memory_stats")) {
+                child = Context::MemoryStats;
+            } else if (keyIs(key, keySize, "blkio_stats")) {
+                child = Context::BlkioStats;
+            } else if (keyIs(key, keySize, "networks")) {
+                child = Context::Networks;
+            } else if (keyIs(key, keySize, "pids_stats")) {
+                child = Context::PidsStats;
+            } else {
+                hasChild = false;
+            }
+            break;
+        case Context::CpuStats:
+            if (keyIs(key, keySize, "cpu_usage")) {
+                hasChild = true;
+                child = Context::CpuUsage;
+            } else if (keyIs(key, keySize, "system_cpu_usage")) {
+                target = &m_stats->systemCpuUsage;
+            } else if (keyIs(key, keySize, "online_cpus")) {
+                quint64 cpus = 0;
+                ok = parseNumber(cpus);
+                m_stats->onlineCpus = static_cast<quint32>(cpus);
+                consumed = true;
+            }
+            break;
+        case Context::PreCpuStats:
+            if (keyIs(key, keySize, "cpu_usage")) {
+                hasChild = true;
+                child = Context::PreCpuUsage;
+            } else if (keyIs(key, keySize, "system_cpu_usage")) {
+                target = &m_stats->preSystemCpuUsage;
+            }
+            break;
+        case Context::CpuUsage:
+            if (keyIs(key, keySize, "total_usage")) {
+                target = &m_stats->cpuTotalUsage;
+            }
+            break;
+        case Context::PreCpuUsage:
+            if (keyIs(key, keySize, "total_usage")) {
+                target = &m_stats->preCpuTotalUsage;
+            }
+            break;
+        case Context::MemoryStats:
+            if (keyIs(key, keySize, "usage")) {
+                target = &m_stats->memoryUsage;
+            } else if (keyIs(key, keySize, "limit")) {
+                target = &m_stats->memoryLimit;
+            }
+            break;
+        case Context::BlkioStats:
+            if (keyIs(key, keySize, "io_service_bytes_recursive")) {
+                ok = parseBlkioArray();
+                consumed = true;
+            }
+            break;
+        case Context::BlkioEntry:
+            if (keyIs(key, keySize, "op")) {
+                const char *op = nullptr;
+                int opSize = 0;
+                ok = parseString(op, opSize);
+                if (ok) {
+                    if (keyIsCaseInsensitive(op, opSize, "read")) {
+                        m_entryOp = ReadOp;
+                    } else if (keyIsCaseInsensitive(op, opSize, "write")) {
+                        m_entryOp = WriteOp;
+                    }
+                }
+                consumed = true;
+            } else if (keyIs(key, keySize, "value")) {
+                target = &m_entryValue;
+            }
+            break;
+        case Context::Networks:
+            // every key is the name of a network interface
+            hasChild = true;
+            child = Context::NetworkInterface;
+            break;
+        case Context::NetworkInterface:
+            accumulate = true;
+            if (keyIs(key, keySize, "rx_bytes")) {
+                target = &m_stats->networkRxBytes;
+            } else if (keyIs(key, keySize, "tx_bytes")) {
+                target = &m_stats->networkTxBytes;
+            } else if (keyIs(key, keySize, "rx_packets")) {
+                target = &m_stats->networkRxPackets;
+            } else if (keyIs(key, keySize, "tx_packets")) {
+                target = &m_stats->networkTxPackets;
+            }
+            break;
+        case Context::PidsStats:
+            if (keyIs(key, keySize, "current")) {
+                target = &m_stats->pids;
+            }
+            break;
+        }
+
+        if (!ok) {
+            return false;
+        }
+
+        if (target) {
+            quint64 value = 0;
+            if (!parseNumber(value)) {
+                return false;
+            }
+            if (accumulate) {
+                *target += value;
+            } else {
+                *target = value;
+            }
+        } else if (hasChild) {
+            if (m_pos < m_end && *m_pos == '{') {
+                if (!parseObject(child)) {
+                    return false;
+                }
+            } else if (!skipValue()) {
+                return false;
+            }
+        } else if (!consumed && !skipValue()) {
+            return false;
+        }
+
+        skipWhitespace();
+        if (m_pos >= m_end) {
+            return false;
+        }
+        if (*m_pos == '}') {
+            ++m_pos;
+            return true;
+        }
+        if (*m_pos != ',') {
+            return false;
+        }
+        ++m_pos;
+    }
+
+    return false;
+}
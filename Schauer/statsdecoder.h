@@ -0,0 +1,66 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_STATSDECODER_H
+#define SCHAUER_STATSDECODER_H
+
+#include <QtGlobal>
+
+namespace Schauer {
+
+struct ContainerStats;
+
+/*!
+ * \internal
+ * \brief Decodes a single container stats sample into a ContainerStats struct.
+ *
+ * The decoder scans the raw JSON data in place and only extracts the numeric values
+ * of the fields known by ContainerStats, everything else is skipped. Keys are compared
+ * without copying, so decoding a sample does not allocate any memory.
+ */
+class StatsDecoder
+{
+public:
+    StatsDecoder(const char *data, int size);
+
+    /*!
+     * Decodes the data into \a stats that will be reset before.
+     * Returns \c false if the data is not a valid JSON object.
+     */
+    bool decode(ContainerStats &stats);
+
+private:
+    enum class Context : qint8 {
+        Root,
+        CpuStats,
+        CpuUsage,
+        PreCpuStats,
+        PreCpuUsage,
+        MemoryStats,
+        BlkioStats,
+        BlkioEntry,
+        Networks,
+        NetworkInterface,
+        PidsStats
+    };
+
+    bool parseObject(Context context);
+    bool parseBlkioArray();
+    bool parseKey(const char *&key, int &keySize);
+    bool parseString(const char *&str, int &size);
+    bool parseNumber(quint64 &value);
+    bool skipValue();
+    void skipWhitespace();
+
+    const char *m_pos = nullptr;
+    const char *m_end = nullptr;
+    ContainerStats *m_stats = nullptr;
+    quint64 m_entryValue = 0;
+    qint8 m_entryOp = 0;
+};
+
+}
+
+#endif // SCHAUER_STATSDECODER_H
@@ -15,6 +15,7 @@ StopContainerJobPrivate::StopContainerJobPrivate(StopContainerJob *q)
     namOperation = NetworkOperation::Post;
     expectedContentType = ExpectedContentType::Empty;
     requiresAuth = false;
+    invalidatesEndpoint = QStringLiteral("/containers/json");
 }
 
 StopContainerJobPrivate::~StopContainerJobPrivate() = default;
@@ -0,0 +1,89 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "streamdemuxer.h"
+#include "logging.h"
+#include <QtEndian>
+#include <cstring>
+
+using namespace Schauer;
+
+StreamDemuxer::StreamDemuxer(Mode mode)
+    : m_mode(mode)
+{
+
+}
+
+void StreamDemuxer::setMode(Mode mode)
+{
+    m_mode = mode;
+    reset();
+}
+
+StreamDemuxer::Mode StreamDemuxer::mode() const
+{
+    return m_mode;
+}
+
+void StreamDemuxer::setCallback(const Callback &callback)
+{
+    m_callback = callback;
+}
+
+void StreamDemuxer::reset()
+{
+    m_frameRemaining = 0;
+    m_headerSize = 0;
+    m_currentStream = Stdout;
+}
+
+void StreamDemuxer::feed(const QByteArray &data)
+{
+    if (data.isEmpty() || !m_callback) {
+        return;
+    }
+
+    if (m_mode == Raw) {
+        m_callback(Stdout, data);
+        return;
+    }
+
+    const int size = data.size();
+    const char *d = data.constData();
+    int pos = 0;
+
+    while (pos < size) {
+        if (m_frameRemaining == 0) {
+            const int n = qMin(8 - m_headerSize, size - pos);
+            std::memcpy(m_header + m_headerSize, d + pos, static_cast<size_t>(n));
+            m_headerSize += n;
+            pos += n;
+            if (m_headerSize < 8) {
+                break;
+            }
+
+            m_headerSize = 0;
+            const auto stream = static_cast<quint8>(m_header[0]);
+            if (Q_UNLIKELY(stream > Stderr)) {
+                qCWarning(schCore) << "Invalid stream type" << stream << "in multiplexed stream header, treating it as stdout";
+                m_currentStream = Stdout;
+            } else {
+                m_currentStream = static_cast<StreamType>(stream);
+            }
+            m_frameRemaining = qFromBigEndian<quint32>(reinterpret_cast<const uchar *>(m_header + 4));
+            continue;
+        }
+
+        const int n = static_cast<int>(qMin<qint64>(m_frameRemaining, size - pos));
+        if (pos == 0 && n == size) {
+            // the whole chunk belongs to the current frame, no need to copy it
+            m_callback(m_currentStream, data);
+        } else {
+            m_callback(m_currentStream, data.mid(pos, n));
+        }
+        pos += n;
+        m_frameRemaining -= static_cast<quint32>(n);
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_STREAMDEMUXER_H
+#define SCHAUER_STREAMDEMUXER_H
+
+#include <QByteArray>
+#include <functional>
+
+namespace Schauer {
+
+/*!
+ * \internal
+ * \brief Splits the multiplexed stream of attached containers and exec instances.
+ *
+ * If no TTY is allocated, the Docker daemon sends \a stdout and \a stderr over the
+ * same connection in frames with an 8 byte header. The first byte of the header
+ * identifies the stream, the last four bytes contain the big endian size of the
+ * frame payload. Payload is handed to the callback as soon as it arrives, even if
+ * the frame is not complete yet, so only the header will be buffered.
+ *
+ * In Raw mode, used if a TTY is allocated, all data is passed through as \a stdout.
+ */
+class StreamDemuxer
+{
+public:
+    enum Mode : qint8 {
+        Multiplexed = 0,
+        Raw = 1
+    };
+
+    enum StreamType : qint8 {
+        Stdin   = 0,
+        Stdout  = 1,
+        Stderr  = 2
+    };
+
+    using Callback = std::function<void(StreamType stream, const QByteArray &data)>;
+
+    explicit StreamDemuxer(Mode mode = Multiplexed);
+
+    void setMode(Mode mode);
+
+    Mode mode() const;
+
+    void setCallback(const Callback &callback);
+
+    void feed(const QByteArray &data);
+
+    void reset();
+
+private:
+    Callback m_callback;
+    char m_header[8];
+    quint32 m_frameRemaining = 0;
+    int m_headerSize = 0;
+    StreamType m_currentStream = Stdout;
+    Mode m_mode = Multiplexed;
+};
+
+}
+
+#endif // SCHAUER_STREAMDEMUXER_H
@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "stringpool.h"
+#include "logging.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+
+using namespace Schauer;
+
+namespace {
+
+constexpr int minSqueezeSize = 4096;
+
+struct PoolData {
+    QMutex mutex;
+    QSet<QString> strings;
+    quint64 hits = 0;
+    quint64 misses = 0;
+    int squeezeSize = minSqueezeSize;
+};
+
+Q_GLOBAL_STATIC(PoolData, poolData)
+
+void squeezeLocked(PoolData *data)
+{
+    auto it = data->strings.begin();
+    while (it != data->strings.end()) {
+        // only referenced by the pool itself
+        if (it->isDetached()) {
+            it = data->strings.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    data->squeezeSize = qMax(minSqueezeSize, data->strings.size() * 2);
+}
+
+QString internLocked(PoolData *data, const QString &str)
+{
+    if (str.isEmpty()) {
+        return str;
+    }
+
+    auto it = data->strings.constFind(str);
+    if (it != data->strings.constEnd()) {
+        data->hits++;
+        return *it;
+    }
+
+    data->misses++;
+    if (data->strings.size() >= data->squeezeSize) {
+        squeezeLocked(data);
+    }
+    data->strings.insert(str);
+    return str;
+}
+
+}
+
+QString StringPool::intern(const QString &str)
+{
+    PoolData *data = poolData;
+    QMutexLocker locker(&data->mutex);
+    return internLocked(data, str);
+}
+
+void StringPool::intern(QStringList &list)
+{
+    PoolData *data = poolData;
+    QMutexLocker locker(&data->mutex);
+    for (QString &str : list) {
+        str = internLocked(data, str);
+    }
+}
+
+void StringPool::intern(QMap<QString,QString> &map)
+{
+    if (map.isEmpty()) {
+        return;
+    }
+
+    PoolData *data = poolData;
+    QMutexLocker locker(&data->mutex);
+    // keys of a QMap can not be replaced in place
+    QMap<QString,QString> pooled;
+    auto i = map.constBegin();
+    while (i != map.constEnd()) {
+        pooled.insert(internLocked(data, i.key()), internLocked(data, i.value()));
+        ++i;
+    }
+    map.swap(pooled);
+}
+
+StringPool::Statistics StringPool::statistics()
+{
+    PoolData *data = poolData;
+    QMutexLocker locker(&data->mutex);
+    Statistics stats;
+    stats.hits = data->hits;
+    stats.misses = data->misses;
+    stats.size = data->strings.size();
+    return stats;
+}
+
+void StringPool::resetStatistics()
+{
+    PoolData *data = poolData;
+    QMutexLocker locker(&data->mutex);
+    data->hits = 0;
+    data->misses = 0;
+}
+
+void StringPool::squeeze()
+{
+    PoolData *data = poolData;
+    QMutexLocker locker(&data->mutex);
+    const int before = data->strings.size();
+    squeezeLocked(data);
+    qCDebug(schCore) << "Removed" << (before - data->strings.size()) << "unused strings from the string pool";
+}
@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_STRINGPOOL_H
+#define SCHAUER_STRINGPOOL_H
+
+#include "schauer_exports.h"
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+namespace Schauer {
+
+/*!
+ * \ingroup data-models
+ * \brief Process wide pool of shared strings used by the data models.
+ *
+ * Values like image names, image IDs, status texts and labels repeat a lot between
+ * the rows of a model and between different models. The models put those values
+ * into this pool, so that every distinct value is only stored once and all rows
+ * share the same implicitly shared QString instance.
+ *
+ * Strings that are not used anywhere else anymore are removed from the pool
+ * automatically from time to time, or explicitly by calling squeeze().
+ *
+ * All functions are thread-safe.
+ *
+ * \headerfile "" <Schauer/StringPool>
+ */
+class SCHAUER_LIBRARY StringPool
+{
+public:
+    /*!
+     * \brief Usage statistics of the pool.
+     */
+    struct Statistics {
+        /*!
+         * \brief Number of lookups that returned an already pooled string.
+         */
+        quint64 hits = 0;
+
+        /*!
+         * \brief Number of lookups that added a new string to the pool.
+         */
+        quint64 misses = 0;
+
+        /*!
+         * \brief Number of strings currently in the pool.
+         */
+        int size = 0;
+
+        /*!
+         * \brief Returns the share of lookups that returned a pooled string, between \c 0 and \c 1.
+         */
+        double hitRate() const { return hits + misses > 0 ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0; }
+    };
+
+    /*!
+     * \brief Returns the pooled instance of \a str.
+     *
+     * If \a str is not in the pool yet, it is added. Empty strings are returned as they are.
+     */
+    static QString intern(const QString &str);
+
+    /*!
+     * \brief Replaces all strings in \a list by their pooled instances.
+     */
+    static void intern(QStringList &list);
+
+    /*!
+     * \brief Replaces all keys and values in \a map by their pooled instances.
+     */
+    static void intern(QMap<QString,QString> &map);
+
+    /*!
+     * \brief Returns the current usage statistics.
+     * \sa resetStatistics()
+     */
+    static Statistics statistics();
+
+    /*!
+     * \brief Resets the hit and miss counters.
+     * \sa statistics()
+     */
+    static void resetStatistics();
+
+    /*!
+     * \brief Removes all strings from the pool that are not used anywhere else.
+     */
+    static void squeeze();
+};
+
+}
+
+#endif // SCHAUER_STRINGPOOL_H
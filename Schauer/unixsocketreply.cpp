@@ -0,0 +1,568 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "unixsocketreply.h"
+#include "logging.h"
+#include <QTimer>
+#include <QUrl>
+#include <cstring>
+
+using namespace Schauer;
+
+namespace {
+
+QNetworkReply::NetworkError statusToNetworkError(int statusCode)
+{
+    switch (statusCode) {
+    case 400:
+    case 418:
+        return QNetworkReply::ProtocolInvalidOperationError;
+    case 401:
+        return QNetworkReply::AuthenticationRequiredError;
+    case 403:
+        return QNetworkReply::ContentAccessDenied;
+    case 404:
+        return QNetworkReply::ContentNotFoundError;
+    case 405:
+        return QNetworkReply::ContentOperationNotPermittedError;
+    case 407:
+        return QNetworkReply::ProxyAuthenticationRequiredError;
+    case 409:
+        return QNetworkReply::ContentConflictError;
+    case 410:
+        return QNetworkReply::ContentGoneError;
+    case 500:
+        return QNetworkReply::InternalServerError;
+    case 501:
+        return QNetworkReply::OperationNotImplementedError;
+    case 503:
+        return QNetworkReply::ServiceUnavailableError;
+    default:
+        return statusCode < 500 ? QNetworkReply::UnknownContentError : QNetworkReply::UnknownServerError;
+    }
+}
+
+QByteArray operationToVerb(QNetworkAccessManager::Operation operation, const QNetworkRequest &request)
+{
+    switch (operation) {
+    case QNetworkAccessManager::HeadOperation:
+        return QByteArrayLiteral("HEAD");
+    case QNetworkAccessManager::GetOperation:
+        return QByteArrayLiteral("GET");
+    case QNetworkAccessManager::PutOperation:
+        return QByteArrayLiteral("PUT");
+    case QNetworkAccessManager::PostOperation:
+        return QByteArrayLiteral("POST");
+    case QNetworkAccessManager::DeleteOperation:
+        return QByteArrayLiteral("DELETE");
+    case QNetworkAccessManager::CustomOperation:
+        return request.attribute(QNetworkRequest::CustomVerbAttribute).toByteArray();
+    default:
+        return QByteArray();
+    }
+}
+
+}
+
+UnixSocketReply::UnixSocketReply(const QString &socketPath, QLocalSocket *socket, QNetworkAccessManager::Operation operation, const QNetworkRequest &request, const QByteArray &payload, QObject *parent)
+    : QNetworkReply(parent), m_socketPath(socketPath), m_payload(payload)
+{
+    setRequest(request);
+    setUrl(request.url());
+    setOperation(operation);
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+    if (socket) {
+        m_socket = socket;
+        m_socket->setParent(this);
+        m_reusedSocket = true;
+    } else {
+        m_socket = new QLocalSocket(this);
+    }
+    setupSocket();
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 15, 0))
+    if (request.transferTimeout() > 0) {
+        m_timeoutTimer = new QTimer(this);
+        m_timeoutTimer->setSingleShot(true);
+        m_timeoutTimer->setTimerType(Qt::VeryCoarseTimer);
+        m_timeoutTimer->setInterval(request.transferTimeout());
+        connect(m_timeoutTimer, &QTimer::timeout, this, &UnixSocketReply::transferTimedOut);
+    }
+#endif
+
+    // QLocalSocket might report errors synchronously while connecting, so defer
+    // connecting until the job had the chance to connect to our signals.
+    QTimer::singleShot(0, this, &UnixSocketReply::connectToDaemon);
+}
+
+UnixSocketReply::~UnixSocketReply() = default;
+
+void UnixSocketReply::abort()
+{
+    if (isFinished()) {
+        return;
+    }
+
+    qCDebug(schCore) << "Aborting request on unix domain socket" << m_socketPath;
+    m_socket->abort();
+    //: Error message
+    //% "Operation canceled."
+    failReply(QNetworkReply::OperationCanceledError, qtTrId("libschauer-error-socket-operation-canceled"));
+}
+
+qint64 UnixSocketReply::bytesAvailable() const
+{
+    return m_body.size() - m_readPos + QNetworkReply::bytesAvailable();
+}
+
+bool UnixSocketReply::isSequential() const
+{
+    return true;
+}
+
+qint64 UnixSocketReply::readData(char *data, qint64 maxSize)
+{
+    const qint64 available = m_body.size() - m_readPos;
+    if (available <= 0) {
+        return isFinished() ? -1 : 0;
+    }
+
+    const qint64 size = qMin(available, maxSize);
+    std::memcpy(data, m_body.constData() + m_readPos, static_cast<size_t>(size));
+    m_readPos += size;
+
+    if (m_readPos == m_body.size()) {
+        m_body.clear();
+        m_readPos = 0;
+    }
+
+    return size;
+}
+
+void UnixSocketReply::setupSocket()
+{
+    connect(m_socket, &QLocalSocket::connected, this, &UnixSocketReply::sendRequest);
+    connect(m_socket, &QLocalSocket::readyRead, this, &UnixSocketReply::socketReadyRead);
+    connect(m_socket, &QLocalSocket::disconnected, this, &UnixSocketReply::socketDisconnected);
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 15, 0))
+    connect(m_socket, &QLocalSocket::errorOccurred, this, &UnixSocketReply::socketError);
+#else
+    connect(m_socket, static_cast<void(QLocalSocket::*)(QLocalSocket::LocalSocketError)>(&QLocalSocket::error), this, &UnixSocketReply::socketError);
+#endif
+}
+
+void UnixSocketReply::connectToDaemon()
+{
+    if (isFinished()) {
+        return;
+    }
+
+    if (m_timeoutTimer) {
+        m_timeoutTimer->start();
+    }
+
+    if (m_socket->state() == QLocalSocket::ConnectedState) {
+        qCDebug(schCore) << "Reusing connection to unix domain socket" << m_socketPath;
+        sendRequest();
+    } else {
+        qCDebug(schCore) << "Connecting to unix domain socket" << m_socketPath;
+        m_socket->connectToServer(m_socketPath);
+    }
+}
+
+bool UnixSocketReply::retryWithNewConnection()
+{
+    // the daemon might have closed a kept alive connection in the meantime,
+    // if nothing has been received yet, simply try again on a new connection
+    if (!m_reusedSocket || m_state != ParserState::StatusLine || !m_input.isEmpty()) {
+        return false;
+    }
+
+    qCDebug(schCore) << "Reused connection to unix domain socket" << m_socketPath << "has been closed, retrying on a new connection";
+    m_reusedSocket = false;
+    m_socket->disconnect(this);
+    m_socket->abort();
+    m_socket->deleteLater();
+    m_socket = new QLocalSocket(this);
+    setupSocket();
+    QTimer::singleShot(0, this, &UnixSocketReply::connectToDaemon);
+    return true;
+}
+
+void UnixSocketReply::sendRequest()
+{
+    qCDebug(schCore) << "Sending request to unix domain socket" << m_socketPath;
+    m_socket->write(buildRequest());
+    if (!m_reusedSocket) {
+        m_payload.clear();
+    }
+}
+
+QByteArray UnixSocketReply::buildRequest() const
+{
+    const QNetworkRequest req = request();
+    const QUrl _url = req.url();
+
+    QByteArray target = _url.path(QUrl::FullyEncoded).toLatin1();
+    if (target.isEmpty()) {
+        target = QByteArrayLiteral("/");
+    }
+    if (_url.hasQuery()) {
+        target += '?';
+        target += _url.query(QUrl::FullyEncoded).toLatin1();
+    }
+
+    QByteArray data = operationToVerb(operation(), req);
+    data += ' ';
+    data += target;
+    data += " HTTP/1.1\r\nHost: ";
+    data += _url.host().isEmpty() ? QByteArrayLiteral("localhost") : _url.host().toLatin1();
+    data += "\r\n";
+
+    const auto rhl = req.rawHeaderList();
+    for (const QByteArray &h : rhl) {
+        data += h;
+        data += ": ";
+        data += req.rawHeader(h);
+        data += "\r\n";
+    }
+
+    if (!m_payload.isEmpty() || operation() == QNetworkAccessManager::PostOperation || operation() == QNetworkAccessManager::PutOperation) {
+        data += "Content-Length: ";
+        data += QByteArray::number(m_payload.size());
+        data += "\r\n";
+    }
+
+    data += "\r\n";
+    data += m_payload;
+
+    return data;
+}
+
+void UnixSocketReply::socketReadyRead()
+{
+    if (isFinished()) {
+        m_socket->readAll();
+        return;
+    }
+
+    if (m_timeoutTimer) {
+        m_timeoutTimer->start();
+    }
+
+    m_input.append(m_socket->readAll());
+
+    int pos = 0;
+    bool bodyAppended = false;
+
+    while (m_state != ParserState::Done) {
+        if (m_state == ParserState::Body || m_state == ParserState::ChunkData) {
+            const qint64 available = m_input.size() - pos;
+            if (available <= 0) {
+                break;
+            }
+            const qint64 size = (m_bodyLength == BodyLength::UntilClose) ? available : qMin(available, m_remaining);
+            appendBody(m_input.constData() + pos, size);
+            bodyAppended = true;
+            pos += static_cast<int>(size);
+            if (m_bodyLength != BodyLength::UntilClose) {
+                m_remaining -= size;
+                if (m_remaining == 0) {
+                    m_state = (m_state == ParserState::Body) ? ParserState::Done : ParserState::ChunkDataEnd;
+                }
+            }
+            continue;
+        }
+
+        const int eol = m_input.indexOf("\r\n", pos);
+        if (eol < 0) {
+            break;
+        }
+        const QByteArray line = m_input.mid(pos, eol - pos);
+        pos = eol + 2;
+
+        switch (m_state) {
+        case ParserState::StatusLine:
+            if (Q_UNLIKELY(!parseStatusLine(line))) {
+                //: Error message
+                //% "Received an invalid HTTP status line from the Docker daemon."
+                failReply(QNetworkReply::ProtocolFailure, qtTrId("libschauer-error-socket-invalid-status-line"));
+                return;
+            }
+            m_state = ParserState::Headers;
+            break;
+        case ParserState::Headers:
+            if (line.isEmpty()) {
+                headersFinished();
+            } else {
+                parseHeaderLine(line);
+            }
+            break;
+        case ParserState::ChunkSize:
+        {
+            const int semicolonIdx = line.indexOf(';');
+            bool ok = false;
+            const qint64 chunkSize = (semicolonIdx > -1 ? line.left(semicolonIdx) : line).trimmed().toLongLong(&ok, 16);
+            if (Q_UNLIKELY(!ok || chunkSize < 0)) {
+                //: Error message
+                //% "Received invalid chunked data from the Docker daemon."
+                failReply(QNetworkReply::ProtocolFailure, qtTrId("libschauer-error-socket-invalid-chunk"));
+                return;
+            }
+            if (chunkSize == 0) {
+                m_state = ParserState::ChunkTrailer;
+            } else {
+                m_remaining = chunkSize;
+                m_state = ParserState::ChunkData;
+            }
+        }
+            break;
+        case ParserState::ChunkDataEnd:
+            if (Q_UNLIKELY(!line.isEmpty())) {
+                failReply(QNetworkReply::ProtocolFailure, qtTrId("libschauer-error-socket-invalid-chunk"));
+                return;
+            }
+            m_state = ParserState::ChunkSize;
+            break;
+        case ParserState::ChunkTrailer:
+            if (line.isEmpty()) {
+                m_state = ParserState::Done;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    m_input.remove(0, pos);
+
+    if (bodyAppended) {
+        Q_EMIT downloadProgress(m_bytesReceived, m_contentLength);
+        Q_EMIT readyRead();
+    }
+
+    if (m_state == ParserState::Done) {
+        finishReply();
+    }
+}
+
+bool UnixSocketReply::parseStatusLine(const QByteArray &line)
+{
+    if (!line.startsWith("HTTP/1.")) {
+        qCCritical(schCore) << "Invalid HTTP status line received on unix domain socket:" << line;
+        return false;
+    }
+
+    const int firstSpace = line.indexOf(' ');
+    if (firstSpace < 0) {
+        return false;
+    }
+
+    const int secondSpace = line.indexOf(' ', firstSpace + 1);
+    bool ok = false;
+    const int statusCode = line.mid(firstSpace + 1, secondSpace > -1 ? secondSpace - firstSpace - 1 : -1).toInt(&ok);
+    if (!ok) {
+        return false;
+    }
+
+    setAttribute(QNetworkRequest::HttpStatusCodeAttribute, statusCode);
+    if (secondSpace > -1) {
+        setAttribute(QNetworkRequest::HttpReasonPhraseAttribute, line.mid(secondSpace + 1));
+    }
+
+    return true;
+}
+
+void UnixSocketReply::parseHeaderLine(const QByteArray &line)
+{
+    const int colonIdx = line.indexOf(':');
+    if (Q_UNLIKELY(colonIdx < 1)) {
+        qCWarning(schCore) << "Ignoring invalid HTTP header line received on unix domain socket:" << line;
+        return;
+    }
+
+    const QByteArray name = line.left(colonIdx).trimmed();
+    const QByteArray value = line.mid(colonIdx + 1).trimmed();
+    setRawHeader(name, value);
+}
+
+void UnixSocketReply::headersFinished()
+{
+    Q_EMIT metaDataChanged();
+
+    const int statusCode = attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (statusCode >= 400) {
+        setError(statusToNetworkError(statusCode), attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString());
+    }
+
+    if (operation() == QNetworkAccessManager::HeadOperation || statusCode == 204 || statusCode == 304 || (statusCode >= 100 && statusCode < 200)) {
+        m_bodyLength = BodyLength::None;
+        m_state = ParserState::Done;
+        return;
+    }
+
+    if (rawHeader(QByteArrayLiteral("Transfer-Encoding")).toLower().contains("chunked")) {
+        m_bodyLength = BodyLength::Chunked;
+        m_state = ParserState::ChunkSize;
+        return;
+    }
+
+    if (hasRawHeader(QByteArrayLiteral("Content-Length"))) {
+        bool ok = false;
+        m_contentLength = rawHeader(QByteArrayLiteral("Content-Length")).toLongLong(&ok);
+        if (!ok || m_contentLength < 0) {
+            m_contentLength = -1;
+            m_bodyLength = BodyLength::UntilClose;
+            m_state = ParserState::Body;
+            return;
+        }
+        m_bodyLength = BodyLength::Fixed;
+        m_remaining = m_contentLength;
+        m_state = m_contentLength > 0 ? ParserState::Body : ParserState::Done;
+        return;
+    }
+
+    m_bodyLength = BodyLength::UntilClose;
+    m_state = ParserState::Body;
+}
+
+void UnixSocketReply::appendBody(const char *data, qint64 size)
+{
+    if (m_readPos > 0 && m_readPos == m_body.size()) {
+        m_body.clear();
+        m_readPos = 0;
+    }
+    m_body.append(data, static_cast<int>(size));
+    m_bytesReceived += size;
+}
+
+void UnixSocketReply::socketDisconnected()
+{
+    if (isFinished()) {
+        return;
+    }
+
+    if (m_socket->bytesAvailable() > 0) {
+        socketReadyRead();
+        if (isFinished()) {
+            return;
+        }
+    }
+
+    if (m_state == ParserState::Body && m_bodyLength == BodyLength::UntilClose) {
+        m_state = ParserState::Done;
+        finishReply();
+        return;
+    }
+
+    if (retryWithNewConnection()) {
+        return;
+    }
+
+    //: Error message
+    //% "The Docker daemon closed the connection before the reply was complete."
+    failReply(QNetworkReply::RemoteHostClosedError, qtTrId("libschauer-error-socket-closed"));
+}
+
+void UnixSocketReply::socketError(QLocalSocket::LocalSocketError socketError)
+{
+    if (isFinished()) {
+        return;
+    }
+
+    if (socketError == QLocalSocket::PeerClosedError) {
+        socketDisconnected();
+        return;
+    }
+
+    if (retryWithNewConnection()) {
+        return;
+    }
+
+    qCCritical(schCore) << "Error on unix domain socket" << m_socketPath << ":" << m_socket->errorString();
+
+    QNetworkReply::NetworkError code = QNetworkReply::UnknownNetworkError;
+    switch (socketError) {
+    case QLocalSocket::ConnectionRefusedError:
+        code = QNetworkReply::ConnectionRefusedError;
+        break;
+    case QLocalSocket::ServerNotFoundError:
+        code = QNetworkReply::HostNotFoundError;
+        break;
+    case QLocalSocket::SocketAccessError:
+        code = QNetworkReply::ContentAccessDenied;
+        break;
+    case QLocalSocket::SocketTimeoutError:
+        code = QNetworkReply::TimeoutError;
+        break;
+    default:
+        break;
+    }
+
+    failReply(code, m_socket->errorString());
+}
+
+void UnixSocketReply::transferTimedOut()
+{
+    if (isFinished()) {
+        return;
+    }
+
+    qCCritical(schCore) << "Request on unix domain socket" << m_socketPath << "timed out";
+    m_socket->abort();
+    //: Error message
+    //% "The request to the Docker daemon timed out."
+    failReply(QNetworkReply::TimeoutError, qtTrId("libschauer-error-socket-timeout"));
+}
+
+void UnixSocketReply::failReply(QNetworkReply::NetworkError code, const QString &errorString)
+{
+    m_transportFailed = true;
+    setError(code, errorString);
+    finishReply();
+}
+
+void UnixSocketReply::finishReply()
+{
+    if (isFinished()) {
+        return;
+    }
+
+    if (m_timeoutTimer) {
+        m_timeoutTimer->stop();
+    }
+
+    setFinished(true);
+
+    const bool reusable = !m_transportFailed
+            && m_state == ParserState::Done
+            && m_bodyLength != BodyLength::UntilClose
+            && m_input.isEmpty()
+            && m_socket->state() == QLocalSocket::ConnectedState
+            && rawHeader(QByteArrayLiteral("Connection")).toLower() != "close";
+
+    if (reusable) {
+        QLocalSocket *socket = m_socket;
+        m_socket->disconnect(this);
+        m_socket = nullptr;
+        Q_EMIT socketReusable(socket);
+    } else if (m_socket->state() != QLocalSocket::UnconnectedState) {
+        m_socket->disconnectFromServer();
+    }
+
+    if (error() != QNetworkReply::NoError) {
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 15, 0))
+        Q_EMIT errorOccurred(error());
+#else
+        Q_EMIT QNetworkReply::error(error());
+#endif
+    }
+
+    Q_EMIT readChannelFinished();
+    Q_EMIT finished();
+}
+
+#include "moc_unixsocketreply.cpp"
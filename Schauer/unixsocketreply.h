@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_UNIXSOCKETREPLY_H
+#define SCHAUER_UNIXSOCKETREPLY_H
+
+#include <QNetworkReply>
+#include <QNetworkAccessManager>
+#include <QLocalSocket>
+
+class QTimer;
+
+namespace Schauer {
+
+/*!
+ * \internal
+ * \brief Network reply that performs a HTTP/1.1 request over a unix domain socket.
+ *
+ * QNetworkAccessManager can not talk to local sockets, so this class writes the request
+ * directly to a QLocalSocket and parses the response itself. It behaves like the replies
+ * created by QNetworkAccessManager, so Job can handle both the same way.
+ *
+ * If an already connected \a socket is given, the request will be send over it, otherwise
+ * a new connection will be opened. If the connection can be kept alive after the reply has
+ * been received completely, socketReusable() is emitted right before finished().
+ */
+class UnixSocketReply : public QNetworkReply
+{
+    Q_OBJECT
+public:
+    UnixSocketReply(const QString &socketPath, QLocalSocket *socket, QNetworkAccessManager::Operation operation, const QNetworkRequest &request, const QByteArray &payload, QObject *parent = nullptr);
+    ~UnixSocketReply() override;
+
+    void abort() override;
+
+    qint64 bytesAvailable() const override;
+
+    bool isSequential() const override;
+
+Q_SIGNALS:
+    /*!
+     * Emitted before finished() if the connection can be used for further requests.
+     * The reply releases the ownership of the \a socket.
+     */
+    void socketReusable(QLocalSocket *socket);
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+
+private:
+    enum class ParserState : qint8 {
+        StatusLine,
+        Headers,
+        Body,
+        ChunkSize,
+        ChunkData,
+        ChunkDataEnd,
+        ChunkTrailer,
+        Done
+    };
+
+    enum class BodyLength : qint8 {
+        None,
+        Fixed,
+        Chunked,
+        UntilClose
+    };
+
+    void setupSocket();
+    void connectToDaemon();
+    bool retryWithNewConnection();
+    void sendRequest();
+    void socketReadyRead();
+    void socketDisconnected();
+    void socketError(QLocalSocket::LocalSocketError socketError);
+    void transferTimedOut();
+    bool parseStatusLine(const QByteArray &line);
+    void parseHeaderLine(const QByteArray &line);
+    void headersFinished();
+    void appendBody(const char *data, qint64 size);
+    void finishReply();
+    void failReply(QNetworkReply::NetworkError code, const QString &errorString);
+    QByteArray buildRequest() const;
+
+    QString m_socketPath;
+    QByteArray m_payload;
+    QByteArray m_input;
+    QByteArray m_body;
+    QLocalSocket *m_socket = nullptr;
+    QTimer *m_timeoutTimer = nullptr;
+    qint64 m_readPos = 0;
+    qint64 m_remaining = 0;
+    qint64 m_contentLength = -1;
+    qint64 m_bytesReceived = 0;
+    ParserState m_state = ParserState::StatusLine;
+    BodyLength m_bodyLength = BodyLength::None;
+    bool m_reusedSocket = false;
+    bool m_transportFailed = false;
+
+    Q_DISABLE_COPY(UnixSocketReply)
+};
+
+}
+
+#endif // SCHAUER_UNIXSOCKETREPLY_H
@@ -0,0 +1,153 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "waitcontainerjob_p.h"
+#include "logging.h"
+#include <QTimer>
+#include <QJsonObject>
+
+using namespace Schauer;
+
+WaitContainerJobPrivate::WaitContainerJobPrivate(WaitContainerJob *q)
+    : JobPrivate(q)
+{
+    namOperation = NetworkOperation::Post;
+    expectedContentType = ExpectedContentType::JsonObject;
+    requiresAuth = false;
+    // the daemon answers when the condition has been reached, what can take forever
+    requestTimeout = 0;
+}
+
+WaitContainerJobPrivate::~WaitContainerJobPrivate() = default;
+
+QString WaitContainerJobPrivate::buildUrlPath() const
+{
+    const QString _id = id.startsWith(QLatin1Char('/')) ? id.mid(1) : id;
+    const QString path = JobPrivate::buildUrlPath() + QLatin1String("/containers/") + _id + QLatin1String("/wait");
+    return path;
+}
+
+QUrlQuery WaitContainerJobPrivate::buildUrlQuery() const
+{
+    QUrlQuery uq = JobPrivate::buildUrlQuery();
+    switch (condition) {
+    case WaitContainerJob::NotRunning:
+        uq.addQueryItem(QStringLiteral("condition"), QStringLiteral("not-running"));
+        break;
+    case WaitContainerJob::NextExit:
+        uq.addQueryItem(QStringLiteral("condition"), QStringLiteral("next-exit"));
+        break;
+    case WaitContainerJob::Removed:
+        uq.addQueryItem(QStringLiteral("condition"), QStringLiteral("removed"));
+        break;
+    }
+    return uq;
+}
+
+void WaitContainerJobPrivate::emitDescription()
+{
+    Q_Q(WaitContainerJob);
+
+    //: Job description title
+    //% "Waiting for container with ID %1"
+    const QString _title = qtTrId("libschauer-job-desc-wait-container-title").arg(id);
+
+    Q_EMIT q->description(q, _title);
+}
+
+bool WaitContainerJobPrivate::checkInput()
+{
+    if (!JobPrivate::checkInput()) {
+        return false;
+    }
+
+    if (id.isEmpty()) {
+        //: Error message if container id is missing when trying to wait for a container
+        //% "Can not wait for a container without a valid container ID."
+        emitError(InvalidInput, qtTrId("libschauer-error-wait-container-missing-id"));
+        qCCritical(schCore) << "Missing container ID when trying to wait for a container";
+        return false;
+    }
+
+    return true;
+}
+
+bool WaitContainerJobPrivate::checkOutput(const QByteArray &data)
+{
+    if (!JobPrivate::checkOutput(data) || !parseReply()) {
+        return false;
+    }
+
+    const QJsonObject o = json().object();
+    const QJsonValue statusCode = o.value(QStringLiteral("StatusCode"));
+    if (Q_UNLIKELY(!statusCode.isDouble())) {
+        Q_Q(WaitContainerJob);
+        q->setError(WrongOutputType);
+        qCCritical(schCore) << "Invalid reply: the wait result has no status code.";
+        return false;
+    }
+
+    exitStatus.statusCode = static_cast<qint64>(statusCode.toDouble());
+    exitStatus.error = o.value(QStringLiteral("Error")).toObject().value(QStringLiteral("Message")).toString();
+
+    qCDebug(schCore) << "Container" << id << "exited with status code" << exitStatus.statusCode;
+
+    return true;
+}
+
+WaitContainerJob::WaitContainerJob(QObject *parent)
+    : Job(* new WaitContainerJobPrivate(this), parent)
+{
+
+}
+
+WaitContainerJob::~WaitContainerJob() = default;
+
+void WaitContainerJob::start()
+{
+    Q_D(WaitContainerJob);
+    d->exitStatus = ContainerExitStatus();
+    QTimer::singleShot(0, this, &WaitContainerJob::sendRequest);
+}
+
+QString WaitContainerJob::id() const
+{
+    Q_D(const WaitContainerJob);
+    return d->id;
+}
+
+void WaitContainerJob::setId(const QString &id)
+{
+    Q_D(WaitContainerJob);
+    if (d->id != id) {
+        qCDebug(schCore) << "Changing \"id\" from" << d->id << "to" << id;
+        d->id = id;
+        Q_EMIT idChanged(this->id());
+    }
+}
+
+WaitContainerJob::Condition WaitContainerJob::condition() const
+{
+    Q_D(const WaitContainerJob);
+    return d->condition;
+}
+
+void WaitContainerJob::setCondition(Condition condition)
+{
+    Q_D(WaitContainerJob);
+    if (d->condition != condition) {
+        qCDebug(schCore) << "Changing \"condition\" from" << d->condition << "to" << condition;
+        d->condition = condition;
+        Q_EMIT conditionChanged(this->condition());
+    }
+}
+
+ContainerExitStatus WaitContainerJob::exitStatus() const
+{
+    Q_D(const WaitContainerJob);
+    return d->exitStatus;
+}
+
+#include "moc_waitcontainerjob.cpp"
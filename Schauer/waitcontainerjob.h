@@ -0,0 +1,186 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_WAITCONTAINERJOB_H
+#define SCHAUER_WAITCONTAINERJOB_H
+
+#include "schauer_exports.h"
+#include "job.h"
+
+namespace Schauer {
+
+/*!
+ * \ingroup api-jobs-containers
+ * \brief Exit status of a container reported by WaitContainerJob.
+ *
+ * \headerfile "" <Schauer/WaitContainerJob>
+ */
+struct ContainerExitStatus
+{
+    /*!
+     * \brief Exit code of the container.
+     *
+     * Is \c -1 as long as no exit status has been received.
+     */
+    qint64 statusCode = -1;
+
+    /*!
+     * \brief Error message reported by the daemon while waiting for the container, if any.
+     */
+    QString error;
+};
+
+class WaitContainerJobPrivate;
+
+/*!
+ * \ingroup api-jobs-containers
+ * \brief Waits until a container stops and returns its exit status.
+ *
+ * This job sends a single request that is answered by the Docker daemon when the
+ * container reaches the \link WaitContainerJob::condition condition\endlink. This
+ * replaces polling the container state. The request timeout is disabled for this
+ * job, kill the job to stop waiting.
+ *
+ * The job succeeds if the daemon reports an exit status, regardless of the exit code.
+ * Use exitStatus() to get the exit code and an optional error message.
+ *
+ * Have a look at the description of the Job class to learn how to use Job
+ * classes.
+ *
+ * \par Example
+ * \code{.cpp}
+ * auto job = new WaitContainerJob();
+ * job->setId(QStringLiteral("my-container"));
+ * connect(job, &Job::succeeded, this, [job](){
+ *     qDebug() << "Container exited with" << job->exitStatus().statusCode;
+ * });
+ * job->start();
+ * \endcode
+ *
+ * \par API route
+ * /containers/{\link WaitContainerJob::id id\endlink}/wait
+ *
+ * \par API method
+ * POST
+ *
+ * \dockerAPI{ContainerWait}
+ *
+ * \sa StopContainerJob
+ *
+ * \headerfile "" <Schauer/WaitContainerJob>
+ */
+class SCHAUER_LIBRARY WaitContainerJob : public Job
+{
+    Q_OBJECT
+    /*!
+     * \brief ID or name of the container to wait for.
+     *
+     * By default this property holds an empty string. This property must be set to
+     * a valid container ID or name to execute the job.
+     *
+     * \par Access functions
+     * \li QString() id() const
+     * \li void setId(const QString &id)
+     *
+     * \par Notifier signal
+     * \li void idChanged(const QString &id)
+     */
+    Q_PROPERTY(QString id READ id WRITE setId NOTIFY idChanged)
+    /*!
+     * \brief The condition to wait for.
+     *
+     * The default value is WaitContainerJob::NotRunning.
+     *
+     * \par Access functions
+     * \li Condition condition() const
+     * \li void setCondition(Condition condition)
+     *
+     * \par Notifier signal
+     * \li void conditionChanged(Condition condition)
+     */
+    Q_PROPERTY(Schauer::WaitContainerJob::Condition condition READ condition WRITE setCondition NOTIFY conditionChanged)
+public:
+    /*!
+     * \brief Conditions to wait for.
+     */
+    enum Condition : int {
+        NotRunning = 0, /**< Returns as soon as the container is not running, also if it is not running already. */
+        NextExit,       /**< Returns when the container exits the next time. */
+        Removed         /**< Returns when the container has been removed. */
+    };
+    Q_ENUM(Condition)
+
+    /*!
+     * \brief Constructs a new %WaitContainerJob object with the given \a parent.
+     */
+    explicit WaitContainerJob(QObject *parent = nullptr);
+
+    /*!
+     * \brief Destroys the %WaitContainerJob object.
+     */
+    ~WaitContainerJob() override;
+
+    /*!
+     * \brief Starts waiting for the container asynchronously.
+     *
+     * When the container has reached the \link WaitContainerJob::condition condition\endlink,
+     * result() will be emitted. To wait in a synchronous way, use exec().
+     */
+    void start() override;
+
+    /*!
+     * \brief Getter function for the \link WaitContainerJob::id id\endlink property.
+     * \sa setId(), idChanged()
+     */
+    QString id() const;
+
+    /*!
+     * \brief Setter function for the \link WaitContainerJob::id id\endlink property.
+     * \sa id(), idChanged()
+     */
+    void setId(const QString &id);
+
+    /*!
+     * \brief Getter function for the \link WaitContainerJob::condition condition\endlink property.
+     * \sa setCondition(), conditionChanged()
+     */
+    Condition condition() const;
+
+    /*!
+     * \brief Setter function for the \link WaitContainerJob::condition condition\endlink property.
+     * \sa condition(), conditionChanged()
+     */
+    void setCondition(Condition condition);
+
+    /*!
+     * \brief Returns the exit status of the container.
+     *
+     * The returned status is only valid after the job has been finished successfully.
+     */
+    ContainerExitStatus exitStatus() const;
+
+Q_SIGNALS:
+    /*!
+     * \brief Notifier signal for the \link WaitContainerJob::id id\endlink property.
+     * \sa id(), setId()
+     */
+    void idChanged(const QString &id);
+
+    /*!
+     * \brief Notifier signal for the \link WaitContainerJob::condition condition\endlink property.
+     * \sa condition(), setCondition()
+     */
+    void conditionChanged(Schauer::WaitContainerJob::Condition condition);
+
+private:
+    Q_DECLARE_PRIVATE_D(s_ptr, WaitContainerJob)
+    Q_DISABLE_COPY(WaitContainerJob)
+};
+
+}
+
+Q_DECLARE_METATYPE(Schauer::ContainerExitStatus)
+
+#endif // SCHAUER_WAITCONTAINERJOB_H
@@ -0,0 +1,42 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_WAITCONTAINERJOB_P_H
+#define SCHAUER_WAITCONTAINERJOB_P_H
+
+#include "waitcontainerjob.h"
+#include "job_p.h"
+
+namespace Schauer {
+
+class WaitContainerJobPrivate : public JobPrivate
+{
+public:
+    explicit WaitContainerJobPrivate(WaitContainerJob *q);
+
+    ~WaitContainerJobPrivate() override;
+
+    QString buildUrlPath() const override;
+
+    QUrlQuery buildUrlQuery() const override;
+
+    void emitDescription() override;
+
+    bool checkInput() override;
+
+    bool checkOutput(const QByteArray &data) override;
+
+    QString id;
+    ContainerExitStatus exitStatus;
+    WaitContainerJob::Condition condition = WaitContainerJob::NotRunning;
+
+private:
+    Q_DISABLE_COPY(WaitContainerJobPrivate)
+    Q_DECLARE_PUBLIC(WaitContainerJob)
+};
+
+}
+
+#endif // SCHAUER_WAITCONTAINERJOB_P_H
@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <QTest>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <Schauer/listdecoder.h>
+#include <Schauer/abstractcontainermodel_p.h>
+
+using namespace Schauer;
+
+class ListDecoderBench : public QObject
+{
+    Q_OBJECT
+public:
+    ListDecoderBench(QObject *parent = nullptr) : QObject(parent) {}
+
+    ~ListDecoderBench() override {}
+
+private Q_SLOTS:
+    void initTestCase() {}
+
+    void benchContainerList_data();
+    void benchContainerList();
+
+    void cleanupTestCase() {}
+
+private:
+    static QByteArray containerList(int rows);
+};
+
+// builds a /containers/json reply with rows that look like the ones of a real daemon
+QByteArray ListDecoderBench::containerList(int rows)
+{
+    QByteArray json;
+    json.reserve(rows * 600);
+    json.append('[');
+    for (int i = 0; i < rows; ++i) {
+        const QByteArray id = QByteArray::number(i, 16).rightJustified(64, '0');
+        const QByteArray no = QByteArray::number(i);
+        if (i > 0) {
+            json.append(',');
+        }
+        json.append(R"({"Id":")" + id + R"(","Names":["/container_)" + no + R"("],)"
+                    R"("Image":"nginx:latest","ImageID":"sha256:)" + id + R"(",)"
+                    R"("Command":"/docker-entrypoint.sh nginx -g 'daemon off;'","Created":)" + QByteArray::number(1641038400 + i) + ','
+                    + R"("Ports":[{"PrivatePort":80,"Type":"tcp"}],)"
+                    R"("Labels":{"com.docker.compose.project":"project_)" + QByteArray::number(i % 10) + R"(","com.docker.compose.service":"web"},)"
+                    R"("State":")" + (i % 3 == 0 ? "exited" : "running") + R"(","Status":"Up 2 hours",)"
+                    R"("SizeRw":12288,"SizeRootFs":142000000,)"
+                    R"("HostConfig":{"NetworkMode":"default"},"Mounts":[]})");
+    }
+    json.append(']');
+    return json;
+}
+
+void ListDecoderBench::benchContainerList_data()
+{
+    QTest::addColumn<int>("rows");
+    QTest::addColumn<bool>("useDecoder");
+
+    QTest::newRow("10k rows ListDecoder") << 10000 << true;
+    QTest::newRow("10k rows QJsonDocument") << 10000 << false;
+    QTest::newRow("100k rows ListDecoder") << 100000 << true;
+    QTest::newRow("100k rows QJsonDocument") << 100000 << false;
+}
+
+void ListDecoderBench::benchContainerList()
+{
+    QFETCH(int, rows);
+    QFETCH(bool, useDecoder);
+
+    const QByteArray payload = containerList(rows);
+    const quint32 mask = ContainerColumns::LookupColumns | ContainerColumns::CommandColumn | ContainerColumns::CreatedColumn
+            | ContainerColumns::StateColumn | ContainerColumns::StatusColumn | ContainerColumns::LabelsColumn
+            | ContainerColumns::SizeRwColumn | ContainerColumns::SizeRootFsColumn;
+
+    QElapsedTimer timer;
+    qint64 elapsed = 0;
+    int iterations = 0;
+
+    QBENCHMARK {
+        ContainerColumns columns;
+        timer.start();
+        if (useDecoder) {
+            ListDecoder decoder(payload.constData(), payload.size());
+            QVERIFY(decoder.decode(columns, mask));
+        } else {
+            const QJsonArray array = QJsonDocument::fromJson(payload).array();
+            columns.reserve(static_cast<std::size_t>(array.size()));
+            for (const QJsonValue &v : array) {
+                columns.appendFromJson(v.toObject(), mask);
+            }
+        }
+        elapsed += timer.nsecsElapsed();
+        ++iterations;
+        QCOMPARE(columns.rowCount(), rows);
+    }
+
+    if (elapsed > 0) {
+        const double seconds = static_cast<double>(elapsed) / 1e9 / iterations;
+        qInfo("%s: %.1f MB/s, %.0f rows/s", QTest::currentDataTag(), payload.size() / seconds / (1024.0 * 1024.0), rows / seconds);
+    }
+}
+
+QTEST_MAIN(ListDecoderBench)
+
+#include "benchlistdecoder.moc"
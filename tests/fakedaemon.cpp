@@ -0,0 +1,176 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "fakedaemon.h"
+#include <QLocalServer>
+#include <QLocalSocket>
+
+FakeDaemon::FakeDaemon(QObject *parent)
+    : QObject(parent)
+{
+
+}
+
+FakeDaemon::~FakeDaemon() = default;
+
+bool FakeDaemon::listen()
+{
+    if (!m_dir.isValid()) {
+        return false;
+    }
+
+    m_server = new QLocalServer(this);
+    connect(m_server, &QLocalServer::newConnection, this, &FakeDaemon::newConnection);
+    return m_server->listen(socketPath());
+}
+
+QString FakeDaemon::socketPath() const
+{
+    return m_dir.filePath(QStringLiteral("docker.sock"));
+}
+
+void FakeDaemon::setHandler(const QByteArray &method, const QByteArray &path, const Handler &handler)
+{
+    m_handlers.insert(method + ' ' + path, handler);
+}
+
+FakeDaemon::Handler FakeDaemon::handler(const QByteArray &method, const QByteArray &path) const
+{
+    return m_handlers.value(method + ' ' + path);
+}
+
+int FakeDaemon::connectionCount() const
+{
+    return m_connectionCount;
+}
+
+QList<FakeDaemon::Request> FakeDaemon::requests() const
+{
+    return m_requests;
+}
+
+FakeDaemon::Response FakeDaemon::jsonResponse(int statusCode, const QByteArray &json)
+{
+    Response r;
+    r.data = "HTTP/1.1 " + QByteArray::number(statusCode) + " Fake\r\n";
+    if (!json.isEmpty()) {
+        r.data += "Content-Type: application/json\r\n";
+    }
+    r.data += "Content-Length: " + QByteArray::number(json.size()) + "\r\n\r\n";
+    r.data += json;
+    return r;
+}
+
+FakeDaemon::Response FakeDaemon::chunkedResponse(int statusCode, const QByteArray &contentType, const QList<QByteArray> &chunks)
+{
+    Response r;
+    r.data = "HTTP/1.1 " + QByteArray::number(statusCode) + " Fake\r\n";
+    r.data += "Content-Type: " + contentType + "\r\n";
+    r.data += "Transfer-Encoding: chunked\r\n\r\n";
+    for (const QByteArray &chunk : chunks) {
+        r.data += QByteArray::number(chunk.size(), 16) + "\r\n" + chunk + "\r\n";
+    }
+    r.data += "0\r\n\r\n";
+    return r;
+}
+
+FakeDaemon::Response FakeDaemon::streamResponse(const QByteArray &contentType, const QByteArray &data)
+{
+    Response r;
+    r.data = "HTTP/1.1 200 OK\r\nContent-Type: " + contentType + "\r\n\r\n" + data;
+    r.closeConnection = true;
+    return r;
+}
+
+FakeDaemon::Response FakeDaemon::openStreamResponse(const QByteArray &contentType, const QByteArray &data)
+{
+    Response r;
+    r.data = "HTTP/1.1 200 OK\r\nContent-Type: " + contentType + "\r\n\r\n" + data;
+    r.holdConnection = true;
+    return r;
+}
+
+void FakeDaemon::newConnection()
+{
+    while (QLocalSocket *socket = m_server->nextPendingConnection()) {
+        m_connectionCount++;
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket](){
+            readRequest(socket);
+        });
+        connect(socket, &QLocalSocket::disconnected, this, [this, socket](){
+            m_buffers.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void FakeDaemon::readRequest(QLocalSocket *socket)
+{
+    QByteArray &buffer = m_buffers[socket];
+    buffer.append(socket->readAll());
+
+    for (;;) {
+        const int headerEnd = buffer.indexOf("\r\n\r\n");
+        if (headerEnd < 0) {
+            return;
+        }
+
+        Request req;
+        const QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+        const QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+        if (requestLine.size() < 2) {
+            socket->abort();
+            return;
+        }
+        req.method = requestLine.at(0);
+        const QByteArray target = requestLine.at(1);
+        const int queryIdx = target.indexOf('?');
+        req.path = queryIdx > -1 ? target.left(queryIdx) : target;
+        req.query = queryIdx > -1 ? target.mid(queryIdx + 1) : QByteArray();
+        // strip the API version prefix
+        if (req.path.startsWith("/v")) {
+            const int slashIdx = req.path.indexOf('/', 1);
+            if (slashIdx > -1) {
+                req.path = req.path.mid(slashIdx);
+            }
+        }
+        for (int i = 1; i < lines.size(); ++i) {
+            const QByteArray line = lines.at(i).trimmed();
+            const int colonIdx = line.indexOf(':');
+            if (colonIdx > 0) {
+                req.headers.insert(line.left(colonIdx).trimmed().toLower(), line.mid(colonIdx + 1).trimmed());
+            }
+        }
+
+        const int contentLength = req.headers.value("content-length").toInt();
+        if (buffer.size() < headerEnd + 4 + contentLength) {
+            return;
+        }
+        req.body = buffer.mid(headerEnd + 4, contentLength);
+        buffer.remove(0, headerEnd + 4 + contentLength);
+
+        m_requests.append(req);
+
+        Response resp;
+        const Handler handler = m_handlers.value(req.method + ' ' + req.path);
+        if (handler) {
+            resp = handler(req);
+        } else {
+            resp = jsonResponse(404, QByteArrayLiteral("{\"message\":\"page not found\"}"));
+        }
+
+        socket->write(resp.data);
+        if (resp.holdConnection) {
+            // the stream never ends, the client has to close the connection
+            return;
+        }
+        if (resp.closeConnection || req.headers.value("connection").toLower() == "close") {
+            socket->disconnectFromServer();
+            return;
+        }
+    }
+}
+
+#include "moc_fakedaemon.cpp"
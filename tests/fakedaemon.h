@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_FAKEDAEMON_H
+#define SCHAUER_FAKEDAEMON_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QMap>
+#include <QList>
+#include <QHash>
+#include <QTemporaryDir>
+#include <functional>
+
+class QLocalServer;
+class QLocalSocket;
+
+/*!
+ * Minimal HTTP/1.1 server listening on a unix domain socket in a temporary
+ * directory that answers requests with canned responses like the Docker daemon.
+ */
+class FakeDaemon : public QObject
+{
+    Q_OBJECT
+public:
+    struct Request {
+        QByteArray method;
+        QByteArray path;
+        QByteArray query;
+        QMap<QByteArray,QByteArray> headers;
+        QByteArray body;
+    };
+
+    struct Response {
+        QByteArray data;
+        bool closeConnection = false;
+        bool holdConnection = false;
+    };
+
+    using Handler = std::function<Response(const Request &request)>;
+
+    explicit FakeDaemon(QObject *parent = nullptr);
+    ~FakeDaemon() override;
+
+    bool listen();
+
+    QString socketPath() const;
+
+    void setHandler(const QByteArray &method, const QByteArray &path, const Handler &handler);
+
+    Handler handler(const QByteArray &method, const QByteArray &path) const;
+
+    int connectionCount() const;
+
+    QList<Request> requests() const;
+
+    static Response jsonResponse(int statusCode, const QByteArray &json);
+
+    static Response chunkedResponse(int statusCode, const QByteArray &contentType, const QList<QByteArray> &chunks);
+
+    static Response streamResponse(const QByteArray &contentType, const QByteArray &data);
+
+    static Response openStreamResponse(const QByteArray &contentType, const QByteArray &data);
+
+private:
+    void newConnection();
+    void readRequest(QLocalSocket *socket);
+
+    QTemporaryDir m_dir;
+    QHash<QByteArray,Handler> m_handlers;
+    QHash<QLocalSocket*,QByteArray> m_buffers;
+    QList<Request> m_requests;
+    QLocalServer *m_server = nullptr;
+    int m_connectionCount = 0;
+
+    Q_DISABLE_COPY(FakeDaemon)
+};
+
+#endif // SCHAUER_FAKEDAEMON_H
@@ -0,0 +1,157 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "fakedocker.h"
+#include "testconfig.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+
+FakeDocker::FakeDocker(QObject *parent)
+    : FakeDaemon(parent)
+{
+    setHandler("GET", "/version", [](const Request &){
+        return jsonResponse(200, QByteArrayLiteral("{\"Version\":\"20.10.12\",\"ApiVersion\":\"1.41\",\"Components\":[]}"));
+    });
+
+    setHandler("GET", "/containers/json", [](const Request &){
+        return chunkedResponse(200, QByteArrayLiteral("application/json"), {
+                                   QByteArrayLiteral("[{\"Id\":\"8dfafdbc3a40\",\"Names\":[\"/boring_feynman\"],\"State\":\"running\"},{\"Id\":\"9cd87474be90\",\"Na"),
+                                   QByteArrayLiteral("mes\":[\"/coolName\"],\"Labels\":{\"x\":\"}]\\\"\"},\"State\":\"exited\"}]")
+                               });
+    });
+
+    setHandler("GET", "/images/json", [](const Request &){
+        return jsonResponse(200, QByteArrayLiteral("{\"Id\":\"sha256:e216a057b1cb\"}"));
+    });
+
+    setHandler("POST", "/containers/create", [](const Request &req){
+        const QJsonObject config = QJsonDocument::fromJson(req.body).object();
+        if (config.value(QStringLiteral("Image")).toString() != QLatin1String("nginx")) {
+            return jsonResponse(400, QByteArrayLiteral("{\"message\":\"invalid image\"}"));
+        }
+        if (req.query.contains("name=crashing")) {
+            return jsonResponse(201, QByteArrayLiteral("{\"Id\":\"crashing\",\"Warnings\":[]}"));
+        }
+        return jsonResponse(201, QByteArrayLiteral("{\"Id\":\"e90e34656806\",\"Warnings\":[]}"));
+    });
+
+    setHandler("POST", "/containers/e90e34656806/start", [](const Request &){
+        return jsonResponse(204, QByteArray());
+    });
+
+    setHandler("GET", "/containers/e90e34656806/json", [](const Request &){
+        return jsonResponse(200, QByteArrayLiteral("{\"Id\":\"e90e34656806\",\"State\":{\"Status\":\"running\",\"Running\":true}}"));
+    });
+
+    setHandler("DELETE", "/containers/e90e34656806", [](const Request &){
+        return jsonResponse(204, QByteArray());
+    });
+
+    setHandler("POST", "/containers/crashing/start", [](const Request &){
+        return jsonResponse(204, QByteArray());
+    });
+
+    setHandler("GET", "/containers/crashing/json", [](const Request &){
+        return jsonResponse(200, QByteArrayLiteral("{\"Id\":\"crashing\",\"State\":{\"Status\":\"exited\",\"Running\":false,\"ExitCode\":1}}"));
+    });
+
+    setHandler("DELETE", "/containers/crashing", [](const Request &){
+        return jsonResponse(204, QByteArray());
+    });
+
+    setHandler("POST", "/containers/unknown/start", [](const Request &){
+        return jsonResponse(404, QByteArrayLiteral("{\"message\":\"No such container: unknown\"}"));
+    });
+
+    setHandler("POST", "/exec/multiplexed/start", [](const Request &){
+        QByteArray data;
+        data += frame(1, QByteArrayLiteral("hello "));
+        data += frame(2, QByteArrayLiteral("warning\n"));
+        data += frame(1, QByteArrayLiteral("world\n"));
+        return streamResponse(QByteArrayLiteral("application/vnd.docker.multiplexed-stream"), data);
+    });
+
+    setHandler("POST", "/containers/runner/exec", [](const Request &req){
+        const QJsonObject config = QJsonDocument::fromJson(req.body).object();
+        if (!config.value(QStringLiteral("AttachStdout")).toBool() || !config.value(QStringLiteral("AttachStderr")).toBool()) {
+            return jsonResponse(400, QByteArrayLiteral("{\"message\":\"output not attached\"}"));
+        }
+        return jsonResponse(201, QByteArrayLiteral("{\"Id\":\"runexec\"}"));
+    });
+
+    setHandler("POST", "/exec/runexec/start", [](const Request &){
+        return streamResponse(QByteArrayLiteral("application/vnd.docker.multiplexed-stream"), frame(1, QByteArrayLiteral("out\n")) + frame(2, QByteArrayLiteral("err\n")));
+    });
+
+    setHandler("GET", "/exec/runexec/json", [](const Request &){
+        return jsonResponse(200, QByteArrayLiteral("{\"ID\":\"runexec\",\"Running\":false,\"ExitCode\":3}"));
+    });
+
+    setHandler("POST", "/exec/tty/start", [](const Request &){
+        return streamResponse(QByteArrayLiteral("application/vnd.docker.raw-stream"), QByteArrayLiteral("plain output\r\n"));
+    });
+
+    setHandler("GET", "/events", [](const Request &){
+        return chunkedResponse(200, QByteArrayLiteral("application/json"), {
+                                   QByteArrayLiteral("{\"Type\":\"container\",\"Action\":\"start\",\"Actor\":{\"ID\":\"8dfafdbc3a40\",\"Attributes\":{\"name\":\"boring_feynman\"}},\"scope\":\"local\",\"time\":1641038400,\"timeNano\":1641038400123456789}\n{\"Type\":\"ima"),
+                                   QByteArrayLiteral("ge\",\"Action\":\"pull\",\"Actor\":{\"ID\":\"nginx:latest\"},\"scope\":\"local\",\"time\":1641038401,\"timeNano\":1641038401000000001}\n")
+                               });
+    });
+
+    setHandler("GET", "/containers/stats-test/stats", [](const Request &){
+        const QByteArray sample1 = QByteArrayLiteral("{\"read\":\"2022-01-01T12:00:00.0Z\",\"pids_stats\":{\"current\":3},"
+                                                     "\"networks\":{\"eth0\":{\"rx_bytes\":100,\"rx_packets\":2,\"tx_bytes\":50,\"tx_packets\":1},\"eth1\":{\"rx_bytes\":10,\"rx_packets\":1,\"tx_bytes\":5,\"tx_packets\":1}},"
+                                                     "\"memory_stats\":{\"stats\":{\"cache\":0},\"usage\":6537216,\"limit\":67108864},"
+                                                     "\"blkio_stats\":{\"io_service_bytes_recursive\":[{\"major\":8,\"minor\":0,\"op\":\"Read\",\"value\":4096},{\"major\":8,\"minor\":0,\"op\":\"Write\",\"value\":512},{\"major\":8,\"minor\":0,\"op\":\"Total\",\"value\":4608}]},"
+                                                     "\"cpu_stats\":{\"cpu_usage\":{\"percpu_usage\":[1,2],\"total_usage\":400},\"system_cpu_usage\":20000,\"online_cpus\":2},"
+                                                     "\"precpu_stats\":{\"cpu_usage\":{\"total_usage\":200},\"system_cpu_usage\":10000}}\n");
+        const QByteArray sample2 = QByteArrayLiteral("{\"memory_stats\":{\"usage\":1024,\"limit\":4096},\"blkio_stats\":{\"io_service_bytes_recursive\":null}}\n");
+        return chunkedResponse(200, QByteArrayLiteral("application/json"), {sample1.left(100), sample1.mid(100) + sample2.left(10), sample2.mid(10)});
+    });
+
+    setHandler("GET", "/containers/logs-test/logs", [](const Request &req){
+        QByteArray data;
+        if (req.query.contains("timestamps=true")) {
+            data += frame(1, QByteArrayLiteral("2022-01-01T12:00:00.123456789Z first line\n"));
+            data += frame(2, QByteArrayLiteral("2022-01-01T12:00:01.5Z error line\n"));
+        } else {
+            data += frame(1, QByteArrayLiteral("first "));
+            data += frame(2, QByteArrayLiteral("error line\r\n"));
+            data += frame(1, QByteArrayLiteral("line\nsecond line\n"));
+            data += frame(1, QByteArrayLiteral("0123456789abcdefghij"));
+        }
+        return streamResponse(QByteArrayLiteral("application/vnd.docker.multiplexed-stream"), data);
+    });
+
+    setHandler("POST", "/containers/e90e34656806/wait", [](const Request &req){
+        if (req.query.contains("condition=next-exit")) {
+            return jsonResponse(200, QByteArrayLiteral("{\"StatusCode\":137,\"Error\":{\"Message\":\"killed\"}}"));
+        }
+        return jsonResponse(200, QByteArrayLiteral("{\"StatusCode\":0}"));
+    });
+}
+
+FakeDocker::~FakeDocker() = default;
+
+TestConfig *FakeDocker::createConfig(QObject *parent) const
+{
+    auto conf = new TestConfig(parent);
+    conf->setHost(QString());
+    conf->setSocketPath(socketPath());
+    return conf;
+}
+
+QByteArray FakeDocker::frame(char stream, const QByteArray &payload)
+{
+    QByteArray data;
+    data += stream;
+    data += QByteArray(3, '\0');
+    data += static_cast<char>((payload.size() >> 24) & 0xff);
+    data += static_cast<char>((payload.size() >> 16) & 0xff);
+    data += static_cast<char>((payload.size() >> 8) & 0xff);
+    data += static_cast<char>(payload.size() & 0xff);
+    data += payload;
+    return data;
+}
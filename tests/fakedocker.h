@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SCHAUER_FAKEDOCKER_H
+#define SCHAUER_FAKEDOCKER_H
+
+#include "fakedaemon.h"
+
+class TestConfig;
+
+/*!
+ * FakeDaemon that answers the Docker API routes used by the tests that
+ * talk to a daemon. Tests can replace single handlers and have to restore
+ * the original handler afterwards.
+ */
+class FakeDocker : public FakeDaemon
+{
+    Q_OBJECT
+public:
+    explicit FakeDocker(QObject *parent = nullptr);
+    ~FakeDocker() override;
+
+    /*!
+     * Returns a new configuration that connects to the socket of this daemon.
+     */
+    TestConfig *createConfig(QObject *parent) const;
+
+    /*!
+     * Returns \a payload as frame of a multiplexed attach stream.
+     */
+    static QByteArray frame(char stream, const QByteArray &payload);
+
+private:
+    Q_DISABLE_COPY(FakeDocker)
+};
+
+#endif // SCHAUER_FAKEDOCKER_H
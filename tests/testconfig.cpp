@@ -23,4 +23,35 @@ void TestConfig::setHost(const QString &host)
     m_host = host;
 }
 
+QString TestConfig::socketPath() const
+{
+    return m_socketPath;
+}
+
+void TestConfig::setSocketPath(const QString &socketPath)
+{
+    m_socketPath = socketPath;
+}
+
+int TestConfig::maxConnectionsPerHost() const
+{
+    return m_maxConnections;
+}
+
+void TestConfig::setMaxConnectionsPerHost(int maxConnections)
+{
+    m_maxConnections = maxConnections;
+}
+
+int TestConfig::responseCacheTimeToLive(const QString &endpoint) const
+{
+    Q_UNUSED(endpoint)
+    return m_cacheTimeToLive;
+}
+
+void TestConfig::setResponseCacheTimeToLive(int timeToLive)
+{
+    m_cacheTimeToLive = timeToLive;
+}
+
 #include "moc_testconfig.cpp"
@@ -18,10 +18,22 @@ public:
     void setHost(const QString &host);
     QString host() const override;
 
+    void setSocketPath(const QString &socketPath);
+    QString socketPath() const override;
+
+    void setMaxConnectionsPerHost(int maxConnections);
+    int maxConnectionsPerHost() const override;
+
+    void setResponseCacheTimeToLive(int timeToLive);
+    int responseCacheTimeToLive(const QString &endpoint) const override;
+
 private:
     Q_DISABLE_COPY(TestConfig)
 
     QString m_host = QStringLiteral("localhost");
+    QString m_socketPath;
+    int m_maxConnections = 6;
+    int m_cacheTimeToLive = 0;
 };
 
 #endif // SCHAUER_TESTCONFIG_H
@@ -0,0 +1,445 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <QTest>
+#include <QSignalSpy>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <Schauer/GetVersionJob>
+#include <Schauer/ListImagesJob>
+#include <Schauer/CreateContainerJob>
+#include <Schauer/ContainerConfig>
+#include <Schauer/CreateAndStartContainerJob>
+#include <Schauer/StartExecInstanceJob>
+#include <Schauer/RunCommandJob>
+#include <Schauer/EventsJob>
+#include <Schauer/ContainerStatsJob>
+#include <Schauer/ContainerLogsJob>
+#include <Schauer/WaitContainerJob>
+#include "testconfig.h"
+#include "fakedocker.h"
+
+using namespace Schauer;
+
+class DaemonJobsTest : public QObject
+{
+    Q_OBJECT
+public:
+    explicit DaemonJobsTest(QObject *parent = nullptr) : QObject(parent) {}
+
+    ~DaemonJobsTest() override {}
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void testGetVersionJob();
+    void testListImagesJobSummaries();
+    void testCreateContainerJobPayload();
+    void testAttachedExec();
+    void testAttachedExecTty();
+    void testRunCommandJob();
+    void testRunCommandJobStillRunning();
+    void testEventsJob();
+    void testEventsJobReconnect();
+    void testContainerStatsJob();
+    void testCreateAndStartContainerJob();
+    void testWaitContainerJob();
+    void testContainerLogsJob();
+
+    void cleanupTestCase() {}
+
+private:
+    FakeDocker *m_daemon = nullptr;
+    TestConfig *m_config = nullptr;
+};
+
+void DaemonJobsTest::initTestCase()
+{
+    m_daemon = new FakeDocker(this);
+    QVERIFY(m_daemon->listen());
+    m_config = m_daemon->createConfig(this);
+}
+
+void DaemonJobsTest::testGetVersionJob()
+{
+    auto job = new GetVersionJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QCOMPARE(job->replyData().object().value(QStringLiteral("Version")).toString(), QStringLiteral("20.10.12"));
+    QCOMPARE(m_daemon->requests().last().method, QByteArrayLiteral("GET"));
+    const VersionInfo info = job->versionInfo();
+    QCOMPARE(info.version, QStringLiteral("20.10.12"));
+    QCOMPARE(info.apiVersion, QStringLiteral("1.41"));
+    QVERIFY(info.components.empty());
+    QCOMPARE(job->rawReplyData(), QByteArrayLiteral("{\"Version\":\"20.10.12\",\"ApiVersion\":\"1.41\",\"Components\":[]}"));
+}
+
+void DaemonJobsTest::testListImagesJobSummaries()
+{
+    const FakeDaemon::Handler original = m_daemon->handler("GET", "/images/json");
+    m_daemon->setHandler("GET", "/images/json", [](const FakeDaemon::Request &){
+        return FakeDaemon::jsonResponse(200, QByteArrayLiteral(R"([{"Id":"sha256:e216a057b1cb","ParentId":"","RepoTags":["nginx:latest"],"RepoDigests":null,"Created":1642700000,"Size":141500000,"VirtualSize":141500000,"SharedSize":-1,"Labels":{"maintainer":"NGINX"},"Containers":2},)"
+                                                       R"({"Id":"sha256:9c6f07244728","ParentId":"sha256:e216a057b1cb","RepoTags":[],"Created":1.6427E9,"Size":5,"Labels":null,"Containers":-1}])"));
+    });
+
+    auto job = new ListImagesJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    const QVector<ImageSummary> images = job->images();
+    QCOMPARE(images.size(), 2);
+    QCOMPARE(images.at(0).id, QStringLiteral("sha256:e216a057b1cb"));
+    QCOMPARE(images.at(0).repoTags, QStringList({QStringLiteral("nginx:latest")}));
+    QVERIFY(images.at(0).repoDigests.isEmpty());
+    QCOMPARE(images.at(0).created.toMSecsSinceEpoch(), Q_INT64_C(1642700000000));
+    QCOMPARE(images.at(0).sharedSize, Q_INT64_C(-1));
+    QCOMPARE(images.at(0).labels.value(QStringLiteral("maintainer")), QStringLiteral("NGINX"));
+    QCOMPARE(images.at(0).containers, 2);
+    QCOMPARE(images.at(1).parentId, QStringLiteral("sha256:e216a057b1cb"));
+    QCOMPARE(images.at(1).created.toMSecsSinceEpoch(), Q_INT64_C(1642700000000));
+    QCOMPARE(images.at(1).size, Q_INT64_C(5));
+    QVERIFY(images.at(1).labels.isEmpty());
+    QCOMPARE(images.at(1).containers, -1);
+    QCOMPARE(job->images().size(), 2);
+
+    m_daemon->setHandler("GET", "/images/json", original);
+}
+
+void DaemonJobsTest::testCreateContainerJobPayload()
+{
+    auto job = new CreateContainerJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+    job->setContainerConfig({{QStringLiteral("Image"), QStringLiteral("nginx")}});
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QCOMPARE(job->replyData().object().value(QStringLiteral("Id")).toString(), QStringLiteral("e90e34656806"));
+    QCOMPARE(job->createdContainer().id, QStringLiteral("e90e34656806"));
+    QVERIFY(job->createdContainer().warnings.empty());
+    QCOMPARE(m_daemon->requests().last().headers.value("content-type"), QByteArrayLiteral("application/json"));
+    QCOMPARE(m_daemon->requests().last().body, QByteArrayLiteral("{\"Image\":\"nginx\"}"));
+
+    // the serialized config is sent as it is and takes precedence
+    ContainerConfig config;
+    config.image = QStringLiteral("nginx");
+    config.env << QStringLiteral("FOO=bar");
+    const QByteArray payload = config.toJson();
+    job->setContainerConfig(QVariantHash());
+    job->setSerializedConfig(payload);
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QCOMPARE(m_daemon->requests().last().body, payload);
+}
+
+void DaemonJobsTest::testAttachedExec()
+{
+    auto job = new StartExecInstanceJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+    job->setId(QStringLiteral("multiplexed"));
+    job->setDetach(false);
+
+    QByteArray out;
+    QByteArray err;
+    connect(job, &StartExecInstanceJob::stdoutReceived, this, [&out](const QByteArray &data){ out += data; });
+    connect(job, &StartExecInstanceJob::stderrReceived, this, [&err](const QByteArray &data){ err += data; });
+
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QCOMPARE(out, QByteArrayLiteral("hello world\n"));
+    QCOMPARE(err, QByteArrayLiteral("warning\n"));
+
+    const QJsonObject body = QJsonDocument::fromJson(m_daemon->requests().last().body).object();
+    QCOMPARE(body.value(QStringLiteral("Detach")).toBool(true), false);
+}
+
+void DaemonJobsTest::testAttachedExecTty()
+{
+    auto job = new StartExecInstanceJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+    job->setId(QStringLiteral("tty"));
+    job->setDetach(false);
+    job->setTty(true);
+
+    QByteArray out;
+    QSignalSpy errSpy(job, &StartExecInstanceJob::stderrReceived);
+    connect(job, &StartExecInstanceJob::stdoutReceived, this, [&out](const QByteArray &data){ out += data; });
+
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QCOMPARE(out, QByteArrayLiteral("plain output\r\n"));
+    QCOMPARE(errSpy.count(), 0);
+}
+
+void DaemonJobsTest::testRunCommandJob()
+{
+    auto job = new RunCommandJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+    job->setId(QStringLiteral("runner"));
+    job->setCmd(QStringList({QStringLiteral("false")}));
+
+    QSignalSpy outSpy(job, &RunCommandJob::stdoutReceived);
+
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QCOMPARE(job->execId(), QStringLiteral("runexec"));
+    QCOMPARE(job->exitCode(), 3);
+    QCOMPARE(job->standardOutput(), QByteArrayLiteral("out\n"));
+    QCOMPARE(job->standardError(), QByteArrayLiteral("err\n"));
+    QVERIFY(outSpy.count() > 0);
+    QCOMPARE(job->replyData().object().value(QStringLiteral("ExitCode")).toInt(), 3);
+    QCOMPARE(m_daemon->requests().last().path, QByteArrayLiteral("/exec/runexec/json"));
+}
+
+void DaemonJobsTest::testRunCommandJobStillRunning()
+{
+    const FakeDaemon::Handler original = m_daemon->handler("GET", "/exec/runexec/json");
+    m_daemon->setHandler("GET", "/exec/runexec/json", [](const FakeDaemon::Request &){
+        return FakeDaemon::jsonResponse(200, QByteArrayLiteral(R"({"ID":"runexec","Running":true,"ExitCode":0})"));
+    });
+
+    auto job = new RunCommandJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+    job->setId(QStringLiteral("runner"));
+    job->setCmd(QStringList({QStringLiteral("sleep"), QStringLiteral("60")}));
+
+    const int requests = m_daemon->requests().size();
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::APIError));
+    QCOMPARE(job->exitCode(), -1);
+    // create, start and the initial inspection plus all retries
+    QCOMPARE(m_daemon->requests().size(), requests + 23);
+
+    m_daemon->setHandler("GET", "/exec/runexec/json", original);
+}
+
+void DaemonJobsTest::testEventsJob()
+{
+    auto job = new EventsJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+    job->setUntil(QDateTime::fromMSecsSinceEpoch(1641038402000));
+    job->addFilter(QStringLiteral("type"), QStringLiteral("container"));
+
+    QList<Event> events;
+    connect(job, &EventsJob::eventReceived, this, [&events](const Schauer::Event &event){ events.append(event); });
+
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QCOMPARE(events.size(), 2);
+    QCOMPARE(events.at(0).type, Event::Container);
+    QCOMPARE(events.at(0).action, QStringLiteral("start"));
+    QCOMPARE(events.at(0).actorId, QStringLiteral("8dfafdbc3a40"));
+    QCOMPARE(events.at(0).attributes.value(QStringLiteral("name")), QStringLiteral("boring_feynman"));
+    QCOMPARE(events.at(0).timeNano, Q_INT64_C(1641038400123456789));
+    QCOMPARE(events.at(1).type, Event::Image);
+    QCOMPARE(events.at(1).action, QStringLiteral("pull"));
+    QCOMPARE(job->lastEventTime(), Q_INT64_C(1641038401000000001));
+
+    const QByteArray query = m_daemon->requests().last().query;
+    QVERIFY(query.contains("until=1641038402"));
+    QVERIFY(query.contains("filters="));
+}
+
+void DaemonJobsTest::testEventsJobReconnect()
+{
+    const FakeDaemon::Handler original = m_daemon->handler("GET", "/events");
+    // older daemons only send the time in seconds, so events share their timestamps
+    m_daemon->setHandler("GET", "/events", [](const FakeDaemon::Request &req){
+        QByteArray data = QByteArrayLiteral(R"({"Type":"container","Action":"start","Actor":{"ID":"a1"},"time":1641038400})" "\n"
+                                            R"({"Type":"container","Action":"start","Actor":{"ID":"b2"},"time":1641038400})" "\n");
+        if (req.query.contains("since=")) {
+            // sent again after reconnecting, together with a new event of the same second
+            data += QByteArrayLiteral(R"({"Type":"container","Action":"die","Actor":{"ID":"a1"},"time":1641038400})" "\n");
+        }
+        return FakeDaemon::streamResponse(QByteArrayLiteral("application/json"), data);
+    });
+
+    auto job = new EventsJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+
+    QList<Event> events;
+    connect(job, &EventsJob::eventReceived, this, [&events](const Schauer::Event &event){ events.append(event); });
+
+    const int requests = m_daemon->requests().size();
+    job->start();
+    QTRY_COMPARE(events.size(), 2);
+    QCOMPARE(events.at(1).actorId, QStringLiteral("b2"));
+
+    QTRY_COMPARE(m_daemon->requests().size(), requests + 2);
+    QTRY_COMPARE(events.size(), 3);
+    QCOMPARE(events.at(2).actorId, QStringLiteral("a1"));
+    QCOMPARE(events.at(2).action, QStringLiteral("die"));
+    QCOMPARE(job->lastEventTime(), Q_INT64_C(1641038400000000000));
+
+    job->kill();
+    m_daemon->setHandler("GET", "/events", original);
+}
+
+void DaemonJobsTest::testContainerStatsJob()
+{
+    auto job = new ContainerStatsJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+    job->setId(QStringLiteral("stats-test"));
+
+    QList<ContainerStats> samples;
+    connect(job, &ContainerStatsJob::statsReceived, this, [&samples](const Schauer::ContainerStats &stats){ samples.append(stats); });
+
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QCOMPARE(samples.size(), 2);
+
+    const ContainerStats &first = samples.at(0);
+    QCOMPARE(first.cpuDelta(), Q_UINT64_C(200));
+    QCOMPARE(first.systemCpuDelta(), Q_UINT64_C(10000));
+    QCOMPARE(first.onlineCpus, 2u);
+    QCOMPARE(first.memoryUsage, Q_UINT64_C(6537216));
+    QCOMPARE(first.memoryLimit, Q_UINT64_C(67108864));
+    QCOMPARE(first.blockRead, Q_UINT64_C(4096));
+    QCOMPARE(first.blockWrite, Q_UINT64_C(512));
+    QCOMPARE(first.networkRxBytes, Q_UINT64_C(110));
+    QCOMPARE(first.networkTxBytes, Q_UINT64_C(55));
+    QCOMPARE(first.networkRxPackets, Q_UINT64_C(3));
+    QCOMPARE(first.networkTxPackets, Q_UINT64_C(2));
+    QCOMPARE(first.pids, Q_UINT64_C(3));
+
+    QCOMPARE(samples.at(1).memoryUsage, Q_UINT64_C(1024));
+    QCOMPARE(samples.at(1).blockRead, Q_UINT64_C(0));
+    QCOMPARE(job->lastStats().memoryLimit, Q_UINT64_C(4096));
+    QVERIFY(m_daemon->requests().last().query.contains("stream=true"));
+}
+
+void DaemonJobsTest::testCreateAndStartContainerJob()
+{
+    auto job = new CreateAndStartContainerJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+    job->setContainerConfig({{QStringLiteral("Image"), QStringLiteral("nginx")}});
+
+    // create and start only
+    int requests = m_daemon->requests().size();
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QCOMPARE(job->containerId(), QStringLiteral("e90e34656806"));
+    QCOMPARE(job->createdContainer().id, job->containerId());
+    QCOMPARE(m_daemon->requests().size(), requests + 2);
+    QCOMPARE(m_daemon->requests().last().path, QByteArrayLiteral("/containers/e90e34656806/start"));
+    QCOMPARE(job->replyData().object().value(QStringLiteral("Id")).toString(), QStringLiteral("e90e34656806"));
+
+    // create, start and confirm running
+    job->setWaitUntilRunning(true);
+    requests = m_daemon->requests().size();
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QCOMPARE(m_daemon->requests().size(), requests + 3);
+    QCOMPARE(m_daemon->requests().last().path, QByteArrayLiteral("/containers/e90e34656806/json"));
+
+    // container exits directly after start and gets removed again
+    job->setName(QStringLiteral("crashing"));
+    requests = m_daemon->requests().size();
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::APIError));
+    QCOMPARE(job->containerId(), QStringLiteral("crashing"));
+    QTRY_COMPARE(m_daemon->requests().size(), requests + 4);
+    QCOMPARE(m_daemon->requests().last().method, QByteArrayLiteral("DELETE"));
+    QCOMPARE(m_daemon->requests().last().path, QByteArrayLiteral("/containers/crashing"));
+    QVERIFY(m_daemon->requests().last().query.contains("force=true"));
+
+    // the container is kept if removing is disabled
+    job->setRemoveOnFailure(false);
+    requests = m_daemon->requests().size();
+    QVERIFY(!job->exec());
+    QCOMPARE(job->containerId(), QStringLiteral("crashing"));
+    QTest::qWait(100);
+    QCOMPARE(m_daemon->requests().size(), requests + 3);
+    QCOMPARE(m_daemon->requests().last().path, QByteArrayLiteral("/containers/crashing/json"));
+
+    // typed configuration
+    ContainerConfig config;
+    config.image = QStringLiteral("nginx");
+    job->setName(QString());
+    job->setContainerConfig(QVariantHash());
+    job->setSerializedConfig(config);
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QCOMPARE(job->containerId(), QStringLiteral("e90e34656806"));
+
+    // killing the job after the container has been created removes the container as well
+    const FakeDaemon::Handler originalStart = m_daemon->handler("POST", "/containers/e90e34656806/start");
+    m_daemon->setHandler("POST", "/containers/e90e34656806/start", [](const FakeDaemon::Request &){
+        return FakeDaemon::openStreamResponse(QByteArrayLiteral("text/plain"), QByteArray());
+    });
+    job->setRemoveOnFailure(true);
+    requests = m_daemon->requests().size();
+    job->start();
+    QTRY_COMPARE(m_daemon->requests().size(), requests + 2);
+    QCOMPARE(m_daemon->requests().last().path, QByteArrayLiteral("/containers/e90e34656806/start"));
+    QVERIFY(job->kill());
+    QTRY_COMPARE(m_daemon->requests().size(), requests + 3);
+    QCOMPARE(m_daemon->requests().last().method, QByteArrayLiteral("DELETE"));
+    QCOMPARE(m_daemon->requests().last().path, QByteArrayLiteral("/containers/e90e34656806"));
+    m_daemon->setHandler("POST", "/containers/e90e34656806/start", originalStart);
+}
+
+void DaemonJobsTest::testWaitContainerJob()
+{
+    auto job = new WaitContainerJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+    job->setId(QStringLiteral("e90e34656806"));
+
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QCOMPARE(job->exitStatus().statusCode, Q_INT64_C(0));
+    QVERIFY(job->exitStatus().error.isEmpty());
+    QVERIFY(m_daemon->requests().last().query.contains("condition=not-running"));
+
+    job->setCondition(WaitContainerJob::NextExit);
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QCOMPARE(job->exitStatus().statusCode, Q_INT64_C(137));
+    QCOMPARE(job->exitStatus().error, QStringLiteral("killed"));
+}
+
+void DaemonJobsTest::testContainerLogsJob()
+{
+    auto job = new ContainerLogsJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+    job->setId(QStringLiteral("logs-test"));
+    job->setTail(10);
+    job->setMaxLineLength(8);
+
+    QList<LogLine> lines;
+    connect(job, &ContainerLogsJob::lineReceived, this, [&lines](const Schauer::LogLine &line){ lines.append(line); });
+
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QVERIFY(m_daemon->requests().last().query.contains("tail=10"));
+    QVERIFY(m_daemon->requests().last().query.contains("follow=false"));
+
+    // stdout and stderr lines are split independently, overlong lines are split into parts
+    QCOMPARE(lines.size(), 6);
+    QCOMPARE(lines.at(0).stream, LogLine::Stderr);
+    QCOMPARE(lines.at(0).text, QStringLiteral("error line"));
+    QCOMPARE(lines.at(1).stream, LogLine::Stdout);
+    QCOMPARE(lines.at(1).text, QStringLiteral("first line"));
+    QCOMPARE(lines.at(2).text, QStringLiteral("second line"));
+    QCOMPARE(lines.at(3).text, QStringLiteral("01234567"));
+    QVERIFY(lines.at(3).partial);
+    QCOMPARE(lines.at(4).text, QStringLiteral("89abcdef"));
+    QVERIFY(lines.at(4).partial);
+    QCOMPARE(lines.at(5).text, QStringLiteral("ghij"));
+    QVERIFY(!lines.at(5).partial);
+    QCOMPARE(job->lineCount(), Q_UINT64_C(6));
+
+    // timestamps are split off the lines
+    lines.clear();
+    job->setMaxLineLength(65536);
+    job->setTimestamps(true);
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QCOMPARE(lines.size(), 2);
+    QCOMPARE(lines.at(0).text, QStringLiteral("first line"));
+    QCOMPARE(lines.at(0).timestamp, QDateTime(QDate(2022, 1, 1), QTime(12, 0, 0, 123), Qt::UTC));
+    QCOMPARE(lines.at(1).stream, LogLine::Stderr);
+    QCOMPARE(lines.at(1).timestamp, QDateTime(QDate(2022, 1, 1), QTime(12, 0, 1, 500), Qt::UTC));
+}
+
+QTEST_MAIN(DaemonJobsTest)
+
+#include "testdaemonjobs.moc"
@@ -0,0 +1,266 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <QTest>
+#include <QSignalSpy>
+#include <Schauer/ListContainersJob>
+#include <Schauer/ContainerListModel>
+#include "testconfig.h"
+#include "fakedocker.h"
+#include <memory>
+
+using namespace Schauer;
+
+class DaemonModelsTest : public QObject
+{
+    Q_OBJECT
+public:
+    explicit DaemonModelsTest(QObject *parent = nullptr) : QObject(parent) {}
+
+    ~DaemonModelsTest() override {}
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void testContainerListModel();
+    void testContainerListModelRefresh();
+    void testContainerListModelAsync();
+    void testContainerListModelDecoder();
+    void testContainerListModelCache();
+
+    void cleanupTestCase() {}
+
+private:
+    FakeDocker *m_daemon = nullptr;
+    TestConfig *m_config = nullptr;
+};
+
+void DaemonModelsTest::initTestCase()
+{
+    m_daemon = new FakeDocker(this);
+    QVERIFY(m_daemon->listen());
+    m_config = m_daemon->createConfig(this);
+}
+
+void DaemonModelsTest::testContainerListModel()
+{
+    auto model = new ContainerListModel(this);
+    model->setConfiguration(m_config);
+    QVERIFY(model->load(AbstractBaseModel::LoadSync));
+    QCOMPARE(model->rowCount(), 2);
+    QVERIFY(model->contains(QStringLiteral("/coolName")));
+    QVERIFY(model->contains(QLatin1String("8dfafdbc3a40")));
+    QVERIFY(!model->contains(QStringLiteral("/unknown")));
+    QCOMPARE(model->rowForId(QStringLiteral("9cd87474be90")), 1);
+    QCOMPARE(model->rowForId(QStringLiteral("unknown")), -1);
+    QCOMPARE(model->rowForName(QStringLiteral("/boring_feynman")), 0);
+    QCOMPARE(model->rowForName(QStringLiteral("coolName")), 1);
+    QCOMPARE(model->rowForName(QString()), -1);
+    QCOMPARE(model->data(model->index(0, 0), ContainerListModel::StateRole).toString(), QStringLiteral("running"));
+    QCOMPARE(model->data(model->index(1, 0), ContainerListModel::StateRole).toString(), QStringLiteral("exited"));
+    QCOMPARE(model->data(model->index(1, 0), ContainerListModel::NamesRole).toStringList(), QStringList({QStringLiteral("/coolName")}));
+    const auto labels = model->data(model->index(1, 0), ContainerListModel::LabelsRole).value<QMap<QString,QString>>();
+    QCOMPARE(labels.value(QStringLiteral("x")), QStringLiteral("}]\""));
+    QVERIFY(model->data(model->index(0, 0), ContainerListModel::LabelsRole).value<QMap<QString,QString>>().isEmpty());
+
+    // indexes have to be reset together with the data
+    auto smallDaemon = new FakeDaemon(this);
+    QVERIFY(smallDaemon->listen());
+    smallDaemon->setHandler("GET", "/containers/json", [](const FakeDaemon::Request &){
+        return FakeDaemon::jsonResponse(200, QByteArrayLiteral(R"([{"Id":"8dfafdbc3a40","Names":["/boring_feynman"],"State":"running"},{"Id":"5e1f","Names":["/sleepy"],"State":"hibernating"}])"));
+    });
+    auto conf = new TestConfig(this);
+    conf->setHost(QString());
+    conf->setSocketPath(smallDaemon->socketPath());
+    model->setConfiguration(conf);
+    QVERIFY(model->load(AbstractBaseModel::LoadSync));
+    QCOMPARE(model->rowCount(), 2);
+    QVERIFY(!model->contains(QStringLiteral("/coolName")));
+    QCOMPARE(model->rowForId(QStringLiteral("9cd87474be90")), -1);
+    QCOMPARE(model->rowForName(QStringLiteral("coolName")), -1);
+    QCOMPARE(model->rowForName(QStringLiteral("/boring_feynman")), 0);
+    // states unknown to the library keep the name reported by the daemon
+    QCOMPARE(model->data(model->index(1, 0), ContainerListModel::StateRole).toString(), QStringLiteral("hibernating"));
+}
+
+void DaemonModelsTest::testContainerListModelRefresh()
+{
+    const FakeDaemon::Handler original = m_daemon->handler("GET", "/containers/json");
+    // shared, so that the handler stays valid if the test fails early
+    auto reply = std::make_shared<QByteArray>(QByteArrayLiteral(R"([{"Id":"a1","Names":["/one"],"State":"running"},{"Id":"b2","Names":["/two"],"State":"running"},{"Id":"c3","Names":["/three"],"State":"running"}])"));
+    m_daemon->setHandler("GET", "/containers/json", [reply](const FakeDaemon::Request &){
+        return FakeDaemon::jsonResponse(200, *reply);
+    });
+
+    auto model = new ContainerListModel(this);
+    model->setConfiguration(m_config);
+    QVERIFY(model->load(AbstractBaseModel::LoadSync));
+    QCOMPARE(model->rowCount(), 3);
+
+    QSignalSpy resetSpy(model, &QAbstractItemModel::modelReset);
+    QSignalSpy removedSpy(model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy insertedSpy(model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy changedSpy(model, &QAbstractItemModel::dataChanged);
+
+    // nothing has changed
+    QVERIFY(model->refresh(AbstractBaseModel::LoadSync));
+    QCOMPARE(removedSpy.count(), 0);
+    QCOMPARE(insertedSpy.count(), 0);
+    QCOMPARE(changedSpy.count(), 0);
+
+    // the lookup functions have to match the rows already while the changes are signalled
+    QVector<int> removedLookups, changedLookups, insertedLookups;
+    connect(model, &QAbstractItemModel::rowsRemoved, this, [model, &removedLookups](){
+        removedLookups << model->rowForId(QStringLiteral("b2")) << model->rowForId(QStringLiteral("c3"));
+    });
+    connect(model, &QAbstractItemModel::dataChanged, this, [model, &changedLookups](){
+        changedLookups << model->rowForName(QStringLiteral("drei"));
+    });
+    connect(model, &QAbstractItemModel::rowsInserted, this, [model, &insertedLookups](){
+        insertedLookups << model->rowForId(QStringLiteral("d4"));
+    });
+
+    // b2 has been removed, c3 has exited and d4 is new
+    *reply = QByteArrayLiteral(R"([{"Id":"a1","Names":["/one"],"State":"running"},{"Id":"c3","Names":["/drei"],"State":"exited"},{"Id":"d4","Names":["/four"],"State":"created"}])");
+    QVERIFY(model->refresh(AbstractBaseModel::LoadSync));
+    QCOMPARE(removedLookups, QVector<int>({-1, 1}));
+    QCOMPARE(changedLookups, QVector<int>({1}));
+    QCOMPARE(insertedLookups, QVector<int>({2}));
+    QCOMPARE(removedSpy.count(), 1);
+    QCOMPARE(removedSpy.at(0).at(1).toInt(), 1);
+    QCOMPARE(removedSpy.at(0).at(2).toInt(), 1);
+    QCOMPARE(changedSpy.count(), 1);
+    QCOMPARE(changedSpy.at(0).at(0).value<QModelIndex>().row(), 1);
+    QCOMPARE(changedSpy.at(0).at(2).value<QVector<int>>(), QVector<int>({ContainerListModel::NamesRole, ContainerListModel::StateRole}));
+    QCOMPARE(insertedSpy.count(), 1);
+    QCOMPARE(insertedSpy.at(0).at(1).toInt(), 2);
+    QCOMPARE(insertedSpy.at(0).at(2).toInt(), 2);
+    QCOMPARE(resetSpy.count(), 0);
+
+    QCOMPARE(model->rowCount(), 3);
+    QCOMPARE(model->data(model->index(1, 0), ContainerListModel::StateRole).toString(), QStringLiteral("exited"));
+    QCOMPARE(model->rowForId(QStringLiteral("c3")), 1);
+    QCOMPARE(model->rowForName(QStringLiteral("four")), 2);
+    QCOMPARE(model->rowForName(QStringLiteral("three")), -1);
+    QVERIFY(!model->contains(QStringLiteral("b2")));
+
+    // label sets that are not used anymore are dropped without mixing up the remaining ones
+    for (int i = 0; i < 10; ++i) {
+        *reply = QByteArrayLiteral(R"([{"Id":"a1","Names":["/one"],"State":"running","Labels":{"shared":"yes"}},{"Id":"c3","Names":["/drei"],"State":"exited","Labels":{"run":")") + QByteArray::number(i) + QByteArrayLiteral(R"("}}])");
+        QVERIFY(model->refresh(AbstractBaseModel::LoadSync));
+        QCOMPARE(model->data(model->index(0, 0), ContainerListModel::LabelsRole).value<QMap<QString,QString>>(), (QMap<QString,QString>{{QStringLiteral("shared"), QStringLiteral("yes")}}));
+        QCOMPARE(model->data(model->index(1, 0), ContainerListModel::LabelsRole).value<QMap<QString,QString>>(), (QMap<QString,QString>{{QStringLiteral("run"), QString::number(i)}}));
+    }
+    QCOMPARE(model->rowCount(), 2);
+    QCOMPARE(model->rowForName(QStringLiteral("drei")), 1);
+
+    m_daemon->setHandler("GET", "/containers/json", original);
+}
+
+void DaemonModelsTest::testContainerListModelAsync()
+{
+    auto model = new ContainerListModel(this);
+    model->setConfiguration(m_config);
+    QSignalSpy loadedSpy(model, &AbstractBaseModel::loaded);
+    QSignalSpy insertedSpy(model, &QAbstractItemModel::rowsInserted);
+    QVERIFY(model->load());
+    QVERIFY(model->isLoading());
+    QVERIFY(loadedSpy.wait());
+    QCOMPARE(loadedSpy.count(), 1);
+    QVERIFY(!model->isLoading());
+    // rows decoded on the worker thread are inserted at once
+    QCOMPARE(insertedSpy.count(), 1);
+    QCOMPARE(model->rowCount(), 2);
+    QCOMPARE(model->rowForName(QStringLiteral("coolName")), 1);
+
+    QVERIFY(model->refresh());
+    QVERIFY(loadedSpy.wait());
+    QCOMPARE(insertedSpy.count(), 1);
+    QCOMPARE(model->rowCount(), 2);
+}
+
+void DaemonModelsTest::testContainerListModelDecoder()
+{
+    const FakeDaemon::Handler original = m_daemon->handler("GET", "/containers/json");
+    auto reply = std::make_shared<QByteArray>(QByteArrayLiteral(R"([ {"Id":"a1","Names":["/caf\u00e9","/two"],"Image":"nginx","Created":1642700000,"Ports":[{"PrivatePort":80,"Type":"tcp"}],"Labels":null,"State":"running","Status":"Up 2 \"hours\"","SizeRw":12345,"HostConfig":{"NetworkMode":"default"}},
+        {"Id":"b2","Names":null,"Created":1.6427E9,"Labels":{"k\\ey":"v\/al","x":"y"},"State":"paused","Mounts":[]} ])"));
+    m_daemon->setHandler("GET", "/containers/json", [reply](const FakeDaemon::Request &){
+        return FakeDaemon::jsonResponse(200, *reply);
+    });
+
+    auto model = new ContainerListModel(this);
+    model->setConfiguration(m_config);
+    QVERIFY(model->load(AbstractBaseModel::LoadSync));
+    QCOMPARE(model->rowCount(), 2);
+    QCOMPARE(model->data(model->index(0, 0), ContainerListModel::NamesRole).toStringList(), QStringList({QStringLiteral("/caf") + QChar(0x00e9), QStringLiteral("/two")}));
+    QCOMPARE(model->data(model->index(0, 0), ContainerListModel::ImageRole).toString(), QStringLiteral("nginx"));
+    QCOMPARE(model->data(model->index(0, 0), ContainerListModel::StatusRole).toString(), QStringLiteral("Up 2 \"hours\""));
+    QCOMPARE(model->data(model->index(0, 0), ContainerListModel::CreatedRole).toDateTime().toMSecsSinceEpoch(), Q_INT64_C(1642700000000));
+    QCOMPARE(model->data(model->index(0, 0), ContainerListModel::SizeRwRole).value<quint64>(), Q_UINT64_C(12345));
+    QVERIFY(model->data(model->index(0, 0), ContainerListModel::LabelsRole).value<QMap<QString,QString>>().isEmpty());
+    QVERIFY(model->data(model->index(1, 0), ContainerListModel::NamesRole).toStringList().isEmpty());
+    QCOMPARE(model->data(model->index(1, 0), ContainerListModel::CreatedRole).toDateTime().toMSecsSinceEpoch(), Q_INT64_C(1642700000000));
+    QCOMPARE(model->data(model->index(1, 0), ContainerListModel::StateRole).toString(), QStringLiteral("paused"));
+    const auto labels = model->data(model->index(1, 0), ContainerListModel::LabelsRole).value<QMap<QString,QString>>();
+    QCOMPARE(labels.size(), 2);
+    QCOMPARE(labels.value(QStringLiteral("k\\ey")), QStringLiteral("v/al"));
+    QCOMPARE(model->rowForName(QStringLiteral("caf") + QChar(0x00e9)), 0);
+
+    // only the active roles and the data needed for lookups are decoded
+    model->setActiveRoles({ContainerListModel::StateRole});
+    QVERIFY(model->load(AbstractBaseModel::LoadSync));
+    QCOMPARE(model->rowCount(), 2);
+    QCOMPARE(model->data(model->index(1, 0), ContainerListModel::StateRole).toString(), QStringLiteral("paused"));
+    QVERIFY(model->data(model->index(0, 0), ContainerListModel::StatusRole).toString().isEmpty());
+    QVERIFY(model->data(model->index(1, 0), ContainerListModel::LabelsRole).value<QMap<QString,QString>>().isEmpty());
+    QCOMPARE(model->data(model->index(0, 0), ContainerListModel::SizeRwRole).value<quint64>(), Q_UINT64_C(0));
+    QCOMPARE(model->data(model->index(0, 0), ContainerListModel::ImageRole).toString(), QStringLiteral("nginx"));
+    QCOMPARE(model->rowForName(QStringLiteral("two")), 0);
+    model->setActiveRoles(QVector<int>());
+
+    // invalid data fails the load instead of showing partial data
+    *reply = QByteArrayLiteral(R"([{"Id":"a1","Names":["/one"]},{"Id":}])");
+    QVERIFY(!model->load(AbstractBaseModel::LoadSync));
+    QCOMPARE(model->error(), static_cast<int>(Schauer::JsonParseError));
+    QCOMPARE(model->rowCount(), 0);
+
+    // a backslash at the end of the data must not make the decoder read past it
+    *reply = QByteArrayLiteral(R"([{"Id":"a1\)");
+    QVERIFY(!model->load(AbstractBaseModel::LoadSync));
+    QCOMPARE(model->error(), static_cast<int>(Schauer::JsonParseError));
+
+    m_daemon->setHandler("GET", "/containers/json", original);
+}
+
+void DaemonModelsTest::testContainerListModelCache()
+{
+    auto conf = m_daemon->createConfig(this);
+    conf->setResponseCacheTimeToLive(60000);
+
+    auto model = new ContainerListModel(this);
+    model->setConfiguration(conf);
+
+    // the raw reply decoded by the model is cached
+    const int requests = m_daemon->requests().size();
+    QVERIFY(model->load(AbstractBaseModel::LoadSync));
+    QVERIFY(model->load(AbstractBaseModel::LoadSync));
+    QCOMPARE(m_daemon->requests().size(), requests + 1);
+    QCOMPARE(model->rowCount(), 2);
+    QCOMPARE(model->rowForName(QStringLiteral("coolName")), 1);
+
+    // jobs with the same request share the entry
+    auto list = new ListContainersJob(this);
+    list->setAutoDelete(false);
+    list->setConfiguration(conf);
+    QSignalSpy itemSpy(list, &Job::itemReceived);
+    QVERIFY2(list->exec(), qUtf8Printable(list->errorString()));
+    QCOMPARE(m_daemon->requests().size(), requests + 1);
+    QCOMPARE(itemSpy.count(), 2);
+    QCOMPARE(list->containers().size(), 2);
+}
+
+QTEST_MAIN(DaemonModelsTest)
+
+#include "testdaemonmodels.moc"
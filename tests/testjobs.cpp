@@ -5,14 +5,28 @@
 
 #include <QTest>
 #include <QSignalSpy>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
 #include <Schauer/ListImagesJob>
 #include <Schauer/ListContainersJob>
 #include <Schauer/CreateContainerJob>
+#include <Schauer/ContainerConfig>
+#include <Schauer/CreateAndStartContainerJob>
 #include <Schauer/StartContainerJob>
 #include <Schauer/StopContainerJob>
 #include <Schauer/RemoveContainerJob>
 #include <Schauer/CreateExecInstanceJob>
 #include <Schauer/StartExecInstanceJob>
+#include <Schauer/RunCommandJob>
+#include <Schauer/EventsJob>
+#include <Schauer/ContainerStatsJob>
+#include <Schauer/JobQueue>
+#include <Schauer/WaitContainerJob>
+#include <Schauer/ContainerPool>
+#include <Schauer/ContainerLogsJob>
+#include <Schauer/Filters>
+#include <Schauer/StringPool>
 #include "testconfig.h"
 
 using namespace Schauer;
@@ -31,6 +45,9 @@ private Q_SLOTS:
     void testSetConfiguration();
     void testMissingConfiguration();
     void testMissingHost();
+    void testFilters();
+    void testStringPool();
+    void testContainerConfig();
     void testListImagesJob();
     void testListContainersJob();
     void testCreateContainerJob();
@@ -39,6 +56,14 @@ private Q_SLOTS:
     void testRemoveContainerJob();
     void testCreateExecInstanceJob();
     void testStartExecInstanceJob();
+    void testRunCommandJob();
+    void testEventsJob();
+    void testContainerStatsJob();
+    void testJobQueue();
+    void testCreateAndStartContainerJob();
+    void testWaitContainerJob();
+    void testContainerPool();
+    void testContainerLogsJob();
 
     void cleanupTestCase() {}
 };
@@ -72,11 +97,142 @@ void JobsTest::testMissingHost()
     QCOMPARE(job->error(), static_cast<int>(Schauer::MissingHost));
 }
 
+void JobsTest::testFilters()
+{
+    Filters filters;
+    QVERIFY(filters.isEmpty()); // default value
+    QVERIFY(filters.toJson().isEmpty());
+
+    filters.label(QStringLiteral("com.example.owner"), QStringLiteral("tests"))
+           .label(QStringLiteral("com.example.temp"))
+           .status(Filters::Running)
+           .status(Filters::Running)
+           .status(Filters::Exited)
+           .name(QStringLiteral("web"))
+           .ancestor(QStringLiteral("nginx"));
+    QCOMPARE(filters.value(QStringLiteral("label")), QStringList({QStringLiteral("com.example.owner=tests"), QStringLiteral("com.example.temp")}));
+    QCOMPARE(filters.value(QStringLiteral("status")), QStringList({QStringLiteral("running"), QStringLiteral("exited")}));
+    QCOMPARE(filters.keys(), QStringList({QStringLiteral("ancestor"), QStringLiteral("label"), QStringLiteral("name"), QStringLiteral("status")}));
+    QCOMPARE(filters.toJson(), QStringLiteral(R"({"ancestor":["nginx"],"label":["com.example.owner=tests","com.example.temp"],"name":["web"],"status":["running","exited"]})"));
+
+    Filters imgFilters;
+    imgFilters.dangling(true).dangling(false).reference(QStringLiteral("nginx:*")).before(QStringLiteral("a")).since(QStringLiteral("b"));
+    QCOMPARE(imgFilters.value(QStringLiteral("dangling")), QStringList({QStringLiteral("false")}));
+    QCOMPARE(imgFilters.value(QStringLiteral("reference")), QStringList({QStringLiteral("nginx:*")}));
+    QCOMPARE(imgFilters.value(QStringLiteral("before")), QStringList({QStringLiteral("a")}));
+    QCOMPARE(imgFilters.value(QStringLiteral("since")), QStringList({QStringLiteral("b")}));
+
+    const Filters fromMap(QMap<QString,QStringList>({{QStringLiteral("status"), {QStringLiteral("running"), QStringLiteral("exited")}}}));
+    Filters statusOnly = filters;
+    statusOnly.remove(QStringLiteral("ancestor"));
+    statusOnly.remove(QStringLiteral("label"));
+    statusOnly.remove(QStringLiteral("name"));
+    QVERIFY(statusOnly == fromMap);
+    QVERIFY(filters != fromMap);
+    QCOMPARE(fromMap.toMap().size(), 1);
+
+    filters.clear();
+    QVERIFY(filters.isEmpty());
+}
+
+void JobsTest::testStringPool()
+{
+    StringPool::resetStatistics();
+    QCOMPARE(StringPool::statistics().hits, Q_UINT64_C(0)); // default value
+
+    const QString first = StringPool::intern(QString::fromLatin1("nginx:latest"));
+    const QString second = StringPool::intern(QString::fromLatin1("nginx:latest"));
+    QCOMPARE(second, first);
+    QVERIFY(second.constData() == first.constData());
+
+    QStringList list({QString::fromLatin1("nginx:latest"), QString::fromLatin1("running")});
+    StringPool::intern(list);
+    QVERIFY(list.at(0).constData() == first.constData());
+
+    QMap<QString,QString> labels({{QString::fromLatin1("image"), QString::fromLatin1("nginx:latest")}});
+    StringPool::intern(labels);
+    QVERIFY(labels.first().constData() == first.constData());
+
+    QVERIFY(StringPool::intern(QString()).isNull());
+
+    const StringPool::Statistics stats = StringPool::statistics();
+    QCOMPARE(stats.hits, Q_UINT64_C(3));
+    QCOMPARE(stats.misses, Q_UINT64_C(3));
+    QCOMPARE(stats.hitRate(), 0.5);
+
+    // strings only referenced by the pool are removed
+    const int sizeBefore = stats.size;
+    list.clear();
+    labels.clear();
+    StringPool::squeeze();
+    QCOMPARE(StringPool::statistics().size, sizeBefore - 2);
+    QVERIFY(StringPool::intern(QString::fromLatin1("nginx:latest")).constData() == first.constData());
+}
+
+void JobsTest::testContainerConfig()
+{
+    ContainerConfig config;
+    config.image = QStringLiteral("nginx");
+    config.cmd << QStringLiteral("nginx") << QStringLiteral("-g") << QStringLiteral("daemon off;");
+    config.env << QStringLiteral("QUOTE=\"\\\n");
+    config.labels.insert(QStringLiteral("de.huessenbergnetz.test"), QStringLiteral("täst"));
+    config.exposedPorts << QStringLiteral("80/tcp");
+    config.tty = true;
+    config.hostConfig.portBindings.append({QStringLiteral("80/tcp"), QString(), 8080});
+    config.hostConfig.portBindings.append({QStringLiteral("443/tcp"), QStringLiteral("127.0.0.1"), 0});
+    config.hostConfig.portBindings.append({QStringLiteral("80/tcp"), QStringLiteral("::1"), 8081});
+    config.hostConfig.mounts.append({Mount::Tmpfs, QString(), QStringLiteral("/tmp"), false});
+    config.hostConfig.mounts.append({Mount::Bind, QStringLiteral("/srv/www"), QStringLiteral("/usr/share/nginx/html"), true});
+    config.hostConfig.restartPolicy = QStringLiteral("always");
+    config.hostConfig.memory = Q_INT64_C(5368709120);
+
+    const QByteArray json = config.toJson();
+    QJsonParseError error;
+    const QJsonObject o = QJsonDocument::fromJson(json, &error).object();
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QCOMPARE(o.value(QStringLiteral("Image")).toString(), config.image);
+    QCOMPARE(o.value(QStringLiteral("Cmd")).toArray().size(), 3);
+    QCOMPARE(o.value(QStringLiteral("Cmd")).toArray().at(2).toString(), QStringLiteral("daemon off;"));
+    QCOMPARE(o.value(QStringLiteral("Env")).toArray().at(0).toString(), config.env.at(0));
+    QCOMPARE(o.value(QStringLiteral("Labels")).toObject().value(QStringLiteral("de.huessenbergnetz.test")).toString(), QStringLiteral("täst"));
+    QVERIFY(o.value(QStringLiteral("ExposedPorts")).toObject().value(QStringLiteral("80/tcp")).isObject());
+    QVERIFY(o.value(QStringLiteral("Tty")).toBool());
+    // default values are not written
+    QVERIFY(!o.contains(QStringLiteral("Entrypoint")));
+    QVERIFY(!o.contains(QStringLiteral("OpenStdin")));
+
+    const QJsonObject hc = o.value(QStringLiteral("HostConfig")).toObject();
+    const QJsonObject pb = hc.value(QStringLiteral("PortBindings")).toObject();
+    QCOMPARE(pb.size(), 2);
+    const QJsonArray http = pb.value(QStringLiteral("80/tcp")).toArray();
+    QCOMPARE(http.size(), 2);
+    QCOMPARE(http.at(0).toObject().value(QStringLiteral("HostPort")).toString(), QStringLiteral("8080"));
+    QCOMPARE(http.at(1).toObject().value(QStringLiteral("HostIp")).toString(), QStringLiteral("::1"));
+    QCOMPARE(pb.value(QStringLiteral("443/tcp")).toArray().at(0).toObject().value(QStringLiteral("HostPort")).toString(), QString());
+
+    const QJsonArray mounts = hc.value(QStringLiteral("Mounts")).toArray();
+    QCOMPARE(mounts.size(), 2);
+    QCOMPARE(mounts.at(0).toObject().value(QStringLiteral("Type")).toString(), QStringLiteral("tmpfs"));
+    QVERIFY(!mounts.at(0).toObject().contains(QStringLiteral("Source")));
+    QCOMPARE(mounts.at(1).toObject().value(QStringLiteral("Type")).toString(), QStringLiteral("bind"));
+    QVERIFY(mounts.at(1).toObject().value(QStringLiteral("ReadOnly")).toBool());
+
+    QCOMPARE(hc.value(QStringLiteral("RestartPolicy")).toObject().value(QStringLiteral("Name")).toString(), QStringLiteral("always"));
+    QCOMPARE(hc.value(QStringLiteral("Memory")).toDouble(), 5368709120.0);
+    QVERIFY(!hc.contains(QStringLiteral("NetworkMode")));
+
+    // serializing twice gives the same payload
+    QCOMPARE(config.toJson(), json);
+}
+
 void JobsTest::testListImagesJob()
 {
     auto job = new ListImagesJob(this);
     job->setAutoDelete(false);
 
+    QVERIFY(job->images().empty()); // default value
+
     // test showAll property
     QSignalSpy showAllSpy(job, &ListImagesJob::showAllChanged);
     QCOMPARE(job->showAll(), false); // default value
@@ -94,6 +250,18 @@ void JobsTest::testListImagesJob()
     const QVariantList showDigestsSpyArgs = showDigestsSpy.takeFirst();
     QCOMPARE(showDigestsSpyArgs.at(0).toBool(), true);
     QCOMPARE(job->showDigests(), true);
+
+    // test filters property
+    QSignalSpy filtersSpy(job, &ListImagesJob::filtersChanged);
+    QVERIFY(job->filters().isEmpty()); // default value
+    job->setFilters(Filters().dangling(true));
+    job->setFilters(Filters().dangling(true));
+    QCOMPARE(filtersSpy.count(), 1);
+    job->addFilter(QStringLiteral("reference"), QStringLiteral("nginx"));
+    job->addFilter(QStringLiteral("reference"), QStringLiteral("nginx"));
+    QCOMPARE(filtersSpy.count(), 2);
+    QCOMPARE(filtersSpy.at(1).at(0).value<Filters>(), Filters().dangling(true).reference(QStringLiteral("nginx")));
+    QCOMPARE(job->filters().value(QStringLiteral("reference")), QStringList({QStringLiteral("nginx")}));
 }
 
 void JobsTest::testListContainersJob()
@@ -101,6 +269,8 @@ void JobsTest::testListContainersJob()
     auto job = new ListContainersJob(this);
     job->setAutoDelete(false);
 
+    QVERIFY(job->containers().empty()); // default value
+
     // test limit property
     const int newLimit = 25;
     QSignalSpy limitChangedSpy(job, &ListContainersJob::limitChanged);
@@ -128,6 +298,18 @@ void JobsTest::testListContainersJob()
     const QVariantList showSizeArgs = showSizeSpy.takeFirst();
     QCOMPARE(showSizeArgs.at(0).toBool(), true);
     QCOMPARE(job->showSize(), true);
+
+    // test filters property
+    QSignalSpy filtersSpy(job, &ListContainersJob::filtersChanged);
+    QVERIFY(job->filters().isEmpty()); // default value
+    const Filters newFilters = Filters().label(QStringLiteral("com.example.owner")).status(Filters::Paused);
+    job->setFilters(newFilters);
+    QCOMPARE(filtersSpy.count(), 1);
+    QCOMPARE(filtersSpy.takeFirst().at(0).value<Filters>(), newFilters);
+    QCOMPARE(job->filters(), newFilters);
+    job->setFilters(Filters());
+    QCOMPARE(filtersSpy.count(), 1);
+    QVERIFY(job->filters().isEmpty());
 }
 
 void JobsTest::testCreateContainerJob()
@@ -169,6 +351,21 @@ void JobsTest::testCreateContainerJob()
     QVERIFY(!job->exec());
     QCOMPARE(job->error(), static_cast<int>(Schauer::InvalidInput));
 
+    // test serializedConfig property
+    ContainerConfig config;
+    config.image = QStringLiteral("hello-world");
+    const QByteArray newSerializedConfig = config.toJson();
+    QSignalSpy scSpy(job, &CreateContainerJob::serializedConfigChanged);
+    QVERIFY(job->serializedConfig().isEmpty()); // default value
+    job->setSerializedConfig(newSerializedConfig);
+    QCOMPARE(scSpy.count(), 1);
+    QCOMPARE(scSpy.at(0).at(0).toByteArray(), newSerializedConfig);
+    QCOMPARE(job->serializedConfig(), newSerializedConfig);
+    config.image = QStringLiteral("nginx");
+    job->setSerializedConfig(config);
+    QCOMPARE(scSpy.count(), 2);
+    QCOMPARE(job->serializedConfig(), config.toJson());
+
     // check invalid container name
     const QString invalidContainerName = QStringLiteral("//_kacke");
     job->setName(invalidContainerName);
@@ -305,6 +502,8 @@ void JobsTest::testCreateExecInstanceJob()
     job->setConfiguration(new TestConfig(this));
     job->setAutoDelete(false);
 
+    QVERIFY(job->execId().isEmpty()); // default value
+
     // test missing id
     QVERIFY(!job->exec());
     QCOMPARE(job->error(), static_cast<int>(Schauer::InvalidInput));
@@ -488,6 +687,514 @@ void JobsTest::testStartExecInstanceJob()
     }
 }
 
+void JobsTest::testRunCommandJob()
+{
+    auto job = new RunCommandJob(this);
+    job->setConfiguration(new TestConfig(this));
+    job->setAutoDelete(false);
+
+    // test missing id
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::InvalidInput));
+
+    // test id property
+    {
+        QSignalSpy spy(job, &RunCommandJob::idChanged);
+        QVERIFY(job->id().isEmpty()); // default value
+        job->setId(QStringLiteral("new-id"));
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toString(), QStringLiteral("new-id"));
+        QCOMPARE(job->id(), QStringLiteral("new-id"));
+    }
+
+    // test missing cmd
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::InvalidInput));
+
+    // test cmd property
+    {
+        QSignalSpy spy(job, &RunCommandJob::cmdChanged);
+        QVERIFY(job->cmd().empty()); // default value
+        const QStringList cmd({QStringLiteral("ls"), QStringLiteral("-l")});
+        job->setCmd(cmd);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toStringList(), cmd);
+        QCOMPARE(job->cmd(), cmd);
+    }
+
+    // test env property
+    {
+        QSignalSpy spy(job, &RunCommandJob::envChanged);
+        QVERIFY(job->env().empty()); // default value
+        const QStringList env({QStringLiteral("FOO=bar")});
+        job->setEnv(env);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toStringList(), env);
+        QCOMPARE(job->env(), env);
+    }
+
+    // test user property
+    {
+        QSignalSpy spy(job, &RunCommandJob::userChanged);
+        QVERIFY(job->user().isEmpty()); // default value
+        job->setUser(QStringLiteral("www-data"));
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toString(), QStringLiteral("www-data"));
+        QCOMPARE(job->user(), QStringLiteral("www-data"));
+    }
+
+    // test workingDir property
+    {
+        QSignalSpy spy(job, &RunCommandJob::workingDirChanged);
+        QVERIFY(job->workingDir().isEmpty()); // default value
+        job->setWorkingDir(QStringLiteral("/my/working/dir"));
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toString(), QStringLiteral("/my/working/dir"));
+        QCOMPARE(job->workingDir(), QStringLiteral("/my/working/dir"));
+    }
+
+    // test privileged property
+    {
+        QSignalSpy spy(job, &RunCommandJob::privilegedChanged);
+        QVERIFY(!job->privileged()); // default value
+        job->setPrivileged(true);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toBool(), true);
+        QCOMPARE(job->privileged(), true);
+    }
+
+    // test tty property
+    {
+        QSignalSpy spy(job, &RunCommandJob::ttyChanged);
+        QVERIFY(!job->tty()); // default value
+        job->setTty(true);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toBool(), true);
+        QCOMPARE(job->tty(), true);
+    }
+
+    // default results
+    QCOMPARE(job->exitCode(), -1);
+    QVERIFY(job->execId().isEmpty());
+}
+
+void JobsTest::testEventsJob()
+{
+    auto job = new EventsJob(this);
+    job->setConfiguration(new TestConfig(this));
+    job->setAutoDelete(false);
+
+    // test since property
+    {
+        QSignalSpy spy(job, &EventsJob::sinceChanged);
+        QVERIFY(!job->since().isValid()); // default value
+        const QDateTime since = QDateTime::fromMSecsSinceEpoch(1640995200000);
+        job->setSince(since);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toDateTime(), since);
+        QCOMPARE(job->since(), since);
+    }
+
+    // test until property
+    {
+        QSignalSpy spy(job, &EventsJob::untilChanged);
+        QVERIFY(!job->until().isValid()); // default value
+        const QDateTime until = QDateTime::fromMSecsSinceEpoch(1641081600000);
+        job->setUntil(until);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toDateTime(), until);
+        QCOMPARE(job->until(), until);
+    }
+
+    // test autoReconnect property
+    {
+        QSignalSpy spy(job, &EventsJob::autoReconnectChanged);
+        QVERIFY(job->autoReconnect()); // default value
+        job->setAutoReconnect(false);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toBool(), false);
+        QCOMPARE(job->autoReconnect(), false);
+    }
+
+    // test filters property
+    {
+        QSignalSpy spy(job, &EventsJob::filtersChanged);
+        QVERIFY(job->filters().empty()); // default value
+        job->addFilter(QStringLiteral("type"), QStringLiteral("container"));
+        job->addFilter(QStringLiteral("type"), QStringLiteral("container"));
+        job->addFilter(QStringLiteral("event"), QStringLiteral("start"));
+        QCOMPARE(spy.count(), 2);
+        QCOMPARE(job->filters().value(QStringLiteral("type")), QStringList({QStringLiteral("container")}));
+        QCOMPARE(job->filters().value(QStringLiteral("event")), QStringList({QStringLiteral("start")}));
+        job->setFilters(QMap<QString,QStringList>());
+        job->setFilters(QMap<QString,QStringList>());
+        QCOMPARE(spy.count(), 3);
+        QVERIFY(spy.at(2).at(0).value<Filters>().isEmpty());
+        QVERIFY(job->filters().empty());
+    }
+
+    QCOMPARE(job->lastEventTime(), Q_INT64_C(0));
+    QCOMPARE(Event::typeFromString(QStringLiteral("network")), Event::Network);
+    QCOMPARE(Event::typeFromString(QStringLiteral("foo")), Event::Unknown);
+}
+
+void JobsTest::testContainerStatsJob()
+{
+    auto job = new ContainerStatsJob(this);
+    job->setConfiguration(new TestConfig(this));
+    job->setAutoDelete(false);
+
+    // test missing id
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::InvalidInput));
+
+    // test id property
+    {
+        QSignalSpy spy(job, &ContainerStatsJob::idChanged);
+        QVERIFY(job->id().isEmpty()); // default value
+        job->setId(QStringLiteral("new-id"));
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toString(), QStringLiteral("new-id"));
+        QCOMPARE(job->id(), QStringLiteral("new-id"));
+    }
+
+    // test stream property
+    {
+        QSignalSpy spy(job, &ContainerStatsJob::streamChanged);
+        QVERIFY(job->stream()); // default value
+        job->setStream(false);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toBool(), false);
+        QCOMPARE(job->stream(), false);
+    }
+
+    // test ContainerStats calculations
+    {
+        ContainerStats stats;
+        QCOMPARE(stats.cpuPercent(), 0.0);
+        QCOMPARE(stats.memoryPercent(), 0.0);
+        stats.cpuTotalUsage = 300;
+        stats.preCpuTotalUsage = 100;
+        stats.systemCpuUsage = 2000;
+        stats.preSystemCpuUsage = 1000;
+        stats.onlineCpus = 2;
+        stats.memoryUsage = 256;
+        stats.memoryLimit = 1024;
+        QCOMPARE(stats.cpuDelta(), Q_UINT64_C(200));
+        QCOMPARE(stats.systemCpuDelta(), Q_UINT64_C(1000));
+        QCOMPARE(stats.cpuPercent(), 40.0);
+        QCOMPARE(stats.memoryPercent(), 25.0);
+    }
+}
+
+void JobsTest::testJobQueue()
+{
+    auto queue = new JobQueue(this);
+
+    // test maxRunningJobs property
+    {
+        QSignalSpy spy(queue, &JobQueue::maxRunningJobsChanged);
+        QCOMPARE(queue->maxRunningJobs(), 8); // default value
+        queue->setMaxRunningJobs(1);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toInt(), 1);
+        QCOMPARE(queue->maxRunningJobs(), 1);
+    }
+
+    // test maxRunningJobsPerConfiguration property
+    {
+        QSignalSpy spy(queue, &JobQueue::maxRunningJobsPerConfigurationChanged);
+        QCOMPARE(queue->maxRunningJobsPerConfiguration(), 0); // default value
+        queue->setMaxRunningJobsPerConfiguration(2);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toInt(), 2);
+        QCOMPARE(queue->maxRunningJobsPerConfiguration(), 2);
+    }
+
+    QCOMPARE(queue->queueDepth(), 0);
+    QCOMPARE(queue->runningJobs(), 0);
+    QCOMPARE(queue->averageWaitTime(), Q_INT64_C(0));
+
+    // killing a waiting job removes it from the queue
+    auto config = new TestConfig(this);
+    auto running = new ListImagesJob(this);
+    running->setConfiguration(config);
+    auto waiting = new ListImagesJob(this);
+    waiting->setConfiguration(config);
+    waiting->setAutoDelete(false);
+
+    QSignalSpy depthSpy(queue, &JobQueue::queueDepthChanged);
+    queue->enqueue(running);
+    queue->enqueue(waiting, JobQueue::Bulk);
+    QCOMPARE(queue->runningJobs(), 1);
+    QCOMPARE(queue->queueDepth(), 1);
+    QCOMPARE(queue->queueDepth(JobQueue::Bulk), 1);
+
+    QVERIFY(waiting->kill(SJob::EmitResult));
+    QCOMPARE(queue->queueDepth(), 0);
+    QCOMPARE(depthSpy.count(), 2);
+    QCOMPARE(depthSpy.last().at(0).toInt(), 0);
+}
+
+void JobsTest::testCreateAndStartContainerJob()
+{
+    auto job = new CreateAndStartContainerJob(this);
+    job->setConfiguration(new TestConfig(this));
+    job->setAutoDelete(false);
+
+    // test missing image
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::InvalidInput));
+
+    // test name property
+    {
+        QSignalSpy spy(job, &CreateAndStartContainerJob::nameChanged);
+        QVERIFY(job->name().isEmpty()); // default value
+        job->setName(QStringLiteral("in valid"));
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toString(), QStringLiteral("in valid"));
+        QCOMPARE(job->name(), QStringLiteral("in valid"));
+    }
+
+    // test containerConfig property
+    {
+        QSignalSpy spy(job, &CreateAndStartContainerJob::containerConfigChanged);
+        QVERIFY(job->containerConfig().empty()); // default value
+        const QVariantHash config({{QStringLiteral("Image"), QStringLiteral("nginx")}});
+        job->setContainerConfig(config);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toHash(), config);
+        QCOMPARE(job->containerConfig(), config);
+    }
+
+    // test invalid name
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::InvalidInput));
+
+    // test waitUntilRunning property
+    {
+        QSignalSpy spy(job, &CreateAndStartContainerJob::waitUntilRunningChanged);
+        QVERIFY(!job->waitUntilRunning()); // default value
+        job->setWaitUntilRunning(true);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toBool(), true);
+        QCOMPARE(job->waitUntilRunning(), true);
+    }
+
+    // test serializedConfig property
+    {
+        QSignalSpy spy(job, &CreateAndStartContainerJob::serializedConfigChanged);
+        QVERIFY(job->serializedConfig().isEmpty()); // default value
+        ContainerConfig config;
+        config.image = QStringLiteral("nginx");
+        job->setSerializedConfig(config);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toByteArray(), config.toJson());
+        QCOMPARE(job->serializedConfig(), config.toJson());
+    }
+
+    // test removeOnFailure property
+    {
+        QSignalSpy spy(job, &CreateAndStartContainerJob::removeOnFailureChanged);
+        QVERIFY(job->removeOnFailure()); // default value
+        job->setRemoveOnFailure(false);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toBool(), false);
+        QCOMPARE(job->removeOnFailure(), false);
+    }
+
+    QVERIFY(job->containerId().isEmpty());
+}
+
+void JobsTest::testWaitContainerJob()
+{
+    auto job = new WaitContainerJob(this);
+    job->setConfiguration(new TestConfig(this));
+    job->setAutoDelete(false);
+
+    // test missing id
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::InvalidInput));
+
+    // test id property
+    {
+        QSignalSpy spy(job, &WaitContainerJob::idChanged);
+        QVERIFY(job->id().isEmpty()); // default value
+        job->setId(QStringLiteral("new-id"));
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toString(), QStringLiteral("new-id"));
+        QCOMPARE(job->id(), QStringLiteral("new-id"));
+    }
+
+    // test condition property
+    {
+        QSignalSpy spy(job, &WaitContainerJob::conditionChanged);
+        QCOMPARE(job->condition(), WaitContainerJob::NotRunning); // default value
+        job->setCondition(WaitContainerJob::Removed);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).value<WaitContainerJob::Condition>(), WaitContainerJob::Removed);
+        QCOMPARE(job->condition(), WaitContainerJob::Removed);
+    }
+
+    QCOMPARE(job->exitStatus().statusCode, Q_INT64_C(-1));
+}
+
+void JobsTest::testContainerPool()
+{
+    auto pool = new ContainerPool(this);
+
+    // test size property
+    {
+        QSignalSpy spy(pool, &ContainerPool::sizeChanged);
+        QCOMPARE(pool->size(), 2); // default value
+        pool->setSize(4);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toInt(), 4);
+        QCOMPARE(pool->size(), 4);
+    }
+
+    // test maxConcurrentStarts property
+    {
+        QSignalSpy spy(pool, &ContainerPool::maxConcurrentStartsChanged);
+        QCOMPARE(pool->maxConcurrentStarts(), 2); // default value
+        pool->setMaxConcurrentStarts(1);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toInt(), 1);
+        QCOMPARE(pool->maxConcurrentStarts(), 1);
+    }
+
+    // test containerConfig property
+    {
+        QSignalSpy spy(pool, &ContainerPool::containerConfigChanged);
+        QVERIFY(pool->containerConfig().empty()); // default value
+        const QVariantHash config({{QStringLiteral("Image"), QStringLiteral("nginx")}});
+        pool->setContainerConfig(config);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toHash(), config);
+        QCOMPARE(pool->containerConfig(), config);
+    }
+
+    QCOMPARE(pool->readyCount(), 0);
+    QCOMPARE(pool->leasedCount(), 0);
+
+    // releasing a container that has not been leased does nothing
+    pool->release(QStringLiteral("not-leased"));
+    QCOMPARE(pool->leasedCount(), 0);
+}
+
+void JobsTest::testContainerLogsJob()
+{
+    auto job = new ContainerLogsJob(this);
+    job->setConfiguration(new TestConfig(this));
+    job->setAutoDelete(false);
+
+    // test missing id
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::InvalidInput));
+
+    // test id property
+    {
+        QSignalSpy spy(job, &ContainerLogsJob::idChanged);
+        QVERIFY(job->id().isEmpty()); // default value
+        job->setId(QStringLiteral("new-id"));
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toString(), QStringLiteral("new-id"));
+        QCOMPARE(job->id(), QStringLiteral("new-id"));
+    }
+
+    // test follow property
+    {
+        QSignalSpy spy(job, &ContainerLogsJob::followChanged);
+        QVERIFY(!job->follow()); // default value
+        job->setFollow(true);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toBool(), true);
+        QCOMPARE(job->follow(), true);
+    }
+
+    // test tail property
+    {
+        QSignalSpy spy(job, &ContainerLogsJob::tailChanged);
+        QCOMPARE(job->tail(), -1); // default value
+        job->setTail(100);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toInt(), 100);
+        QCOMPARE(job->tail(), 100);
+    }
+
+    // test since property
+    {
+        QSignalSpy spy(job, &ContainerLogsJob::sinceChanged);
+        QVERIFY(!job->since().isValid()); // default value
+        const QDateTime since = QDateTime::currentDateTimeUtc();
+        job->setSince(since);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toDateTime(), since);
+        QCOMPARE(job->since(), since);
+    }
+
+    // test until property
+    {
+        QSignalSpy spy(job, &ContainerLogsJob::untilChanged);
+        QVERIFY(!job->until().isValid()); // default value
+        const QDateTime until = QDateTime::currentDateTimeUtc();
+        job->setUntil(until);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toDateTime(), until);
+        QCOMPARE(job->until(), until);
+    }
+
+    // test timestamps property
+    {
+        QSignalSpy spy(job, &ContainerLogsJob::timestampsChanged);
+        QVERIFY(!job->timestamps()); // default value
+        job->setTimestamps(true);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toBool(), true);
+        QCOMPARE(job->timestamps(), true);
+    }
+
+    // test showStdout and showStderr properties
+    {
+        QSignalSpy stdoutSpy(job, &ContainerLogsJob::showStdoutChanged);
+        QSignalSpy stderrSpy(job, &ContainerLogsJob::showStderrChanged);
+        QVERIFY(job->showStdout()); // default value
+        QVERIFY(job->showStderr()); // default value
+        job->setShowStdout(false);
+        job->setShowStderr(false);
+        QCOMPARE(stdoutSpy.count(), 1);
+        QCOMPARE(stderrSpy.count(), 1);
+        QCOMPARE(job->showStdout(), false);
+        QCOMPARE(job->showStderr(), false);
+    }
+
+    // test no stream selected
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::InvalidInput));
+
+    // test tty property
+    {
+        QSignalSpy spy(job, &ContainerLogsJob::ttyChanged);
+        QVERIFY(!job->tty()); // default value
+        job->setTty(true);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toBool(), true);
+        QCOMPARE(job->tty(), true);
+    }
+
+    // test maxLineLength property
+    {
+        QSignalSpy spy(job, &ContainerLogsJob::maxLineLengthChanged);
+        QCOMPARE(job->maxLineLength(), 65536); // default value
+        job->setMaxLineLength(1024);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toInt(), 1024);
+        job->setMaxLineLength(0);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(job->maxLineLength(), 1024);
+    }
+}
+
 QTEST_MAIN(JobsTest)
 
 #include "testjobs.moc"
@@ -84,6 +84,19 @@ void ModelTest::testContainerListModel()
         QCOMPARE(spy.at(0).at(0).toBool(), true);
         QCOMPARE(model->showSize(), true);
     }
+
+    // test activeRoles property
+    {
+        QSignalSpy spy(model, &AbstractBaseModel::activeRolesChanged);
+        QVERIFY(model->activeRoles().empty()); // default value
+        const QVector<int> roles({ContainerListModel::NamesRole, ContainerListModel::StateRole});
+        model->setActiveRoles(roles);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).value<QVector<int>>(), roles);
+        QCOMPARE(model->activeRoles(), roles);
+        model->setActiveRoles(roles);
+        QCOMPARE(spy.count(), 1);
+    }
 }
 
 QTEST_MAIN(ModelTest)
@@ -0,0 +1,206 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <QTest>
+#include <QSignalSpy>
+#include <Schauer/GetVersionJob>
+#include <Schauer/ListContainersJob>
+#include <Schauer/JobQueue>
+#include <Schauer/ContainerPool>
+#include "testconfig.h"
+#include "fakedocker.h"
+
+using namespace Schauer;
+
+class PoolQueueTest : public QObject
+{
+    Q_OBJECT
+public:
+    explicit PoolQueueTest(QObject *parent = nullptr) : QObject(parent) {}
+
+    ~PoolQueueTest() override {}
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void testJobQueue();
+    void testContainerPool();
+    void testContainerPoolAsync();
+
+    void cleanupTestCase() {}
+
+private:
+    FakeDocker *m_daemon = nullptr;
+    TestConfig *m_config = nullptr;
+};
+
+void PoolQueueTest::initTestCase()
+{
+    m_daemon = new FakeDocker(this);
+    QVERIFY(m_daemon->listen());
+    m_config = m_daemon->createConfig(this);
+}
+
+void PoolQueueTest::testJobQueue()
+{
+    auto queue = new JobQueue(this);
+    queue->setMaxRunningJobs(2);
+    queue->setMaxRunningJobsPerConfiguration(-1);
+
+    QList<Job*> startOrder;
+    int maxRunning = 0;
+    int finished = 0;
+    connect(queue, &JobQueue::jobStarted, this, [&startOrder](Job *job, qint64 waitTime){
+        QVERIFY(waitTime >= 0);
+        startOrder.append(job);
+    });
+    connect(queue, &JobQueue::runningJobsChanged, this, [&maxRunning](int running){
+        maxRunning = qMax(maxRunning, running);
+    });
+
+    for (int i = 0; i < 4; ++i) {
+        auto job = new GetVersionJob(this);
+        job->setConfiguration(m_config);
+        connect(job, &Job::succeeded, this, [&finished](){ finished++; });
+        queue->enqueue(job, JobQueue::Bulk);
+    }
+
+    QCOMPARE(queue->runningJobs(), 2);
+    QCOMPARE(queue->queueDepth(), 2);
+    QCOMPARE(queue->queueDepth(JobQueue::Bulk), 2);
+
+    auto interactive = new ListContainersJob(this);
+    interactive->setConfiguration(m_config);
+    connect(interactive, &Job::succeeded, this, [&finished](){ finished++; });
+    queue->enqueue(interactive, JobQueue::Interactive);
+    QCOMPARE(queue->queueDepth(), 3);
+
+    QTRY_COMPARE(finished, 5);
+    QCOMPARE(maxRunning, 2);
+    QCOMPARE(startOrder.size(), 5);
+    // the interactive job is started with the first free slot
+    QCOMPARE(startOrder.at(2), static_cast<Job*>(interactive));
+    QCOMPARE(queue->queueDepth(), 0);
+    QTRY_COMPARE(queue->runningJobs(), 0);
+    QVERIFY(queue->maxWaitTime() >= queue->averageWaitTime());
+
+    // per configuration limit
+    auto conf = m_daemon->createConfig(this);
+    conf->setMaxConnectionsPerHost(1);
+    queue->setMaxRunningJobsPerConfiguration(0);
+
+    for (int i = 0; i < 2; ++i) {
+        auto job = new GetVersionJob(this);
+        job->setConfiguration(conf);
+        queue->enqueue(job);
+    }
+    auto other = new GetVersionJob(this);
+    other->setConfiguration(m_config);
+    queue->enqueue(other);
+
+    // the second job of conf has to wait, but does not block the job with the other configuration
+    QCOMPARE(queue->runningJobs(), 2);
+    QCOMPARE(queue->queueDepth(), 1);
+    QTRY_COMPARE(queue->runningJobs(), 0);
+}
+
+void PoolQueueTest::testContainerPool()
+{
+    auto pool = new ContainerPool(this);
+    pool->setConfiguration(m_config);
+    pool->setContainerConfig({{QStringLiteral("Image"), QStringLiteral("nginx")}});
+    pool->setSize(2);
+    pool->setMaxConcurrentStarts(1);
+
+    // nothing is created before the pool is filled
+    QCOMPARE(pool->lease(), QString());
+
+    QSignalSpy readySpy(pool, &ContainerPool::containerReady);
+    pool->fill();
+    QTRY_COMPARE(pool->readyCount(), 2);
+    QCOMPARE(readySpy.count(), 2);
+    QCOMPARE(readySpy.at(0).at(0).toString(), QStringLiteral("e90e34656806"));
+
+    // leasing takes a ready container and refills the pool
+    const QString id = pool->lease();
+    QCOMPARE(id, QStringLiteral("e90e34656806"));
+    QCOMPARE(pool->readyCount(), 1);
+    QCOMPARE(pool->leasedCount(), 1);
+    QTRY_COMPARE(pool->readyCount(), 2);
+
+    // releasing removes the container
+    pool->release(id);
+    QCOMPARE(pool->leasedCount(), 0);
+    QTRY_VERIFY(m_daemon->requests().last().method == QByteArrayLiteral("DELETE"));
+    QCOMPARE(m_daemon->requests().last().path, QByteArrayLiteral("/containers/e90e34656806"));
+
+    // releasing for reuse puts the container back into the pool
+    pool->setSize(1);
+    QCOMPARE(pool->readyCount(), 1);
+    const QString reused = pool->lease();
+    QCOMPARE(reused, QStringLiteral("e90e34656806"));
+    QTRY_COMPARE(pool->readyCount(), 1);
+    pool->setSize(2);
+    pool->release(reused, true);
+    QCOMPARE(pool->readyCount(), 2);
+
+    // a failing template pauses refilling
+    QSignalSpy failedSpy(pool, &ContainerPool::failed);
+    pool->setContainerConfig({{QStringLiteral("Image"), QStringLiteral("invalid")}});
+    QCOMPARE(pool->readyCount(), 0);
+    QTRY_COMPARE(failedSpy.count(), 1);
+    QCOMPARE(failedSpy.at(0).at(0).toInt(), static_cast<int>(Schauer::APIError));
+    QCOMPARE(pool->lease(100), QString());
+
+    pool->drain();
+    QCOMPARE(pool->readyCount(), 0);
+}
+
+void PoolQueueTest::testContainerPoolAsync()
+{
+    auto pool = new ContainerPool(this);
+    pool->setConfiguration(m_config);
+    pool->setContainerConfig({{QStringLiteral("Image"), QStringLiteral("nginx")}});
+    pool->setSize(1);
+    pool->setMaxConcurrentStarts(1);
+
+    // the request waits for the first container
+    QSignalSpy leasedSpy(pool, &ContainerPool::leased);
+    pool->requestLease();
+    QCOMPARE(pool->pendingLeases(), 1);
+    QCOMPARE(leasedSpy.count(), 0);
+    QTRY_COMPARE(leasedSpy.count(), 1);
+    QCOMPARE(leasedSpy.at(0).at(0).toString(), QStringLiteral("e90e34656806"));
+    QCOMPARE(pool->pendingLeases(), 0);
+    QCOMPARE(pool->leasedCount(), 1);
+
+    // a ready container is leased directly
+    QTRY_COMPARE(pool->readyCount(), 1);
+    pool->requestLease();
+    QCOMPARE(leasedSpy.count(), 2);
+    QCOMPARE(pool->readyCount(), 0);
+
+    // a reused container goes to the pending request
+    pool->requestLease();
+    QCOMPARE(pool->pendingLeases(), 1);
+    pool->release(leasedSpy.at(0).at(0).toString(), true);
+    QCOMPARE(leasedSpy.count(), 3);
+    QCOMPARE(pool->pendingLeases(), 0);
+
+    // a container that is still starting is removed after the pool has been destroyed
+    QTRY_COMPARE(pool->readyCount(), 1);
+    pool->requestLease();
+    QCOMPARE(leasedSpy.count(), 4);
+    const int requests = m_daemon->requests().size();
+    delete pool;
+    // create, start, inspect and remove
+    QTRY_COMPARE(m_daemon->requests().size(), requests + 4);
+    QCOMPARE(m_daemon->requests().last().method, QByteArrayLiteral("DELETE"));
+    QCOMPARE(m_daemon->requests().last().path, QByteArrayLiteral("/containers/e90e34656806"));
+}
+
+QTEST_MAIN(PoolQueueTest)
+
+#include "testpoolqueue.moc"
@@ -0,0 +1,377 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2021-2022 Matthias Fehring / www.huessenbergnetz.de
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <QTest>
+#include <QSignalSpy>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <Schauer/GetVersionJob>
+#include <Schauer/ListContainersJob>
+#include <Schauer/ListImagesJob>
+#include <Schauer/StartContainerJob>
+#include <Schauer/StartExecInstanceJob>
+#include <Schauer/RemoveContainerJob>
+#include "testconfig.h"
+#include "fakedocker.h"
+#include <memory>
+
+using namespace Schauer;
+
+class TransportTest : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TransportTest(QObject *parent = nullptr) : QObject(parent) {}
+
+    ~TransportTest() override {}
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void testListContainersJobChunked();
+    void testListJobWrongOutputType();
+    void testIncompleteJson();
+    void testApiError();
+    void testMissingSocket();
+    void testConnectionReuse();
+    void testQueuedRequests();
+    void testLongLivedRequests();
+    void testCoalescedRequests();
+    void testCoalescedRequestsLateJoin();
+    void testResponseCache();
+
+    void cleanupTestCase() {}
+
+private:
+    FakeDocker *m_daemon = nullptr;
+    TestConfig *m_config = nullptr;
+};
+
+void TransportTest::initTestCase()
+{
+    m_daemon = new FakeDocker(this);
+    QVERIFY(m_daemon->listen());
+    m_config = m_daemon->createConfig(this);
+}
+
+void TransportTest::testListContainersJobChunked()
+{
+    auto job = new ListContainersJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+    job->setShowAll(true);
+    const Filters filters = Filters().status(Filters::Running).status(Filters::Exited).label(QStringLiteral("version"), QStringLiteral("1.0+build"));
+    job->setFilters(filters);
+    QSignalSpy itemSpy(job, &Job::itemReceived);
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QCOMPARE(job->replyData().array().size(), 2);
+    QCOMPARE(itemSpy.count(), 2);
+    const QJsonObject second = itemSpy.at(1).at(0).toJsonObject();
+    QCOMPARE(second.value(QStringLiteral("Id")).toString(), QStringLiteral("9cd87474be90"));
+    QCOMPARE(second.value(QStringLiteral("Labels")).toObject().value(QStringLiteral("x")).toString(), QStringLiteral("}]\""));
+    const QVector<ContainerSummary> containers = job->containers();
+    QCOMPARE(containers.size(), 2);
+    QCOMPARE(containers.at(0).names, QStringList({QStringLiteral("/boring_feynman")}));
+    QCOMPARE(containers.at(0).state, QStringLiteral("running"));
+    QCOMPARE(containers.at(1).id, QStringLiteral("9cd87474be90"));
+    QCOMPARE(containers.at(1).labels.value(QStringLiteral("x")), QStringLiteral("}]\""));
+    // decoded while received, so only the document is left
+    QCOMPARE(QJsonDocument::fromJson(job->rawReplyData()).array().size(), 2);
+    QVERIFY(m_daemon->requests().last().query.contains("all=true"));
+    // a literal "+" would be decoded as space by the daemon
+    const QByteArray query = m_daemon->requests().last().query;
+    const int filtersIdx = query.indexOf("filters=");
+    QVERIFY(filtersIdx > -1);
+    const QByteArray encodedFilters = query.mid(filtersIdx + 8).split('&').first();
+    QVERIFY(encodedFilters.contains("%2B"));
+    QVERIFY(!encodedFilters.contains('+'));
+    QCOMPARE(QString::fromUtf8(QByteArray::fromPercentEncoding(encodedFilters)), filters.toJson());
+}
+
+void TransportTest::testListJobWrongOutputType()
+{
+    auto job = new ListImagesJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+    QSignalSpy itemSpy(job, &Job::itemReceived);
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::WrongOutputType));
+    QCOMPARE(itemSpy.count(), 0);
+}
+
+void TransportTest::testIncompleteJson()
+{
+    const FakeDaemon::Handler original = m_daemon->handler("GET", "/version");
+    // shared, so that the handler stays valid if the test fails early
+    auto body = std::make_shared<QByteArray>(QByteArrayLiteral(R"({"Version":)"));
+    m_daemon->setHandler("GET", "/version", [body](const FakeDaemon::Request &){
+        return FakeDaemon::jsonResponse(200, *body);
+    });
+
+    auto job = new GetVersionJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+
+    // detected by the pre-scan without parsing the reply
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::JsonParseError));
+
+    *body = QByteArrayLiteral(" \r\n ");
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::EmptyJson));
+
+    *body = QByteArrayLiteral(R"(["20.10.12"])");
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::WrongOutputType));
+
+    *body = QByteArrayLiteral(" { } ");
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::EmptyJson));
+
+    // structurally complete, but invalid inside, only shows up when the reply is parsed
+    *body = QByteArrayLiteral(R"({"Version":20.10.12})");
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QVERIFY(job->replyData().isEmpty());
+    QVERIFY(job->versionInfo().version.isEmpty());
+
+    *body = QByteArrayLiteral(R"({"Version":"20.10.12"} )");
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+    QCOMPARE(job->rawReplyData(), *body);
+    QCOMPARE(job->versionInfo().version, QStringLiteral("20.10.12"));
+
+    m_daemon->setHandler("GET", "/version", original);
+}
+
+void TransportTest::testApiError()
+{
+    auto job = new StartContainerJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+    job->setId(QStringLiteral("unknown"));
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::APIError));
+    QCOMPARE(job->errorString(), QStringLiteral("No such container: unknown"));
+}
+
+void TransportTest::testMissingSocket()
+{
+    auto conf = new TestConfig(this);
+    conf->setSocketPath(m_daemon->socketPath() + QLatin1String(".missing"));
+    auto job = new GetVersionJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(conf);
+    QVERIFY(!job->exec());
+    QCOMPARE(job->error(), static_cast<int>(Schauer::NetworkError));
+}
+
+void TransportTest::testConnectionReuse()
+{
+    auto job = new GetVersionJob(this);
+    job->setAutoDelete(false);
+    job->setConfiguration(m_config);
+    QVERIFY2(job->exec(), qUtf8Printable(job->errorString()));
+
+    const int connections = m_daemon->connectionCount();
+
+    for (int i = 0; i < 3; ++i) {
+        auto j = new GetVersionJob(this);
+        j->setAutoDelete(false);
+        j->setConfiguration(m_config);
+        QVERIFY2(j->exec(), qUtf8Printable(j->errorString()));
+    }
+
+    QCOMPARE(m_daemon->connectionCount(), connections);
+}
+
+void TransportTest::testQueuedRequests()
+{
+    auto conf = m_daemon->createConfig(this);
+    conf->setMaxConnectionsPerHost(1);
+
+    const int connections = m_daemon->connectionCount();
+    int succeeded = 0;
+
+    for (int i = 0; i < 4; ++i) {
+        auto job = new ListContainersJob(this);
+        job->setConfiguration(conf);
+        // different queries, so the requests are not coalesced
+        job->setLimit(i + 1);
+        connect(job, &Job::succeeded, this, [&succeeded](){ succeeded++; });
+        job->start();
+    }
+
+    QTRY_COMPARE(succeeded, 4);
+    QVERIFY(m_daemon->connectionCount() <= connections + 1);
+}
+
+void TransportTest::testLongLivedRequests()
+{
+    m_daemon->setHandler("POST", "/exec/held/start", [](const FakeDaemon::Request &){
+        return FakeDaemon::openStreamResponse(QByteArrayLiteral("application/vnd.docker.multiplexed-stream"), QByteArray());
+    });
+
+    auto conf = m_daemon->createConfig(this);
+    conf->setMaxConnectionsPerHost(2);
+
+    // more attached execs than connections per host, they must not starve other requests
+    const int requests = m_daemon->requests().size();
+    QList<StartExecInstanceJob*> execs;
+    int finished = 0;
+    for (int i = 0; i < 4; ++i) {
+        auto exec = new StartExecInstanceJob(this);
+        exec->setAutoDelete(false);
+        exec->setConfiguration(conf);
+        exec->setId(QStringLiteral("held"));
+        exec->setDetach(false);
+        connect(exec, &SJob::finished, this, [&finished](){ finished++; });
+        exec->start();
+        execs.append(exec);
+    }
+    QTRY_COMPARE(m_daemon->requests().size(), requests + 4);
+
+    auto list = new ListContainersJob(this);
+    list->setAutoDelete(false);
+    list->setConfiguration(conf);
+    QVERIFY2(list->exec(), qUtf8Printable(list->errorString()));
+    QCOMPARE(list->replyData().array().size(), 2);
+    QCOMPARE(finished, 0);
+
+    for (StartExecInstanceJob *exec : qAsConst(execs)) {
+        exec->kill();
+    }
+}
+
+void TransportTest::testCoalescedRequests()
+{
+    QList<ListContainersJob*> jobs;
+    int succeeded = 0;
+
+    for (int i = 0; i < 3; ++i) {
+        auto job = new ListContainersJob(this);
+        job->setAutoDelete(false);
+        job->setConfiguration(m_config);
+        connect(job, &Job::succeeded, this, [&succeeded](){ succeeded++; });
+        jobs.append(job);
+    }
+
+    // the second job would differ in its query
+    jobs.at(1)->setShowAll(true);
+
+    const int requests = m_daemon->requests().size();
+    for (ListContainersJob *job : qAsConst(jobs)) {
+        job->start();
+    }
+
+    QTRY_COMPARE(succeeded, 3);
+    QCOMPARE(m_daemon->requests().size(), requests + 2);
+    for (ListContainersJob *job : qAsConst(jobs)) {
+        QCOMPARE(job->replyData().array().size(), 2);
+    }
+
+    // killing the job sending the request lets a waiting job send it itself
+    auto first = new GetVersionJob(this);
+    first->setAutoDelete(false);
+    first->setConfiguration(m_config);
+    auto second = new GetVersionJob(this);
+    second->setAutoDelete(false);
+    second->setConfiguration(m_config);
+    QSignalSpy secondSpy(second, &Job::succeeded);
+
+    first->start();
+    second->start();
+    // let both jobs set up their requests, the second one waits for the first one
+    QCoreApplication::processEvents();
+    QVERIFY(first->kill(SJob::EmitResult));
+    QTRY_COMPARE(secondSpy.count(), 1);
+    QCOMPARE(second->replyData().object().value(QStringLiteral("Version")).toString(), QStringLiteral("20.10.12"));
+}
+
+void TransportTest::testCoalescedRequestsLateJoin()
+{
+    const FakeDaemon::Handler original = m_daemon->handler("GET", "/containers/json");
+    m_daemon->setHandler("GET", "/containers/json", [](const FakeDaemon::Request &){
+        return FakeDaemon::openStreamResponse(QByteArrayLiteral("application/json"), QByteArrayLiteral(R"([{"Id":"8dfafdbc3a40"},)"));
+    });
+
+    auto first = new ListContainersJob(this);
+    first->setAutoDelete(false);
+    first->setConfiguration(m_config);
+    QSignalSpy itemSpy(first, &Job::itemReceived);
+
+    const int requests = m_daemon->requests().size();
+    first->start();
+    QTRY_COMPARE(itemSpy.count(), 1);
+
+    // the first job already consumed parts of its reply, so the second one can not share it
+    auto second = new ListContainersJob(this);
+    second->setAutoDelete(false);
+    second->setConfiguration(m_config);
+    second->start();
+    QTRY_COMPARE(m_daemon->requests().size(), requests + 2);
+
+    first->kill();
+    second->kill();
+    m_daemon->setHandler("GET", "/containers/json", original);
+}
+
+void TransportTest::testResponseCache()
+{
+    auto conf = m_daemon->createConfig(this);
+    conf->setResponseCacheTimeToLive(60000);
+
+    auto version = new GetVersionJob(this);
+    version->setAutoDelete(false);
+    version->setConfiguration(conf);
+
+    int requests = m_daemon->requests().size();
+    QVERIFY2(version->exec(), qUtf8Printable(version->errorString()));
+    QVERIFY2(version->exec(), qUtf8Printable(version->errorString()));
+    QCOMPARE(m_daemon->requests().size(), requests + 1);
+    QCOMPARE(version->replyData().object().value(QStringLiteral("Version")).toString(), QStringLiteral("20.10.12"));
+    QCOMPARE(version->versionInfo().version, QStringLiteral("20.10.12"));
+
+    // cached lists still report their items
+    auto list = new ListContainersJob(this);
+    list->setAutoDelete(false);
+    list->setConfiguration(conf);
+    int items = 0;
+    connect(list, &Job::itemReceived, this, [&items](){ items++; });
+
+    requests = m_daemon->requests().size();
+    QVERIFY2(list->exec(), qUtf8Printable(list->errorString()));
+    QVERIFY2(list->exec(), qUtf8Printable(list->errorString()));
+    QCOMPARE(m_daemon->requests().size(), requests + 1);
+    QCOMPARE(items, 4);
+    QCOMPARE(list->replyData().array().size(), 2);
+    QCOMPARE(list->containers().size(), 2);
+
+    // a different query is cached on its own
+    list->setShowAll(true);
+    QVERIFY2(list->exec(), qUtf8Printable(list->errorString()));
+    QCOMPARE(m_daemon->requests().size(), requests + 2);
+    list->setShowAll(false);
+
+    // lifecycle jobs invalidate the container lists
+    auto remove = new RemoveContainerJob(this);
+    remove->setAutoDelete(false);
+    remove->setConfiguration(conf);
+    remove->setId(QStringLiteral("e90e34656806"));
+    QVERIFY2(remove->exec(), qUtf8Printable(remove->errorString()));
+    requests = m_daemon->requests().size();
+    QVERIFY2(list->exec(), qUtf8Printable(list->errorString()));
+    QCOMPARE(m_daemon->requests().size(), requests + 1);
+
+    // the version is still cached until it is invalidated explicitly
+    QVERIFY2(version->exec(), qUtf8Printable(version->errorString()));
+    QCOMPARE(m_daemon->requests().size(), requests + 1);
+    conf->invalidateResponseCache(QStringLiteral("/version"));
+    QVERIFY2(version->exec(), qUtf8Printable(version->errorString()));
+    QCOMPARE(m_daemon->requests().size(), requests + 2);
+}
+
+QTEST_MAIN(TransportTest)
+
+#include "testtransport.moc"